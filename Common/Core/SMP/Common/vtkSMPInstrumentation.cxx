@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "SMP/Common/vtkSMPInstrumentation.h"
+
+#include "vtkCxxABIConfigure.h"
+#include "vtkLogger.h"
+
+#include <algorithm> // For std::find, std::max
+#include <cstdlib>   // For std::free
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+//------------------------------------------------------------------------------
+double vtkSMPInstrumentationRecord::GetBusyTime() const
+{
+  double busyTime = 0.0;
+  for (const auto& thread : this->Threads)
+  {
+    busyTime += thread.BusyTime;
+  }
+  return busyTime;
+}
+
+//------------------------------------------------------------------------------
+double vtkSMPInstrumentationRecord::GetIdleTime() const
+{
+  double maxBusyTime = 0.0;
+  for (const auto& thread : this->Threads)
+  {
+    maxBusyTime = std::max(maxBusyTime, thread.BusyTime);
+  }
+  return maxBusyTime * this->Threads.size() - this->GetBusyTime();
+}
+
+//------------------------------------------------------------------------------
+double vtkSMPInstrumentationRecord::GetImbalance() const
+{
+  const double busyTime = this->GetBusyTime();
+  if (this->Threads.empty() || busyTime <= 0.0)
+  {
+    return 1.0;
+  }
+  double maxBusyTime = 0.0;
+  for (const auto& thread : this->Threads)
+  {
+    maxBusyTime = std::max(maxBusyTime, thread.BusyTime);
+  }
+  return maxBusyTime * this->Threads.size() / busyTime;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkSMPInstrumentation::GetTypeName(const std::type_info& type)
+{
+  std::string name = type.name();
+#ifdef VTK_HAS_CXXABI_DEMANGLE
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+  if (status == 0 && demangled)
+  {
+    name = demangled;
+  }
+  std::free(demangled);
+#endif
+  return name;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPInstrumentation::Call::AddChunk(double busyTime)
+{
+  const std::thread::id id = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  auto it = std::find(this->ThreadIds.begin(), this->ThreadIds.end(), id);
+  if (it == this->ThreadIds.end())
+  {
+    this->ThreadIds.push_back(id);
+    this->Record.Threads.emplace_back();
+    it = this->ThreadIds.end() - 1;
+  }
+  auto& thread = this->Record.Threads[it - this->ThreadIds.begin()];
+  thread.BusyTime += busyTime;
+  thread.NumberOfChunks++;
+  this->Record.NumberOfChunks++;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPInstrumentation::Call::AddSteal()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Record.NumberOfSteals++;
+}
+
+//------------------------------------------------------------------------------
+std::unique_ptr<vtkSMPInstrumentation::Call> vtkSMPInstrumentation::BeginCall(
+  std::string name, const char* backend, vtkIdType first, vtkIdType last, vtkIdType grain)
+{
+  std::unique_ptr<Call> call(new Call);
+  call->Record.Name = std::move(name);
+  call->Record.Backend = backend ? backend : "";
+  call->Record.First = first;
+  call->Record.Last = last;
+  call->Record.Grain = grain;
+  call->Start = std::chrono::steady_clock::now();
+  return call;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPInstrumentation::EndCall(std::unique_ptr<Call> call)
+{
+  const std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - call->Start;
+  vtkSMPInstrumentationRecord& record = call->Record;
+  record.WallTime = wallTime.count();
+
+  vtkLogF(TRACE,
+    "vtkSMPTools %s [%lld, %lld) grain %lld (%s): %.3f ms, %lld chunks on %d threads, "
+    "%lld steals, imbalance %.2f, idle %.3f ms",
+    record.Name.c_str(), static_cast<long long>(record.First), static_cast<long long>(record.Last),
+    static_cast<long long>(record.Grain), record.Backend.c_str(), 1000.0 * record.WallTime,
+    static_cast<long long>(record.NumberOfChunks), static_cast<int>(record.Threads.size()),
+    static_cast<long long>(record.NumberOfSteals), record.GetImbalance(),
+    1000.0 * record.GetIdleTime());
+
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Records.emplace_back(std::move(record));
+  while (this->Records.size() > this->MaximumNumberOfRecords)
+  {
+    this->Records.pop_front();
+  }
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkSMPInstrumentationRecord> vtkSMPInstrumentation::GetRecords() const
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return std::vector<vtkSMPInstrumentationRecord>(this->Records.begin(), this->Records.end());
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPInstrumentation::ClearRecords()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Records.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPInstrumentation::SetMaximumNumberOfRecords(std::size_t maximum)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->MaximumNumberOfRecords = maximum;
+  while (this->Records.size() > this->MaximumNumberOfRecords)
+  {
+    this->Records.pop_front();
+  }
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkSMPInstrumentation::GetMaximumNumberOfRecords() const
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->MaximumNumberOfRecords;
+}
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
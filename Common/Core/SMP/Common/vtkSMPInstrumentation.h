@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef vtkSMPInstrumentation_h
+#define vtkSMPInstrumentation_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <atomic>      // For std::atomic
+#include <chrono>      // For std::chrono::steady_clock
+#include <cstddef>     // For std::size_t
+#include <deque>       // For std::deque
+#include <memory>      // For std::unique_ptr
+#include <mutex>       // For std::mutex
+#include <string>      // For std::string
+#include <thread>      // For std::thread::id
+#include <type_traits> // For std::decay
+#include <typeinfo>    // For std::type_info
+#include <utility>     // For std::declval
+#include <vector>      // For std::vector
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+/**
+ * @brief Scheduling statistics of a single vtkSMPTools::For call or task graph.
+ *
+ * Times are in seconds. A "chunk" is a sub-range given to a thread (or a task for a task
+ * graph). Only the threads that executed at least one chunk are listed in `Threads`.
+ */
+struct VTKCOMMONCORE_EXPORT vtkSMPInstrumentationRecord
+{
+  struct ThreadRecord
+  {
+    double BusyTime = 0.0;
+    vtkIdType NumberOfChunks = 0;
+  };
+
+  std::string Name;    // Type of the functor, or "vtkSMPTools::TaskGraph"
+  std::string Backend; // Backend in use
+  vtkIdType First = 0;
+  vtkIdType Last = 0;
+  vtkIdType Grain = 0; // Grain given by the caller, 0 if the backend chose it
+  double WallTime = 0.0;
+  vtkIdType NumberOfChunks = 0;
+  vtkIdType NumberOfSteals = 0; // Only known for the built-in task graph scheduler
+  std::vector<ThreadRecord> Threads;
+
+  /**
+   * Sum of the busy time of every thread.
+   */
+  double GetBusyTime() const;
+
+  /**
+   * Time the participating threads spent waiting for the slowest one, in seconds.
+   */
+  double GetIdleTime() const;
+
+  /**
+   * Ratio between the busiest thread and the average busy time: 1 means perfectly balanced,
+   * 2 means one thread worked twice as long as the average.
+   */
+  double GetImbalance() const;
+};
+
+/**
+ * @brief Internal recorder behind vtkSMPTools::SetInstrumentation().
+ *
+ * When enabled, vtkSMPToolsAPI wraps the functor given to For() in a
+ * vtkSMPInstrumentedFunctor that measures every chunk. Completed calls are kept in a bounded
+ * history and logged with vtkLogger at the TRACE verbosity.
+ */
+class VTKCOMMONCORE_EXPORT vtkSMPInstrumentation
+{
+public:
+  /**
+   * Statistics of a call in progress, chunks may be added from any thread.
+   */
+  class VTKCOMMONCORE_EXPORT Call
+  {
+  public:
+    void AddChunk(double busyTime);
+    void AddSteal();
+
+  private:
+    friend class vtkSMPInstrumentation;
+
+    vtkSMPInstrumentationRecord Record;
+    std::chrono::steady_clock::time_point Start;
+    std::vector<std::thread::id> ThreadIds;
+    std::mutex Mutex;
+  };
+
+  //--------------------------------------------------------------------------------
+  // Demangled name of a type, used to name records.
+  static std::string GetTypeName(const std::type_info& type);
+
+  //--------------------------------------------------------------------------------
+  bool IsEnabled() const { return this->Enabled.load(std::memory_order_relaxed); }
+
+  //--------------------------------------------------------------------------------
+  void SetEnabled(bool enabled) { this->Enabled.store(enabled); }
+
+  //--------------------------------------------------------------------------------
+  std::unique_ptr<Call> BeginCall(
+    std::string name, const char* backend, vtkIdType first, vtkIdType last, vtkIdType grain);
+
+  //--------------------------------------------------------------------------------
+  void EndCall(std::unique_ptr<Call> call);
+
+  //--------------------------------------------------------------------------------
+  std::vector<vtkSMPInstrumentationRecord> GetRecords() const;
+
+  //--------------------------------------------------------------------------------
+  void ClearRecords();
+
+  //--------------------------------------------------------------------------------
+  // Oldest records are dropped once this number is reached, defaults to 1000.
+  void SetMaximumNumberOfRecords(std::size_t maximum);
+  std::size_t GetMaximumNumberOfRecords() const;
+
+private:
+  std::atomic<bool> Enabled{ false };
+  mutable std::mutex Mutex;
+  std::deque<vtkSMPInstrumentationRecord> Records;
+  std::size_t MaximumNumberOfRecords = 1000;
+};
+
+/**
+ * @brief FunctorInternal wrapper measuring the time spent in each chunk.
+ */
+template <typename FunctorInternal>
+class vtkSMPInstrumentedFunctor
+{
+public:
+  vtkSMPInstrumentedFunctor(FunctorInternal& fi, vtkSMPInstrumentation::Call& call)
+    : Internal(fi)
+    , CallRecord(call)
+  {
+  }
+
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    this->Internal.Execute(first, last);
+    const std::chrono::duration<double> busyTime = std::chrono::steady_clock::now() - start;
+    this->CallRecord.AddChunk(busyTime.count());
+  }
+
+private:
+  FunctorInternal& Internal;
+  vtkSMPInstrumentation::Call& CallRecord;
+};
+
+/**
+ * @brief User functor type of a FunctorInternal, used to name the records.
+ */
+template <typename FunctorInternal, typename = void>
+struct vtkSMPInstrumentedFunctorType
+{
+  using type = FunctorInternal;
+};
+
+template <typename FunctorInternal>
+struct vtkSMPInstrumentedFunctorType<FunctorInternal,
+  decltype(void(std::declval<FunctorInternal&>().F))>
+{
+  using type = typename std::decay<decltype(std::declval<FunctorInternal&>().F)>::type;
+};
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+/* VTK-HeaderTest-Exclude: vtkSMPInstrumentation.h */
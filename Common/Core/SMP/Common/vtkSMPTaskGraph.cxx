@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "SMP/Common/vtkSMPTaskGraph.h"
+
+#include "vtkObject.h" // For vtkGenericWarningMacro
+
+#include <chrono>  // For std::chrono::steady_clock
+#include <utility> // For std::move
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::vtkSMPTaskGraph() = default;
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::~vtkSMPTaskGraph() = default;
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::TaskId vtkSMPTaskGraph::AddTask(std::function<void()> function)
+{
+  Task task;
+  task.Function = std::move(function);
+  this->Tasks.emplace_back(std::move(task));
+  return this->Tasks.size() - 1;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTaskGraph::AddDependency(TaskId task, TaskId dependency)
+{
+  if (task >= this->Tasks.size() || dependency >= this->Tasks.size() || task == dependency)
+  {
+    return false;
+  }
+  this->Tasks[dependency].Successors.push_back(task);
+  this->Tasks[task].NumberOfDependencies++;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::Clear()
+{
+  this->Tasks.clear();
+  this->RootTasks.clear();
+  this->Pending.reset();
+  this->Workers.clear();
+  this->ReadyTasks = 0;
+  this->RemainingTasks = 0;
+  this->Canceled = false;
+  this->Exception = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTaskGraph::Prepare()
+{
+  const std::size_t numberOfTasks = this->Tasks.size();
+  this->Pending.reset(new std::atomic<std::size_t>[numberOfTasks]);
+  this->RootTasks.clear();
+  this->Canceled = false;
+  this->Exception = nullptr;
+  this->RemainingTasks = numberOfTasks;
+
+  // Kahn's algorithm: every task has to be reachable from the roots, otherwise the graph has a
+  // cycle and the backends would wait forever.
+  std::vector<std::size_t> counts(numberOfTasks);
+  std::vector<TaskId> stack;
+  for (TaskId id = 0; id < numberOfTasks; ++id)
+  {
+    counts[id] = this->Tasks[id].NumberOfDependencies;
+    this->Pending[id] = counts[id];
+    if (counts[id] == 0)
+    {
+      this->RootTasks.push_back(id);
+      stack.push_back(id);
+    }
+  }
+
+  std::size_t visited = 0;
+  while (!stack.empty())
+  {
+    const TaskId id = stack.back();
+    stack.pop_back();
+    ++visited;
+    for (TaskId successor : this->Tasks[id].Successors)
+    {
+      if (--counts[successor] == 0)
+      {
+        stack.push_back(successor);
+      }
+    }
+  }
+
+  if (visited != numberOfTasks)
+  {
+    vtkGenericWarningMacro("vtkSMPTools::TaskGraph contains a dependency cycle, "
+      << numberOfTasks - visited << " task(s) can never run. Nothing is executed.");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::Execute(TaskId id)
+{
+  if (this->Canceled.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  try
+  {
+    if (this->Instrumentation)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      this->Tasks[id].Function();
+      const std::chrono::duration<double> busyTime = std::chrono::steady_clock::now() - start;
+      this->Instrumentation->AddChunk(busyTime.count());
+    }
+    else
+    {
+      this->Tasks[id].Function();
+    }
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(this->ExceptionMutex);
+    if (!this->Exception)
+    {
+      this->Exception = std::current_exception();
+    }
+    this->Canceled.store(true, std::memory_order_release);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::InitializeWorkers(std::size_t numberOfWorkers)
+{
+  numberOfWorkers = numberOfWorkers > 0 ? numberOfWorkers : 1;
+  this->Workers.clear();
+  for (std::size_t i = 0; i < numberOfWorkers; ++i)
+  {
+    this->Workers.emplace_back(new WorkerQueue);
+  }
+
+  // Spread the roots so that every worker has something to start with.
+  this->ReadyTasks = 0;
+  for (std::size_t i = 0; i < this->RootTasks.size(); ++i)
+  {
+    this->Workers[i % numberOfWorkers]->Tasks.push_back(this->RootTasks[i]);
+  }
+  this->ReadyTasks = this->RootTasks.size();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::Push(std::size_t workerIndex, TaskId id)
+{
+  {
+    WorkerQueue& queue = *this->Workers[workerIndex];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    queue.Tasks.push_back(id);
+  }
+  this->ReadyTasks.fetch_add(1);
+  if (this->SleepingWorkers.load() > 0)
+  {
+    std::lock_guard<std::mutex> lock(this->WakeMutex);
+    this->WakeCondition.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTaskGraph::Pop(std::size_t workerIndex, TaskId& id)
+{
+  WorkerQueue& queue = *this->Workers[workerIndex];
+  std::lock_guard<std::mutex> lock(queue.Mutex);
+  if (queue.Tasks.empty())
+  {
+    return false;
+  }
+  id = queue.Tasks.back();
+  queue.Tasks.pop_back();
+  this->ReadyTasks.fetch_sub(1);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTaskGraph::Steal(std::size_t workerIndex, TaskId& id)
+{
+  const std::size_t numberOfWorkers = this->Workers.size();
+  for (std::size_t offset = 1; offset < numberOfWorkers; ++offset)
+  {
+    WorkerQueue& victim = *this->Workers[(workerIndex + offset) % numberOfWorkers];
+    std::lock_guard<std::mutex> lock(victim.Mutex);
+    if (!victim.Tasks.empty())
+    {
+      id = victim.Tasks.front();
+      victim.Tasks.pop_front();
+      this->ReadyTasks.fetch_sub(1);
+      if (this->Instrumentation)
+      {
+        this->Instrumentation->AddSteal();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::RunWorker(std::size_t workerIndex)
+{
+  while (this->RemainingTasks.load() > 0)
+  {
+    TaskId id;
+    if (this->Pop(workerIndex, id) || this->Steal(workerIndex, id))
+    {
+      this->Execute(id);
+      this->Release(id, [this, workerIndex](TaskId ready) { this->Push(workerIndex, ready); });
+      if (this->RemainingTasks.fetch_sub(1) == 1)
+      {
+        std::lock_guard<std::mutex> lock(this->WakeMutex);
+        this->WakeCondition.notify_all();
+      }
+      continue;
+    }
+
+    // Nothing to run: sleep until a task is pushed or the graph is done.
+    std::unique_lock<std::mutex> lock(this->WakeMutex);
+    this->SleepingWorkers.fetch_add(1);
+    this->WakeCondition.wait(lock,
+      [this] { return this->ReadyTasks.load() > 0 || this->RemainingTasks.load() == 0; });
+    this->SleepingWorkers.fetch_sub(1);
+  }
+}
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
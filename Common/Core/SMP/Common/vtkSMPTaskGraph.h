@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef vtkSMPTaskGraph_h
+#define vtkSMPTaskGraph_h
+
+#include "SMP/Common/vtkSMPInstrumentation.h" // For vtkSMPInstrumentation::Call
+#include "vtkCommonCoreModule.h"               // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <atomic>             // For std::atomic
+#include <condition_variable> // For std::condition_variable
+#include <cstddef>            // For std::size_t
+#include <deque>              // For std::deque
+#include <exception>          // For std::exception_ptr
+#include <functional>         // For std::function
+#include <memory>             // For std::unique_ptr
+#include <mutex>              // For std::mutex
+#include <vector>             // For std::vector
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+/**
+ * @brief Internal storage and scheduling helpers for vtkSMPTools::TaskGraph.
+ *
+ * A task graph is a directed acyclic graph of std::function<void()> nodes. Each node keeps the
+ * list of its successors and the number of tasks it depends on. Backends execute the graph by
+ * starting with the root tasks (no dependencies) and calling `Release()` every time a task is
+ * done: successors whose last dependency has been released become ready and are handed back to
+ * the backend through the `spawn` callback.
+ *
+ * Backends without a native task scheduler (Sequential and STDThread) use the built-in
+ * work-stealing scheduler: `InitializeWorkers()` seeds one deque per worker with the root tasks,
+ * then every worker calls `RunWorker()`. A worker pops its own deque from the back (LIFO, so
+ * continuations run on the thread that produced their input) and steals from the front of the
+ * other deques when it runs dry.
+ *
+ * Once a task throws, the remaining tasks are skipped but still released so that the graph
+ * always completes. The first exception is kept and can be retrieved with `GetException()`.
+ */
+class VTKCOMMONCORE_EXPORT vtkSMPTaskGraph
+{
+public:
+  using TaskId = std::size_t;
+
+  vtkSMPTaskGraph();
+  ~vtkSMPTaskGraph();
+  vtkSMPTaskGraph(const vtkSMPTaskGraph&) = delete;
+  vtkSMPTaskGraph& operator=(const vtkSMPTaskGraph&) = delete;
+
+  //--------------------------------------------------------------------------------
+  TaskId AddTask(std::function<void()> function);
+
+  //--------------------------------------------------------------------------------
+  bool AddDependency(TaskId task, TaskId dependency);
+
+  //--------------------------------------------------------------------------------
+  std::size_t GetNumberOfTasks() const { return this->Tasks.size(); }
+
+  //--------------------------------------------------------------------------------
+  void Clear();
+
+  //--------------------------------------------------------------------------------
+  // Reset the dependency counters and check that the graph is acyclic. Returns false (and
+  // nothing should be executed) if a cycle has been found.
+  bool Prepare();
+
+  //--------------------------------------------------------------------------------
+  const std::vector<TaskId>& GetRootTasks() const { return this->RootTasks; }
+
+  //--------------------------------------------------------------------------------
+  // Run the task function, unless a previous task has thrown.
+  void Execute(TaskId id);
+
+  //--------------------------------------------------------------------------------
+  // Decrement the dependency counter of every successor of `id` and call `spawn` for the ones
+  // that became ready.
+  template <typename Spawner>
+  void Release(TaskId id, Spawner&& spawn)
+  {
+    for (TaskId successor : this->Tasks[id].Successors)
+    {
+      if (this->Pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        spawn(successor);
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  void InitializeWorkers(std::size_t numberOfWorkers);
+
+  //--------------------------------------------------------------------------------
+  void RunWorker(std::size_t workerIndex);
+
+  //--------------------------------------------------------------------------------
+  std::exception_ptr GetException() const { return this->Exception; }
+
+  //--------------------------------------------------------------------------------
+  // When set, the duration of every task and the number of steals are recorded in `call`.
+  void SetInstrumentation(vtkSMPInstrumentation::Call* call) { this->Instrumentation = call; }
+
+private:
+  struct Task
+  {
+    std::function<void()> Function;
+    std::vector<TaskId> Successors;
+    std::size_t NumberOfDependencies = 0;
+  };
+
+  struct WorkerQueue
+  {
+    std::mutex Mutex;
+    std::deque<TaskId> Tasks;
+  };
+
+  void Push(std::size_t workerIndex, TaskId id);
+  bool Pop(std::size_t workerIndex, TaskId& id);
+  bool Steal(std::size_t workerIndex, TaskId& id);
+
+  std::vector<Task> Tasks;
+  std::vector<TaskId> RootTasks;
+  std::unique_ptr<std::atomic<std::size_t>[]> Pending;
+
+  std::vector<std::unique_ptr<WorkerQueue>> Workers;
+  std::atomic<std::size_t> ReadyTasks{ 0 };
+  std::atomic<std::size_t> RemainingTasks{ 0 };
+  std::atomic<int> SleepingWorkers{ 0 };
+  std::mutex WakeMutex;
+  std::condition_variable WakeCondition;
+
+  std::atomic<bool> Canceled{ false };
+  std::mutex ExceptionMutex;
+  std::exception_ptr Exception;
+
+  vtkSMPInstrumentation::Call* Instrumentation = nullptr;
+};
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
+/* VTK-HeaderTest-Exclude: vtkSMPTaskGraph.h */
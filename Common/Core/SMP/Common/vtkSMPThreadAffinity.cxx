@@ -0,0 +1,347 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "SMP/Common/vtkSMPThreadAffinity.h"
+
+#include <algorithm> // For std::find
+#include <cctype>    // For std::isspace, std::tolower
+#include <cstdlib>   // For std::strtol
+#include <fstream>   // For std::ifstream
+#include <sstream>   // For std::ostringstream
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include "vtkWindows.h"
+#endif
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Parse a list of indices and ranges such as "0-3,8,10-11".
+bool ParseProcessorList(const std::string& list, std::vector<int>& processors)
+{
+  std::vector<int> result;
+  std::size_t position = 0;
+  while (position <= list.size())
+  {
+    std::size_t next = list.find(',', position);
+    if (next == std::string::npos)
+    {
+      next = list.size();
+    }
+    const std::string item = list.substr(position, next - position);
+    const char* begin = item.c_str();
+    char* end = nullptr;
+    const long first = std::strtol(begin, &end, 10);
+    if (end == begin || first < 0)
+    {
+      return false;
+    }
+    long last = first;
+    if (*end == '-')
+    {
+      begin = end + 1;
+      last = std::strtol(begin, &end, 10);
+      if (end == begin || last < first)
+      {
+        return false;
+      }
+    }
+    if (*end != '\0')
+    {
+      return false;
+    }
+    for (long processor = first; processor <= last; ++processor)
+    {
+      result.push_back(static_cast<int>(processor));
+    }
+    position = next + 1;
+  }
+  processors.swap(result);
+  return !processors.empty();
+}
+
+#if defined(__linux__)
+//------------------------------------------------------------------------------
+cpu_set_t GetProcessMask()
+{
+  // Computed once, before any thread of the pool is bound.
+  static const cpu_set_t mask = []() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    {
+      for (unsigned int i = 0; i < std::thread::hardware_concurrency(); ++i)
+      {
+        CPU_SET(i, &set);
+      }
+    }
+    return set;
+  }();
+  return mask;
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Processors available to the process, in increasing order.
+std::vector<int> GetAvailableProcessors()
+{
+  std::vector<int> processors;
+#if defined(__linux__)
+  cpu_set_t mask = GetProcessMask();
+  for (int i = 0; i < CPU_SETSIZE; ++i)
+  {
+    if (CPU_ISSET(i, &mask))
+    {
+      processors.push_back(i);
+    }
+  }
+#elif defined(_WIN32)
+  DWORD_PTR processMask = 0;
+  DWORD_PTR systemMask = 0;
+  if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+  {
+    for (int i = 0; i < static_cast<int>(8 * sizeof(DWORD_PTR)); ++i)
+    {
+      if (processMask & (static_cast<DWORD_PTR>(1) << i))
+      {
+        processors.push_back(i);
+      }
+    }
+  }
+#endif
+  if (processors.empty())
+  {
+    for (unsigned int i = 0; i < std::thread::hardware_concurrency(); ++i)
+    {
+      processors.push_back(static_cast<int>(i));
+    }
+  }
+  return processors;
+}
+
+//------------------------------------------------------------------------------
+// Available processors grouped by NUMA node.
+std::vector<std::vector<int>> GetNodes()
+{
+  const std::vector<int> available = GetAvailableProcessors();
+  std::vector<std::vector<int>> nodes;
+  std::vector<int> assigned;
+
+#if defined(__linux__)
+  std::ifstream onlineFile("/sys/devices/system/node/online");
+  std::string online;
+  std::vector<int> nodeIds;
+  if (onlineFile && std::getline(onlineFile, online) && ParseProcessorList(online, nodeIds))
+  {
+    for (int nodeId : nodeIds)
+    {
+      std::ifstream cpuFile(
+        "/sys/devices/system/node/node" + std::to_string(nodeId) + "/cpulist");
+      std::string cpuList;
+      std::vector<int> cpus;
+      if (!cpuFile || !std::getline(cpuFile, cpuList) || !ParseProcessorList(cpuList, cpus))
+      {
+        continue;
+      }
+      std::vector<int> node;
+      for (int cpu : cpus)
+      {
+        if (std::find(available.begin(), available.end(), cpu) != available.end())
+        {
+          node.push_back(cpu);
+          assigned.push_back(cpu);
+        }
+      }
+      if (!node.empty())
+      {
+        nodes.push_back(node);
+      }
+    }
+  }
+#endif
+
+  // Processors without a known node (or no NUMA information at all) form the last node.
+  std::vector<int> remaining;
+  for (int cpu : available)
+  {
+    if (std::find(assigned.begin(), assigned.end(), cpu) == assigned.end())
+    {
+      remaining.push_back(cpu);
+    }
+  }
+  if (!remaining.empty())
+  {
+    nodes.push_back(remaining);
+  }
+  return nodes;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+bool vtkSMPThreadAffinity::Parse(const std::string& description)
+{
+  std::string value;
+  for (char c : description)
+  {
+    if (!std::isspace(static_cast<unsigned char>(c)))
+    {
+      value += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  }
+
+  if (value.empty() || value == "none")
+  {
+    this->Policy = PolicyType::None;
+    this->Processors.clear();
+  }
+  else if (value == "compact")
+  {
+    this->Policy = PolicyType::Compact;
+    this->Processors.clear();
+  }
+  else if (value == "scatter")
+  {
+    this->Policy = PolicyType::Scatter;
+    this->Processors.clear();
+  }
+  else
+  {
+    std::vector<int> processors;
+    if (!ParseProcessorList(value, processors))
+    {
+      return false;
+    }
+    this->Policy = PolicyType::Explicit;
+    this->Processors.swap(processors);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkSMPThreadAffinity::GetDescription() const
+{
+  switch (this->Policy)
+  {
+    case PolicyType::None:
+      return "none";
+    case PolicyType::Compact:
+      return "compact";
+    case PolicyType::Scatter:
+      return "scatter";
+    case PolicyType::Explicit:
+      break;
+  }
+  std::ostringstream description;
+  for (std::size_t i = 0; i < this->Processors.size(); ++i)
+  {
+    description << (i ? "," : "") << this->Processors[i];
+  }
+  return description.str();
+}
+
+//------------------------------------------------------------------------------
+std::vector<int> vtkSMPThreadAffinity::ComputeProcessors(std::size_t numberOfThreads) const
+{
+  std::vector<int> order;
+  switch (this->Policy)
+  {
+    case PolicyType::None:
+      return order;
+    case PolicyType::Explicit:
+      order = this->Processors;
+      break;
+    case PolicyType::Compact:
+      for (const auto& node : GetNodes())
+      {
+        order.insert(order.end(), node.begin(), node.end());
+      }
+      break;
+    case PolicyType::Scatter:
+    {
+      const auto nodes = GetNodes();
+      for (std::size_t rank = 0; order.size() < numberOfThreads; ++rank)
+      {
+        bool found = false;
+        for (const auto& node : nodes)
+        {
+          if (rank < node.size())
+          {
+            order.push_back(node[rank]);
+            found = true;
+          }
+        }
+        if (!found)
+        {
+          break;
+        }
+      }
+      break;
+    }
+  }
+
+  std::vector<int> processors(numberOfThreads);
+  for (std::size_t i = 0; i < numberOfThreads && !order.empty(); ++i)
+  {
+    processors[i] = order[i % order.size()];
+  }
+  return order.empty() ? order : processors;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPThreadAffinity::BindThread(std::thread& thread, int processor)
+{
+#if defined(__linux__)
+  if (processor < 0 || processor >= CPU_SETSIZE)
+  {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(processor, &set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+  if (processor < 0 || processor >= static_cast<int>(8 * sizeof(DWORD_PTR)))
+  {
+    return false;
+  }
+  return SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()),
+           static_cast<DWORD_PTR>(1) << processor) != 0;
+#else
+  (void)thread;
+  (void)processor;
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPThreadAffinity::UnbindThread(std::thread& thread)
+{
+#if defined(__linux__)
+  cpu_set_t set = GetProcessMask();
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+  DWORD_PTR processMask = 0;
+  DWORD_PTR systemMask = 0;
+  return GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask) &&
+    SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), processMask) != 0;
+#else
+  (void)thread;
+  return false;
+#endif
+}
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
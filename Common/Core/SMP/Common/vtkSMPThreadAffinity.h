@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef vtkSMPThreadAffinity_h
+#define vtkSMPThreadAffinity_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <cstddef> // For std::size_t
+#include <string>  // For std::string
+#include <thread>  // For std::thread
+#include <vector>  // For std::vector
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+/**
+ * @brief Internal description of the processors SMP threads should be bound to.
+ *
+ * An affinity is parsed from a string:
+ * - "" or "none": threads are not bound, the OS is free to migrate them (default),
+ * - "compact": consecutive threads are bound to consecutive processors, filling a NUMA node
+ *   before using the next one,
+ * - "scatter": consecutive threads are bound to processors of different NUMA nodes, so that a
+ *   reduced number of threads still uses the memory bandwidth of every socket,
+ * - a list of processor indices and ranges, e.g. "0-7,16-23": thread i is bound to the
+ *   i-th processor of the list (modulo its length).
+ *
+ * NUMA nodes are read from /sys/devices/system/node on Linux. On other platforms, or when
+ * this information is not available, all processors belong to a single node and "scatter" is
+ * equivalent to "compact". Binding is implemented for Linux and Windows only.
+ */
+class VTKCOMMONCORE_EXPORT vtkSMPThreadAffinity
+{
+public:
+  enum class PolicyType
+  {
+    None,
+    Compact,
+    Scatter,
+    Explicit
+  };
+
+  //--------------------------------------------------------------------------------
+  // Returns false, and leaves this object untouched, if the description is not valid.
+  bool Parse(const std::string& description);
+
+  //--------------------------------------------------------------------------------
+  PolicyType GetPolicy() const { return this->Policy; }
+
+  //--------------------------------------------------------------------------------
+  // Normalized description, suitable for Parse().
+  std::string GetDescription() const;
+
+  //--------------------------------------------------------------------------------
+  // Processor each of the `numberOfThreads` threads should be bound to. Empty when the policy
+  // is None.
+  std::vector<int> ComputeProcessors(std::size_t numberOfThreads) const;
+
+  //--------------------------------------------------------------------------------
+  // Thread binding, return false if it is not supported or the processor is not available to
+  // the process. Unbinding restores the affinity the process had at startup.
+  static bool BindThread(std::thread& thread, int processor);
+  static bool UnbindThread(std::thread& thread);
+
+  //--------------------------------------------------------------------------------
+  bool operator==(const vtkSMPThreadAffinity& other) const
+  {
+    return this->Policy == other.Policy && this->Processors == other.Processors;
+  }
+  bool operator!=(const vtkSMPThreadAffinity& other) const { return !(*this == other); }
+
+private:
+  PolicyType Policy = PolicyType::None;
+  std::vector<int> Processors; // Explicit policy only
+};
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
+/* VTK-HeaderTest-Exclude: vtkSMPThreadAffinity.h */
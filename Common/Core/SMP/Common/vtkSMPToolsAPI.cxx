@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "SMP/Common/vtkSMPToolsAPI.h"
+#include "SMP/Common/vtkSMPTaskGraph.h" // For vtkSMPTaskGraph
 #include "vtkSMP.h"    // For SMP preprocessor information
 #include "vtkSetGet.h" // For vtkWarningMacro
 
@@ -48,6 +49,27 @@ vtkSMPToolsAPI::vtkSMPToolsAPI()
 
   // Set max thread number from env
   this->RefreshNumberOfThread();
+
+  // Enable adaptive scheduling from env if set
+  const char* vtkSMPAdaptiveScheduling = std::getenv("VTK_SMP_ADAPTIVE_SCHEDULING");
+  if (vtkSMPAdaptiveScheduling)
+  {
+    this->SetAdaptiveScheduling(std::atoi(vtkSMPAdaptiveScheduling) != 0);
+  }
+
+  // Enable instrumentation from env if set
+  const char* vtkSMPInstrumentation = std::getenv("VTK_SMP_INSTRUMENTATION");
+  if (vtkSMPInstrumentation)
+  {
+    this->Instrumentation.SetEnabled(std::atoi(vtkSMPInstrumentation) != 0);
+  }
+
+  // Set thread affinity from env if set
+  const char* vtkSMPThreadAffinity = std::getenv("VTK_SMP_THREAD_AFFINITY");
+  if (vtkSMPThreadAffinity)
+  {
+    this->SetThreadAffinity(vtkSMPThreadAffinity);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -131,9 +153,67 @@ bool vtkSMPToolsAPI::SetBackend(const char* type)
     return false;
   }
   this->RefreshNumberOfThread();
+  this->RefreshThreadAffinity();
   return true;
 }
 
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::SetThreadAffinity(const char* affinity)
+{
+  vtkSMPThreadAffinity threadAffinity;
+  if (!affinity || !threadAffinity.Parse(affinity))
+  {
+    std::cerr << "WARNING: invalid SMPTools thread affinity \"" << (affinity ? affinity : "")
+              << "\"!\n";
+    std::cerr << "Valid values are \"none\", \"compact\", \"scatter\" or a list of "
+                 "processors such as \"0-3,8-11\".\n";
+    std::cerr << "Using \"" << this->ThreadAffinityDescription << "\" instead." << std::endl;
+    return false;
+  }
+  if (threadAffinity != this->ThreadAffinity)
+  {
+    this->ThreadAffinity = threadAffinity;
+    this->ThreadAffinityDescription = threadAffinity.GetDescription();
+    this->RefreshThreadAffinity();
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPToolsAPI::GetThreadAffinity()
+{
+  return this->ThreadAffinityDescription.c_str();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::RefreshThreadAffinity()
+{
+  // Nothing to undo if threads have never been bound, this also avoids spawning the threads of
+  // the STDThread pool just to unbind them.
+  if (this->ThreadAffinity.GetPolicy() == vtkSMPThreadAffinity::PolicyType::None &&
+    !this->ThreadAffinityApplied)
+  {
+    return;
+  }
+  this->ThreadAffinityApplied = true;
+
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      this->SequentialBackend->SetThreadAffinity(this->ThreadAffinity);
+      break;
+    case BackendType::STDThread:
+      this->STDThreadBackend->SetThreadAffinity(this->ThreadAffinity);
+      break;
+    case BackendType::TBB:
+      this->TBBBackend->SetThreadAffinity(this->ThreadAffinity);
+      break;
+    case BackendType::OpenMP:
+      this->OpenMPBackend->SetThreadAffinity(this->ThreadAffinity);
+      break;
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkSMPToolsAPI::Initialize(int numThreads)
 {
@@ -233,6 +313,43 @@ bool vtkSMPToolsAPI::GetNestedParallelism()
   return false;
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetAdaptiveScheduling(bool adaptive)
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      this->SequentialBackend->SetAdaptiveScheduling(adaptive);
+      break;
+    case BackendType::STDThread:
+      this->STDThreadBackend->SetAdaptiveScheduling(adaptive);
+      break;
+    case BackendType::TBB:
+      this->TBBBackend->SetAdaptiveScheduling(adaptive);
+      break;
+    case BackendType::OpenMP:
+      this->OpenMPBackend->SetAdaptiveScheduling(adaptive);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::GetAdaptiveScheduling()
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      return this->SequentialBackend->GetAdaptiveScheduling();
+    case BackendType::STDThread:
+      return this->STDThreadBackend->GetAdaptiveScheduling();
+    case BackendType::TBB:
+      return this->TBBBackend->GetAdaptiveScheduling();
+    case BackendType::OpenMP:
+      return this->OpenMPBackend->GetAdaptiveScheduling();
+  }
+  return false;
+}
+
 //------------------------------------------------------------------------------
 bool vtkSMPToolsAPI::IsParallelScope()
 {
@@ -271,6 +388,40 @@ bool vtkSMPToolsAPI::GetSingleThread()
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::RunTaskGraph(vtkSMPTaskGraph& graph)
+{
+  std::unique_ptr<vtkSMPInstrumentation::Call> call;
+  if (this->Instrumentation.IsEnabled())
+  {
+    call = this->Instrumentation.BeginCall("vtkSMPTools::TaskGraph", this->GetBackend(), 0,
+      static_cast<vtkIdType>(graph.GetNumberOfTasks()), 1);
+    graph.SetInstrumentation(call.get());
+  }
+
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      this->SequentialBackend->RunTaskGraph(graph);
+      break;
+    case BackendType::STDThread:
+      this->STDThreadBackend->RunTaskGraph(graph);
+      break;
+    case BackendType::TBB:
+      this->TBBBackend->RunTaskGraph(graph);
+      break;
+    case BackendType::OpenMP:
+      this->OpenMPBackend->RunTaskGraph(graph);
+      break;
+  }
+
+  if (call)
+  {
+    graph.SetInstrumentation(nullptr);
+    this->Instrumentation.EndCall(std::move(call));
+  }
+}
+
 //------------------------------------------------------------------------------
 // Must NOT be initialized. Default initialization to zero is necessary.
 unsigned int vtkSMPToolsAPIInitializeCount;
@@ -10,7 +10,11 @@
 #include "vtkSMP.h"
 
 #include <memory>
+#include <string>
+#include <typeinfo>
 
+#include "SMP/Common/vtkSMPInstrumentation.h"
+#include "SMP/Common/vtkSMPThreadAffinity.h"
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #if VTK_SMP_ENABLE_SEQUENTIAL
 #include "SMP/Sequential/vtkSMPToolsImpl.txx"
@@ -65,6 +69,24 @@ public:
   //--------------------------------------------------------------------------------
   bool GetNestedParallelism();
 
+  //--------------------------------------------------------------------------------
+  void SetAdaptiveScheduling(bool adaptive);
+
+  //--------------------------------------------------------------------------------
+  bool GetAdaptiveScheduling();
+
+  //--------------------------------------------------------------------------------
+  bool SetThreadAffinity(const char* affinity);
+
+  //--------------------------------------------------------------------------------
+  const char* GetThreadAffinity();
+
+  //--------------------------------------------------------------------------------
+  void SetFirstTouchAllocation(bool firstTouch) { this->FirstTouchAllocation = firstTouch; }
+
+  //--------------------------------------------------------------------------------
+  bool GetFirstTouchAllocation() { return this->FirstTouchAllocation; }
+
   //--------------------------------------------------------------------------------
   bool IsParallelScope();
 
@@ -92,27 +114,32 @@ public:
     *this << oldConfig;
   }
 
+  //--------------------------------------------------------------------------------
+  vtkSMPInstrumentation& GetInstrumentation() { return this->Instrumentation; }
+
   //--------------------------------------------------------------------------------
   template <typename FunctorInternal>
   void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
   {
-    switch (this->ActivatedBackend)
+    if (this->Instrumentation.IsEnabled())
     {
-      case BackendType::Sequential:
-        this->SequentialBackend->For(first, last, grain, fi);
-        break;
-      case BackendType::STDThread:
-        this->STDThreadBackend->For(first, last, grain, fi);
-        break;
-      case BackendType::TBB:
-        this->TBBBackend->For(first, last, grain, fi);
-        break;
-      case BackendType::OpenMP:
-        this->OpenMPBackend->For(first, last, grain, fi);
-        break;
+      using Functor = typename vtkSMPInstrumentedFunctorType<FunctorInternal>::type;
+      auto call =
+        this->Instrumentation.BeginCall(vtkSMPInstrumentation::GetTypeName(typeid(Functor)),
+          this->GetBackend(), first, last, grain);
+      vtkSMPInstrumentedFunctor<FunctorInternal> instrumented(fi, *call);
+      this->DispatchFor(first, last, grain, instrumented);
+      this->Instrumentation.EndCall(std::move(call));
+    }
+    else
+    {
+      this->DispatchFor(first, last, grain, fi);
     }
   }
 
+  //--------------------------------------------------------------------------------
+  void RunTaskGraph(vtkSMPTaskGraph& graph);
+
   //--------------------------------------------------------------------------------
   template <typename InputIt, typename OutputIt, typename Functor>
   void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor& transform)
@@ -177,6 +204,60 @@ public:
     }
   }
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename BinaryOp>
+  T Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->Reduce(begin, end, init, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->Reduce(begin, end, init, op);
+      case BackendType::TBB:
+        return this->TBBBackend->Reduce(begin, end, init, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->Reduce(begin, end, init, op);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <bool Inclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  OutputIt Scan(InputIt begin, InputIt end, OutputIt outBegin, const T* init, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->template Scan<Inclusive>(begin, end, outBegin, init, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->template Scan<Inclusive>(begin, end, outBegin, init, op);
+      case BackendType::TBB:
+        return this->TBBBackend->template Scan<Inclusive>(begin, end, outBegin, init, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->template Scan<Inclusive>(begin, end, outBegin, init, op);
+    }
+    return outBegin;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+  OutputIt CopyIf(InputIt begin, InputIt end, OutputIt outBegin, UnaryPredicate pred)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->CopyIf(begin, end, outBegin, pred);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->CopyIf(begin, end, outBegin, pred);
+      case BackendType::TBB:
+        return this->TBBBackend->CopyIf(begin, end, outBegin, pred);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->CopyIf(begin, end, outBegin, pred);
+    }
+    return outBegin;
+  }
+
   //--------------------------------------------------------------------------------
   template <typename RandomAccessIterator>
   void Sort(RandomAccessIterator begin, RandomAccessIterator end)
@@ -235,9 +316,33 @@ private:
   //--------------------------------------------------------------------------------
   vtkSMPToolsAPI();
 
+  //--------------------------------------------------------------------------------
+  template <typename FunctorInternal>
+  void DispatchFor(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        this->SequentialBackend->For(first, last, grain, fi);
+        break;
+      case BackendType::STDThread:
+        this->STDThreadBackend->For(first, last, grain, fi);
+        break;
+      case BackendType::TBB:
+        this->TBBBackend->For(first, last, grain, fi);
+        break;
+      case BackendType::OpenMP:
+        this->OpenMPBackend->For(first, last, grain, fi);
+        break;
+    }
+  }
+
   //--------------------------------------------------------------------------------
   void RefreshNumberOfThread();
 
+  //--------------------------------------------------------------------------------
+  void RefreshThreadAffinity();
+
   //--------------------------------------------------------------------------------
   // This operator overload is used to unpack Config parameters and set them
   // in vtkSMPToolsAPI (e.g `*this << config;`)
@@ -247,6 +352,9 @@ private:
     this->Initialize(config.MaxNumberOfThreads);
     this->SetBackend(config.Backend.c_str());
     this->SetNestedParallelism(config.NestedParallelism);
+    this->SetAdaptiveScheduling(config.AdaptiveScheduling);
+    this->SetThreadAffinity(config.ThreadAffinity.c_str());
+    this->SetFirstTouchAllocation(config.FirstTouchAllocation);
     return *this;
   }
 
@@ -260,6 +368,23 @@ private:
    */
   int DesiredNumberOfThread = 0;
 
+  /**
+   * Processors the threads of the backend are bound to
+   */
+  vtkSMPThreadAffinity ThreadAffinity;
+  std::string ThreadAffinityDescription = "none";
+  bool ThreadAffinityApplied = false;
+
+  /**
+   * Use a parallel first touch when vtkBuffer allocates memory
+   */
+  bool FirstTouchAllocation = false;
+
+  /**
+   * Scheduling statistics recorder
+   */
+  vtkSMPInstrumentation Instrumentation;
+
   /**
    * Sequential backend
    */
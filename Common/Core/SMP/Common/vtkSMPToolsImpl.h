@@ -42,6 +42,9 @@ const BackendType DefaultBackend = BackendType::TBB;
 const BackendType DefaultBackend = BackendType::OpenMP;
 #endif
 
+class vtkSMPTaskGraph;
+class vtkSMPThreadAffinity;
+
 template <BackendType Backend>
 class VTKCOMMONCORE_EXPORT vtkSMPToolsImpl
 {
@@ -61,16 +64,30 @@ public:
   //--------------------------------------------------------------------------------
   bool GetNestedParallelism() { return this->NestedActivated; }
 
+  //--------------------------------------------------------------------------------
+  void SetAdaptiveScheduling(bool adaptive) { this->AdaptiveScheduling = adaptive; }
+
+  //--------------------------------------------------------------------------------
+  bool GetAdaptiveScheduling() { return this->AdaptiveScheduling; }
+
   //--------------------------------------------------------------------------------
   bool IsParallelScope() { return this->IsParallel; }
 
   //--------------------------------------------------------------------------------
   bool GetSingleThread();
 
+  //--------------------------------------------------------------------------------
+  // Bind the threads managed by the backend. Returns false when the backend does not manage
+  // its threads or when binding failed.
+  bool SetThreadAffinity(const vtkSMPThreadAffinity& affinity);
+
   //--------------------------------------------------------------------------------
   template <typename FunctorInternal>
   void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi);
 
+  //--------------------------------------------------------------------------------
+  void RunTaskGraph(vtkSMPTaskGraph& graph);
+
   //--------------------------------------------------------------------------------
   template <typename InputIt, typename OutputIt, typename Functor>
   void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor transform);
@@ -84,6 +101,19 @@ public:
   template <typename Iterator, typename T>
   void Fill(Iterator begin, Iterator end, const T& value);
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename BinaryOp>
+  T Reduce(InputIt begin, InputIt end, T init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  // Inclusive or exclusive scan. `init` is optional (nullptr) for inclusive scans only.
+  template <bool Inclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  OutputIt Scan(InputIt begin, InputIt end, OutputIt outBegin, const T* init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+  OutputIt CopyIf(InputIt begin, InputIt end, OutputIt outBegin, UnaryPredicate pred);
+
   //--------------------------------------------------------------------------------
   template <typename RandomAccessIterator>
   void Sort(RandomAccessIterator begin, RandomAccessIterator end);
@@ -102,6 +132,7 @@ public:
   //--------------------------------------------------------------------------------
   vtkSMPToolsImpl(const vtkSMPToolsImpl& other)
     : NestedActivated(other.NestedActivated)
+    , AdaptiveScheduling(other.AdaptiveScheduling)
     , IsParallel(other.IsParallel.load())
   {
   }
@@ -110,11 +141,13 @@ public:
   void operator=(const vtkSMPToolsImpl& other)
   {
     this->NestedActivated = other.NestedActivated;
+    this->AdaptiveScheduling = other.AdaptiveScheduling;
     this->IsParallel = other.IsParallel.load();
   }
 
 private:
   bool NestedActivated = false;
+  bool AdaptiveScheduling = false;
   std::atomic<bool> IsParallel{ false };
 };
 
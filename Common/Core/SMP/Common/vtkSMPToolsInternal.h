@@ -4,7 +4,13 @@
 #ifndef vtkSMPToolsInternal_h
 #define vtkSMPToolsInternal_h
 
-#include <iterator> // For std::advance
+#include <algorithm> // For std::max, std::min
+#include <atomic>    // For std::atomic
+#include <chrono>    // For std::chrono::steady_clock
+#include <cmath>     // For std::ceil
+#include <cstddef>   // For std::size_t
+#include <iterator>  // For std::advance
+#include <vector>    // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -90,6 +96,332 @@ public:
   T operator()(T vtkNotUsed(inValue)) { return Value; }
 };
 
+//--------------------------------------------------------------------------------
+// Contiguous blocks of [0, size) used by the two-pass algorithms below (Reduce, scans and
+// CopyIf): the first pass computes one partial result per block, a serial combine step turns
+// the partials into per-block offsets, then the second pass produces the output of each block.
+class BlockPartition
+{
+public:
+  BlockPartition(vtkIdType size, vtkIdType numberOfBlocks)
+    : Size(size)
+    , NumberOfBlocks(numberOfBlocks < size ? numberOfBlocks : size)
+  {
+    if (this->NumberOfBlocks < 1)
+    {
+      this->NumberOfBlocks = 1;
+    }
+  }
+
+  vtkIdType GetNumberOfBlocks() const { return this->NumberOfBlocks; }
+  vtkIdType Begin(vtkIdType block) const { return (this->Size * block) / this->NumberOfBlocks; }
+  vtkIdType End(vtkIdType block) const { return this->Begin(block + 1); }
+
+private:
+  vtkIdType Size;
+  vtkIdType NumberOfBlocks;
+};
+
+template <typename InputIt, typename T, typename BinaryOp>
+class ReduceBlocks
+{
+public:
+  ReduceBlocks(InputIt in, const BlockPartition& blocks, T init, BinaryOp& op)
+    : In(in)
+    , Blocks(blocks)
+    , Op(op)
+    , Partials(blocks.GetNumberOfBlocks())
+    , Result(init)
+  {
+  }
+
+  void FirstPass(vtkIdType block)
+  {
+    InputIt it(this->In);
+    std::advance(it, this->Blocks.Begin(block));
+    T acc = *it;
+    ++it;
+    for (vtkIdType i = this->Blocks.Begin(block) + 1; i < this->Blocks.End(block); ++i, ++it)
+    {
+      acc = this->Op(acc, *it);
+    }
+    this->Partials[block] = acc;
+  }
+
+  void Combine()
+  {
+    for (const T& partial : this->Partials)
+    {
+      this->Result = this->Op(this->Result, partial);
+    }
+  }
+
+  void SecondPass(vtkIdType) {}
+
+  T GetResult() const { return this->Result; }
+
+private:
+  InputIt In;
+  const BlockPartition& Blocks;
+  BinaryOp& Op;
+  std::vector<T> Partials;
+  T Result;
+};
+
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp, bool Inclusive>
+class ScanBlocks
+{
+public:
+  ScanBlocks(InputIt in, OutputIt out, const BlockPartition& blocks, const T* init, BinaryOp& op)
+    : In(in)
+    , Out(out)
+    , Blocks(blocks)
+    , Op(op)
+    , Partials(blocks.GetNumberOfBlocks())
+    , Offsets(blocks.GetNumberOfBlocks())
+    , HasInit(init != nullptr)
+  {
+    if (init)
+    {
+      this->Init = *init;
+    }
+  }
+
+  void FirstPass(vtkIdType block)
+  {
+    InputIt it(this->In);
+    std::advance(it, this->Blocks.Begin(block));
+    T acc = *it;
+    ++it;
+    for (vtkIdType i = this->Blocks.Begin(block) + 1; i < this->Blocks.End(block); ++i, ++it)
+    {
+      acc = this->Op(acc, *it);
+    }
+    this->Partials[block] = acc;
+  }
+
+  void Combine()
+  {
+    // Offsets[b] is the reduction of everything before block b (including init). Only the
+    // first block of an inclusive scan without init has no offset.
+    T acc = this->Init;
+    for (vtkIdType block = 0; block < this->Blocks.GetNumberOfBlocks(); ++block)
+    {
+      this->Offsets[block] = acc;
+      acc = (block == 0 && !this->HasInit) ? this->Partials[block]
+                                           : this->Op(acc, this->Partials[block]);
+    }
+  }
+
+  void SecondPass(vtkIdType block)
+  {
+    InputIt itIn(this->In);
+    OutputIt itOut(this->Out);
+    std::advance(itIn, this->Blocks.Begin(block));
+    std::advance(itOut, this->Blocks.Begin(block));
+    vtkIdType i = this->Blocks.Begin(block);
+    T acc = this->Offsets[block];
+    if (block == 0 && !this->HasInit)
+    {
+      acc = *itIn;
+      *itOut = acc;
+      ++itIn;
+      ++itOut;
+      ++i;
+    }
+    for (; i < this->Blocks.End(block); ++i, ++itIn, ++itOut)
+    {
+      // Read first, the output may alias the input
+      T value = *itIn;
+      if (Inclusive)
+      {
+        acc = this->Op(acc, value);
+        *itOut = acc;
+      }
+      else
+      {
+        *itOut = acc;
+        acc = this->Op(acc, value);
+      }
+    }
+  }
+
+private:
+  InputIt In;
+  OutputIt Out;
+  const BlockPartition& Blocks;
+  BinaryOp& Op;
+  std::vector<T> Partials;
+  std::vector<T> Offsets;
+  T Init{};
+  bool HasInit;
+};
+
+template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+class CopyIfBlocks
+{
+public:
+  CopyIfBlocks(InputIt in, OutputIt out, const BlockPartition& blocks, UnaryPredicate& pred)
+    : In(in)
+    , Out(out)
+    , Blocks(blocks)
+    , Pred(pred)
+    , Counts(blocks.GetNumberOfBlocks() + 1, 0)
+  {
+  }
+
+  void FirstPass(vtkIdType block)
+  {
+    InputIt it(this->In);
+    std::advance(it, this->Blocks.Begin(block));
+    vtkIdType count = 0;
+    for (vtkIdType i = this->Blocks.Begin(block); i < this->Blocks.End(block); ++i, ++it)
+    {
+      count += this->Pred(*it) ? 1 : 0;
+    }
+    this->Counts[block + 1] = count;
+  }
+
+  void Combine()
+  {
+    for (std::size_t block = 1; block < this->Counts.size(); ++block)
+    {
+      this->Counts[block] += this->Counts[block - 1];
+    }
+  }
+
+  void SecondPass(vtkIdType block)
+  {
+    InputIt itIn(this->In);
+    OutputIt itOut(this->Out);
+    std::advance(itIn, this->Blocks.Begin(block));
+    std::advance(itOut, this->Counts[block]);
+    for (vtkIdType i = this->Blocks.Begin(block); i < this->Blocks.End(block); ++i, ++itIn)
+    {
+      if (this->Pred(*itIn))
+      {
+        *itOut = *itIn;
+        ++itOut;
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfCopies() const { return this->Counts.back(); }
+
+private:
+  InputIt In;
+  OutputIt Out;
+  const BlockPartition& Blocks;
+  UnaryPredicate& Pred;
+  std::vector<vtkIdType> Counts;
+};
+
+// Adapters running one of the passes of the above classes from vtkSMPToolsImpl::For
+template <typename TwoPass>
+struct FirstPassCall
+{
+  TwoPass& Algorithm;
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      this->Algorithm.FirstPass(block);
+    }
+  }
+};
+
+template <typename TwoPass>
+struct SecondPassCall
+{
+  TwoPass& Algorithm;
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      this->Algorithm.SecondPass(block);
+    }
+  }
+};
+
+// Guided self-scheduling of a range, shared by the backends for the adaptive scheduling mode.
+// Each thread repeatedly claims a chunk of half the remaining range divided by the number of
+// threads, so chunks are large at the beginning and shrink toward the end of the loop, which
+// keeps every thread busy until the end on irregular work. The first chunks are small probes:
+// their measured cost gives the minimum chunk size needed to amortize the claim.
+class AdaptivePartitioner
+{
+public:
+  AdaptivePartitioner(vtkIdType first, vtkIdType last, vtkIdType numberOfThreads)
+    : Position(first)
+    , Last(last)
+    , NumberOfThreads((std::max)(numberOfThreads, vtkIdType(1)))
+    , MinimumGrain(0)
+  {
+    this->ProbeGrain = (std::max)((last - first) / (this->NumberOfThreads * 64), vtkIdType(1));
+  }
+
+  // Claim the next chunk, returns false once the whole range has been claimed.
+  bool Next(vtkIdType& begin, vtkIdType& end)
+  {
+    begin = this->Position.load(std::memory_order_relaxed);
+    vtkIdType size;
+    do
+    {
+      if (begin >= this->Last)
+      {
+        return false;
+      }
+      const vtkIdType remaining = this->Last - begin;
+      const vtkIdType minimumGrain = this->MinimumGrain.load(std::memory_order_relaxed);
+      size = remaining / (2 * this->NumberOfThreads);
+      size = minimumGrain > 0 ? (std::max)(size, minimumGrain) : this->ProbeGrain;
+      size = (std::min)((std::max)(size, vtkIdType(1)), remaining);
+    } while (!this->Position.compare_exchange_weak(begin, begin + size));
+    end = begin + size;
+    return true;
+  }
+
+  // Update the minimum chunk size from the time spent on a chunk.
+  void Report(vtkIdType size, double seconds)
+  {
+    // Long enough for the claim and the clock reads to be negligible.
+    const double targetDuration = 50e-6;
+    if (size > 0 && seconds > 0.0)
+    {
+      const double grain = std::ceil(targetDuration * size / seconds);
+      this->MinimumGrain.store(
+        grain < static_cast<double>(this->Last) ? static_cast<vtkIdType>(grain) : this->Last,
+        std::memory_order_relaxed);
+    }
+    else if (size > 0)
+    {
+      // Too fast to be measured
+      this->MinimumGrain.store(size * 64, std::memory_order_relaxed);
+    }
+  }
+
+  // Execute chunks until the range is exhausted, to be called by each thread.
+  template <typename Executer>
+  void Run(Executer&& execute)
+  {
+    vtkIdType begin, end;
+    while (this->Next(begin, end))
+    {
+      const auto start = std::chrono::steady_clock::now();
+      execute(begin, end);
+      const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+      this->Report(end - begin, duration.count());
+    }
+  }
+
+private:
+  std::atomic<vtkIdType> Position;
+  const vtkIdType Last;
+  const vtkIdType NumberOfThreads;
+  std::atomic<vtkIdType> MinimumGrain;
+  vtkIdType ProbeGrain;
+};
+
 VTK_ABI_NAMESPACE_END
 
 } // namespace smp
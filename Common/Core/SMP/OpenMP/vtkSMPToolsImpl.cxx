@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "SMP/Common/vtkSMPTaskGraph.h"
+#include "SMP/Common/vtkSMPThreadAffinity.h"
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/OpenMP/vtkSMPToolsImpl.txx"
 
@@ -126,6 +128,117 @@ void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
   threadIdStack->pop();
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPToolsImplAdaptiveForOpenMP(vtkIdType first, vtkIdType last,
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated)
+{
+  omp_set_nested(nestedActivated);
+
+#pragma omp single
+  threadIdStack->emplace(omp_get_thread_num());
+
+  AdaptivePartitioner partitioner(first, last, GetNumberOfThreadsOpenMP());
+#pragma omp parallel
+  partitioner.Run([functorExecuter, functor](vtkIdType from, vtkIdType to) {
+    functorExecuter(functor, from, to - from, to);
+  });
+
+#pragma omp single
+  threadIdStack->pop();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsImplTwoPassOpenMP(vtkIdType numberOfBlocks, ExecuteBlockPtrType firstPass,
+  CombineBlocksPtrType combine, ExecuteBlockPtrType secondPass, void* algorithm,
+  bool nestedActivated)
+{
+  omp_set_nested(nestedActivated);
+
+#pragma omp single
+  threadIdStack->emplace(omp_get_thread_num());
+
+  // Both passes run in the same parallel region: the serial combine step is a single construct
+  // between two barriers instead of a second fork/join. The static schedule hands the same
+  // block to the same thread in both passes, so the second pass reads warm cache lines.
+#pragma omp parallel num_threads(static_cast<int>(numberOfBlocks))
+  {
+#pragma omp for schedule(static)
+    for (vtkIdType block = 0; block < numberOfBlocks; ++block)
+    {
+      firstPass(algorithm, block);
+    }
+
+#pragma omp single
+    combine(algorithm);
+
+    if (secondPass)
+    {
+#pragma omp for schedule(static)
+      for (vtkIdType block = 0; block < numberOfBlocks; ++block)
+      {
+        secondPass(algorithm, block);
+      }
+    }
+  }
+
+#pragma omp single
+  threadIdStack->pop();
+}
+
+//------------------------------------------------------------------------------
+static void SpawnTaskOpenMP(vtkSMPTaskGraph& graph, vtkSMPTaskGraph::TaskId id)
+{
+#pragma omp task firstprivate(id) shared(graph)
+  {
+    graph.Execute(id);
+    graph.Release(id, [&graph](vtkSMPTaskGraph::TaskId ready) { SpawnTaskOpenMP(graph, ready); });
+  }
+}
+
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::OpenMP>::RunTaskGraph(vtkSMPTaskGraph& graph)
+{
+  if (!this->NestedActivated && this->IsParallel)
+  {
+    graph.InitializeWorkers(1);
+    graph.RunWorker(0);
+    return;
+  }
+
+  bool fromParallelCode = this->IsParallel.exchange(true);
+  omp_set_nested(this->NestedActivated);
+
+  // Ready tasks are turned into OpenMP tasks, the runtime takes care of balancing them between
+  // the threads of the team. The taskgroup waits for every task, including the ones spawned by
+  // other tasks.
+#pragma omp parallel num_threads(GetNumberOfThreadsOpenMP())
+#pragma omp single
+  {
+    threadIdStack->emplace(omp_get_thread_num());
+#pragma omp taskgroup
+    {
+      for (vtkSMPTaskGraph::TaskId root : graph.GetRootTasks())
+      {
+        SpawnTaskOpenMP(graph, root);
+      }
+    }
+    threadIdStack->pop();
+  }
+
+  bool trueFlag = true;
+  this->IsParallel.compare_exchange_weak(trueFlag, fromParallelCode);
+}
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::OpenMP>::SetThreadAffinity(const vtkSMPThreadAffinity& affinity)
+{
+  // Threads are managed by the OpenMP runtime, use OMP_PROC_BIND and OMP_PLACES instead.
+  (void)affinity;
+  return false;
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
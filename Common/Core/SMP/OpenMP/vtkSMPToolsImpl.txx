@@ -22,6 +22,14 @@ int VTKCOMMONCORE_EXPORT GetNumberOfThreadsOpenMP();
 bool VTKCOMMONCORE_EXPORT GetSingleThreadOpenMP();
 void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
   ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated);
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImplAdaptiveForOpenMP(vtkIdType first, vtkIdType last,
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated);
+
+using ExecuteBlockPtrType = void (*)(void*, vtkIdType);
+using CombineBlocksPtrType = void (*)(void*);
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImplTwoPassOpenMP(vtkIdType numberOfBlocks,
+  ExecuteBlockPtrType firstPass, CombineBlocksPtrType combine, ExecuteBlockPtrType secondPass,
+  void* algorithm, bool nestedActivated);
 
 //------------------------------------------------------------------------------
 // Address the static initialization order 'fiasco' by implementing
@@ -49,6 +57,27 @@ void ExecuteFunctorOpenMP(void* functor, vtkIdType from, vtkIdType grain, vtkIdT
   fi.Execute(from, to);
 }
 
+//--------------------------------------------------------------------------------
+template <typename TwoPass>
+void FirstPassOpenMP(void* algorithm, vtkIdType block)
+{
+  reinterpret_cast<TwoPass*>(algorithm)->FirstPass(block);
+}
+
+//--------------------------------------------------------------------------------
+template <typename TwoPass>
+void CombineOpenMP(void* algorithm)
+{
+  reinterpret_cast<TwoPass*>(algorithm)->Combine();
+}
+
+//--------------------------------------------------------------------------------
+template <typename TwoPass>
+void SecondPassOpenMP(void* algorithm, vtkIdType block)
+{
+  reinterpret_cast<TwoPass*>(algorithm)->SecondPass(block);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 template <typename FunctorInternal>
@@ -71,8 +100,16 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::For(
     // (e.g only the 2 first nested For are in parallel)
     bool fromParallelCode = this->IsParallel.exchange(true);
 
-    vtkSMPToolsImplForOpenMP(
-      first, last, grain, ExecuteFunctorOpenMP<FunctorInternal>, &fi, this->NestedActivated);
+    if (grain <= 0 && this->AdaptiveScheduling)
+    {
+      vtkSMPToolsImplAdaptiveForOpenMP(
+        first, last, ExecuteFunctorOpenMP<FunctorInternal>, &fi, this->NestedActivated);
+    }
+    else
+    {
+      vtkSMPToolsImplForOpenMP(
+        first, last, grain, ExecuteFunctorOpenMP<FunctorInternal>, &fi, this->NestedActivated);
+    }
 
     // Atomic contortion to achieve this->IsParallel &= fromParallelCode.
     // This compare&exchange basically boils down to:
@@ -125,6 +162,105 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::Fill(Iterator begin, Iterator end, co
   this->For(0, size, 0, exec);
 }
 
+//--------------------------------------------------------------------------------
+// Number of blocks of a two-pass algorithm: one per OpenMP thread, or a single one when called
+// from a parallel scope without nested parallelism, where the algorithm runs serially like For.
+inline vtkIdType GetNumberOfTwoPassBlocksOpenMP(bool isParallel, bool nestedActivated)
+{
+  return isParallel && !nestedActivated ? 1 : GetNumberOfThreadsOpenMP();
+}
+
+//--------------------------------------------------------------------------------
+// Run a two-pass algorithm (see vtkSMPToolsInternal.h) with one block per OpenMP thread.
+template <typename TwoPass>
+void ExecuteTwoPassOpenMP(std::atomic<bool>& isParallel, bool nestedActivated, TwoPass& algorithm,
+  vtkIdType numberOfBlocks, bool needSecondPass)
+{
+  if (numberOfBlocks <= 1 || (isParallel && !nestedActivated))
+  {
+    for (vtkIdType block = 0; block < numberOfBlocks; ++block)
+    {
+      algorithm.FirstPass(block);
+    }
+    algorithm.Combine();
+    for (vtkIdType block = 0; needSecondPass && block < numberOfBlocks; ++block)
+    {
+      algorithm.SecondPass(block);
+    }
+    return;
+  }
+
+  bool fromParallelCode = isParallel.exchange(true);
+
+  vtkSMPToolsImplTwoPassOpenMP(numberOfBlocks, FirstPassOpenMP<TwoPass>, CombineOpenMP<TwoPass>,
+    needSecondPass ? SecondPassOpenMP<TwoPass> : nullptr, &algorithm, nestedActivated);
+
+  bool trueFlag = true;
+  isParallel.compare_exchange_weak(trueFlag, fromParallelCode);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::OpenMP>::Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return init;
+  }
+
+  BlockPartition blocks(
+    size, GetNumberOfTwoPassBlocksOpenMP(this->IsParallel, this->NestedActivated));
+  ReduceBlocks<InputIt, T, BinaryOp> algorithm(begin, blocks, init, op);
+  ExecuteTwoPassOpenMP(
+    this->IsParallel, this->NestedActivated, algorithm, blocks.GetNumberOfBlocks(), false);
+  return algorithm.GetResult();
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <bool Inclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::OpenMP>::Scan(
+  InputIt begin, InputIt end, OutputIt outBegin, const T* init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return outBegin;
+  }
+
+  BlockPartition blocks(
+    size, GetNumberOfTwoPassBlocksOpenMP(this->IsParallel, this->NestedActivated));
+  ScanBlocks<InputIt, OutputIt, T, BinaryOp, Inclusive> algorithm(
+    begin, outBegin, blocks, init, op);
+  ExecuteTwoPassOpenMP(
+    this->IsParallel, this->NestedActivated, algorithm, blocks.GetNumberOfBlocks(), true);
+  std::advance(outBegin, size);
+  return outBegin;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+OutputIt vtkSMPToolsImpl<BackendType::OpenMP>::CopyIf(
+  InputIt begin, InputIt end, OutputIt outBegin, UnaryPredicate pred)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return outBegin;
+  }
+
+  BlockPartition blocks(
+    size, GetNumberOfTwoPassBlocksOpenMP(this->IsParallel, this->NestedActivated));
+  CopyIfBlocks<InputIt, OutputIt, UnaryPredicate> algorithm(begin, outBegin, blocks, pred);
+  ExecuteTwoPassOpenMP(
+    this->IsParallel, this->NestedActivated, algorithm, blocks.GetNumberOfBlocks(), true);
+  std::advance(outBegin, algorithm.GetNumberOfCopies());
+  return outBegin;
+}
+
 //--------------------------------------------------------------------------------
 template <>
 template <typename RandomAccessIterator>
@@ -143,6 +279,14 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::OpenMP>::RunTaskGraph(vtkSMPTaskGraph& graph);
+
+//--------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::OpenMP>::SetThreadAffinity(const vtkSMPThreadAffinity& affinity);
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int);
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "SMP/STDThread/vtkSMPThreadPool.h"
+#include "SMP/Common/vtkSMPThreadAffinity.h" // For vtkSMPThreadAffinity
 
 #include <vtkObject.h>
 
@@ -45,7 +46,7 @@ struct vtkSMPThreadPool::ThreadData
   // erase the job and other threads can only push back new jobs not insert. This constraint could
   // be relaxed by using unique ids instead.
   std::size_t RunningJob{ NoRunningJob };
-  std::thread SystemThread{};                  // the system thread, not really used
+  std::thread SystemThread{};                  // the system thread, used to set affinity
   std::mutex Mutex{};                          // thread mutex, used for Jobs manipulation
   std::condition_variable ConditionVariable{}; // thread cv, used to wake up the thread
 };
@@ -417,6 +418,26 @@ std::size_t vtkSMPThreadPool::GetNextThreadId() noexcept
   return this->NextProxyThreadId.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
+bool vtkSMPThreadPool::SetAffinity(const std::vector<int>& processors)
+{
+  std::lock_guard<std::mutex> lock{ this->AffinityMutex };
+  if (processors == this->Affinity)
+  {
+    return true;
+  }
+
+  bool success = true;
+  for (std::size_t i{}; i < this->Threads.size(); ++i)
+  {
+    std::thread& thread = this->Threads[i]->SystemThread;
+    success &= processors.empty() ? vtkSMPThreadAffinity::UnbindThread(thread)
+                                  : vtkSMPThreadAffinity::BindThread(
+                                      thread, processors[i % processors.size()]);
+  }
+  this->Affinity = processors;
+  return success;
+}
+
 vtkSMPThreadPool& vtkSMPThreadPool::GetInstance()
 {
   static vtkSMPThreadPool instance{};
@@ -153,6 +153,18 @@ public:
    */
   std::size_t ThreadCount() const noexcept;
 
+  /**
+   * @brief Bind the threads of the pool to processors.
+   *
+   * Thread i of the pool is bound to `processors[i]`, an empty list unbinds all threads.
+   * Since top level proxies use the first threads of the pool, the first processors of the
+   * list are the ones used when the number of threads is limited.
+   * Nothing is done if the threads are already bound this way.
+   *
+   * @return false if some threads could not be bound.
+   */
+  bool SetAffinity(const std::vector<int>& processors);
+
 private:
   // static because also used by proxy
   static void RunJob(ThreadData& data, std::size_t jobIndex, std::unique_lock<std::mutex>& lock);
@@ -167,6 +179,8 @@ private:
   std::atomic<bool> Joining{};
   std::vector<std::unique_ptr<ThreadData>> Threads; // Thread pool, fixed size
   std::atomic<std::size_t> NextProxyThreadId{ 1 };
+  std::vector<int> Affinity;                        // Processor of each thread, if bound
+  std::mutex AffinityMutex;
 
 public:
   static vtkSMPThreadPool& GetInstance();
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "SMP/Common/vtkSMPTaskGraph.h"
+#include "SMP/Common/vtkSMPThreadAffinity.h"
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/STDThread/vtkSMPToolsImpl.txx"
 
@@ -74,6 +76,40 @@ bool vtkSMPToolsImpl<BackendType::STDThread>::IsParallelScope()
   return vtkSMPThreadPool::GetInstance().IsParallelScope();
 }
 
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::STDThread>::RunTaskGraph(vtkSMPTaskGraph& graph)
+{
+  auto& pool = vtkSMPThreadPool::GetInstance();
+  const std::size_t numberOfTasks = graph.GetNumberOfTasks();
+  if (numberOfTasks == 1 || (!this->NestedActivated && pool.IsParallelScope()))
+  {
+    graph.InitializeWorkers(1);
+    graph.RunWorker(0);
+    return;
+  }
+
+  // One long-running worker per proxy thread, the workers balance the graph between them by
+  // stealing ready tasks from each other.
+  auto proxy = pool.AllocateThreads(GetNumberOfThreadsSTDThread());
+  const std::size_t numberOfWorkers = std::min(proxy.GetThreads().size(), numberOfTasks);
+  graph.InitializeWorkers(numberOfWorkers);
+  for (std::size_t worker = 0; worker < numberOfWorkers; ++worker)
+  {
+    proxy.DoJob([&graph, worker] { graph.RunWorker(worker); });
+  }
+  proxy.Join();
+}
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::STDThread>::SetThreadAffinity(
+  const vtkSMPThreadAffinity& affinity)
+{
+  auto& pool = vtkSMPThreadPool::GetInstance();
+  return pool.SetAffinity(affinity.ComputeProcessors(pool.ThreadCount()));
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
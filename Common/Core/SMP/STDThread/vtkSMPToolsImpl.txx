@@ -38,6 +38,19 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
   {
     fi.Execute(first, last);
   }
+  else if (grain <= 0 && this->AdaptiveScheduling)
+  {
+    const int threadNumber = GetNumberOfThreadsSTDThread();
+    AdaptivePartitioner partitioner(first, last, threadNumber);
+    auto proxy = vtkSMPThreadPool::GetInstance().AllocateThreads(threadNumber);
+    for (int thread = 0; thread < threadNumber; ++thread)
+    {
+      proxy.DoJob([&fi, &partitioner] {
+        partitioner.Run([&fi](vtkIdType from, vtkIdType to) { fi.Execute(from, to); });
+      });
+    }
+    proxy.Join();
+  }
   else
   {
     int threadNumber = GetNumberOfThreadsSTDThread();
@@ -97,6 +110,77 @@ void vtkSMPToolsImpl<BackendType::STDThread>::Fill(Iterator begin, Iterator end,
   this->For(0, size, 0, exec);
 }
 
+//--------------------------------------------------------------------------------
+// Run both passes of a two-pass algorithm (see vtkSMPToolsInternal.h), one job per block.
+template <typename TwoPass>
+void ExecuteTwoPassSTDThread(
+  vtkSMPToolsImpl<BackendType::STDThread>& impl, TwoPass& algorithm, vtkIdType numberOfBlocks)
+{
+  FirstPassCall<TwoPass> firstPass{ algorithm };
+  impl.For(0, numberOfBlocks, 1, firstPass);
+  algorithm.Combine();
+  SecondPassCall<TwoPass> secondPass{ algorithm };
+  impl.For(0, numberOfBlocks, 1, secondPass);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::STDThread>::Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return init;
+  }
+
+  BlockPartition blocks(size, GetNumberOfThreadsSTDThread() * 4);
+  ReduceBlocks<InputIt, T, BinaryOp> algorithm(begin, blocks, init, op);
+  FirstPassCall<ReduceBlocks<InputIt, T, BinaryOp>> firstPass{ algorithm };
+  this->For(0, blocks.GetNumberOfBlocks(), 1, firstPass);
+  algorithm.Combine();
+  return algorithm.GetResult();
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <bool Inclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::STDThread>::Scan(
+  InputIt begin, InputIt end, OutputIt outBegin, const T* init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return outBegin;
+  }
+
+  BlockPartition blocks(size, GetNumberOfThreadsSTDThread() * 4);
+  ScanBlocks<InputIt, OutputIt, T, BinaryOp, Inclusive> algorithm(
+    begin, outBegin, blocks, init, op);
+  ExecuteTwoPassSTDThread(*this, algorithm, blocks.GetNumberOfBlocks());
+  std::advance(outBegin, size);
+  return outBegin;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+OutputIt vtkSMPToolsImpl<BackendType::STDThread>::CopyIf(
+  InputIt begin, InputIt end, OutputIt outBegin, UnaryPredicate pred)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return outBegin;
+  }
+
+  BlockPartition blocks(size, GetNumberOfThreadsSTDThread() * 4);
+  CopyIfBlocks<InputIt, OutputIt, UnaryPredicate> algorithm(begin, outBegin, blocks, pred);
+  ExecuteTwoPassSTDThread(*this, algorithm, blocks.GetNumberOfBlocks());
+  std::advance(outBegin, algorithm.GetNumberOfCopies());
+  return outBegin;
+}
+
 //--------------------------------------------------------------------------------
 template <>
 template <typename RandomAccessIterator>
@@ -115,6 +199,15 @@ void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::STDThread>::RunTaskGraph(vtkSMPTaskGraph& graph);
+
+//--------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::STDThread>::SetThreadAffinity(
+  const vtkSMPThreadAffinity& affinity);
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::STDThread>::Initialize(int);
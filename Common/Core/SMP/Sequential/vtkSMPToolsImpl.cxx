@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "SMP/Common/vtkSMPTaskGraph.h"
+#include "SMP/Common/vtkSMPThreadAffinity.h"
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Sequential/vtkSMPToolsImpl.txx"
 
@@ -39,6 +41,24 @@ bool vtkSMPToolsImpl<BackendType::Sequential>::GetSingleThread()
   return true;
 }
 
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::Sequential>::RunTaskGraph(vtkSMPTaskGraph& graph)
+{
+  graph.InitializeWorkers(1);
+  graph.RunWorker(0);
+}
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::Sequential>::SetThreadAffinity(
+  const vtkSMPThreadAffinity& affinity)
+{
+  // The calling thread is the only thread used, it is not ours to bind.
+  (void)affinity;
+  return false;
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
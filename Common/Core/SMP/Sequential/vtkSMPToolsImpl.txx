@@ -4,7 +4,8 @@
 #ifndef SequentialvtkSMPToolsImpl_txx
 #define SequentialvtkSMPToolsImpl_txx
 
-#include <algorithm> // For std::sort, std::transform, std::fill
+#include <algorithm> // For std::sort, std::transform, std::fill, std::copy_if
+#include <numeric>   // For std::accumulate
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
@@ -75,6 +76,58 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Fill(Iterator begin, Iterator end
   std::fill(begin, end, value);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+{
+  return std::accumulate(begin, end, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <bool Inclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::Sequential>::Scan(
+  InputIt begin, InputIt end, OutputIt outBegin, const T* init, BinaryOp op)
+{
+  if (begin == end)
+  {
+    return outBegin;
+  }
+  T acc = init ? *init : static_cast<T>(*begin);
+  if (!init)
+  {
+    *outBegin = acc;
+    ++begin;
+    ++outBegin;
+  }
+  for (; begin != end; ++begin, ++outBegin)
+  {
+    // Read first, the output may alias the input
+    T value = *begin;
+    if (Inclusive)
+    {
+      acc = op(acc, value);
+      *outBegin = acc;
+    }
+    else
+    {
+      *outBegin = acc;
+      acc = op(acc, value);
+    }
+  }
+  return outBegin;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+OutputIt vtkSMPToolsImpl<BackendType::Sequential>::CopyIf(
+  InputIt begin, InputIt end, OutputIt outBegin, UnaryPredicate pred)
+{
+  return std::copy_if(begin, end, outBegin, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 template <typename RandomAccessIterator>
@@ -93,6 +146,15 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::Sequential>::RunTaskGraph(vtkSMPTaskGraph& graph);
+
+//--------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::Sequential>::SetThreadAffinity(
+  const vtkSMPThreadAffinity& affinity);
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "SMP/Common/vtkSMPTaskGraph.h"
+#include "SMP/Common/vtkSMPThreadAffinity.h"
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/TBB/vtkSMPToolsImpl.txx"
 
@@ -14,6 +16,7 @@
 #endif
 
 #include <tbb/task_arena.h> // For tbb:task_arena
+#include <tbb/task_group.h> // For tbb:task_group
 
 #ifdef _MSC_VER
 #pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
@@ -150,6 +153,68 @@ void vtkSMPToolsImplForTBB(vtkIdType first, vtkIdType last, vtkIdType grain,
   threadIdStackLock->unlock();
 }
 
+//------------------------------------------------------------------------------
+static void SpawnTaskTBB(tbb::task_group& group, vtkSMPTaskGraph& graph, vtkSMPTaskGraph::TaskId id)
+{
+  group.run([&group, &graph, id] {
+    graph.Execute(id);
+    graph.Release(
+      id, [&group, &graph](vtkSMPTaskGraph::TaskId ready) { SpawnTaskTBB(group, graph, ready); });
+  });
+}
+
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::TBB>::RunTaskGraph(vtkSMPTaskGraph& graph)
+{
+  if (!this->NestedActivated && this->IsParallel)
+  {
+    graph.InitializeWorkers(1);
+    graph.RunWorker(0);
+    return;
+  }
+
+  bool fromParallelCode = this->IsParallel.exchange(true);
+
+  threadIdStackLock->lock();
+  threadIdStack->emplace(tbb::this_task_arena::current_thread_index());
+  threadIdStackLock->unlock();
+
+  // Ready tasks are spawned in a task_group, TBB work-stealing scheduler balances them.
+  auto runGraph = [&graph]() {
+    tbb::task_group group;
+    for (vtkSMPTaskGraph::TaskId root : graph.GetRootTasks())
+    {
+      SpawnTaskTBB(group, graph, root);
+    }
+    group.wait();
+  };
+  if (taskArena->is_active())
+  {
+    taskArena->execute(runGraph);
+  }
+  else
+  {
+    runGraph();
+  }
+
+  threadIdStackLock->lock();
+  threadIdStack->pop();
+  threadIdStackLock->unlock();
+
+  bool trueFlag = true;
+  this->IsParallel.compare_exchange_weak(trueFlag, fromParallelCode);
+}
+
+//------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::TBB>::SetThreadAffinity(const vtkSMPThreadAffinity& affinity)
+{
+  // Threads are managed by TBB, which has its own affinity mechanisms.
+  (void)affinity;
+  return false;
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
@@ -15,7 +15,10 @@
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
 #include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
 
 #ifdef _MSC_VER
 #pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
@@ -108,6 +111,210 @@ void ExecuteFunctorTBB(void* functor, vtkIdType first, vtkIdType last, vtkIdType
   }
 }
 
+//--------------------------------------------------------------------------------
+// Adaptive scheduling: every thread of the arena claims chunks from the shared partitioner.
+template <typename FunctorInternal>
+void ExecuteFunctorAdaptiveTBB(void* functor, vtkIdType first, vtkIdType last, vtkIdType)
+{
+  FunctorInternal& fi = *reinterpret_cast<FunctorInternal*>(functor);
+  const int numberOfThreads = tbb::this_task_arena::max_concurrency();
+  AdaptivePartitioner partitioner(first, last, numberOfThreads);
+  tbb::parallel_for(0, numberOfThreads, [&fi, &partitioner](int) {
+    partitioner.Run([&fi](vtkIdType from, vtkIdType to) { fi.Execute(from, to); });
+  });
+}
+
+//--------------------------------------------------------------------------------
+// Same heuristic as ExecuteFunctorTBB: a few batches per thread.
+inline vtkIdType EstimateGrainTBB(vtkIdType range)
+{
+  const vtkIdType batches = 40 * 5;
+  return range >= batches ? ((range - 1) / batches) + 1 : 1;
+}
+
+//--------------------------------------------------------------------------------
+// Body for tbb::parallel_reduce, a split body starts without value since the reduction
+// operator may not have an identity.
+template <typename InputIt, typename T, typename BinaryOp>
+class ReduceBodyTBB
+{
+public:
+  ReduceBodyTBB(InputIt in, BinaryOp& op, T init)
+    : In(in)
+    , Op(op)
+    , Sum(init)
+    , HasSum(true)
+  {
+  }
+
+  ReduceBodyTBB(ReduceBodyTBB& other, tbb::split)
+    : In(other.In)
+    , Op(other.Op)
+    , Sum()
+    , HasSum(false)
+  {
+  }
+
+  void operator()(const tbb::blocked_range<vtkIdType>& r)
+  {
+    InputIt it(this->In);
+    std::advance(it, r.begin());
+    for (vtkIdType i = r.begin(); i < r.end(); ++i, ++it)
+    {
+      this->Sum = this->HasSum ? this->Op(this->Sum, *it) : static_cast<T>(*it);
+      this->HasSum = true;
+    }
+  }
+
+  void join(ReduceBodyTBB& rhs)
+  {
+    if (rhs.HasSum)
+    {
+      this->Sum = this->HasSum ? this->Op(this->Sum, rhs.Sum) : rhs.Sum;
+      this->HasSum = true;
+    }
+  }
+
+  InputIt In;
+  BinaryOp& Op;
+  T Sum;
+  bool HasSum;
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp, bool Inclusive>
+class ScanBodyTBB
+{
+public:
+  ScanBodyTBB(InputIt in, OutputIt out, BinaryOp& op, const T* init)
+    : In(in)
+    , Out(out)
+    , Op(op)
+    , Sum(init ? *init : T())
+    , HasSum(init != nullptr)
+  {
+  }
+
+  ScanBodyTBB(ScanBodyTBB& other, tbb::split)
+    : In(other.In)
+    , Out(other.Out)
+    , Op(other.Op)
+    , Sum()
+    , HasSum(false)
+  {
+  }
+
+  template <typename Tag>
+  void operator()(const tbb::blocked_range<vtkIdType>& r, Tag)
+  {
+    InputIt itIn(this->In);
+    OutputIt itOut(this->Out);
+    std::advance(itIn, r.begin());
+    std::advance(itOut, r.begin());
+    for (vtkIdType i = r.begin(); i < r.end(); ++i, ++itIn, ++itOut)
+    {
+      // Read first, the output may alias the input
+      T value = *itIn;
+      if (!Inclusive && Tag::is_final_scan())
+      {
+        *itOut = this->Sum;
+      }
+      this->Sum = this->HasSum ? this->Op(this->Sum, value) : value;
+      this->HasSum = true;
+      if (Inclusive && Tag::is_final_scan())
+      {
+        *itOut = this->Sum;
+      }
+    }
+  }
+
+  void reverse_join(ScanBodyTBB& left)
+  {
+    if (left.HasSum)
+    {
+      this->Sum = this->HasSum ? this->Op(left.Sum, this->Sum) : left.Sum;
+      this->HasSum = true;
+    }
+  }
+
+  void assign(ScanBodyTBB& other)
+  {
+    this->Sum = other.Sum;
+    this->HasSum = other.HasSum;
+  }
+
+  InputIt In;
+  OutputIt Out;
+  BinaryOp& Op;
+  T Sum;
+  bool HasSum;
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+class CopyIfBodyTBB
+{
+public:
+  CopyIfBodyTBB(InputIt in, OutputIt out, UnaryPredicate& pred)
+    : In(in)
+    , Out(out)
+    , Pred(pred)
+  {
+  }
+
+  CopyIfBodyTBB(CopyIfBodyTBB& other, tbb::split)
+    : In(other.In)
+    , Out(other.Out)
+    , Pred(other.Pred)
+  {
+  }
+
+  template <typename Tag>
+  void operator()(const tbb::blocked_range<vtkIdType>& r, Tag)
+  {
+    InputIt itIn(this->In);
+    std::advance(itIn, r.begin());
+    for (vtkIdType i = r.begin(); i < r.end(); ++i, ++itIn)
+    {
+      if (this->Pred(*itIn))
+      {
+        if (Tag::is_final_scan())
+        {
+          OutputIt itOut(this->Out);
+          std::advance(itOut, this->Count);
+          *itOut = *itIn;
+        }
+        ++this->Count;
+      }
+    }
+  }
+
+  void reverse_join(CopyIfBodyTBB& left) { this->Count += left.Count; }
+
+  void assign(CopyIfBodyTBB& other) { this->Count = other.Count; }
+
+  InputIt In;
+  OutputIt Out;
+  UnaryPredicate& Pred;
+  vtkIdType Count = 0;
+};
+
+//--------------------------------------------------------------------------------
+template <typename Body>
+void ExecuteReduceTBB(void* body, vtkIdType first, vtkIdType last, vtkIdType grain)
+{
+  tbb::parallel_reduce(
+    tbb::blocked_range<vtkIdType>(first, last, grain), *reinterpret_cast<Body*>(body));
+}
+
+//--------------------------------------------------------------------------------
+template <typename Body>
+void ExecuteScanTBB(void* body, vtkIdType first, vtkIdType last, vtkIdType grain)
+{
+  tbb::parallel_scan(
+    tbb::blocked_range<vtkIdType>(first, last, grain), *reinterpret_cast<Body*>(body));
+}
+
 //--------------------------------------------------------------------------------
 template <>
 template <typename FunctorInternal>
@@ -124,7 +331,14 @@ void vtkSMPToolsImpl<BackendType::TBB>::For(
     // (e.g only the 2 first nested For are in parallel)
     bool fromParallelCode = this->IsParallel.exchange(true);
 
-    vtkSMPToolsImplForTBB(first, last, grain, ExecuteFunctorTBB<FunctorInternal>, &fi);
+    if (grain <= 0 && this->AdaptiveScheduling)
+    {
+      vtkSMPToolsImplForTBB(first, last, grain, ExecuteFunctorAdaptiveTBB<FunctorInternal>, &fi);
+    }
+    else
+    {
+      vtkSMPToolsImplForTBB(first, last, grain, ExecuteFunctorTBB<FunctorInternal>, &fi);
+    }
 
     // Atomic contortion to achieve this->IsParallel &= fromParallelCode.
     // This compare&exchange basically boils down to:
@@ -177,6 +391,61 @@ void vtkSMPToolsImpl<BackendType::TBB>::Fill(Iterator begin, Iterator end, const
   this->For(0, size, 0, exec);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return init;
+  }
+
+  using Body = ReduceBodyTBB<InputIt, T, BinaryOp>;
+  Body body(begin, op, init);
+  vtkSMPToolsImplForTBB(0, size, EstimateGrainTBB(size), ExecuteReduceTBB<Body>, &body);
+  return body.Sum;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <bool Inclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::TBB>::Scan(
+  InputIt begin, InputIt end, OutputIt outBegin, const T* init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return outBegin;
+  }
+
+  using Body = ScanBodyTBB<InputIt, OutputIt, T, BinaryOp, Inclusive>;
+  Body body(begin, outBegin, op, init);
+  vtkSMPToolsImplForTBB(0, size, EstimateGrainTBB(size), ExecuteScanTBB<Body>, &body);
+  std::advance(outBegin, size);
+  return outBegin;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+OutputIt vtkSMPToolsImpl<BackendType::TBB>::CopyIf(
+  InputIt begin, InputIt end, OutputIt outBegin, UnaryPredicate pred)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return outBegin;
+  }
+
+  using Body = CopyIfBodyTBB<InputIt, OutputIt, UnaryPredicate>;
+  Body body(begin, outBegin, pred);
+  vtkSMPToolsImplForTBB(0, size, EstimateGrainTBB(size), ExecuteScanTBB<Body>, &body);
+  std::advance(outBegin, body.Count);
+  return outBegin;
+}
+
 //--------------------------------------------------------------------------------
 template <>
 template <typename RandomAccessIterator>
@@ -194,6 +463,14 @@ void vtkSMPToolsImpl<BackendType::TBB>::Sort(
   tbb::parallel_sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::TBB>::RunTaskGraph(vtkSMPTaskGraph& graph);
+
+//--------------------------------------------------------------------------------
+template <>
+bool vtkSMPToolsImpl<BackendType::TBB>::SetThreadAffinity(const vtkSMPThreadAffinity& affinity);
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int);
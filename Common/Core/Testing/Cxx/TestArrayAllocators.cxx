@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkArenaArrayAllocator.h"
+#include "vtkArrayAllocator.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPoolArrayAllocator.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <cstdint>
+#include <iostream>
+
+namespace
+{
+#define CHECK(expr)                                                                                \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(expr))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": check failed: " #expr "\n";                           \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+//------------------------------------------------------------------------------
+bool IsAligned(const void* pointer, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+//------------------------------------------------------------------------------
+bool CheckIota(vtkIntArray* array, vtkIdType count)
+{
+  for (vtkIdType i = 0; i < count; ++i)
+  {
+    if (array->GetValue(i) != i)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestAligned()
+{
+  vtkNew<vtkArrayAllocator> allocator;
+  allocator->SetAlignment(100);
+  CHECK(allocator->GetAlignment() == 128);
+
+  vtkNew<vtkIntArray> array;
+  array->SetAllocator(allocator);
+  CHECK(array->GetAllocator() == allocator);
+  array->SetNumberOfValues(1000);
+  CHECK(IsAligned(array->GetPointer(0), 128));
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    array->SetValue(i, static_cast<int>(i));
+  }
+  array->Resize(5000);
+  CHECK(IsAligned(array->GetPointer(0), 128) && CheckIota(array, 1000));
+
+  // Memory allocated with malloc is moved to the allocator when resized.
+  vtkNew<vtkIntArray> external;
+  external->SetNumberOfValues(10);
+  external->SetValue(9, 9);
+  external->SetAllocator(allocator);
+  external->Resize(100);
+  CHECK(IsAligned(external->GetPointer(0), 128) && external->GetValue(9) == 9);
+
+  allocator->UseHugePagesOn();
+  vtkNew<vtkFloatArray> large;
+  large->SetAllocator(allocator);
+  large->SetNumberOfValues(1024 * 1024);
+  large->SetValue(1024 * 1024 - 1, 1.f);
+  CHECK(large->GetValue(1024 * 1024 - 1) == 1.f);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestPool()
+{
+  CHECK(vtkPoolArrayAllocator::GetSizeClass(1) == 256);
+  CHECK(vtkPoolArrayAllocator::GetSizeClass(257) == 320);
+  CHECK(vtkPoolArrayAllocator::GetSizeClass(1000) == 1024);
+  CHECK(vtkPoolArrayAllocator::GetSizeClass(1025) == 1280);
+
+  vtkNew<vtkPoolArrayAllocator> pool;
+  void* first = nullptr;
+  {
+    vtkNew<vtkIntArray> array;
+    array->SetAllocator(pool);
+    array->SetNumberOfValues(1000);
+    first = array->GetPointer(0);
+  }
+  CHECK(pool->GetCachedSize() == vtkPoolArrayAllocator::GetSizeClass(1000 * sizeof(int)));
+
+  // The released block is reused by the next array of the same size class.
+  vtkNew<vtkIntArray> array;
+  array->SetAllocator(pool);
+  array->SetNumberOfValues(1000);
+  CHECK(array->GetPointer(0) == first && pool->GetCachedSize() == 0);
+
+  // Resizing within the same size class does not move the data.
+  void* block = pool->Allocate(4000);
+  CHECK(pool->Reallocate(block, 4000, 4090) == block);
+  void* moved = pool->Reallocate(block, 4090, 5000);
+  CHECK(moved != nullptr && moved != block);
+  pool->Free(moved, 5000);
+  pool->ReleaseCachedMemory();
+  CHECK(pool->GetCachedSize() == 0);
+
+  // Nothing is cached past the limit.
+  pool->SetMaximumCachedSize(0);
+  array->Initialize();
+  CHECK(pool->GetCachedSize() == 0);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestArena()
+{
+  vtkNew<vtkArenaArrayAllocator> arena;
+  arena->SetBlockSize(1024 * 1024);
+  void* first = nullptr;
+  for (int timeStep = 0; timeStep < 3; ++timeStep)
+  {
+    vtkNew<vtkIntArray> a;
+    vtkNew<vtkIntArray> b;
+    a->SetAllocator(arena);
+    b->SetAllocator(arena);
+    a->SetNumberOfValues(1000);
+    b->SetNumberOfValues(1000);
+    CHECK(arena->GetNumberOfAllocations() == 2);
+    CHECK(IsAligned(a->GetPointer(0), 64) && IsAligned(b->GetPointer(0), 64));
+    // Every time step reuses the same memory.
+    if (timeStep == 0)
+    {
+      first = a->GetPointer(0);
+    }
+    CHECK(a->GetPointer(0) == first);
+
+    // The last allocation grows in place.
+    for (vtkIdType i = 0; i < 1000; ++i)
+    {
+      b->SetValue(i, static_cast<int>(i));
+    }
+    void* last = b->GetPointer(0);
+    b->Resize(2000);
+    CHECK(b->GetPointer(0) == last && CheckIota(b, 1000));
+
+    // Other allocations are copied.
+    a->SetValue(0, 42);
+    a->Resize(2000);
+    CHECK(a->GetPointer(0) != first && a->GetValue(0) == 42);
+    CHECK(arena->GetNumberOfAllocations() == 2);
+  }
+  CHECK(arena->GetNumberOfAllocations() == 0 && arena->GetCapacity() == 1024 * 1024);
+  CHECK(arena->ReleaseUnusedBlocks() && arena->GetCapacity() == 0);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestDefaultAllocator()
+{
+  vtkNew<vtkPoolArrayAllocator> pool;
+  vtkArrayAllocator::SetDefaultAllocator(pool);
+  vtkNew<vtkFloatArray> aos;
+  vtkNew<vtkSOADataArrayTemplate<float>> soa;
+  vtkArrayAllocator::SetDefaultAllocator(nullptr);
+  CHECK(aos->GetAllocator() == pool && soa->GetAllocator() == pool);
+
+  vtkNew<vtkArenaArrayAllocator> arena;
+  soa->SetAllocator(arena);
+  soa->SetNumberOfComponents(3);
+  soa->SetNumberOfTuples(100);
+  for (vtkIdType i = 0; i < 100; ++i)
+  {
+    soa->SetTypedComponent(i, 2, static_cast<float>(i));
+  }
+  CHECK(arena->GetNumberOfAllocations() > 0 && soa->GetTypedComponent(99, 2) == 99.f);
+
+  aos->SetAllocator(nullptr);
+  CHECK(aos->GetAllocator() == nullptr);
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestArrayAllocators(int, char*[])
+{
+  bool success = TestAligned();
+  success = TestPool() && success;
+  success = TestArena() && success;
+  success = TestDefaultAllocator() && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
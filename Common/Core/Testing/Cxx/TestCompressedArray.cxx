@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCompressedArray.h"
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+//------------------------------------------------------------------------------
+template <typename ValueType>
+bool CheckValues(vtkDataArray* baseArray, vtkIdType blockSize, const char* name)
+{
+  bool success = true;
+  vtkNew<vtkCompressedArray<ValueType>> compressed;
+  compressed->ConstructBackend(baseArray, blockSize);
+  compressed->SetNumberOfComponents(baseArray->GetNumberOfComponents());
+  compressed->SetNumberOfTuples(baseArray->GetNumberOfTuples());
+
+  const int numComps = baseArray->GetNumberOfComponents();
+  auto expected = [&](vtkIdType idx)
+  { return static_cast<ValueType>(baseArray->GetComponent(idx / numComps, idx % numComps)); };
+
+  // Random access, going back and forth between blocks.
+  const vtkIdType numberOfValues = baseArray->GetNumberOfValues();
+  for (vtkIdType idx = 0; idx < numberOfValues; idx += 7)
+  {
+    const vtkIdType other = numberOfValues - 1 - idx;
+    if (compressed->GetValue(idx) != expected(idx) ||
+      compressed->GetValue(other) != expected(other))
+    {
+      std::cerr << "get value failed with vtkCompressedArray of " << name << std::endl;
+      success = false;
+      break;
+    }
+  }
+
+  // Concurrent reads, each thread going backward through its own blocks.
+  std::atomic<bool> concurrentSuccess(true);
+  vtkSMPTools::For(0, numberOfValues,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = end; i-- > begin;)
+      {
+        if (compressed->GetValue(i) != expected(i))
+        {
+          concurrentSuccess = false;
+        }
+      }
+    });
+  if (!concurrentSuccess)
+  {
+    std::cerr << "concurrent reads failed with vtkCompressedArray of " << name << std::endl;
+    success = false;
+  }
+
+  vtkIdType idx = 0;
+  for (auto value : vtk::DataArrayValueRange(compressed))
+  {
+    if (value != expected(idx++))
+    {
+      std::cerr << "range iterator failed with vtkCompressedArray of " << name << std::endl;
+      success = false;
+      break;
+    }
+  }
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCompressedArray(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // Smooth field, spanning several blocks with a partial last one.
+  vtkNew<vtkFloatArray> smooth;
+  smooth->SetNumberOfComponents(3);
+  smooth->SetNumberOfTuples(10000);
+  for (vtkIdType tupleIdx = 0; tupleIdx < 10000; ++tupleIdx)
+  {
+    smooth->SetTypedComponent(tupleIdx, 0, std::sin(tupleIdx * 1e-3f));
+    smooth->SetTypedComponent(tupleIdx, 1, std::cos(tupleIdx * 1e-3f));
+    smooth->SetTypedComponent(tupleIdx, 2, 1.f);
+  }
+  if (!CheckValues<float>(smooth, 1000, "smooth floats"))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  // Labels with negative values, compressed with the default block size.
+  vtkNew<vtkIntArray> labels;
+  labels->SetNumberOfTuples(20000);
+  for (vtkIdType idx = 0; idx < 20000; ++idx)
+  {
+    labels->SetValue(idx, static_cast<int>(idx / 100) - 50);
+  }
+  if (!CheckValues<int>(labels, 4096, "labels"))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  // Noise does not compress and is stored as is.
+  vtkNew<vtkDoubleArray> noise;
+  noise->SetNumberOfTuples(5000);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+  for (vtkIdType idx = 0; idx < 5000; ++idx)
+  {
+    noise->SetValue(idx, distribution(generator));
+  }
+  if (!CheckValues<double>(noise, 512, "noise"))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  // Conversion to another value type.
+  if (!CheckValues<double>(labels, 4096, "labels as doubles"))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  // Tuples are copied at once.
+  vtkNew<vtkCompressedArray<float>> compressed;
+  compressed->ConstructBackend(smooth);
+  compressed->SetNumberOfComponents(3);
+  compressed->SetNumberOfTuples(10000);
+  float tuple[3];
+  compressed->GetTypedTuple(4321, tuple);
+  if (tuple[0] != smooth->GetTypedComponent(4321, 0) ||
+    tuple[1] != smooth->GetTypedComponent(4321, 1) || tuple[2] != 1.f)
+  {
+    res = EXIT_FAILURE;
+    std::cerr << "get tuple failed with vtkCompressedArray" << std::endl;
+  }
+
+  // Smooth values and labels take a fraction of their size.
+  auto backend = compressed->GetBackend();
+  if (backend->GetUncompressedSize() != 10000 * 3 * sizeof(float) ||
+    backend->GetCompressedSize() >= backend->GetUncompressedSize())
+  {
+    res = EXIT_FAILURE;
+    std::cerr << "smooth floats did not compress: " << backend->GetCompressedSize() << " bytes for "
+              << backend->GetUncompressedSize() << std::endl;
+  }
+  vtkCompressedImplicitBackend<int> labelsBackend(labels);
+  if (labelsBackend.GetCompressedSize() * 4 >= labelsBackend.GetUncompressedSize())
+  {
+    res = EXIT_FAILURE;
+    std::cerr << "labels did not compress: " << labelsBackend.GetCompressedSize() << " bytes for "
+              << labelsBackend.GetUncompressedSize() << std::endl;
+  }
+  if (compressed->GetActualMemorySize() >= smooth->GetActualMemorySize())
+  {
+    res = EXIT_FAILURE;
+    std::cerr << "wrong memory size for vtkCompressedArray: " << compressed->GetActualMemorySize()
+              << " KiB" << std::endl;
+  }
+
+  // Range computation goes through the value range.
+  double range[2];
+  compressed->GetRange(range, 2);
+  if (range[0] != 1. || range[1] != 1.)
+  {
+    res = EXIT_FAILURE;
+    std::cerr << "range computation failed with vtkCompressedArray" << std::endl;
+  }
+
+  return res;
+}
@@ -1,8 +1,12 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkMathUtilities.h"
+#include "vtkNew.h"
+
+#include <vector>
 
 // Define this to run benchmarking tests on some vtkDataArray methods:
 #undef BENCHMARK
@@ -28,6 +32,40 @@ void benchmark();
 } // End TestDataArrayPrivate namespace
 #endif // BENCHMARK
 
+namespace
+{
+// Compare the ranges computed by the contiguous kernels with the ones computed
+// tuple by tuple, which is what happens when a ghost array is given.
+bool CheckRangeKernels(vtkDataArray* array)
+{
+  std::vector<unsigned char> ghosts(array->GetNumberOfTuples(), 0);
+  for (int comp = -1; comp < array->GetNumberOfComponents(); ++comp)
+  {
+    double range[2];
+    double expected[2];
+    array->Modified();
+    array->GetRange(range, comp);
+    array->GetRange(expected, comp, ghosts.data(), 0xff);
+    if (range[0] != expected[0] || range[1] != expected[1])
+    {
+      cerr << "Range of component " << comp << " is (" << range[0] << "-" << range[1]
+           << ") instead of (" << expected[0] << "-" << expected[1] << ")" << endl;
+      return false;
+    }
+    array->Modified();
+    array->GetFiniteRange(range, comp);
+    array->GetFiniteRange(expected, comp, ghosts.data(), 0xff);
+    if (range[0] != expected[0] || range[1] != expected[1])
+    {
+      cerr << "Finite range of component " << comp << " is (" << range[0] << "-" << range[1]
+           << ") instead of (" << expected[0] << "-" << expected[1] << ")" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
 int TestDataArray(int, char*[])
 {
 #ifdef BENCHMARK
@@ -210,6 +248,30 @@ int TestDataArray(int, char*[])
   }
   cout << endl;
   farray->Delete();
+
+  // Ranges of arrays long enough to go through the vectorized kernels, with a
+  // number of tuples that is not a multiple of their block size.
+  vtkNew<vtkFloatArray> vectors;
+  vtkNew<vtkIntArray> ints;
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(1001);
+  ints->SetNumberOfComponents(2);
+  ints->SetNumberOfTuples(1001);
+  for (cc = 0; cc < 3003; ++cc)
+  {
+    vectors->SetValue(cc, static_cast<float>((cc * 7919) % 1000) - 500.f);
+  }
+  for (cc = 0; cc < 2002; ++cc)
+  {
+    ints->SetValue(cc, (cc * 7919) % 1000 - 500);
+  }
+  vectors->SetValue(3, vtkMath::Nan());
+  vectors->SetValue(50, vtkMath::Inf());
+  vectors->SetValue(3002, vtkMath::NegInf());
+  if (!CheckRangeKernels(vectors) || !CheckRangeKernels(ints))
+  {
+    return 1;
+  }
   return 0;
 }
 
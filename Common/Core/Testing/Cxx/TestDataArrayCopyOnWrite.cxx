@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace
+{
+#define CHECK(expr)                                                                                \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(expr))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": check failed: " #expr "\n";                           \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkIntArray> MakeSource()
+{
+  auto source = vtkSmartPointer<vtkIntArray>::New();
+  source->SetName("source");
+  source->SetNumberOfComponents(2);
+  source->SetNumberOfTuples(100);
+  for (vtkIdType i = 0; i < 200; ++i)
+  {
+    source->SetValue(i, static_cast<int>(i));
+  }
+  return source;
+}
+
+//------------------------------------------------------------------------------
+bool TestSharing()
+{
+  auto source = MakeSource();
+  const int* values = source->GetPointer(0);
+
+  vtkNew<vtkIntArray> copy;
+  copy->LazyDeepCopy(source);
+  CHECK(copy->GetNumberOfComponents() == 2 && copy->GetNumberOfTuples() == 100);
+  CHECK(copy->GetName() && std::string(copy->GetName()) == "source");
+
+  // Reading does not copy anything.
+  const auto range = vtk::DataArrayValueRange(copy);
+  CHECK(range.begin() == values && range[199] == 199 && copy->GetValue(10) == 10);
+
+  // The array written to gets its own copy.
+  copy->SetValue(0, -1);
+  CHECK(copy->GetValue(0) == -1 && source->GetValue(0) == 0);
+  CHECK(copy->GetValue(199) == 199);
+  CHECK(source->GetPointer(0) == values);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestLastOwner()
+{
+  auto source = MakeSource();
+  const int* values = source->GetPointer(0);
+
+  vtkNew<vtkIntArray> copy;
+  copy->LazyDeepCopy(source);
+  source = nullptr;
+
+  // Nobody else uses the memory anymore: it is modified in place.
+  auto range = vtk::DataArrayTupleRange(copy);
+  range[5][1] = -1;
+  CHECK(copy->GetPointer(0) == values && copy->GetTypedComponent(5, 1) == -1);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestPointers()
+{
+  // Writing through pointers or non-const ranges of either array copies the
+  // shared values first.
+  const std::function<void(vtkIntArray*)> writes[] = {
+    [](vtkIntArray* array) { array->GetPointer(0)[0] = 42; },
+    [](vtkIntArray* array) { static_cast<int*>(array->GetVoidPointer(0))[0] = 42; },
+    [](vtkIntArray* array) { vtk::DataArrayValueRange(array)[0] = 42; },
+    [](vtkIntArray* array) { vtk::DataArrayTupleRange(array)[0][0] = 42; },
+    [](vtkIntArray* array) { *vtk::DataArrayValueRange(array).begin() = 42; },
+    [](vtkIntArray* array) { vtk::DataArrayValueRange(array).data()[0] = 42; },
+  };
+  for (const auto& write : writes)
+  {
+    for (bool writeSource : { true, false })
+    {
+      auto source = MakeSource();
+      vtkNew<vtkIntArray> copy;
+      copy->LazyDeepCopy(source);
+      vtkIntArray* written = writeSource ? source.Get() : copy.Get();
+      vtkIntArray* other = writeSource ? copy.Get() : source.Get();
+      write(written);
+      CHECK(written->GetValue(0) == 42 && written->GetValue(199) == 199);
+      CHECK(other->GetValue(0) == 0 && other->GetValue(199) == 199);
+      CHECK(written->GetPointer(0) != other->GetPointer(0));
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestConcurrentWrites()
+{
+  auto source = vtkSmartPointer<vtkIntArray>::New();
+  source->SetNumberOfValues(100000);
+  source->FillValue(1);
+
+  // Every thread writing to the copy may be the first one: only one of them
+  // copies the values, and no write is lost.
+  vtkNew<vtkIntArray> copy;
+  copy->LazyDeepCopy(source);
+  vtkSMPTools::For(0, copy->GetNumberOfValues(), 1000, [&](vtkIdType begin, vtkIdType end) {
+    if ((begin / 1000) % 2)
+    {
+      int* data = copy->GetPointer(0);
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        data[i] = static_cast<int>(i);
+      }
+      return;
+    }
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      copy->SetValue(i, static_cast<int>(i));
+    }
+  });
+  for (vtkIdType i = 0; i < 100000; ++i)
+  {
+    CHECK(copy->GetValue(i) == i && source->GetValue(i) == 1);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestWritePaths()
+{
+  auto source = MakeSource();
+
+  vtkNew<vtkIntArray> a;
+  a->LazyDeepCopy(source);
+  a->FillValue(3);
+
+  vtkNew<vtkIntArray> b;
+  b->LazyDeepCopy(source);
+  b->InsertNextValue(200);
+
+  vtkNew<vtkIntArray> c;
+  c->LazyDeepCopy(source);
+  double tuple[2] = { -1., -2. };
+  c->SetTuple(99, tuple);
+
+  vtkNew<vtkIntArray> d;
+  d->LazyDeepCopy(source);
+  int* pointer = d->WritePointer(0, 2);
+  pointer[0] = -1;
+
+  vtkNew<vtkIntArray> e;
+  e->LazyDeepCopy(source);
+  e->Resize(1000);
+  e->SetValue(0, -1);
+
+  CHECK(a->GetValue(0) == 3 && a->GetValue(199) == 3);
+  CHECK(b->GetNumberOfValues() == 201 && b->GetValue(200) == 200 && b->GetValue(199) == 199);
+  CHECK(c->GetComponent(99, 0) == -1. && c->GetValue(0) == 0);
+  CHECK(d->GetValue(0) == -1 && d->GetValue(1) == 1);
+  CHECK(e->GetValue(0) == -1 && e->GetValue(199) == 199);
+  for (vtkIdType i = 0; i < 200; ++i)
+  {
+    CHECK(source->GetValue(i) == i);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestShallowCopies()
+{
+  auto source = MakeSource();
+  vtkNew<vtkIntArray> shallow;
+  shallow->ShallowCopy(source);
+
+  // A lazy copy of a shallow copy does not share the writes of the shallow copy.
+  vtkNew<vtkIntArray> copy;
+  copy->LazyDeepCopy(shallow);
+  shallow->SetValue(0, -1);
+  CHECK(source->GetValue(0) == -1 && copy->GetValue(0) == 0);
+
+  // A shallow copy turned into a lazy copy stops sharing its buffer.
+  shallow->LazyDeepCopy(source);
+  shallow->SetValue(1, -1);
+  CHECK(source->GetValue(1) == 1 && shallow->GetValue(1) == -1);
+
+  // Copies of copies.
+  vtkNew<vtkIntArray> second;
+  second->LazyDeepCopy(copy);
+  copy->SetValue(2, -1);
+  second->SetValue(3, -1);
+  CHECK(copy->GetValue(2) == -1 && copy->GetValue(3) == 3);
+  CHECK(second->GetValue(2) == 2 && second->GetValue(3) == -1);
+  CHECK(source->GetValue(2) == 2 && source->GetValue(3) == 3);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestOtherTypes()
+{
+  // Arrays of different types are deep copied.
+  auto source = MakeSource();
+  vtkNew<vtkDoubleArray> copy;
+  copy->LazyDeepCopy(source);
+  CHECK(copy->GetNumberOfValues() == 200 && copy->GetValue(199) == 199.);
+
+  vtkNew<vtkFloatArray> empty;
+  vtkNew<vtkFloatArray> emptyCopy;
+  emptyCopy->LazyDeepCopy(empty);
+  CHECK(emptyCopy->GetNumberOfValues() == 0);
+  emptyCopy->InsertNextValue(1.f);
+  CHECK(empty->GetNumberOfValues() == 0 && emptyCopy->GetValue(0) == 1.f);
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataArrayCopyOnWrite(int, char*[])
+{
+  bool success = TestSharing();
+  success = TestLastOwner() && success;
+  success = TestPointers() && success;
+  success = TestConcurrentWrites() && success;
+  success = TestWritePaths() && success;
+  success = TestShallowCopies() && success;
+  success = TestOtherTypes() && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
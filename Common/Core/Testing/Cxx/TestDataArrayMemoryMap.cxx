@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkMemoryMap.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const vtkTypeInt64 HeaderSize = 16;
+const vtkIdType NumberOfValues = 10000;
+
+//------------------------------------------------------------------------------
+// Write a small header followed by NumberOfValues floats.
+bool WriteFile(const std::string& fileName)
+{
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  const char header[HeaderSize] = "memory map test";
+  file.write(header, HeaderSize);
+  std::vector<float> values(NumberOfValues);
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+  {
+    values[i] = static_cast<float>(i);
+  }
+  file.write(reinterpret_cast<const char*>(values.data()), NumberOfValues * sizeof(float));
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+bool CheckValues(vtkAOSDataArrayTemplate<float>* array, vtkIdType count, float first)
+{
+  if (array->GetNumberOfValues() != count)
+  {
+    std::cerr << "Expected " << count << " values, got " << array->GetNumberOfValues() << "\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < count; ++i)
+  {
+    if (array->GetValue(i) != first + static_cast<float>(i))
+    {
+      std::cerr << "Wrong value at " << i << ": " << array->GetValue(i) << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestAOS(const std::string& fileName)
+{
+  vtkNew<vtkAOSDataArrayTemplate<float>> array;
+  array->SetNumberOfComponents(2);
+  if (!array->MapFile(fileName.c_str(), HeaderSize, NumberOfValues) || !array->IsMapped())
+  {
+    std::cerr << "Mapping the file failed.\n";
+    return false;
+  }
+  if (array->GetNumberOfTuples() != NumberOfValues / 2 ||
+    !CheckValues(array, NumberOfValues, 0.f))
+  {
+    return false;
+  }
+
+  // Readers hand out zero-copy arrays: shallow copies share the mapping.
+  vtkNew<vtkAOSDataArrayTemplate<float>> shallow;
+  shallow->ShallowCopy(array);
+  if (shallow->GetPointer(0) != array->GetPointer(0))
+  {
+    std::cerr << "Shallow copy of a mapped array is not zero-copy.\n";
+    return false;
+  }
+
+  // Offset not aligned on a page.
+  vtkNew<vtkAOSDataArrayTemplate<float>> shifted;
+  if (!shifted->MapFile(fileName.c_str(), HeaderSize + 4 * 1001, 10) ||
+    !CheckValues(shifted, 10, 1001.f))
+  {
+    std::cerr << "Mapping at an unaligned offset failed.\n";
+    return false;
+  }
+
+  // Resizing moves the values to the heap, the mapping is released.
+  array->Resize(NumberOfValues);
+  if (array->IsMapped() || !CheckValues(array, NumberOfValues, 0.f))
+  {
+    std::cerr << "Resizing a mapped array failed.\n";
+    return false;
+  }
+  array->SetValue(0, 42.f);
+
+  // Errors: offset not aligned on the value size and region past the end of the file.
+  vtkNew<vtkAOSDataArrayTemplate<float>> invalid;
+  if (invalid->MapFile(fileName.c_str(), HeaderSize + 1, 10) ||
+    invalid->MapFile(fileName.c_str(), HeaderSize, NumberOfValues + 1) ||
+    invalid->GetNumberOfValues() != 0)
+  {
+    std::cerr << "Invalid mappings should fail.\n";
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestModes(const std::string& fileName)
+{
+  {
+    vtkNew<vtkAOSDataArrayTemplate<float>> copyOnWrite;
+    if (!copyOnWrite->MapFile(
+          fileName.c_str(), HeaderSize, NumberOfValues, vtkMemoryMap::COPY_ON_WRITE))
+    {
+      return false;
+    }
+    copyOnWrite->SetValue(1, -1.f);
+    if (copyOnWrite->GetValue(1) != -1.f)
+    {
+      std::cerr << "Copy on write mapping is not writable.\n";
+      return false;
+    }
+  }
+  {
+    vtkNew<vtkAOSDataArrayTemplate<float>> readOnly;
+    readOnly->MapFile(fileName.c_str(), HeaderSize, NumberOfValues);
+    if (vtkMemoryMap::GetMode(readOnly->GetPointer(0)) != vtkMemoryMap::READ_ONLY ||
+      !CheckValues(readOnly, NumberOfValues, 0.f))
+    {
+      std::cerr << "Copy on write mapping modified the file.\n";
+      return false;
+    }
+  }
+  {
+    vtkNew<vtkAOSDataArrayTemplate<float>> readWrite;
+    readWrite->MapFile(fileName.c_str(), HeaderSize, NumberOfValues, vtkMemoryMap::READ_WRITE);
+    readWrite->SetValue(2, -2.f);
+  }
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  file.seekg(HeaderSize + 2 * sizeof(float));
+  float value = 0.f;
+  file.read(reinterpret_cast<char*>(&value), sizeof(float));
+  if (value != -2.f)
+  {
+    std::cerr << "Read write mapping did not modify the file.\n";
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestSOA(const std::string& fileName)
+{
+  const vtkIdType numberOfTuples = 100;
+  vtkNew<vtkSOADataArrayTemplate<float>> array;
+  array->SetNumberOfComponents(2);
+  if (!array->MapComponentFile(0, fileName.c_str(), HeaderSize + 4 * 1000, numberOfTuples, true) ||
+    !array->MapComponentFile(
+      1, fileName.c_str(), HeaderSize + 4 * 2000, numberOfTuples, false))
+  {
+    std::cerr << "Mapping SOA components failed.\n";
+    return false;
+  }
+  if (array->GetNumberOfTuples() != numberOfTuples)
+  {
+    std::cerr << "Wrong number of tuples: " << array->GetNumberOfTuples() << "\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < numberOfTuples; ++i)
+  {
+    if (array->GetTypedComponent(i, 0) != 1000.f + i ||
+      array->GetTypedComponent(i, 1) != 2000.f + i)
+    {
+      std::cerr << "Wrong SOA tuple " << i << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataArrayMemoryMap(int argc, char* argv[])
+{
+  if (!vtkMemoryMap::IsSupported())
+  {
+    std::cout << "Memory mapping is not supported on this platform.\n";
+    return EXIT_SUCCESS;
+  }
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestDataArrayMemoryMap.raw";
+  delete[] tempDir;
+
+  if (!WriteFile(fileName))
+  {
+    std::cerr << "Cannot write " << fileName << "\n";
+    return EXIT_FAILURE;
+  }
+
+  const bool success = TestAOS(fileName) && TestModes(fileName) && TestSOA(fileName);
+  std::remove(fileName.c_str());
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,17 +1,23 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkDataArrayRange.h"
+#include "vtkIntArray.h"
 #include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <iterator>
 #include <numeric>
 #include <set>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 static const int Target = 10000;
@@ -480,6 +486,345 @@ int doTestSMP()
       return EXIT_FAILURE;
     }
   }
+
+  // Test task graph: count -> prefix sum -> fill, plus an independent task
+  {
+    const vtkIdType nbOfBlocks = 100;
+    std::vector<vtkIdType> counts(nbOfBlocks, 0);
+    std::vector<vtkIdType> offsets(nbOfBlocks + 1, 0);
+    std::vector<vtkIdType> filled;
+    std::atomic<int> independentRuns(0);
+
+    vtkSMPTools::TaskGraph graph;
+    auto count = graph.SpawnFor(0, nbOfBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        counts[i] = i % 7;
+      }
+    });
+    auto scan = graph.Spawn(
+      [&]() {
+        for (vtkIdType i = 0; i < nbOfBlocks; ++i)
+        {
+          offsets[i + 1] = offsets[i] + counts[i];
+        }
+        filled.resize(offsets[nbOfBlocks], -1);
+      },
+      { count });
+    auto fill = graph.SpawnFor(
+      0, nbOfBlocks,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          std::fill(filled.begin() + offsets[i], filled.begin() + offsets[i + 1], i);
+        }
+      },
+      { scan });
+    auto independent = graph.Spawn([&]() { independentRuns++; });
+    graph.Spawn([&]() { independentRuns++; }, { fill, independent });
+    graph.Wait();
+
+    if (independentRuns != 2 || graph.GetNumberOfTasks() != 0)
+    {
+      cerr << "Error: vtkSMPTools::TaskGraph did not run every task!" << endl;
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < nbOfBlocks; ++i)
+    {
+      for (vtkIdType j = offsets[i]; j < offsets[i + 1]; ++j)
+      {
+        if (filled[j] != i)
+        {
+          cerr << "Error: vtkSMPTools::TaskGraph did not respect dependencies!" << endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    // SpawnFor honors Initialize() and Reduce()
+    InitializableFunctor functor6;
+    graph.SpawnFor(0, Target, 100, functor6);
+    graph.Wait();
+    total = 0;
+    int initTarget = Target;
+    for (auto& counter : functor6.CounterObject)
+    {
+      initTarget += 5;
+      total += counter->GetValue();
+    }
+    if (total != initTarget)
+    {
+      cerr << "Error: vtkSMPTools::TaskGraph::SpawnFor generated " << total << " instead of "
+           << initTarget << endl;
+      return EXIT_FAILURE;
+    }
+
+    // Exceptions are forwarded to Wait() and cancel the dependent tasks
+    bool dependentRan = false;
+    auto throwing = graph.Spawn([]() { throw std::runtime_error("task failure"); });
+    graph.Spawn([&]() { dependentRan = true; }, { throwing });
+    bool caught = false;
+    try
+    {
+      graph.Wait();
+    }
+    catch (const std::runtime_error&)
+    {
+      caught = true;
+    }
+    if (!caught || dependentRan)
+    {
+      cerr << "Error: vtkSMPTools::TaskGraph did not forward the task exception!" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test Reduce, InclusiveScan, ExclusiveScan and CopyIf
+  {
+    const int size = 100003;
+    std::vector<int> values(size);
+    for (int i = 0; i < size; ++i)
+    {
+      values[i] = (i * 7) % 13 - 6;
+    }
+
+    long long sum = vtkSMPTools::Reduce(values.begin(), values.end(), 0LL);
+    long long expectedSum = std::accumulate(values.begin(), values.end(), 0LL);
+    int maximum = vtkSMPTools::Reduce(values.begin() + 1, values.end(), values[0],
+      [](int a, int b) { return std::max(a, b); });
+    if (sum != expectedSum || maximum != 6)
+    {
+      cerr << "Error: vtkSMPTools::Reduce returned " << sum << " and " << maximum
+           << " instead of " << expectedSum << " and 6" << endl;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<int> inclusive(size);
+    std::vector<int> exclusive(size);
+    auto inclusiveEnd = vtkSMPTools::InclusiveScan(values.begin(), values.end(), inclusive.begin());
+    auto exclusiveEnd =
+      vtkSMPTools::ExclusiveScan(values.begin(), values.end(), exclusive.begin(), 10);
+    if (inclusiveEnd != inclusive.end() || exclusiveEnd != exclusive.end())
+    {
+      cerr << "Error: vtkSMPTools scans did not return the end of the output range!" << endl;
+      return EXIT_FAILURE;
+    }
+    int running = 0;
+    for (int i = 0; i < size; ++i)
+    {
+      if (exclusive[i] != running + 10)
+      {
+        cerr << "Error: vtkSMPTools::ExclusiveScan failed at " << i << endl;
+        return EXIT_FAILURE;
+      }
+      running += values[i];
+      if (inclusive[i] != running)
+      {
+        cerr << "Error: vtkSMPTools::InclusiveScan failed at " << i << endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // In place scan with an initial value
+    std::vector<int> inPlace(values);
+    vtkSMPTools::InclusiveScan(
+      inPlace.begin(), inPlace.end(), inPlace.begin(), std::plus<int>(), 5);
+    for (int i = 0; i < size; ++i)
+    {
+      if (inPlace[i] != inclusive[i] + 5)
+      {
+        cerr << "Error: in place vtkSMPTools::InclusiveScan failed at " << i << endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::vector<int> kept(size);
+    auto keptEnd = vtkSMPTools::CopyIf(
+      values.begin(), values.end(), kept.begin(), [](int value) { return value > 2; });
+    std::vector<int> expectedKept;
+    std::copy_if(values.begin(), values.end(), std::back_inserter(expectedKept),
+      [](int value) { return value > 2; });
+    if (!std::equal(expectedKept.begin(), expectedKept.end(), kept.begin()) ||
+      keptEnd - kept.begin() != static_cast<std::ptrdiff_t>(expectedKept.size()))
+    {
+      cerr << "Error: vtkSMPTools::CopyIf failed!" << endl;
+      return EXIT_FAILURE;
+    }
+
+    // Primitives called from a parallel scope, with and without nested parallelism
+    for (bool nested : { false, true })
+    {
+      std::atomic<int> failures(0);
+      auto nestedScans = [&]() {
+        vtkSMPTools::For(0, 8, 1, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType item = begin; item < end; ++item)
+          {
+            const vtkIdType length = size / 8;
+            auto first = values.begin() + item * length;
+            std::vector<int> partial(length);
+            vtkSMPTools::InclusiveScan(first, first + length, partial.begin());
+            const long long partialSum = vtkSMPTools::Reduce(first, first + length, 0LL);
+            if (partialSum != std::accumulate(first, first + length, 0LL) ||
+              partial.back() != partialSum)
+            {
+              ++failures;
+            }
+          }
+        });
+      };
+      vtkSMPTools::LocalScope(vtkSMPTools::Config{ nested }, nestedScans);
+      if (failures > 0)
+      {
+        cerr << "Error: vtkSMPTools primitives failed in a parallel scope!" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Empty ranges
+    std::vector<int> empty;
+    if (vtkSMPTools::Reduce(empty.begin(), empty.end(), 3) != 3 ||
+      vtkSMPTools::InclusiveScan(empty.begin(), empty.end(), inclusive.begin()) !=
+        inclusive.begin() ||
+      vtkSMPTools::CopyIf(empty.begin(), empty.end(), kept.begin(), [](int) { return true; }) !=
+        kept.begin())
+    {
+      cerr << "Error: vtkSMPTools primitives failed on an empty range!" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test thread affinity and first touch allocation
+  {
+    const std::string previousAffinity = vtkSMPTools::GetThreadAffinity();
+    if (vtkSMPTools::SetThreadAffinity("0-") ||
+      previousAffinity != vtkSMPTools::GetThreadAffinity())
+    {
+      cerr << "Error: vtkSMPTools::SetThreadAffinity accepted an invalid value!" << endl;
+      return EXIT_FAILURE;
+    }
+    if (!vtkSMPTools::SetThreadAffinity(" 0-1, 3") ||
+      std::string(vtkSMPTools::GetThreadAffinity()) != "0,1,3")
+    {
+      cerr << "Error: vtkSMPTools::SetThreadAffinity did not parse a processor list!" << endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkSMPTools::Config config;
+    config.ThreadAffinity = "Scatter";
+    config.FirstTouchAllocation = true;
+    bool scopeOk = true;
+    vtkSMPTools::LocalScope(config, [&]() {
+      scopeOk = std::string(vtkSMPTools::GetThreadAffinity()) == "scatter" &&
+        vtkSMPTools::GetFirstTouchAllocation();
+      vtkNew<vtkIntArray> array;
+      array->SetNumberOfValues(1 << 20);
+      auto range = vtk::DataArrayValueRange<1>(array);
+      // The Sequential backend does not touch buffers
+      if (std::string(vtkSMPTools::GetBackend()) != "Sequential")
+      {
+        scopeOk &= std::count(range.cbegin(), range.cend(), 0) == range.size();
+      }
+    });
+    if (!scopeOk || std::string(vtkSMPTools::GetThreadAffinity()) != "0,1,3" ||
+      vtkSMPTools::GetFirstTouchAllocation())
+    {
+      cerr << "Error: vtkSMPTools::LocalScope did not handle the thread affinity or the first "
+              "touch allocation!"
+           << endl;
+      return EXIT_FAILURE;
+    }
+    vtkSMPTools::SetThreadAffinity(previousAffinity.c_str());
+  }
+
+  // Test the adaptive scheduling on irregular work
+  {
+    vtkSMPTools::SetAdaptiveScheduling(true);
+    const vtkIdType size = 100000;
+    std::vector<std::atomic<int>> visits(size);
+    for (auto& visit : visits)
+    {
+      visit = 0;
+    }
+    vtkSMPTools::For(0, size, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        // The last items are much more expensive
+        volatile double work = 0;
+        for (vtkIdType j = 0; j < (i > size - 1000 ? 1000 : 1); ++j)
+        {
+          work = work + 1.0;
+        }
+        visits[i]++;
+      }
+    });
+    const bool adaptive = vtkSMPTools::GetAdaptiveScheduling();
+    vtkSMPTools::SetAdaptiveScheduling(false);
+    if (!adaptive ||
+      std::any_of(visits.begin(), visits.end(), [](const std::atomic<int>& visit) {
+        return visit != 1;
+      }))
+    {
+      cerr << "Error: vtkSMPTools::For with adaptive scheduling did not visit each item once!"
+           << endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkSMPTools::Config config;
+    config.AdaptiveScheduling = true;
+    int total = 0;
+    vtkSMPTools::LocalScope(config, [&]() {
+      ARangeFunctor functor;
+      vtkSMPTools::For(0, Target, functor);
+      for (const auto& count : functor.Counter)
+      {
+        total += count;
+      }
+    });
+    if (total != Target || vtkSMPTools::GetAdaptiveScheduling())
+    {
+      cerr << "Error: vtkSMPTools::LocalScope with adaptive scheduling failed!" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test the scheduling instrumentation
+  {
+    vtkSMPTools::SetInstrumentation(true);
+    vtkSMPTools::ClearInstrumentationRecords();
+
+    ARangeFunctor functor;
+    vtkSMPTools::For(0, Target, 100, functor);
+    vtkSMPTools::TaskGraph graph;
+    auto task = graph.Spawn([]() {});
+    graph.Spawn([]() {}, { task });
+    graph.Wait();
+
+    vtkSMPTools::SetInstrumentation(false);
+    vtkSMPTools::For(0, Target, functor);
+
+    const auto records = vtkSMPTools::GetInstrumentationRecords();
+    if (records.size() != 2 || records[0].Name.find("ARangeFunctor") == std::string::npos ||
+      records[0].Backend != vtkSMPTools::GetBackend() || records[0].Last != Target ||
+      records[0].Grain != 100 || records[1].Name != "vtkSMPTools::TaskGraph" ||
+      records[1].NumberOfChunks != 2)
+    {
+      cerr << "Error: vtkSMPTools instrumentation did not record the expected calls!" << endl;
+      return EXIT_FAILURE;
+    }
+    vtkIdType chunks = 0;
+    for (const auto& thread : records[0].Threads)
+    {
+      chunks += thread.NumberOfChunks;
+    }
+    if (records[0].NumberOfChunks < 1 || chunks != records[0].NumberOfChunks ||
+      records[0].GetImbalance() < 0.999 || records[0].GetIdleTime() < -1e-9)
+    {
+      cerr << "Error: vtkSMPTools instrumentation records are inconsistent!" << endl;
+      return EXIT_FAILURE;
+    }
+    vtkSMPTools::ClearInstrumentationRecords();
+  }
+
   return EXIT_SUCCESS;
 }
 
@@ -87,7 +87,7 @@ public:
   void SetValue(vtkIdType valueIdx, ValueType value)
     VTK_EXPECTS(0 <= valueIdx && valueIdx < GetNumberOfValues())
   {
-    this->Buffer->GetBuffer()[valueIdx] = value;
+    this->Buffer->GetWritableBuffer()[valueIdx] = value;
   }
 
   ///@{
@@ -111,7 +111,8 @@ public:
     VTK_EXPECTS(0 <= tupleIdx && tupleIdx < GetNumberOfTuples())
   {
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
-    std::copy(tuple, tuple + this->NumberOfComponents, this->Buffer->GetBuffer() + valueIdx);
+    std::copy(
+      tuple, tuple + this->NumberOfComponents, this->Buffer->GetWritableBuffer() + valueIdx);
   }
   ///@}
 
@@ -131,7 +132,7 @@ public:
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
     for (vtkIdType ii = 0; ii < this->NumberOfComponents; ++ii)
     {
-      this->Buffer->GetBuffer()[valueIdx + ii] = static_cast<ValueType>(tuple[ii]);
+      this->Buffer->GetWritableBuffer()[valueIdx + ii] = static_cast<ValueType>(tuple[ii]);
     }
   }
 
@@ -151,7 +152,7 @@ public:
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
     for (vtkIdType ii = 0; ii < this->NumberOfComponents; ++ii)
     {
-      this->Buffer->GetBuffer()[valueIdx + ii] = static_cast<ValueType>(tuple[ii]);
+      this->Buffer->GetWritableBuffer()[valueIdx + ii] = static_cast<ValueType>(tuple[ii]);
     }
   }
 
@@ -207,7 +208,8 @@ public:
    * to verify that the memory has been allocated etc.
    * Use of this method is discouraged, as newer arrays require a deep-copy of
    * the array data in order to return a suitable pointer. See vtkArrayDispatch
-   * for a safer alternative for fast data access.
+   * for a safer alternative for fast data access. If the data is shared with
+   * another array by LazyDeepCopy(), it is copied first.
    */
   ValueType* GetPointer(vtkIdType valueIdx);
   void* GetVoidPointer(vtkIdType valueIdx) override;
@@ -242,6 +244,37 @@ public:
    **/
   void SetArrayFreeFunction(void (*callback)(void*)) override;
 
+  ///@{
+  /**
+   * Back the array with @a numberOfValues values mapped from @a fileName,
+   * starting at byte @a offset, instead of copying them in memory. The values
+   * are expected in AOS order with the array value type and native byte order.
+   * Pages are only read when they are accessed, which lets readers hand out
+   * large arrays without copying them.
+   *
+   * @a mode is one of vtkMemoryMap::ModeType. The default READ_ONLY mode
+   * protects the memory: writing to the array is a protection fault. Use
+   * COPY_ON_WRITE to modify the values without changing the file, or
+   * READ_WRITE to write the modifications back to the file. Resizing the array
+   * copies the values to memory.
+   *
+   * Returns false, and leaves the array empty, if the file cannot be mapped.
+   */
+  bool MapFile(const char* fileName, vtkTypeInt64 offset, vtkIdType numberOfValues,
+    int mode = vtkMemoryMap::READ_ONLY);
+  bool IsMapped() const { return this->Buffer->IsMapped(); }
+  ///@}
+
+  ///@{
+  /**
+   * Set the allocator providing the memory of this array from now on. nullptr
+   * restores vtkArrayAllocator::GetDefaultAllocator(). Memory that has already
+   * been allocated is released by the allocator that provided it.
+   */
+  void SetAllocator(vtkArrayAllocator* allocator);
+  vtkArrayAllocator* GetAllocator();
+  ///@}
+
   // Overridden for optimized implementations:
   void SetTuple(vtkIdType tupleIdx, const float* tuple) override;
   void SetTuple(vtkIdType tupleIdx, const double* tuple) override;
@@ -306,6 +339,7 @@ public:
   VTK_NEWINSTANCE vtkArrayIterator* NewIterator() override;
   bool HasStandardMemoryLayout() const override { return true; }
   void ShallowCopy(vtkDataArray* other) override;
+  void LazyDeepCopy(vtkDataArray* other) override;
 
   // Reimplemented for efficiency:
   void InsertTuples(
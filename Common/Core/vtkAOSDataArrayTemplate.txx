@@ -114,6 +114,32 @@ void vtkAOSDataArrayTemplate<ValueType>::SetArrayFreeFunction(void (*callback)(v
   this->Buffer->SetFreeFunction(false, callback);
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAOSDataArrayTemplate<ValueTypeT>::SetAllocator(vtkArrayAllocator* allocator)
+{
+  this->Buffer->SetAllocator(allocator ? allocator : vtkArrayAllocator::GetDefaultAllocator());
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkArrayAllocator* vtkAOSDataArrayTemplate<ValueTypeT>::GetAllocator()
+{
+  return this->Buffer->GetAllocator();
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAOSDataArrayTemplate<ValueTypeT>::MapFile(
+  const char* fileName, vtkTypeInt64 offset, vtkIdType numberOfValues, int mode)
+{
+  const bool mapped = this->Buffer->MapFile(fileName, offset, numberOfValues, mode);
+  this->Size = this->Buffer->GetSize();
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+  return mapped;
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const float* tuple)
@@ -121,7 +147,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const flo
   // While std::copy is the obvious choice here, it kills performance on MSVC
   // debugging builds as their STL calls are poorly optimized. Just use a for
   // loop instead.
-  ValueTypeT* data = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
+  ValueTypeT* data = this->Buffer->GetWritableBuffer() + tupleIdx * this->NumberOfComponents;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
     data[i] = static_cast<ValueType>(tuple[i]);
@@ -133,7 +159,7 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const double* tuple)
 {
   // See note in SetTuple about std::copy vs for loops on MSVC.
-  ValueTypeT* data = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
+  ValueTypeT* data = this->Buffer->GetWritableBuffer() + tupleIdx * this->NumberOfComponents;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
     data[i] = static_cast<ValueType>(tuple[i]);
@@ -148,7 +174,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
   {
     // See note in SetTuple about std::copy vs for loops on MSVC.
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
-    ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
+    ValueTypeT* data = this->Buffer->GetWritableBuffer() + valueIdx;
     for (int i = 0; i < this->NumberOfComponents; ++i)
     {
       data[i] = static_cast<ValueType>(tuple[i]);
@@ -165,7 +191,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
   {
     // See note in SetTuple about std::copy vs for loops on MSVC.
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
-    ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
+    ValueTypeT* data = this->Buffer->GetWritableBuffer() + valueIdx;
     for (int i = 0; i < this->NumberOfComponents; ++i)
     {
       data[i] = static_cast<ValueType>(tuple[i]);
@@ -188,7 +214,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertComponent(
     }
   }
 
-  this->Buffer->GetBuffer()[newMaxId] = static_cast<ValueTypeT>(value);
+  this->Buffer->GetWritableBuffer()[newMaxId] = static_cast<ValueTypeT>(value);
   this->MaxId = std::max(newMaxId, this->MaxId);
 }
 
@@ -207,7 +233,7 @@ vtkIdType vtkAOSDataArrayTemplate<ValueTypeT>::InsertNextTuple(const float* tupl
   }
 
   // See note in SetTuple about std::copy vs for loops on MSVC.
-  ValueTypeT* data = this->Buffer->GetBuffer() + this->MaxId + 1;
+  ValueTypeT* data = this->Buffer->GetWritableBuffer() + this->MaxId + 1;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
     data[i] = static_cast<ValueType>(tuple[i]);
@@ -231,7 +257,7 @@ vtkIdType vtkAOSDataArrayTemplate<ValueTypeT>::InsertNextTuple(const double* tup
   }
 
   // See note in SetTuple about std::copy vs for loops on MSVC.
-  ValueTypeT* data = this->Buffer->GetBuffer() + this->MaxId + 1;
+  ValueTypeT* data = this->Buffer->GetWritableBuffer() + this->MaxId + 1;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
     data[i] = static_cast<ValueType>(tuple[i]);
@@ -301,6 +327,36 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::ShallowCopy(vtkDataArray* other)
   }
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAOSDataArrayTemplate<ValueTypeT>::LazyDeepCopy(vtkDataArray* other)
+{
+  SelfType* o = SelfType::FastDownCast(other);
+  if (!o || o == this)
+  {
+    this->Superclass::LazyDeepCopy(other);
+    return;
+  }
+
+  // Copy the information, name and component names like DeepCopy.
+  this->vtkAbstractArray::DeepCopy(o);
+  this->SetNumberOfComponents(o->NumberOfComponents);
+  if (this->Buffer == o->Buffer)
+  {
+    // Stop sharing the buffer of a previous ShallowCopy.
+    vtkBuffer<ValueType>* buffer = vtkBuffer<ValueType>::New();
+    buffer->SetAllocator(this->Buffer->GetAllocator());
+    this->Buffer->Delete();
+    this->Buffer = buffer;
+  }
+  this->Buffer->ShareCopyOnWrite(o->Buffer);
+  this->Size = o->Size;
+  this->MaxId = o->MaxId;
+
+  this->DeepCopyLookupTable(o);
+  this->DataChanged();
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuples(
@@ -353,9 +409,10 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuples(
 
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
-  ValueType* srcBegin = other->GetPointer(srcStart * numComps);
-  ValueType* srcEnd = srcBegin + (n * numComps);
-  ValueType* dstBegin = this->GetPointer(dstStart * numComps);
+  // Read the source without copying it if its data is shared copy-on-write.
+  const ValueType* srcBegin = other->Buffer->GetBuffer() + srcStart * numComps;
+  const ValueType* srcEnd = srcBegin + (n * numComps);
+  ValueType* dstBegin = this->Buffer->GetWritableBuffer() + dstStart * numComps;
 
   std::copy(srcBegin, srcEnd, dstBegin);
 }
@@ -379,7 +436,8 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::FillValue(ValueType value)
 {
   std::ptrdiff_t offset = this->MaxId + 1;
-  std::fill(this->Buffer->GetBuffer(), this->Buffer->GetBuffer() + offset, value);
+  ValueType* data = this->Buffer->GetWritableBuffer();
+  std::fill(data, data + offset, value);
 }
 
 //-----------------------------------------------------------------------------
@@ -408,7 +466,7 @@ vtkAOSDataArrayTemplate<ValueTypeT>::WritePointer(vtkIdType valueIdx, vtkIdType
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
   this->DataChanged();
-  return this->GetPointer(valueIdx);
+  return this->Buffer->GetWritableBuffer() + valueIdx;
 }
 
 //-----------------------------------------------------------------------------
@@ -423,7 +481,7 @@ template <class ValueTypeT>
 typename vtkAOSDataArrayTemplate<ValueTypeT>::ValueType*
 vtkAOSDataArrayTemplate<ValueTypeT>::GetPointer(vtkIdType valueIdx)
 {
-  return this->Buffer->GetBuffer() + valueIdx;
+  return this->Buffer->GetWritableBuffer() + valueIdx;
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkArenaArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#include <algorithm> // For std::max
+#include <cstdint>   // For std::uintptr_t
+#include <mutex>     // For std::mutex
+#include <vector>    // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+class vtkArenaArrayAllocator::vtkInternals
+{
+public:
+  struct Block
+  {
+    char* Data;
+    std::size_t Size;
+    std::size_t Used;
+  };
+
+  // Carve `size` bytes aligned on `alignment` from `block`, or return nullptr if
+  // the block is too small.
+  static char* Carve(Block& block, std::size_t size, std::size_t alignment)
+  {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.Data);
+    const std::uintptr_t aligned = (base + block.Used + alignment - 1) & ~(alignment - 1);
+    const std::size_t start = static_cast<std::size_t>(aligned - base);
+    if (start + size > block.Size)
+    {
+      return nullptr;
+    }
+    block.Used = start + size;
+    return block.Data + start;
+  }
+
+  // Return the block containing `pointer`, or nullptr if the arena does not own it.
+  Block* Find(const void* pointer)
+  {
+    const char* address = static_cast<const char*>(pointer);
+    for (Block& block : this->Blocks)
+    {
+      if (address >= block.Data && address < block.Data + block.Size)
+      {
+        return &block;
+      }
+    }
+    return nullptr;
+  }
+
+  std::mutex Mutex;
+  std::vector<Block> Blocks;
+  // Index of the block allocations are carved from. Blocks before it are full
+  // until the arena is rewound.
+  std::size_t Current = 0;
+  std::size_t NumberOfAllocations = 0;
+};
+
+vtkStandardNewMacro(vtkArenaArrayAllocator);
+
+//------------------------------------------------------------------------------
+vtkArenaArrayAllocator::vtkArenaArrayAllocator()
+  : BlockSize(64 * 1024 * 1024)
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkArenaArrayAllocator::~vtkArenaArrayAllocator()
+{
+  for (const auto& block : this->Internals->Blocks)
+  {
+    this->FreeBlock(block.Data);
+  }
+}
+
+//------------------------------------------------------------------------------
+void* vtkArenaArrayAllocator::Allocate(std::size_t size)
+{
+  if (size == 0)
+  {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  auto& blocks = this->Internals->Blocks;
+  for (std::size_t i = this->Internals->Current; i < blocks.size(); ++i)
+  {
+    if (char* pointer = vtkInternals::Carve(blocks[i], size, this->Alignment))
+    {
+      this->Internals->Current = i;
+      this->Internals->NumberOfAllocations++;
+      return pointer;
+    }
+  }
+
+  const std::size_t blockSize = (std::max)(this->BlockSize, size + this->Alignment);
+  char* data = static_cast<char*>(this->AllocateBlock(blockSize));
+  if (!data)
+  {
+    return nullptr;
+  }
+  blocks.push_back(vtkInternals::Block{ data, blockSize, 0 });
+  this->Internals->Current = blocks.size() - 1;
+  this->Internals->NumberOfAllocations++;
+  return vtkInternals::Carve(blocks.back(), size, this->Alignment);
+}
+
+//------------------------------------------------------------------------------
+void* vtkArenaArrayAllocator::Reallocate(void* pointer, std::size_t oldSize, std::size_t newSize)
+{
+  if (pointer)
+  {
+    // The last allocation of a block can be resized in place.
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    vtkInternals::Block* block = this->Internals->Find(pointer);
+    char* address = static_cast<char*>(pointer);
+    if (block && address + oldSize == block->Data + block->Used &&
+      address + newSize <= block->Data + block->Size)
+    {
+      block->Used = static_cast<std::size_t>(address - block->Data) + newSize;
+      return pointer;
+    }
+  }
+  return this->Superclass::Reallocate(pointer, oldSize, newSize);
+}
+
+//------------------------------------------------------------------------------
+void vtkArenaArrayAllocator::Free(void* pointer, std::size_t size)
+{
+  if (!pointer)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  vtkInternals::Block* block = this->Internals->Find(pointer);
+  if (!block || this->Internals->NumberOfAllocations == 0)
+  {
+    vtkErrorMacro("Trying to free memory that has not been allocated by this arena.");
+    return;
+  }
+
+  char* address = static_cast<char*>(pointer);
+  if (address + size == block->Data + block->Used)
+  {
+    block->Used = static_cast<std::size_t>(address - block->Data);
+  }
+  if (--this->Internals->NumberOfAllocations == 0)
+  {
+    // Nothing is alive anymore: rewind the arena.
+    for (auto& arenaBlock : this->Internals->Blocks)
+    {
+      arenaBlock.Used = 0;
+    }
+    this->Internals->Current = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkArenaArrayAllocator::ReleaseUnusedBlocks()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  if (this->Internals->NumberOfAllocations > 0)
+  {
+    return false;
+  }
+  for (const auto& block : this->Internals->Blocks)
+  {
+    this->FreeBlock(block.Data);
+  }
+  this->Internals->Blocks.clear();
+  this->Internals->Current = 0;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkArenaArrayAllocator::GetNumberOfAllocations()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfAllocations;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkArenaArrayAllocator::GetCapacity()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  std::size_t capacity = 0;
+  for (const auto& block : this->Internals->Blocks)
+  {
+    capacity += block.Size;
+  }
+  return capacity;
+}
+
+//------------------------------------------------------------------------------
+void vtkArenaArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "NumberOfAllocations: " << this->GetNumberOfAllocations() << "\n";
+  os << indent << "Capacity: " << this->GetCapacity() << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkArenaArrayAllocator
+ * @brief   array allocator carving allocations from large blocks.
+ *
+ * vtkArenaArrayAllocator serves allocations by bumping an offset in large
+ * blocks obtained from the system. Releasing an allocation does not give the
+ * memory back, except for the last allocation of a block which can be undone or
+ * grown in place. Once every allocation has been released, all the blocks are
+ * rewound and reused for the next allocations.
+ *
+ * This is meant for pipelines that re-execute for every time step: the arrays of
+ * a time step are allocated from the arena and released when the next time step
+ * replaces them, so that the following time steps reuse the same memory without
+ * going through malloc and without fragmenting the heap. Memory is only returned
+ * to the system when the allocator is destroyed or when ReleaseUnusedBlocks() is
+ * called while no allocation is alive.
+ *
+ * @sa
+ * vtkArrayAllocator vtkPoolArrayAllocator
+ */
+
+#ifndef vtkArenaArrayAllocator_h
+#define vtkArenaArrayAllocator_h
+
+#include "vtkArrayAllocator.h"
+#include "vtkCommonCoreModule.h" // For export macro
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT vtkArenaArrayAllocator : public vtkArrayAllocator
+{
+public:
+  static vtkArenaArrayAllocator* New();
+  vtkTypeMacro(vtkArenaArrayAllocator, vtkArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void* Allocate(std::size_t size) override;
+  void* Reallocate(void* pointer, std::size_t oldSize, std::size_t newSize) override;
+  void Free(void* pointer, std::size_t size) override;
+
+  ///@{
+  /**
+   * Size in bytes of the blocks requested from the system. Larger allocations
+   * get a block of their own. Default is 64 MiB.
+   */
+  vtkSetMacro(BlockSize, std::size_t);
+  vtkGetMacro(BlockSize, std::size_t);
+  ///@}
+
+  /**
+   * Give the blocks back to the system. Does nothing, and returns false, if
+   * some allocations are still alive.
+   */
+  bool ReleaseUnusedBlocks();
+
+  /**
+   * Number of allocations that have not been released yet.
+   */
+  std::size_t GetNumberOfAllocations();
+
+  /**
+   * Total size in bytes of the blocks owned by the arena.
+   */
+  std::size_t GetCapacity();
+
+protected:
+  vtkArenaArrayAllocator();
+  ~vtkArenaArrayAllocator() override;
+
+  std::size_t BlockSize;
+
+private:
+  vtkArenaArrayAllocator(const vtkArenaArrayAllocator&) = delete;
+  void operator=(const vtkArenaArrayAllocator&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cstdlib>   // For std::free
+#include <cstring>   // For std::memcpy
+#include <mutex>     // For std::mutex
+
+#if defined(_WIN32)
+#include <malloc.h> // For _aligned_malloc
+#elif defined(__linux__)
+#include <sys/mman.h> // For madvise
+#endif
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+// Transparent huge pages on x86_64 and aarch64 with 4 KiB base pages.
+constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+#endif
+
+std::mutex DefaultAllocatorMutex;
+vtkArrayAllocator* DefaultAllocator = nullptr;
+}
+
+vtkStandardNewMacro(vtkArrayAllocator);
+
+//------------------------------------------------------------------------------
+vtkArrayAllocator::vtkArrayAllocator()
+  : Alignment(64)
+  , UseHugePages(false)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkArrayAllocator::~vtkArrayAllocator() = default;
+
+//------------------------------------------------------------------------------
+void* vtkArrayAllocator::Allocate(std::size_t size)
+{
+  return size > 0 ? this->AllocateBlock(size) : nullptr;
+}
+
+//------------------------------------------------------------------------------
+void* vtkArrayAllocator::Reallocate(void* pointer, std::size_t oldSize, std::size_t newSize)
+{
+  if (!pointer)
+  {
+    return this->Allocate(newSize);
+  }
+  void* newPointer = this->Allocate(newSize);
+  if (newPointer)
+  {
+    std::memcpy(newPointer, pointer, (std::min)(oldSize, newSize));
+    this->Free(pointer, oldSize);
+  }
+  return newPointer;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::Free(void* pointer, std::size_t)
+{
+  this->FreeBlock(pointer);
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::SetAlignment(std::size_t alignment)
+{
+  std::size_t powerOfTwo = sizeof(void*);
+  while (powerOfTwo < alignment)
+  {
+    powerOfTwo *= 2;
+  }
+  if (this->Alignment != powerOfTwo)
+  {
+    this->Alignment = powerOfTwo;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void* vtkArrayAllocator::AllocateBlock(std::size_t size)
+{
+  std::size_t alignment = this->Alignment;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  const bool hugePages = this->UseHugePages && size >= HugePageSize;
+  if (hugePages)
+  {
+    alignment = (std::max)(alignment, HugePageSize);
+  }
+#endif
+
+  void* pointer = nullptr;
+#if defined(_WIN32)
+  pointer = _aligned_malloc(size, alignment);
+#else
+  if (posix_memalign(&pointer, alignment, size) != 0)
+  {
+    pointer = nullptr;
+  }
+#endif
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (pointer && hugePages)
+  {
+    // Only advise the whole huge pages of the block.
+    madvise(pointer, size - size % HugePageSize, MADV_HUGEPAGE);
+  }
+#endif
+  return pointer;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::FreeBlock(void* pointer)
+{
+#if defined(_WIN32)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::SetDefaultAllocator(vtkArrayAllocator* allocator)
+{
+  vtkArrayAllocator* previous = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(DefaultAllocatorMutex);
+    if (DefaultAllocator == allocator)
+    {
+      return;
+    }
+    previous = DefaultAllocator;
+    DefaultAllocator = allocator;
+    if (allocator)
+    {
+      allocator->Register(nullptr);
+    }
+  }
+  if (previous)
+  {
+    previous->UnRegister(nullptr);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkArrayAllocator* vtkArrayAllocator::GetDefaultAllocator()
+{
+  std::lock_guard<std::mutex> lock(DefaultAllocatorMutex);
+  return DefaultAllocator;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Alignment: " << this->Alignment << "\n";
+  os << indent << "UseHugePages: " << (this->UseHugePages ? "On" : "Off") << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkArrayAllocator
+ * @brief   allocator used for the storage of data arrays.
+ *
+ * vtkArrayAllocator provides the memory of vtkBuffer, and thus of
+ * vtkAOSDataArrayTemplate and vtkSOADataArrayTemplate. By default arrays use
+ * malloc/realloc/free directly. An allocator can be set for all the arrays
+ * created afterwards with SetDefaultAllocator(), or for a single array with
+ * vtkAOSDataArrayTemplate::SetAllocator() and vtkSOADataArrayTemplate::SetAllocator().
+ *
+ * This class allocates every request separately and can be used as is to
+ * get aligned allocations, e.g. so that SIMD kernels can assume that array data
+ * starts on a cache line boundary. Subclasses recycle memory instead of going
+ * back to the system:
+ * - vtkArenaArrayAllocator carves allocations from large blocks that are reused
+ *   once all the allocations are released, which suits pipelines re-executed for
+ *   every time step.
+ * - vtkPoolArrayAllocator keeps the released allocations in size classes to hand
+ *   them out again.
+ *
+ * Two options are shared by all the allocators:
+ * - Alignment: the alignment in bytes of the returned memory, 64 by default.
+ * - UseHugePages: on Linux, allocations of at least 2 MiB are aligned on 2 MiB
+ *   and advised to be backed by transparent huge pages, which reduces TLB misses
+ *   when traversing large arrays. This option is ignored on other platforms.
+ *
+ * Allocators are thread safe: arrays using the same allocator can be allocated
+ * and released from different threads.
+ *
+ * @sa
+ * vtkArenaArrayAllocator vtkPoolArrayAllocator vtkBuffer
+ */
+
+#ifndef vtkArrayAllocator_h
+#define vtkArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <cstddef> // For std::size_t
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT vtkArrayAllocator : public vtkObject
+{
+public:
+  static vtkArrayAllocator* New();
+  vtkTypeMacro(vtkArrayAllocator, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Allocate @a size bytes. Returns nullptr if the allocation failed or if
+   * @a size is 0.
+   */
+  virtual void* Allocate(std::size_t size);
+
+  /**
+   * Resize an allocation of @a oldSize bytes returned by this allocator to
+   * @a newSize bytes, preserving its content. Returns nullptr, and leaves the
+   * original allocation untouched, if the allocation failed. A nullptr
+   * @a pointer behaves like Allocate().
+   */
+  virtual void* Reallocate(void* pointer, std::size_t oldSize, std::size_t newSize);
+
+  /**
+   * Release an allocation of @a size bytes returned by this allocator.
+   */
+  virtual void Free(void* pointer, std::size_t size);
+
+  ///@{
+  /**
+   * Alignment in bytes of the allocated memory. It is rounded up to a power of
+   * two, and at least the alignment of a pointer. Default is 64.
+   */
+  virtual void SetAlignment(std::size_t alignment);
+  vtkGetMacro(Alignment, std::size_t);
+  ///@}
+
+  ///@{
+  /**
+   * Back large allocations with transparent huge pages, see the class
+   * documentation. Default is false.
+   */
+  vtkSetMacro(UseHugePages, bool);
+  vtkGetMacro(UseHugePages, bool);
+  vtkBooleanMacro(UseHugePages, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Allocator used by the arrays created afterwards. nullptr, the default,
+   * means that arrays use malloc/realloc/free.
+   */
+  static void SetDefaultAllocator(vtkArrayAllocator* allocator);
+  static vtkArrayAllocator* GetDefaultAllocator();
+  ///@}
+
+protected:
+  vtkArrayAllocator();
+  ~vtkArrayAllocator() override;
+
+  /**
+   * Allocate a block from the system honoring Alignment and UseHugePages.
+   * Blocks have to be released with FreeBlock().
+   */
+  void* AllocateBlock(std::size_t size);
+  void FreeBlock(void* pointer);
+
+  std::size_t Alignment;
+  bool UseHugePages;
+
+private:
+  vtkArrayAllocator(const vtkArrayAllocator&) = delete;
+  void operator=(const vtkArrayAllocator&) = delete;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -13,10 +13,32 @@
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkArrayAllocator.h" // For vtkArrayAllocator
+#include "vtkMemoryMap.h"      // For vtkMemoryMap
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
+#include "vtkSmartPointer.h"  // For vtkSmartPointer
 
 #include <algorithm> // for std::min and std::copy
+#include <atomic>    // for std::atomic
+#include <cstddef>   // for std::size_t
+#include <mutex>     // for std::mutex
+#include <new>       // for std::bad_alloc
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+// Zero a newly allocated buffer in parallel when vtkSMPTools::GetFirstTouchAllocation() is
+// true, see vtkSMPTools::SetFirstTouchAllocation(). Defined in vtkSMPTools.cxx.
+VTKCOMMONCORE_EXPORT void vtkSMPToolsFirstTouch(void* buffer, std::size_t numberOfBytes);
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
 
 VTK_ABI_NAMESPACE_BEGIN
 template <class ScalarTypeT>
@@ -35,6 +57,24 @@ public:
   inline ScalarType* GetBuffer() { return this->Pointer; }
   inline const ScalarType* GetBuffer() const { return this->Pointer; }
 
+  /**
+   * Access the buffer to modify it. If the memory is shared with other buffers
+   * through ShareCopyOnWrite(), it is copied first so that the other buffers
+   * are not modified. Several threads may call it at once: the first one
+   * copies the memory while the others wait for it, and once the buffer is not
+   * shared anymore it only costs an atomic load.
+   */
+  inline ScalarType* GetWritableBuffer()
+  {
+    if (this->MaybeShared.load(std::memory_order_acquire) && !this->Detach())
+    {
+#if !defined VTK_DONT_THROW_BAD_ALLOC
+      throw std::bad_alloc();
+#endif
+    }
+    return this->Pointer;
+  }
+
   /**
    * Set the memory buffer that this vtkBuffer object will manage. @a array
    * is a pointer to the buffer data and @a size is the size of the buffer (in
@@ -76,14 +116,72 @@ public:
    */
   bool Reallocate(vtkIdType newsize);
 
+  /**
+   * Release the current buffer and replace it by @a size elements mapped from
+   * @a fileName, starting at byte @a offset. Pages are loaded lazily when they
+   * are accessed. @a mode is one of vtkMemoryMap::ModeType: READ_ONLY mappings
+   * must not be written to, COPY_ON_WRITE mappings can be modified without
+   * changing the file and READ_WRITE mappings write their modifications back to
+   * the file. @a offset has to be a multiple of the size of ScalarType.
+   *
+   * The region is unmapped when the buffer is released. Reallocate() copies the
+   * data to a heap allocated buffer. Returns false if the mapping failed, in
+   * which case the buffer is left empty.
+   */
+  bool MapFile(
+    const char* fileName, vtkTypeInt64 offset, vtkIdType size, int mode = vtkMemoryMap::READ_ONLY);
+
+  /**
+   * Return true if the current buffer is a region mapped with MapFile().
+   */
+  bool IsMapped() const { return this->Pointer && vtkMemoryMap::IsMapped(this->Pointer); }
+
+  /**
+   * Release the current buffer and share the memory of @a other until one of
+   * them is modified through GetWritableBuffer(): the one being written gets a
+   * private copy of the data first, unless it is the last one sharing the
+   * memory. The memory is released once no buffer uses it anymore. Buffers
+   * sharing memory must not be written through GetBuffer(), which never copies
+   * anything. @a other may be detached by other threads meanwhile, but must not
+   * be reallocated or released.
+   */
+  void ShareCopyOnWrite(vtkBuffer<ScalarTypeT>* other);
+
+  /**
+   * Return true if the memory is currently shared with other buffers through
+   * ShareCopyOnWrite().
+   */
+  bool IsSharedCopyOnWrite() const
+  {
+    return this->SharedOwner && this->SharedOwner->GetReferenceCount() > 1;
+  }
+
+  ///@{
+  /**
+   * Set the allocator used by the next calls to Allocate() and Reallocate().
+   * nullptr means that the malloc, realloc and free functions are used. New
+   * buffers use vtkArrayAllocator::GetDefaultAllocator(). The current buffer, if
+   * it has been allocated by another allocator, is still released by it.
+   */
+  void SetAllocator(vtkArrayAllocator* allocator) { this->Allocator = allocator; }
+  vtkArrayAllocator* GetAllocator() const { return this->Allocator; }
+  ///@}
+
 protected:
   vtkBuffer()
     : Pointer(nullptr)
     , Size(0)
+    , AllocatedBytes(0)
+    , MaybeShared(false)
   {
     this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
     this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
     this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    // Extended memory buffers always go through memkind.
+    if (!vtkObjectBase::GetUsingMemkind())
+    {
+      this->Allocator = vtkArrayAllocator::GetDefaultAllocator();
+    }
   }
 
   ~vtkBuffer() override { this->SetBuffer(nullptr, 0); }
@@ -93,8 +191,46 @@ protected:
   vtkMallocingFunction MallocFunction;
   vtkReallocingFunction ReallocFunction;
   vtkFreeingFunction DeleteFunction;
+  // Allocator used for the next allocations, and allocator that provided Pointer
+  // (nullptr if Pointer is released with DeleteFunction) with the size in bytes
+  // it has been allocated with.
+  vtkSmartPointer<vtkArrayAllocator> Allocator;
+  vtkSmartPointer<vtkArrayAllocator> PointerAllocator;
+  std::size_t AllocatedBytes;
+  // Buffer owning the memory shared with ShareCopyOnWrite(), referenced by every
+  // buffer sharing it.
+  vtkSmartPointer<vtkBuffer<ScalarTypeT>> SharedOwner;
+  // Set by ShareCopyOnWrite() and cleared by Detach() once the buffer has a
+  // private copy: it may still be set after the buffer stopped sharing memory.
+  std::atomic<bool> MaybeShared;
+  // Serializes Detach() calls on the buffer and, on the owner, the decision to
+  // copy the shared memory or to take it back.
+  std::mutex DetachMutex;
 
 private:
+  bool ReallocateWithAllocator(vtkIdType newsize);
+
+  // Stop sharing the memory, copying it if other buffers still use it.
+  bool Detach();
+
+  // Free function matching the malloc function.
+  vtkFreeingFunction GetMatchingFreeFunction() const
+  {
+    return (!this->MallocFunction || this->MallocFunction == malloc)
+      ? free
+      : vtkObjectBase::GetCurrentFreeFunction();
+  }
+
+  // Once a mapped region has been released, go back to the free function
+  // matching the malloc function.
+  void ResetMappedFreeFunction()
+  {
+    if (this->DeleteFunction == &vtkMemoryMap::Unmap)
+    {
+      this->DeleteFunction = this->GetMatchingFreeFunction();
+    }
+  }
+
   vtkBuffer(const vtkBuffer&) = delete;
   void operator=(const vtkBuffer&) = delete;
 };
@@ -118,7 +254,17 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
 {
   if (this->Pointer != array)
   {
-    if (this->DeleteFunction)
+    if (this->SharedOwner)
+    {
+      // The owner releases the memory once it is not shared anymore.
+      this->SharedOwner = nullptr;
+    }
+    else if (this->PointerAllocator)
+    {
+      this->PointerAllocator->Free(this->Pointer, this->AllocatedBytes);
+      this->PointerAllocator = nullptr;
+    }
+    else if (this->DeleteFunction)
     {
       this->DeleteFunction(this->Pointer);
     }
@@ -159,6 +305,21 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
 {
   // release old memory.
   this->SetBuffer(nullptr, 0);
+  this->ResetMappedFreeFunction();
+  if (size > 0 && this->Allocator)
+  {
+    const std::size_t numberOfBytes = static_cast<std::size_t>(size) * sizeof(ScalarType);
+    ScalarType* newArray = static_cast<ScalarType*>(this->Allocator->Allocate(numberOfBytes));
+    if (!newArray)
+    {
+      return false;
+    }
+    vtk::detail::smp::vtkSMPToolsFirstTouch(newArray, numberOfBytes);
+    this->SetBuffer(newArray, size);
+    this->PointerAllocator = this->Allocator;
+    this->AllocatedBytes = numberOfBytes;
+    return true;
+  }
   if (size > 0)
   {
     ScalarType* newArray;
@@ -172,6 +333,7 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
     }
     if (newArray)
     {
+      vtk::detail::smp::vtkSMPToolsFirstTouch(newArray, size * sizeof(ScalarType));
       this->SetBuffer(newArray, size);
       if (!this->MallocFunction)
       {
@@ -193,7 +355,15 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     return this->Allocate(0);
   }
 
-  if (this->Pointer && this->DeleteFunction != free)
+  if (this->Allocator)
+  {
+    return this->ReallocateWithAllocator(newsize);
+  }
+
+  // Only the values added to the buffer are touched, the others are copied.
+  const vtkIdType oldSize = this->Pointer ? (std::min)(this->Size, newsize) : 0;
+  if (this->Pointer &&
+    (this->DeleteFunction != free || this->PointerAllocator || this->SharedOwner))
   {
     ScalarType* newArray;
     bool forceFreeFunction = false;
@@ -219,9 +389,12 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     {
       return false;
     }
-    std::copy(this->Pointer, this->Pointer + (std::min)(this->Size, newsize), newArray);
+    vtk::detail::smp::vtkSMPToolsFirstTouch(
+      newArray + oldSize, (newsize - oldSize) * sizeof(ScalarType));
+    std::copy(this->Pointer, this->Pointer + oldSize, newArray);
     // now save the new array and release the old one too.
     this->SetBuffer(newArray, newsize);
+    this->ResetMappedFreeFunction();
     if (!this->MallocFunction || forceFreeFunction)
     {
       this->DeleteFunction = free;
@@ -245,9 +418,175 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     {
       return false;
     }
+    vtk::detail::smp::vtkSMPToolsFirstTouch(
+      newArray + oldSize, (newsize - oldSize) * sizeof(ScalarType));
+    this->Pointer = newArray;
+    this->Size = newsize;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+bool vtkBuffer<ScalarT>::ReallocateWithAllocator(vtkIdType newsize)
+{
+  const std::size_t numberOfBytes = static_cast<std::size_t>(newsize) * sizeof(ScalarType);
+  const vtkIdType oldSize = this->Pointer ? (std::min)(this->Size, newsize) : 0;
+  if (this->Pointer && this->PointerAllocator == this->Allocator)
+  {
+    // The allocator may be able to resize in place.
+    ScalarType* newArray = static_cast<ScalarType*>(
+      this->Allocator->Reallocate(this->Pointer, this->AllocatedBytes, numberOfBytes));
+    if (!newArray)
+    {
+      return false;
+    }
+    vtk::detail::smp::vtkSMPToolsFirstTouch(
+      newArray + oldSize, (newsize - oldSize) * sizeof(ScalarType));
     this->Pointer = newArray;
     this->Size = newsize;
+    this->AllocatedBytes = numberOfBytes;
+    return true;
+  }
+
+  // The current buffer comes from somewhere else: copy it to a new allocation.
+  ScalarType* newArray = static_cast<ScalarType*>(this->Allocator->Allocate(numberOfBytes));
+  if (!newArray)
+  {
+    return false;
+  }
+  vtk::detail::smp::vtkSMPToolsFirstTouch(
+    newArray + oldSize, (newsize - oldSize) * sizeof(ScalarType));
+  if (this->Pointer)
+  {
+    std::copy(this->Pointer, this->Pointer + oldSize, newArray);
+  }
+  this->SetBuffer(newArray, newsize);
+  this->ResetMappedFreeFunction();
+  this->PointerAllocator = this->Allocator;
+  this->AllocatedBytes = numberOfBytes;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+bool vtkBuffer<ScalarT>::MapFile(
+  const char* fileName, vtkTypeInt64 offset, vtkIdType size, int mode)
+{
+  this->Allocate(0);
+  if (size <= 0)
+  {
+    return true;
+  }
+  if (offset % static_cast<vtkTypeInt64>(sizeof(ScalarType)) != 0)
+  {
+    vtkWarningMacro("Cannot map " << (fileName ? fileName : "(null)") << " at offset " << offset
+                                  << ": the offset is not aligned on the value size.");
+    return false;
+  }
+
+  void* mapped = vtkMemoryMap::Map(
+    fileName, offset, static_cast<std::size_t>(size) * sizeof(ScalarType), mode);
+  if (!mapped)
+  {
+    return false;
+  }
+  this->SetBuffer(static_cast<ScalarType*>(mapped), size);
+  this->DeleteFunction = &vtkMemoryMap::Unmap;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+void vtkBuffer<ScalarT>::ShareCopyOnWrite(vtkBuffer<ScalarT>* other)
+{
+  if (!other || other == this)
+  {
+    return;
+  }
+  // Detach() reads and changes the sharing state of both buffers under their
+  // lock. Buffers are locked before their owner there, and owners are never
+  // shared themselves, so locking the two buffers here cannot deadlock.
+  std::unique_lock<std::mutex> lock(this->DetachMutex, std::defer_lock);
+  std::unique_lock<std::mutex> otherLock(other->DetachMutex, std::defer_lock);
+  std::lock(lock, otherLock);
+  if (this->SharedOwner && this->SharedOwner == other->SharedOwner)
+  {
+    return;
+  }
+  this->Allocate(0);
+  if (!other->Pointer)
+  {
+    return;
+  }
+
+  if (!other->SharedOwner)
+  {
+    // Hand the memory, and the way to release it, over to an owner shared by
+    // both buffers.
+    vtkBuffer<ScalarT>* owner = vtkBuffer<ScalarT>::New();
+    owner->Pointer = other->Pointer;
+    owner->Size = other->Size;
+    owner->DeleteFunction = other->DeleteFunction;
+    owner->PointerAllocator = other->PointerAllocator;
+    owner->AllocatedBytes = other->AllocatedBytes;
+    other->PointerAllocator = nullptr;
+    other->DeleteFunction = other->GetMatchingFreeFunction();
+    other->SharedOwner.TakeReference(owner);
+  }
+  // Private copies are allocated, and released, like any other buffer.
+  this->DeleteFunction = this->GetMatchingFreeFunction();
+  this->Pointer = other->Pointer;
+  this->Size = other->Size;
+  this->SharedOwner = other->SharedOwner;
+  this->MaybeShared.store(true, std::memory_order_release);
+  other->MaybeShared.store(true, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+bool vtkBuffer<ScalarT>::Detach()
+{
+  std::lock_guard<std::mutex> lock(this->DetachMutex);
+  if (!this->SharedOwner)
+  {
+    // Detached by another thread, or released since it was shared.
+    this->MaybeShared.store(false, std::memory_order_release);
+    return true;
+  }
+
+  // The owner is kept alive until its lock is released. Buffers sharing its
+  // memory and detaching concurrently hold a reference to it too, so they copy
+  // the memory rather than take it back.
+  vtkSmartPointer<vtkBuffer<ScalarT>> owner = this->SharedOwner;
+  std::lock_guard<std::mutex> ownerLock(owner->DetachMutex);
+  if (owner->GetReferenceCount() == 2)
+  {
+    // Nobody else uses the memory: take it back from the owner.
+    this->DeleteFunction = owner->DeleteFunction;
+    this->PointerAllocator = owner->PointerAllocator;
+    this->AllocatedBytes = owner->AllocatedBytes;
+    owner->Pointer = nullptr;
+    owner->PointerAllocator = nullptr;
+    owner->Size = 0;
+    this->SharedOwner = nullptr;
+    this->MaybeShared.store(false, std::memory_order_release);
+    return true;
+  }
+
+  ScalarType* shared = this->Pointer;
+  const vtkIdType size = this->Size;
+  if (!this->Allocate(size))
+  {
+    vtkErrorMacro("Unable to allocate " << size << " elements of size " << sizeof(ScalarType)
+                                        << " bytes to copy shared data.");
+    this->Pointer = shared;
+    this->Size = size;
+    this->SharedOwner = owner;
+    return false;
   }
+  std::copy(shared, shared + size, this->Pointer);
+  this->MaybeShared.store(false, std::memory_order_release);
   return true;
 }
 
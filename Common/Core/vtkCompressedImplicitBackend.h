@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkCompressedImplicitBackend_h
+#define vtkCompressedImplicitBackend_h
+
+/**
+ * \class vtkCompressedImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework keeping the values of a data array compressed in
+ * memory, so that large arrays that are rarely accessed take a fraction of their size.
+ *
+ * The values, in AOS order, are split into blocks of `blockSize` values compressed independently
+ * with a lossless codec: every value is replaced by its difference with the same component of the
+ * previous tuple (the XOR of their bit patterns for floating point values) and only the significant
+ * bytes of the difference are stored. Smooth fields, identifiers, labels and constant regions
+ * compress well, while noisy floating point data may stay close to its original size. Blocks that
+ * do not compress are stored as is.
+ *
+ * Accessing a value decompresses its whole block into a small cache of `numberOfCachedBlocks`
+ * blocks, so that accessing the values in order only decompresses each block once. Each thread
+ * has its own cache, in a `vtkSMPThreadLocal`, so that threads of `vtkSMPTools` read the array
+ * concurrently without locking; arrays read many times in random order should rather be
+ * decompressed into a regular array first.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkFloatArray> baseArray;
+ * // ... fill baseArray ...
+ * vtkNew<vtkCompressedArray<float>> compressed;
+ * compressed->ConstructBackend(baseArray);
+ * compressed->SetNumberOfComponents(baseArray->GetNumberOfComponents());
+ * compressed->SetNumberOfTuples(baseArray->GetNumberOfTuples());
+ * baseArray = nullptr; // the values now only live in compressed form
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkCompressedArray
+ */
+
+#include "vtkCommonCoreModule.h"
+
+#include "vtkType.h"
+
+#include <cstddef>
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend final
+{
+public:
+  /**
+   * Compress the values of @a array.
+   * @param array array to compress, it is not referenced afterwards
+   * @param blockSize number of values compressed together, rounded down to whole tuples
+   * @param numberOfCachedBlocks number of decompressed blocks kept in memory
+   */
+  vtkCompressedImplicitBackend(
+    vtkDataArray* array, vtkIdType blockSize = 4096, int numberOfCachedBlocks = 4);
+  ~vtkCompressedImplicitBackend();
+
+  /**
+   * Indexing operation for the compressed array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType operator()(vtkIdType idx) const;
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple, looking up the cache of the thread only once.
+   */
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const;
+
+  /**
+   * Returns the smallest integer memory size in KiB needed to store the compressed values and the
+   * cached blocks of all threads. Used to implement GetActualMemorySize on `vtkCompressedArray`.
+   * It must not be called while the array is read concurrently.
+   */
+  unsigned long getMemorySize() const;
+
+  /**
+   * Size in bytes of the compressed values, without the cache.
+   */
+  std::size_t GetCompressedSize() const;
+
+  /**
+   * Size in bytes of the values once decompressed.
+   */
+  std::size_t GetUncompressedSize() const;
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkCompressedImplicitBackend_h
+
+#if defined(VTK_COMPRESSED_BACKEND_INSTANTIATING)
+
+#define VTK_INSTANTIATE_COMPRESSED_BACKEND(ValueType)                                              \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend<ValueType>;                     \
+  VTK_ABI_NAMESPACE_END
+
+#elif defined(VTK_USE_EXTERN_TEMPLATE)
+
+#ifndef VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+#define VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4910) // extern and dllexport incompatible
+#endif
+VTK_ABI_NAMESPACE_BEGIN
+vtkExternTemplateMacro(extern template class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend);
+VTK_ABI_NAMESPACE_END
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#endif // VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+
+#endif
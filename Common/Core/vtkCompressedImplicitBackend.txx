@@ -0,0 +1,382 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCompressedImplicitBackend.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace vtkCompressedImplicitBackendDetail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+// Unsigned integer type holding the bit pattern of a value.
+template <std::size_t Size>
+struct BitsOfSize;
+template <>
+struct BitsOfSize<1>
+{
+  using Type = std::uint8_t;
+};
+template <>
+struct BitsOfSize<2>
+{
+  using Type = std::uint16_t;
+};
+template <>
+struct BitsOfSize<4>
+{
+  using Type = std::uint32_t;
+};
+template <>
+struct BitsOfSize<8>
+{
+  using Type = std::uint64_t;
+};
+
+// First byte of every block.
+enum BlockMode : unsigned char
+{
+  RAW = 0,
+  DELTA = 1
+};
+
+//-----------------------------------------------------------------------
+// Lossless codec turning values into the significant bytes of their difference with the same
+// component of the previous tuple. Every pair of values is preceded by a header byte holding their
+// number of bytes.
+template <typename ValueType>
+struct Codec
+{
+  using Bits = typename BitsOfSize<sizeof(ValueType)>::Type;
+  static constexpr int NumberOfBits = 8 * sizeof(ValueType);
+
+  static Bits ToBits(ValueType value)
+  {
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(ValueType));
+    return bits;
+  }
+
+  static ValueType FromBits(Bits bits)
+  {
+    ValueType value;
+    std::memcpy(&value, &bits, sizeof(ValueType));
+    return value;
+  }
+
+  // Floating point values share their sign, exponent and high mantissa bits with their
+  // neighbors: XOR leaves the low bits only. Integers are delta encoded, with the sign moved to
+  // the lowest bit (zigzag) so that small negative differences are small too.
+  static Bits Residual(Bits bits, Bits previous, std::true_type)
+  {
+    return static_cast<Bits>(bits ^ previous);
+  }
+  static Bits Residual(Bits bits, Bits previous, std::false_type)
+  {
+    const Bits delta = static_cast<Bits>(bits - previous);
+    const Bits sign = (delta >> (NumberOfBits - 1)) ? static_cast<Bits>(~Bits(0)) : Bits(0);
+    return static_cast<Bits>(static_cast<Bits>(delta << 1) ^ sign);
+  }
+  static Bits Restore(Bits residual, Bits previous, std::true_type)
+  {
+    return static_cast<Bits>(residual ^ previous);
+  }
+  static Bits Restore(Bits residual, Bits previous, std::false_type)
+  {
+    const Bits sign = (residual & 1) ? static_cast<Bits>(~Bits(0)) : Bits(0);
+    const Bits delta = static_cast<Bits>(static_cast<Bits>(residual >> 1) ^ sign);
+    return static_cast<Bits>(previous + delta);
+  }
+
+  static int NumberOfBytes(Bits residual)
+  {
+    int count = 0;
+    while (residual)
+    {
+      ++count;
+      residual = static_cast<Bits>(residual >> 8);
+    }
+    return count;
+  }
+
+  static void Encode(const ValueType* values, vtkIdType count, int numberOfComponents,
+    std::vector<unsigned char>& block)
+  {
+    using IsFloat = std::is_floating_point<ValueType>;
+    block.clear();
+    block.push_back(DELTA);
+    std::vector<Bits> previous(numberOfComponents, 0);
+    for (vtkIdType i = 0; i < count; i += 2)
+    {
+      const std::size_t header = block.size();
+      block.push_back(0);
+      for (vtkIdType j = i; j < std::min(i + 2, count); ++j)
+      {
+        const Bits bits = ToBits(values[j]);
+        Bits& last = previous[j % numberOfComponents];
+        Bits residual = Residual(bits, last, IsFloat());
+        last = bits;
+        const int numberOfBytes = NumberOfBytes(residual);
+        block[header] |= static_cast<unsigned char>(numberOfBytes << (4 * (j - i)));
+        for (int b = 0; b < numberOfBytes; ++b)
+        {
+          block.push_back(static_cast<unsigned char>(residual & 0xff));
+          residual = static_cast<Bits>(residual >> 8);
+        }
+      }
+    }
+
+    const std::size_t rawSize = 1 + count * sizeof(ValueType);
+    if (block.size() >= rawSize)
+    {
+      block.resize(rawSize);
+      block[0] = RAW;
+      std::memcpy(block.data() + 1, values, count * sizeof(ValueType));
+    }
+    block.shrink_to_fit();
+  }
+
+  static void Decode(
+    const unsigned char* block, vtkIdType count, int numberOfComponents, ValueType* values)
+  {
+    using IsFloat = std::is_floating_point<ValueType>;
+    if (block[0] == RAW)
+    {
+      std::memcpy(values, block + 1, count * sizeof(ValueType));
+      return;
+    }
+    ++block;
+    std::vector<Bits> previous(numberOfComponents, 0);
+    for (vtkIdType i = 0; i < count; i += 2)
+    {
+      const unsigned char header = *block++;
+      for (vtkIdType j = i; j < std::min(i + 2, count); ++j)
+      {
+        const int numberOfBytes = (header >> (4 * (j - i))) & 0xf;
+        Bits residual = 0;
+        for (int b = numberOfBytes - 1; b >= 0; --b)
+        {
+          residual = static_cast<Bits>(static_cast<Bits>(residual << 8) | block[b]);
+        }
+        block += numberOfBytes;
+        Bits& last = previous[j % numberOfComponents];
+        last = Restore(residual, last, IsFloat());
+        values[j] = FromBits(last);
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------
+// Copy the values of an array, in AOS order, with the backend value type.
+template <typename ValueType>
+struct CopyValuesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, std::vector<ValueType>& values)
+  {
+    const auto range = vtk::DataArrayValueRange(array);
+    values.resize(range.size());
+    auto output = values.begin();
+    for (const auto value : range)
+    {
+      *output++ = static_cast<ValueType>(value);
+    }
+  }
+};
+VTK_ABI_NAMESPACE_END
+} // namespace vtkCompressedImplicitBackendDetail
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkCompressedImplicitBackend<ValueType>::Internals
+{
+  using CodecType = vtkCompressedImplicitBackendDetail::Codec<ValueType>;
+
+  struct CachedBlock
+  {
+    vtkIdType Block = -1;
+    std::vector<ValueType> Values;
+    std::uint64_t LastUse = 0;
+  };
+
+  // Decompressed blocks of one thread
+  struct BlockCache
+  {
+    BlockCache(int numberOfBlocks = 1)
+      : Blocks(numberOfBlocks)
+    {
+    }
+    std::vector<CachedBlock> Blocks;
+    std::uint64_t Clock = 0;
+  };
+
+  Internals(vtkDataArray* array, vtkIdType blockSize, int numberOfCachedBlocks)
+    : Caches(BlockCache(std::max(numberOfCachedBlocks, 1)))
+  {
+    if (!array)
+    {
+      vtkErrorWithObjectMacro(nullptr, "Cannot compress a nullptr array");
+      this->Offsets.push_back(0);
+      return;
+    }
+    // Blocks start on a tuple so that every value is predicted by the same component.
+    this->NumberOfComponents = std::max(array->GetNumberOfComponents(), 1);
+    this->BlockSize = std::max<vtkIdType>(blockSize / this->NumberOfComponents, 1);
+    this->BlockSize *= this->NumberOfComponents;
+
+    std::vector<ValueType> values;
+    vtkCompressedImplicitBackendDetail::CopyValuesWorker<ValueType> worker;
+    if (!vtkArrayDispatch::Dispatch::Execute(array, worker, values))
+    {
+      worker(array, values);
+    }
+    this->NumberOfValues = static_cast<vtkIdType>(values.size());
+
+    // Blocks are compressed independently, in parallel.
+    const vtkIdType numberOfBlocks = (this->NumberOfValues + this->BlockSize - 1) / this->BlockSize;
+    std::vector<std::vector<unsigned char>> blocks(numberOfBlocks);
+    vtkSMPTools::For(0, numberOfBlocks,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType block = begin; block < end; ++block)
+        {
+          const vtkIdType first = block * this->BlockSize;
+          CodecType::Encode(values.data() + first, this->GetBlockLength(block),
+            this->NumberOfComponents, blocks[block]);
+        }
+      });
+    values = std::vector<ValueType>();
+
+    this->Offsets.reserve(numberOfBlocks + 1);
+    this->Offsets.push_back(0);
+    for (const auto& block : blocks)
+    {
+      this->Offsets.push_back(this->Offsets.back() + block.size());
+    }
+    this->Data.reserve(this->Offsets.back());
+    for (auto& block : blocks)
+    {
+      this->Data.insert(this->Data.end(), block.begin(), block.end());
+      block = std::vector<unsigned char>();
+    }
+  }
+
+  vtkIdType GetBlockLength(vtkIdType block) const
+  {
+    return std::min(this->BlockSize, this->NumberOfValues - block * this->BlockSize);
+  }
+
+  // Return the decompressed values of block from the cache of the calling thread.
+  const ValueType* GetBlock(BlockCache& cache, vtkIdType block)
+  {
+    CachedBlock* leastRecent = &cache.Blocks[0];
+    for (auto& cached : cache.Blocks)
+    {
+      if (cached.Block == block)
+      {
+        cached.LastUse = ++cache.Clock;
+        return cached.Values.data();
+      }
+      if (cached.LastUse < leastRecent->LastUse)
+      {
+        leastRecent = &cached;
+      }
+    }
+    leastRecent->Block = block;
+    leastRecent->LastUse = ++cache.Clock;
+    const vtkIdType length = this->GetBlockLength(block);
+    leastRecent->Values.resize(length);
+    CodecType::Decode(this->Data.data() + this->Offsets[block], length, this->NumberOfComponents,
+      leastRecent->Values.data());
+    return leastRecent->Values.data();
+  }
+
+  ValueType GetValue(BlockCache& cache, vtkIdType idx)
+  {
+    const vtkIdType block = idx / this->BlockSize;
+    return this->GetBlock(cache, block)[idx - block * this->BlockSize];
+  }
+
+  vtkIdType BlockSize = 1;
+  vtkIdType NumberOfValues = 0;
+  int NumberOfComponents = 1;
+  std::vector<unsigned char> Data;
+  std::vector<std::size_t> Offsets;
+
+  // The compressed values are never modified, so each thread decompresses
+  // blocks into its own cache without any locking.
+  vtkSMPThreadLocal<BlockCache> Caches;
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::vtkCompressedImplicitBackend(
+  vtkDataArray* array, vtkIdType blockSize, int numberOfCachedBlocks)
+  : Internal(std::unique_ptr<Internals>(new Internals(array, blockSize, numberOfCachedBlocks)))
+{
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::~vtkCompressedImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkCompressedImplicitBackend<ValueType>::operator()(vtkIdType idx) const
+{
+  return this->Internal->GetValue(this->Internal->Caches.Local(), idx);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkCompressedImplicitBackend<ValueType>::mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+{
+  const int numComps = this->Internal->NumberOfComponents;
+  auto& cache = this->Internal->Caches.Local();
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    tuple[comp] = this->Internal->GetValue(cache, tupleIdx * numComps + comp);
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkCompressedImplicitBackend<ValueType>::getMemorySize() const
+{
+  std::size_t bytes = this->GetCompressedSize();
+  for (const auto& cache : this->Internal->Caches)
+  {
+    for (const auto& cached : cache.Blocks)
+    {
+      bytes += cached.Values.capacity() * sizeof(ValueType);
+    }
+  }
+  return static_cast<unsigned long>(std::ceil(bytes / 1024.0));
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+std::size_t vtkCompressedImplicitBackend<ValueType>::GetCompressedSize() const
+{
+  return this->Internal->Data.size() + this->Internal->Offsets.size() * sizeof(std::size_t);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+std::size_t vtkCompressedImplicitBackend<ValueType>::GetUncompressedSize() const
+{
+  return static_cast<std::size_t>(this->Internal->NumberOfValues) * sizeof(ValueType);
+}
+VTK_ABI_NAMESPACE_END
@@ -116,6 +116,24 @@ void vtkDataArray::ShallowCopy(vtkDataArray* other)
   this->DeepCopy(other);
 }
 
+//------------------------------------------------------------------------------
+void vtkDataArray::LazyDeepCopy(vtkDataArray* other)
+{
+  // Deep copy by default. Subclasses may override this behavior.
+  this->DeepCopy(other);
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArray::DeepCopyLookupTable(vtkDataArray* other)
+{
+  this->SetLookupTable(nullptr);
+  if (other->LookupTable)
+  {
+    this->LookupTable = other->LookupTable->NewInstance();
+    this->LookupTable->DeepCopy(other->LookupTable);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkDataArray::SetTuple(vtkIdType i, const float* source)
 {
@@ -309,6 +309,19 @@ public:
    */
   virtual void ShallowCopy(vtkDataArray* other);
 
+  /**
+   * Deep copy of data that defers copying the values until one of the arrays
+   * is modified. Until then both arrays share the same memory, and the array
+   * being written to gets a private copy of the values first. Unlike
+   * ShallowCopy(), modifying one array never changes the other. Pointers
+   * obtained from either array before the copy must not be used to modify it
+   * afterwards. Every non-const accessor of either array, including
+   * GetPointer(), GetVoidPointer() and value/tuple ranges, copies the values
+   * first if they are still shared. Arrays that do not support copy-on-write,
+   * and arrays of different types, are deep copied right away.
+   */
+  virtual void LazyDeepCopy(vtkDataArray* other);
+
   /**
    * Fill a component of a data array with a specified value. This method
    * sets the specified component to specified value for all tuples in the
@@ -693,6 +706,10 @@ protected:
     double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff);
   ///@}
 
+  // Replace the lookup table by a deep copy of the one of other, if any.
+  // Used by LazyDeepCopy() implementations.
+  void DeepCopyLookupTable(vtkDataArray* other);
+
   // Construct object with default tuple dimension (number of components) of 1.
   vtkDataArray();
   ~vtkDataArray() override;
@@ -16,7 +16,9 @@
 #include <algorithm>
 #include <array>
 #include <cassert> // for assert()
+#include <cmath>
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace vtkDataArrayPrivate
@@ -76,12 +78,16 @@ template <typename T>
 struct has_infinity<T, true>
 {
   static bool isinf(T x) { return std::isinf(x); }
+  // Written as a comparison so that loops using it can be vectorized. False
+  // for NaN too.
+  static bool isfinite(T x) { return std::abs(x) <= std::numeric_limits<T>::max(); }
 };
 
 template <typename T>
 struct has_infinity<T, false>
 {
   static bool isinf(T) { return false; }
+  static bool isfinite(T) { return true; }
 };
 
 template <typename T>
@@ -90,6 +96,187 @@ bool isinf(T x)
   // Select the correct partially specialized type.
   return has_infinity<T, std::numeric_limits<T>::has_infinity>::isinf(x);
 }
+
+template <typename T>
+bool isfinite(T x)
+{
+  return has_infinity<T, std::numeric_limits<T>::has_infinity>::isfinite(x);
+}
+}
+
+// Kernels for arrays whose values are contiguous in memory (AOS arrays) when
+// there are no ghosts to skip. The values are processed in blocks of
+// KernelLanes tuples, every lane of a block having its own accumulators, so
+// that the loops do not carry any dependency and get vectorized by the
+// compiler for the instruction set the library is built for. Comparisons are
+// written so that NaN values are ignored without a test of their own, like
+// vtkMathUtilities::UpdateRange().
+namespace detail
+{
+constexpr int KernelLanes = 16;
+
+// Tell whether a value contributes to the range.
+template <typename T>
+bool KeepValue(T, AllValues)
+{
+  return true;
+}
+
+template <typename T>
+bool KeepValue(T value, FiniteValues)
+{
+  return detail::isfinite(value);
+}
+
+// Update range, holding NumComps (min, max) pairs, with numTuples tuples of
+// values.
+template <int NumComps, typename T, typename Tag>
+void MinAndMaxKernel(const T* values, vtkIdType numTuples, T* range, Tag tag)
+{
+  constexpr int Width = NumComps * KernelLanes;
+  T mins[Width];
+  T maxs[Width];
+  for (int l = 0; l < Width; ++l)
+  {
+    mins[l] = range[2 * (l % NumComps)];
+    maxs[l] = range[2 * (l % NumComps) + 1];
+  }
+
+  const T* blocksEnd = values + (numTuples / KernelLanes) * Width;
+  for (; values != blocksEnd; values += Width)
+  {
+    for (int l = 0; l < Width; ++l)
+    {
+      const T value = values[l];
+      const bool keep = KeepValue(value, tag);
+      mins[l] = (keep && value < mins[l]) ? value : mins[l];
+      maxs[l] = (keep && value > maxs[l]) ? value : maxs[l];
+    }
+  }
+  for (int l = 0; l < Width; ++l)
+  {
+    const int j = 2 * (l % NumComps);
+    range[j] = detail::min(range[j], mins[l]);
+    range[j + 1] = detail::max(range[j + 1], maxs[l]);
+  }
+
+  // Remaining tuples.
+  const T* end = values + (numTuples % KernelLanes) * NumComps;
+  for (; values != end; values += NumComps)
+  {
+    for (int c = 0; c < NumComps; ++c)
+    {
+      const T value = values[c];
+      if (KeepValue(value, tag))
+      {
+        range[2 * c] = value < range[2 * c] ? value : range[2 * c];
+        range[2 * c + 1] = value > range[2 * c + 1] ? value : range[2 * c + 1];
+      }
+    }
+  }
+}
+
+// Update range, a (min, max) pair, with the squared norms of numTuples tuples
+// of numComps values.
+template <typename T, typename Tag>
+void SquaredNormMinAndMaxKernel(
+  const T* values, int numComps, vtkIdType numTuples, double* range, Tag tag)
+{
+  double mins[KernelLanes];
+  double maxs[KernelLanes];
+  double norms[KernelLanes];
+  for (int l = 0; l < KernelLanes; ++l)
+  {
+    mins[l] = range[0];
+    maxs[l] = range[1];
+  }
+
+  const vtkIdType blockSize = static_cast<vtkIdType>(KernelLanes) * numComps;
+  const T* blocksEnd = values + (numTuples / KernelLanes) * blockSize;
+  for (; values != blocksEnd; values += blockSize)
+  {
+    for (int l = 0; l < KernelLanes; ++l)
+    {
+      const T* tuple = values + l * numComps;
+      double squaredSum = 0.0;
+      for (int c = 0; c < numComps; ++c)
+      {
+        squaredSum += static_cast<double>(tuple[c]) * static_cast<double>(tuple[c]);
+      }
+      norms[l] = squaredSum;
+    }
+    for (int l = 0; l < KernelLanes; ++l)
+    {
+      const double norm = norms[l];
+      const bool keep = KeepValue(norm, tag);
+      mins[l] = (keep && norm < mins[l]) ? norm : mins[l];
+      maxs[l] = (keep && norm > maxs[l]) ? norm : maxs[l];
+    }
+  }
+  for (int l = 0; l < KernelLanes; ++l)
+  {
+    range[0] = detail::min(range[0], mins[l]);
+    range[1] = detail::max(range[1], maxs[l]);
+  }
+
+  // Remaining tuples.
+  const T* end = values + (numTuples % KernelLanes) * numComps;
+  for (; values != end; values += numComps)
+  {
+    double squaredSum = 0.0;
+    for (int c = 0; c < numComps; ++c)
+    {
+      squaredSum += static_cast<double>(values[c]) * static_cast<double>(values[c]);
+    }
+    if (KeepValue(squaredSum, tag))
+    {
+      range[0] = squaredSum < range[0] ? squaredSum : range[0];
+      range[1] = squaredSum > range[1] ? squaredSum : range[1];
+    }
+  }
+}
+
+// Compute the range of the tuples [begin, end) of array with the kernels above
+// if its values are contiguous, return false otherwise.
+template <int NumComps, typename ArrayT, typename APIType, typename Tag>
+bool ContiguousMinAndMax(ArrayT*, vtkIdType, vtkIdType, APIType*, Tag, std::false_type)
+{
+  return false;
+}
+
+template <int NumComps, typename ArrayT, typename APIType, typename Tag>
+bool ContiguousMinAndMax(
+  ArrayT* array, vtkIdType begin, vtkIdType end, APIType* range, Tag tag, std::true_type)
+{
+  // Const range: reading the values must not trigger a copy-on-write.
+  const auto values = vtk::DataArrayValueRange<NumComps>(array, begin * NumComps, end * NumComps);
+  MinAndMaxKernel<NumComps>(values.begin(), end - begin, range, tag);
+  return true;
+}
+
+template <typename ArrayT, typename Tag>
+bool ContiguousSquaredNormMinAndMax(ArrayT*, vtkIdType, vtkIdType, double*, Tag, std::false_type)
+{
+  return false;
+}
+
+template <typename ArrayT, typename Tag>
+bool ContiguousSquaredNormMinAndMax(
+  ArrayT* array, vtkIdType begin, vtkIdType end, double* range, Tag tag, std::true_type)
+{
+  const int numComps = array->GetNumberOfComponents();
+  const auto values = vtk::DataArrayValueRange(array, begin * numComps, end * numComps);
+  SquaredNormMinAndMaxKernel(values.begin(), numComps, end - begin, range, tag);
+  return true;
+}
+
+// Whether the kernels above can be used for ArrayT, accumulating in APIType.
+template <typename ArrayT, typename APIType>
+using UseContiguousKernel = std::integral_constant<bool,
+  vtk::IsAOSDataArray<ArrayT>::value && std::is_same<APIType, vtk::GetAPIType<ArrayT>>::value>;
+
+template <typename ArrayT>
+using UseContiguousNormKernel = vtk::IsAOSDataArray<ArrayT>;
 }
 
 template <typename APIType, int NumComps>
@@ -162,8 +349,14 @@ public:
   void Reduce() { MinAndMaxT::Reduce(); }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
+    if (!this->Ghosts &&
+      detail::ContiguousMinAndMax<NumComps>(this->Array, begin, end, range.data(), AllValues(),
+        detail::UseContiguousKernel<ArrayT, APIType>()))
+    {
+      return;
+    }
+    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     const unsigned char* ghostIt = this->Ghosts ? this->Ghosts + begin : nullptr;
     for (const auto tuple : tuples)
     {
@@ -203,8 +396,14 @@ public:
   void Reduce() { MinAndMaxT::Reduce(); }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
+    if (!this->Ghosts &&
+      detail::ContiguousMinAndMax<NumComps>(this->Array, begin, end, range.data(), FiniteValues(),
+        detail::UseContiguousKernel<ArrayT, APIType>()))
+    {
+      return;
+    }
+    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     const unsigned char* ghostIt = this->Ghosts ? this->Ghosts + begin : nullptr;
     for (const auto tuple : tuples)
     {
@@ -257,8 +456,14 @@ public:
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
+    if (!this->Ghosts &&
+      detail::ContiguousSquaredNormMinAndMax(this->Array, begin, end, range.data(), AllValues(),
+        detail::UseContiguousNormKernel<ArrayT>()))
+    {
+      return;
+    }
+    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
     const unsigned char* ghostIt = this->Ghosts ? this->Ghosts + begin : nullptr;
     for (const auto tuple : tuples)
     {
@@ -309,8 +514,14 @@ public:
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
+    if (!this->Ghosts &&
+      detail::ContiguousSquaredNormMinAndMax(this->Array, begin, end, range.data(), FiniteValues(),
+        detail::UseContiguousNormKernel<ArrayT>()))
+    {
+      return;
+    }
+    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
     const unsigned char* ghostIt = this->Ghosts ? this->Ghosts + begin : nullptr;
     for (const auto tuple : tuples)
     {
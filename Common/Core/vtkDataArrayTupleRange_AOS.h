@@ -961,13 +961,13 @@ public:
   VTK_ITER_INLINE
   iterator begin() noexcept
   {
-    return iterator(this->GetTuplePointer(this->BeginTuple), this->NumComps);
+    return iterator(this->GetWritableTuplePointer(this->BeginTuple), this->NumComps);
   }
 
   VTK_ITER_INLINE
   iterator end() noexcept
   {
-    return iterator(this->GetTuplePointer(this->EndTuple), this->NumComps);
+    return iterator(this->GetWritableTuplePointer(this->EndTuple), this->NumComps);
   }
 
   VTK_ITER_INLINE
@@ -997,9 +997,7 @@ public:
   VTK_ITER_INLINE
   reference operator[](size_type i) noexcept
   {
-    return reference{ this->Array->Buffer->GetBuffer() +
-        (this->BeginTuple + i) * this->NumComps.value,
-      this->NumComps };
+    return reference{ this->GetWritableTuplePointer(this->BeginTuple + i), this->NumComps };
   }
 
   VTK_ITER_INLINE
@@ -1034,8 +1032,7 @@ public:
 
   VTK_ITER_INLINE void SetTuple(size_type i, const ValueType* tuple) noexcept
   {
-    ValueType* tuplePtr =
-      this->Array->Buffer->GetBuffer() + (this->BeginTuple + i) * this->NumComps.value;
+    ValueType* tuplePtr = this->GetWritableTuplePointer(this->BeginTuple + i);
     for (ComponentIdType c = 0; c < this->NumComps.value; ++c)
     {
       tuplePtr[c] = tuple[c];
@@ -1046,8 +1043,7 @@ public:
   typename std::enable_if<!std::is_same<VT, double>::value>::type VTK_ITER_INLINE SetTuple(
     size_type i, const double* tuple) noexcept
   {
-    ValueType* tuplePtr =
-      this->Array->Buffer->GetBuffer() + (this->BeginTuple + i) * this->NumComps.value;
+    ValueType* tuplePtr = this->GetWritableTuplePointer(this->BeginTuple + i);
     for (ComponentIdType c = 0; c < this->NumComps.value; ++c)
     {
       tuplePtr[c] = static_cast<ValueType>(tuple[c]);
@@ -1061,10 +1057,18 @@ private:
     return this->Array->Buffer->GetBuffer() + (tuple * this->NumComps.value);
   }
 
+  // Copy the data first if the array shares it copy-on-write with another array.
+  VTK_ITER_INLINE
+  ValueType* GetWritableTuplePointer(vtkIdType tuple) noexcept
+  {
+    return this->Array->Buffer->GetWritableBuffer() + (tuple * this->NumComps.value);
+  }
+
   VTK_ITER_INLINE
   TupleIdType GetTupleId(const ValueType* ptr) const noexcept
   {
-    return static_cast<TupleIdType>((ptr - this->Array->GetPointer(0)) / this->NumComps.value);
+    return static_cast<TupleIdType>(
+      (ptr - this->Array->Buffer->GetBuffer()) / this->NumComps.value);
   }
 
   mutable ArrayType* Array{ nullptr };
@@ -79,13 +79,8 @@ public:
   VTK_ITER_INLINE
   ValueRange GetSubRange(ValueIdType beginValue = 0, ValueIdType endValue = -1) const noexcept
   {
-    const ValueIdType realBegin =
-      std::distance(this->Array->GetPointer(0), this->Array->GetPointer(this->BeginValue)) +
-      beginValue;
-    const ValueIdType realEnd = endValue >= 0
-      ? std::distance(this->Array->GetPointer(0), this->Array->GetPointer(this->BeginValue)) +
-        endValue
-      : std::distance(this->Array->GetPointer(0), this->Array->GetPointer(this->EndValue));
+    const ValueIdType realBegin = this->BeginValue + beginValue;
+    const ValueIdType realEnd = endValue >= 0 ? this->BeginValue + endValue : this->EndValue;
 
     return ValueRange<ArrayType, TupleSize, ForceValueTypeForVtkDataArray>{ this->Array, realBegin,
       realEnd };
@@ -100,22 +95,19 @@ public:
   VTK_ITER_INLINE
   ValueIdType GetBeginValueId() const noexcept
   {
-    return static_cast<ValueIdType>(
-      this->Array->GetPointer(this->BeginValue) - this->Array->GetPointer(0));
+    return this->BeginValue;
   }
 
   VTK_ITER_INLINE
   ValueIdType GetEndValueId() const noexcept
   {
-    return static_cast<ValueIdType>(
-      this->Array->GetPointer(this->EndValue) - this->Array->GetPointer(0));
+    return this->EndValue;
   }
 
   VTK_ITER_INLINE
   size_type size() const noexcept
   {
-    return static_cast<size_type>(
-      this->Array->GetPointer(this->EndValue) - this->Array->GetPointer(this->BeginValue));
+    return static_cast<size_type>(this->EndValue - this->BeginValue);
   }
 
   VTK_ITER_INLINE
@@ -124,19 +116,31 @@ public:
   iterator end() noexcept { return this->Array->GetPointer(this->EndValue); }
 
   VTK_ITER_INLINE
-  const_iterator begin() const noexcept { return this->Array->GetPointer(this->BeginValue); }
+  const_iterator begin() const noexcept
+  {
+    return this->Array->Buffer->GetBuffer() + this->BeginValue;
+  }
   VTK_ITER_INLINE
-  const_iterator end() const noexcept { return this->Array->GetPointer(this->EndValue); }
+  const_iterator end() const noexcept
+  {
+    return this->Array->Buffer->GetBuffer() + this->EndValue;
+  }
 
   VTK_ITER_INLINE
-  const_iterator cbegin() const noexcept { return this->Array->GetPointer(this->BeginValue); }
+  const_iterator cbegin() const noexcept
+  {
+    return this->Array->Buffer->GetBuffer() + this->BeginValue;
+  }
   VTK_ITER_INLINE
-  const_iterator cend() const noexcept { return this->Array->GetPointer(this->EndValue); }
+  const_iterator cend() const noexcept
+  {
+    return this->Array->Buffer->GetBuffer() + this->EndValue;
+  }
 
   VTK_ITER_INLINE
   reference operator[](size_type i) noexcept
   {
-    return this->Array->Buffer->GetBuffer()[this->BeginValue + i];
+    return this->Array->Buffer->GetWritableBuffer()[this->BeginValue + i];
   }
   VTK_ITER_INLINE
   const_reference operator[](size_type i) const noexcept
@@ -145,7 +149,7 @@ public:
   }
 
   // Danger! pointer is non-const!
-  value_type* data() noexcept { return this->Array->Buffer->GetBuffer(); }
+  value_type* data() noexcept { return this->Array->Buffer->GetWritableBuffer(); }
 
   value_type* data() const noexcept { return this->Array->Buffer->GetBuffer(); }
 
@@ -16,7 +16,7 @@ namespace
 template <typename ValueType>
 struct threadedCopyFunctor
 {
-  ValueType* src;
+  const ValueType* src;
   ValueType* dst;
   int nComp;
   void operator()(vtkIdType begin, vtkIdType end) const
@@ -34,16 +34,19 @@ struct DeepCopyWorker
   void operator()(
     vtkAOSDataArrayTemplate<ValueType>* src, vtkAOSDataArrayTemplate<ValueType>* dst) const
   {
+    // Read the source through a const range: it does not copy values shared by
+    // LazyDeepCopy().
+    const auto srcRange = vtk::DataArrayValueRange(src);
     vtkIdType len = src->GetNumberOfTuples();
     if (len < 1024 * 1024)
     {
       // With less than a megabyte or so threading is likely to hurt performance. so don't
-      std::copy(src->Begin(), src->End(), dst->Begin());
+      std::copy(srcRange.cbegin(), srcRange.cend(), dst->Begin());
     }
     else
     {
       threadedCopyFunctor<ValueType> worker;
-      worker.src = src->GetPointer(0);
+      worker.src = srcRange.data();
       worker.dst = dst->GetPointer(0);
       worker.nComp = src->GetNumberOfComponents();
       // High granularity is likely to hurt performance too, so limit calls. 16 is about maximal.
@@ -507,6 +507,8 @@ struct vtkAffineImplicitBackend;
 template <typename ValueType>
 class vtkCompositeImplicitBackend;
 template <typename ValueType>
+class vtkCompressedImplicitBackend;
+template <typename ValueType>
 struct vtkConstantImplicitBackend;
 template <typename ValueType>
 class vtkStructuredPointBackend;
@@ -556,6 +558,8 @@ struct vtkAffineImplicitBackend;
 template <typename ValueType>
 class vtkCompositeImplicitBackend;
 template <typename ValueType>
+class vtkCompressedImplicitBackend;
+template <typename ValueType>
 struct vtkConstantImplicitBackend;
 template <typename ValueType>
 class vtkStructuredPointBackend;
@@ -623,6 +627,7 @@ VTK_ABI_NAMESPACE_BEGIN
 VTK_DECLARE_VALUERANGE_IMPLICIT_BACKENDTYPE(vtkAffineImplicitBackend)
 VTK_DECLARE_VALUERANGE_IMPLICIT_BACKENDTYPE(vtkConstantImplicitBackend)
 VTK_DECLARE_VALUERANGE_IMPLICIT_BACKENDTYPE(vtkCompositeImplicitBackend)
+VTK_DECLARE_VALUERANGE_IMPLICIT_BACKENDTYPE(vtkCompressedImplicitBackend)
 VTK_DECLARE_VALUERANGE_IMPLICIT_BACKENDTYPE(vtkStructuredPointBackend)
 VTK_DECLARE_VALUERANGE_IMPLICIT_BACKENDTYPE(vtkIndexedImplicitBackend)
 
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMemoryMap.h"
+
+#include "vtkObject.h" // For vtkGenericWarningMacro
+
+#include <map>   // For std::map
+#include <mutex> // For std::mutex
+
+#if defined(_WIN32)
+#include "vtkWindows.h"
+#include <vtksys/Encoding.hxx>
+#define VTK_MEMORY_MAP_WIN32
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VTK_MEMORY_MAP_POSIX
+#endif
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Mapping functions work on whole pages: keep the start of the view and its
+// length for every pointer handed out so that Unmap() can release it.
+struct MappedRegion
+{
+  void* Base;
+  std::size_t Length;
+  int Mode;
+};
+
+struct MappedRegions
+{
+  std::mutex Mutex;
+  std::map<const void*, MappedRegion> Regions;
+};
+
+MappedRegions& GetMappedRegions()
+{
+  static MappedRegions regions;
+  return regions;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 GetMappingGranularity()
+{
+#if defined(VTK_MEMORY_MAP_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<vtkTypeInt64>(info.dwAllocationGranularity);
+#elif defined(VTK_MEMORY_MAP_POSIX)
+  return static_cast<vtkTypeInt64>(sysconf(_SC_PAGESIZE));
+#else
+  return 1;
+#endif
+}
+}
+
+//------------------------------------------------------------------------------
+void* vtkMemoryMap::Map(
+  const char* fileName, vtkTypeInt64 offset, std::size_t numberOfBytes, int mode)
+{
+  if (!fileName || offset < 0 || numberOfBytes == 0)
+  {
+    vtkGenericWarningMacro("Invalid memory map request for file "
+      << (fileName ? fileName : "(null)") << " at offset " << offset << " (" << numberOfBytes
+      << " bytes).");
+    return nullptr;
+  }
+  if (mode != READ_ONLY && mode != COPY_ON_WRITE && mode != READ_WRITE)
+  {
+    vtkGenericWarningMacro("Invalid memory map mode " << mode << ".");
+    return nullptr;
+  }
+
+  const vtkTypeInt64 granularity = GetMappingGranularity();
+  const vtkTypeInt64 alignedOffset = offset - offset % granularity;
+  const std::size_t padding = static_cast<std::size_t>(offset - alignedOffset);
+  const std::size_t length = numberOfBytes + padding;
+  void* base = nullptr;
+
+#if defined(VTK_MEMORY_MAP_POSIX)
+  const int fd = open(fileName, mode == READ_WRITE ? O_RDWR : O_RDONLY);
+  if (fd < 0)
+  {
+    vtkGenericWarningMacro("Cannot open " << fileName << " for memory mapping.");
+    return nullptr;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+    static_cast<vtkTypeInt64>(info.st_size) < offset + static_cast<vtkTypeInt64>(numberOfBytes))
+  {
+    vtkGenericWarningMacro("Cannot map " << numberOfBytes << " bytes at offset " << offset
+                                         << ": " << fileName << " is too small.");
+    close(fd);
+    return nullptr;
+  }
+  const int protection = mode == READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+  const int flags = mode == READ_WRITE ? MAP_SHARED : MAP_PRIVATE;
+  base = mmap(nullptr, length, protection, flags, fd, static_cast<off_t>(alignedOffset));
+  // The mapping keeps its own reference to the file.
+  close(fd);
+  if (base == MAP_FAILED)
+  {
+    vtkGenericWarningMacro("Memory mapping of " << fileName << " failed.");
+    return nullptr;
+  }
+#elif defined(VTK_MEMORY_MAP_WIN32)
+  const std::wstring wideFileName = vtksys::Encoding::ToWide(fileName);
+  const DWORD access = mode == READ_WRITE ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+  HANDLE file = CreateFileW(wideFileName.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE,
+    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    vtkGenericWarningMacro("Cannot open " << fileName << " for memory mapping.");
+    return nullptr;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+    fileSize.QuadPart < offset + static_cast<vtkTypeInt64>(numberOfBytes))
+  {
+    vtkGenericWarningMacro("Cannot map " << numberOfBytes << " bytes at offset " << offset
+                                         << ": " << fileName << " is too small.");
+    CloseHandle(file);
+    return nullptr;
+  }
+  const DWORD protection = mode == READ_ONLY ? PAGE_READONLY
+    : mode == COPY_ON_WRITE                  ? PAGE_WRITECOPY
+                                             : PAGE_READWRITE;
+  HANDLE mapping = CreateFileMappingW(file, nullptr, protection, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    vtkGenericWarningMacro("Memory mapping of " << fileName << " failed.");
+    return nullptr;
+  }
+  const DWORD viewAccess = mode == READ_ONLY ? FILE_MAP_READ
+    : mode == COPY_ON_WRITE                  ? FILE_MAP_COPY
+                                             : FILE_MAP_WRITE;
+  base = MapViewOfFile(mapping, viewAccess, static_cast<DWORD>(alignedOffset >> 32),
+    static_cast<DWORD>(alignedOffset & 0xFFFFFFFF), length);
+  // The view keeps its own reference to the mapping object.
+  CloseHandle(mapping);
+  if (!base)
+  {
+    vtkGenericWarningMacro("Memory mapping of " << fileName << " failed.");
+    return nullptr;
+  }
+#else
+  (void)length;
+  vtkGenericWarningMacro("Memory mapping is not supported on this platform.");
+  return nullptr;
+#endif
+
+  void* pointer = static_cast<char*>(base) + padding;
+  MappedRegions& mapped = GetMappedRegions();
+  std::lock_guard<std::mutex> lock(mapped.Mutex);
+  mapped.Regions[pointer] = MappedRegion{ base, length, mode };
+  return pointer;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryMap::Unmap(void* pointer)
+{
+  if (!pointer)
+  {
+    return;
+  }
+
+  MappedRegion region;
+  {
+    MappedRegions& mapped = GetMappedRegions();
+    std::lock_guard<std::mutex> lock(mapped.Mutex);
+    auto it = mapped.Regions.find(pointer);
+    if (it == mapped.Regions.end())
+    {
+      return;
+    }
+    region = it->second;
+    mapped.Regions.erase(it);
+  }
+
+#if defined(VTK_MEMORY_MAP_POSIX)
+  munmap(region.Base, region.Length);
+#elif defined(VTK_MEMORY_MAP_WIN32)
+  UnmapViewOfFile(region.Base);
+#else
+  (void)region;
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMap::IsMapped(const void* pointer)
+{
+  return vtkMemoryMap::GetMode(pointer) >= 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryMap::GetMode(const void* pointer)
+{
+  MappedRegions& mapped = GetMappedRegions();
+  std::lock_guard<std::mutex> lock(mapped.Mutex);
+  auto it = mapped.Regions.find(pointer);
+  return it != mapped.Regions.end() ? it->second.Mode : -1;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMap::IsSupported()
+{
+#if defined(VTK_MEMORY_MAP_POSIX) || defined(VTK_MEMORY_MAP_WIN32)
+  return true;
+#else
+  return false;
+#endif
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkMemoryMap
+ * @brief   map regions of a file in memory to back a vtkBuffer.
+ *
+ * vtkMemoryMap is a small set of static functions used by vtkBuffer to hand out
+ * memory that is backed by a file instead of the heap (`mmap` on POSIX systems,
+ * `MapViewOfFile` on Windows). Pages are only read from the file when they are
+ * first accessed, so mapping a large dataset is cheap and only the parts that are
+ * actually used end up in memory.
+ *
+ * The pointer returned by `Map()` points to the first requested byte, even when
+ * the offset in the file is not aligned on a page boundary, and has to be released
+ * with `Unmap()`. `Unmap()` matches the vtkFreeingFunction signature so that it
+ * can be used as the free function of a vtkBuffer.
+ *
+ * Three modes are supported:
+ * - READ_ONLY: the pages are mapped read-only. Writing to the memory is a
+ *   protection fault, which guarantees that nobody modifies data shared with other
+ *   arrays or processes.
+ * - COPY_ON_WRITE: the pages are private to the mapping. They can be modified,
+ *   modified pages are copied on first write and the file is never changed.
+ * - READ_WRITE: the pages are shared with the file, modifications are written
+ *   back to it.
+ *
+ * This is an internal class, use vtkAOSDataArrayTemplate::MapFile() or
+ * vtkSOADataArrayTemplate::MapComponentFile() to create file-backed arrays.
+ *
+ * @sa
+ * vtkBuffer vtkAOSDataArrayTemplate vtkSOADataArrayTemplate
+ */
+
+#ifndef vtkMemoryMap_h
+#define vtkMemoryMap_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkType.h"             // For vtkTypeInt64
+
+#include <cstddef> // For std::size_t
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT vtkMemoryMap
+{
+public:
+  enum ModeType
+  {
+    READ_ONLY = 0,
+    COPY_ON_WRITE = 1,
+    READ_WRITE = 2
+  };
+
+  /**
+   * Map @a numberOfBytes bytes of @a fileName starting at byte @a offset. Returns
+   * nullptr and prints a warning if the file cannot be opened, if the requested
+   * region goes past the end of the file or if the mapping fails. A region of size
+   * 0 cannot be mapped.
+   */
+  static void* Map(
+    const char* fileName, vtkTypeInt64 offset, std::size_t numberOfBytes, int mode = READ_ONLY);
+
+  /**
+   * Release a region returned by Map(). Does nothing if @a pointer is nullptr or
+   * was not returned by Map().
+   */
+  static void Unmap(void* pointer);
+
+  /**
+   * Return true if @a pointer has been returned by Map() and has not been
+   * released yet.
+   */
+  static bool IsMapped(const void* pointer);
+
+  /**
+   * Return the mode @a pointer has been mapped with, or -1 if it is not mapped.
+   */
+  static int GetMode(const void* pointer);
+
+  /**
+   * Return true if memory mapping is supported on this platform.
+   */
+  static bool IsSupported();
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
+// VTK-HeaderTest-Exclude: vtkMemoryMap.h
@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPoolArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#include <map>    // For std::map
+#include <mutex>  // For std::mutex
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+constexpr std::size_t MinimumSizeClass = 256;
+}
+
+//------------------------------------------------------------------------------
+class vtkPoolArrayAllocator::vtkInternals
+{
+public:
+  std::mutex Mutex;
+  std::map<std::size_t, std::vector<void*>> FreeBlocks;
+  std::size_t CachedSize = 0;
+};
+
+vtkStandardNewMacro(vtkPoolArrayAllocator);
+
+//------------------------------------------------------------------------------
+vtkPoolArrayAllocator::vtkPoolArrayAllocator()
+  : MaximumCachedSize(1024 * 1024 * 1024)
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkPoolArrayAllocator::~vtkPoolArrayAllocator()
+{
+  this->ReleaseCachedMemory();
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkPoolArrayAllocator::GetSizeClass(std::size_t size)
+{
+  if (size <= MinimumSizeClass)
+  {
+    return MinimumSizeClass;
+  }
+  // Find the power of two such that base < size <= 2 * base, then round up to a
+  // quarter of it.
+  std::size_t base = MinimumSizeClass;
+  while (base <= (size - 1) / 2)
+  {
+    base *= 2;
+  }
+  const std::size_t step = base / 4;
+  return base + (size - base + step - 1) / step * step;
+}
+
+//------------------------------------------------------------------------------
+void* vtkPoolArrayAllocator::Allocate(std::size_t size)
+{
+  if (size == 0)
+  {
+    return nullptr;
+  }
+
+  const std::size_t sizeClass = vtkPoolArrayAllocator::GetSizeClass(size);
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    auto it = this->Internals->FreeBlocks.find(sizeClass);
+    if (it != this->Internals->FreeBlocks.end() && !it->second.empty())
+    {
+      void* pointer = it->second.back();
+      it->second.pop_back();
+      this->Internals->CachedSize -= sizeClass;
+      return pointer;
+    }
+  }
+  return this->AllocateBlock(sizeClass);
+}
+
+//------------------------------------------------------------------------------
+void* vtkPoolArrayAllocator::Reallocate(void* pointer, std::size_t oldSize, std::size_t newSize)
+{
+  if (pointer && newSize > 0 &&
+    vtkPoolArrayAllocator::GetSizeClass(oldSize) == vtkPoolArrayAllocator::GetSizeClass(newSize))
+  {
+    return pointer;
+  }
+  return this->Superclass::Reallocate(pointer, oldSize, newSize);
+}
+
+//------------------------------------------------------------------------------
+void vtkPoolArrayAllocator::Free(void* pointer, std::size_t size)
+{
+  if (!pointer)
+  {
+    return;
+  }
+
+  const std::size_t sizeClass = vtkPoolArrayAllocator::GetSizeClass(size);
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    if (this->Internals->CachedSize + sizeClass <= this->MaximumCachedSize)
+    {
+      this->Internals->FreeBlocks[sizeClass].push_back(pointer);
+      this->Internals->CachedSize += sizeClass;
+      return;
+    }
+  }
+  this->FreeBlock(pointer);
+}
+
+//------------------------------------------------------------------------------
+void vtkPoolArrayAllocator::SetAlignment(std::size_t alignment)
+{
+  const std::size_t previous = this->Alignment;
+  this->Superclass::SetAlignment(alignment);
+  if (this->Alignment != previous)
+  {
+    this->ReleaseCachedMemory();
+  }
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkPoolArrayAllocator::GetCachedSize()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->CachedSize;
+}
+
+//------------------------------------------------------------------------------
+void vtkPoolArrayAllocator::ReleaseCachedMemory()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  for (const auto& freeBlocks : this->Internals->FreeBlocks)
+  {
+    for (void* pointer : freeBlocks.second)
+    {
+      this->FreeBlock(pointer);
+    }
+  }
+  this->Internals->FreeBlocks.clear();
+  this->Internals->CachedSize = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkPoolArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumCachedSize: " << this->MaximumCachedSize << "\n";
+  os << indent << "CachedSize: " << this->GetCachedSize() << "\n";
+}
+VTK_ABI_NAMESPACE_END
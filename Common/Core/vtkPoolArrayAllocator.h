@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPoolArrayAllocator
+ * @brief   array allocator recycling released allocations by size class.
+ *
+ * vtkPoolArrayAllocator rounds every allocation up to a size class and keeps
+ * the released allocations in a free list per size class instead of giving them
+ * back to the system. The next allocation of the same class reuses a cached
+ * block. There are four size classes per power of two, so that at most 20% of an
+ * allocation is wasted. Resizing within the same size class does not move the
+ * data.
+ *
+ * Unlike vtkArenaArrayAllocator, the allocations can be released in any order
+ * and memory can be reused while other allocations are alive. The amount of
+ * cached memory is bounded by MaximumCachedSize, the blocks released past this
+ * limit are given back to the system.
+ *
+ * @sa
+ * vtkArrayAllocator vtkArenaArrayAllocator
+ */
+
+#ifndef vtkPoolArrayAllocator_h
+#define vtkPoolArrayAllocator_h
+
+#include "vtkArrayAllocator.h"
+#include "vtkCommonCoreModule.h" // For export macro
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT vtkPoolArrayAllocator : public vtkArrayAllocator
+{
+public:
+  static vtkPoolArrayAllocator* New();
+  vtkTypeMacro(vtkPoolArrayAllocator, vtkArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void* Allocate(std::size_t size) override;
+  void* Reallocate(void* pointer, std::size_t oldSize, std::size_t newSize) override;
+  void Free(void* pointer, std::size_t size) override;
+
+  /**
+   * Changing the alignment releases the cached blocks.
+   */
+  void SetAlignment(std::size_t alignment) override;
+
+  ///@{
+  /**
+   * Maximum size in bytes of the released blocks kept for reuse. Default is
+   * 1 GiB.
+   */
+  vtkSetMacro(MaximumCachedSize, std::size_t);
+  vtkGetMacro(MaximumCachedSize, std::size_t);
+  ///@}
+
+  /**
+   * Size in bytes of the size class an allocation of @a size bytes belongs to.
+   */
+  static std::size_t GetSizeClass(std::size_t size);
+
+  /**
+   * Total size in bytes of the released blocks kept for reuse.
+   */
+  std::size_t GetCachedSize();
+
+  /**
+   * Give the cached blocks back to the system.
+   */
+  void ReleaseCachedMemory();
+
+protected:
+  vtkPoolArrayAllocator();
+  ~vtkPoolArrayAllocator() override;
+
+  std::size_t MaximumCachedSize;
+
+private:
+  vtkPoolArrayAllocator(const vtkPoolArrayAllocator&) = delete;
+  void operator=(const vtkPoolArrayAllocator&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
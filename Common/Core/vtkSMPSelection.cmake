@@ -127,8 +127,14 @@ endif()
 
 set(vtk_smp_common_dir SMP/Common)
 list(APPEND vtk_smp_sources
+  "${vtk_smp_common_dir}/vtkSMPInstrumentation.cxx"
+  "${vtk_smp_common_dir}/vtkSMPTaskGraph.cxx"
+  "${vtk_smp_common_dir}/vtkSMPThreadAffinity.cxx"
   "${vtk_smp_common_dir}/vtkSMPToolsAPI.cxx")
 list(APPEND vtk_smp_nowrap_headers
+  "${vtk_smp_common_dir}/vtkSMPInstrumentation.h"
+  "${vtk_smp_common_dir}/vtkSMPTaskGraph.h"
+  "${vtk_smp_common_dir}/vtkSMPThreadAffinity.h"
   "${vtk_smp_common_dir}/vtkSMPThreadLocalAPI.h"
   "${vtk_smp_common_dir}/vtkSMPThreadLocalImplAbstract.h"
   "${vtk_smp_common_dir}/vtkSMPToolsAPI.h"
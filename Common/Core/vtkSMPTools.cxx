@@ -3,8 +3,14 @@
 
 #include "vtkSMPTools.h"
 
+#include "SMP/Common/vtkSMPTaskGraph.h"
+#include "vtkBuffer.h"
 #include "vtkSMP.h"
 
+#include <cstring>   // For std::memset
+#include <exception> // For std::exception_ptr
+#include <utility>   // For std::move
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 const char* vtkSMPTools::GetBackend()
@@ -55,6 +61,90 @@ bool vtkSMPTools::GetNestedParallelism()
   return SMPToolsAPI.GetNestedParallelism();
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetAdaptiveScheduling(bool adaptive)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetAdaptiveScheduling(adaptive);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetAdaptiveScheduling()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetAdaptiveScheduling();
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::SetThreadAffinity(const char* affinity)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.SetThreadAffinity(affinity);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPTools::GetThreadAffinity()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetThreadAffinity();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetFirstTouchAllocation(bool firstTouch)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetFirstTouchAllocation(firstTouch);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetFirstTouchAllocation()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetFirstTouchAllocation();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetInstrumentation(bool enable)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.GetInstrumentation().SetEnabled(enable);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetInstrumentation()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetInstrumentation().IsEnabled();
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkSMPTools::InstrumentationRecord> vtkSMPTools::GetInstrumentationRecords()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetInstrumentation().GetRecords();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::ClearInstrumentationRecords()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.GetInstrumentation().ClearRecords();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetMaximumNumberOfInstrumentationRecords(std::size_t maximum)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.GetInstrumentation().SetMaximumNumberOfRecords(maximum);
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkSMPTools::GetMaximumNumberOfInstrumentationRecords()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetInstrumentation().GetMaximumNumberOfRecords();
+}
+
 //------------------------------------------------------------------------------
 bool vtkSMPTools::IsParallelScope()
 {
@@ -68,4 +158,90 @@ bool vtkSMPTools::GetSingleThread()
   auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
   return SMPToolsAPI.GetSingleThread();
 }
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGraph::TaskGraph()
+  : Internals(new vtk::detail::smp::vtkSMPTaskGraph)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGraph::~TaskGraph() = default;
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGraph::TaskId vtkSMPTools::TaskGraph::AddTask(std::function<void()> task)
+{
+  return this->Internals->AddTask(std::move(task));
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::TaskGraph::DependsOn(TaskId task, TaskId dependency)
+{
+  if (!this->Internals->AddDependency(task, dependency))
+  {
+    vtkGenericWarningMacro("Invalid dependency " << dependency << " -> " << task
+                                                 << " in vtkSMPTools::TaskGraph.");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkSMPTools::TaskGraph::GetNumberOfTasks() const
+{
+  return this->Internals->GetNumberOfTasks();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::TaskGraph::Wait()
+{
+  auto& graph = *this->Internals;
+  if (graph.GetNumberOfTasks() > 0 && graph.Prepare())
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.RunTaskGraph(graph);
+  }
+
+  std::exception_ptr exception = graph.GetException();
+  graph.Clear();
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+VTK_ABI_NAMESPACE_END
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkSMPToolsFirstTouch(void* buffer, std::size_t numberOfBytes)
+{
+  // Small allocations are usually recycled by malloc and their pages already touched.
+  static constexpr std::size_t MinimumNumberOfBytes = 1 << 20;
+
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  if (!buffer || numberOfBytes < MinimumNumberOfBytes ||
+    !SMPToolsAPI.GetFirstTouchAllocation() ||
+    SMPToolsAPI.GetBackendType() == BackendType::Sequential || SMPToolsAPI.IsParallelScope())
+  {
+    return;
+  }
+
+  // Split the bytes the same way a later vtkSMPTools::For over the items of the buffer would, so
+  // that each range is touched by the thread most likely to process it.
+  unsigned char* bytes = static_cast<unsigned char*>(buffer);
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(numberOfBytes), [bytes](vtkIdType begin, vtkIdType end) {
+      std::memset(bytes + begin, 0, static_cast<std::size_t>(end - begin));
+    });
+}
+
 VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -24,8 +24,15 @@
 #include "SMP/Common/vtkSMPToolsAPI.h"
 #include "vtkSMPThreadLocal.h" // For Initialized
 
-#include <functional>  // For std::function
-#include <type_traits> // For std:::enable_if
+#include <algorithm>        // For std::min
+#include <cstddef>          // For std::size_t
+#include <functional>       // For std::function
+#include <initializer_list> // For std::initializer_list
+#include <iterator>         // For std::iterator_traits
+#include <memory>           // For std::shared_ptr, std::unique_ptr
+#include <type_traits>      // For std:::enable_if
+#include <utility>          // For std::forward
+#include <vector>           // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -124,6 +131,21 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
   vtkSMPTools_FunctorInternal(const vtkSMPTools_FunctorInternal<Functor, true>&);
 };
 
+template <typename FunctorInternal>
+struct vtkSMPTools_FunctorReduce;
+
+template <typename Functor, bool Init>
+struct vtkSMPTools_FunctorReduce<vtkSMPTools_FunctorInternal<Functor, Init>>
+{
+  static void Reduce(Functor&) {}
+};
+
+template <typename Functor>
+struct vtkSMPTools_FunctorReduce<vtkSMPTools_FunctorInternal<Functor, true>>
+{
+  static void Reduce(Functor& f) { f.Reduce(); }
+};
+
 template <typename Functor>
 class vtkSMPTools_Lookup_For
 {
@@ -142,6 +164,26 @@ public:
   typedef vtkSMPTools_FunctorInternal<Functor const, init> type;
 };
 
+// Functor storage used by vtkSMPTools::TaskGraph::SpawnFor: lvalue functors are referenced,
+// temporaries are moved in since the tasks outlive the SpawnFor call.
+template <typename Functor>
+struct vtkSMPTools_TaskFunctor
+{
+  using FunctorInternal =
+    typename vtkSMPTools_Lookup_For<typename std::remove_reference<Functor>::type>::type;
+
+  Functor F;
+  FunctorInternal Internal;
+
+  vtkSMPTools_TaskFunctor(Functor&& f)
+    : F(std::forward<Functor>(f))
+    , Internal(this->F)
+  {
+  }
+  void Execute(vtkIdType first, vtkIdType last) { this->Internal.Execute(first, last); }
+  void Reduce() { vtkSMPTools_FunctorReduce<FunctorInternal>::Reduce(this->F); }
+};
+
 template <typename Iterator, typename Functor, bool Init>
 struct vtkSMPTools_RangeFunctor;
 
@@ -207,6 +249,8 @@ public:
 
 template <typename T>
 using resolvedNotInt = typename std::enable_if<!std::is_integral<T>::value, void>::type;
+
+class vtkSMPTaskGraph;
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
@@ -437,6 +481,115 @@ public:
    */
   static bool GetNestedParallelism();
 
+  /**
+   * /!\ This method is not thread safe.
+   * If true, vtkSMPTools::For calls without an explicit grain (grain <= 0) use an adaptive
+   * schedule instead of splitting the range in fixed-size chunks: each thread claims a chunk of
+   * half the remaining range divided by the number of threads, so chunks shrink toward the end
+   * of the loop and no thread sits idle while another finishes a large chunk. The first chunks
+   * are timed so that later chunks are never too small to amortize the scheduling cost. This
+   * is meant for irregular work, where the cost of an item varies a lot (clipping, contouring,
+   * ...). STDThread, OpenMP and TBB use the same partitioner, Sequential ignores the setting.
+   * It can also be enabled with the VTK_SMP_ADAPTIVE_SCHEDULING environment variable.
+   * Default is false.
+   */
+  static void SetAdaptiveScheduling(bool adaptive);
+
+  /**
+   * Get true if the adaptive scheduling is enabled, see SetAdaptiveScheduling().
+   */
+  static bool GetAdaptiveScheduling();
+
+  /**
+   * /!\ This method is not thread safe.
+   * Bind the threads used by the backend to processors, so that a thread keeps accessing the
+   * memory of the NUMA node it runs on. Valid values are:
+   *    - "none": threads are not bound (default),
+   *    - "compact": thread i is bound to the i-th available processor, filling a NUMA node
+   *      before using the next one,
+   *    - "scatter": consecutive threads are bound to different NUMA nodes,
+   *    - a list of processors such as "0-7,16-23": thread i is bound to the i-th processor of
+   *      the list.
+   * Only the STDThread backend binds its threads, on Linux and Windows. OpenMP users should
+   * rely on OMP_PROC_BIND and OMP_PLACES instead.
+   * The affinity can also be set with the VTK_SMP_THREAD_AFFINITY environment variable.
+   * Returns false, and keeps the current affinity, if the value is not valid.
+   */
+  static bool SetThreadAffinity(const char* affinity);
+
+  /**
+   * Get the thread affinity in use, see SetThreadAffinity().
+   */
+  static const char* GetThreadAffinity();
+
+  /**
+   * /!\ This method is not thread safe.
+   * If true, large vtkBuffer allocations (used by vtkAOSDataArrayTemplate and
+   * vtkSOADataArrayTemplate) are zeroed in parallel with vtkSMPTools::For right after being
+   * allocated. Operating systems place a memory page on the NUMA node of the thread that first
+   * writes to it, so the pages end up close to the threads that will later process the same
+   * range. This is mostly useful combined with SetThreadAffinity().
+   * Default is false.
+   */
+  static void SetFirstTouchAllocation(bool firstTouch);
+
+  /**
+   * Get true if the parallel first touch allocation is enabled.
+   */
+  static bool GetFirstTouchAllocation();
+
+  /**
+   * Scheduling statistics of a vtkSMPTools::For call or of a TaskGraph::Wait call, see
+   * SetInstrumentation(). Members are:
+   *    - Name: the demangled type of the functor, or "vtkSMPTools::TaskGraph",
+   *    - Backend: the backend that executed the call,
+   *    - First, Last and Grain: the arguments of the call (Last is the number of tasks for a
+   *      task graph),
+   *    - WallTime: the duration of the call, in seconds,
+   *    - NumberOfChunks: the number of sub-ranges (or tasks) executed,
+   *    - NumberOfSteals: the number of tasks stolen by the STDThread and Sequential task graph
+   *      scheduler, 0 otherwise,
+   *    - Threads: busy time and number of chunks of each participating thread.
+   * GetImbalance() returns the ratio between the busiest thread and the average (1 is perfect)
+   * and GetIdleTime() the time the threads spent waiting for the slowest one.
+   */
+  using InstrumentationRecord = vtk::detail::smp::vtkSMPInstrumentationRecord;
+
+  /**
+   * /!\ This method is not thread safe.
+   * If true, every vtkSMPTools::For and TaskGraph::Wait call measures the time spent in each
+   * chunk and by each thread. A summary of each call is logged with vtkLogger at the TRACE
+   * verbosity and the last records can be retrieved with GetInstrumentationRecords(). This is
+   * meant to tune grain sizes and find badly balanced loops, it adds a lock and two clock reads
+   * per chunk. It can also be enabled with the VTK_SMP_INSTRUMENTATION environment variable.
+   * Default is false.
+   */
+  static void SetInstrumentation(bool enable);
+
+  /**
+   * Get true if the instrumentation is enabled, see SetInstrumentation().
+   */
+  static bool GetInstrumentation();
+
+  /**
+   * Get the records of the last instrumented calls, oldest first. At most
+   * `GetMaximumNumberOfInstrumentationRecords()` records are kept.
+   */
+  static std::vector<InstrumentationRecord> GetInstrumentationRecords();
+
+  /**
+   * Remove all the instrumentation records.
+   */
+  static void ClearInstrumentationRecords();
+
+  ///@{
+  /**
+   * Set/Get the number of instrumentation records kept, default is 1000.
+   */
+  static void SetMaximumNumberOfInstrumentationRecords(std::size_t maximum);
+  static std::size_t GetMaximumNumberOfInstrumentationRecords();
+  ///@}
+
   /**
    * Return true if it is called from a parallel scope.
    */
@@ -454,12 +607,22 @@ public:
    *    - MaxNumberOfThreads set the maximum number of threads.
    *    - Backend set a specific SMPTools backend.
    *    - NestedParallelism, if true enable nested parallelism.
+   *    - ThreadAffinity set the thread affinity, see SetThreadAffinity().
+   *    - FirstTouchAllocation, see SetFirstTouchAllocation().
+   *    - AdaptiveScheduling, see SetAdaptiveScheduling().
+   * ThreadAffinity, FirstTouchAllocation and AdaptiveScheduling default to the current values.
    */
   struct Config
   {
     int MaxNumberOfThreads = 0;
     std::string Backend = vtk::detail::smp::vtkSMPToolsAPI::GetInstance().GetBackend();
     bool NestedParallelism = false;
+    std::string ThreadAffinity =
+      vtk::detail::smp::vtkSMPToolsAPI::GetInstance().GetThreadAffinity();
+    bool FirstTouchAllocation =
+      vtk::detail::smp::vtkSMPToolsAPI::GetInstance().GetFirstTouchAllocation();
+    bool AdaptiveScheduling =
+      vtk::detail::smp::vtkSMPToolsAPI::GetInstance().GetAdaptiveScheduling();
 
     Config() = default;
     Config(int maxNumberOfThreads)
@@ -485,6 +648,9 @@ public:
       : MaxNumberOfThreads(API.GetInternalDesiredNumberOfThread())
       , Backend(API.GetBackend())
       , NestedParallelism(API.GetNestedParallelism())
+      , ThreadAffinity(API.GetThreadAffinity())
+      , FirstTouchAllocation(API.GetFirstTouchAllocation())
+      , AdaptiveScheduling(API.GetAdaptiveScheduling())
     {
     }
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -623,6 +789,275 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  ///@{
+  /**
+   * A convenience method for reducing data in parallel. It is a drop in replacement for
+   * std::reduce(): the values of the range are combined with `op` (std::plus by default),
+   * starting with `init`. The operator must be associative, but it does not need to be
+   * commutative since partial results are always combined in the order of the range.
+   *
+   * Usage example:
+   * \code
+   * const auto range = vtk::DataArrayValueRange<1>(array);
+   * double max = vtkSMPTools::Reduce(range.cbegin(), range.cend(), VTK_DOUBLE_MIN,
+   *   [](double a, double b) { return std::max(a, b); });
+   * \endcode
+   */
+  template <typename InputIt, typename T>
+  static T Reduce(InputIt begin, InputIt end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+
+  template <typename InputIt, typename T, typename BinaryOp>
+  static T Reduce(InputIt begin, InputIt end, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Reduce(begin, end, init, op);
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method computing prefix sums in parallel. It is a drop in replacement for
+   * std::inclusive_scan(): the i-th output is the reduction of the first i+1 input values
+   * (preceded by `init` if provided) with `op` (std::plus by default). The output range may
+   * be the input range. Returns the end of the output range.
+   *
+   * The STDThread and OpenMP backends use a two-pass algorithm (per-block reduction, serial
+   * scan of the block results, per-block scan), TBB uses tbb::parallel_scan. Random access
+   * iterators are recommended since each block has to std::advance to its beginning.
+   */
+  template <typename InputIt, typename OutputIt>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    return vtkSMPTools::InclusiveScan(begin, end, outBegin, std::plus<T>());
+  }
+
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.template Scan<true>(
+      begin, end, outBegin, static_cast<const T*>(nullptr), op);
+  }
+
+  template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+  static OutputIt InclusiveScan(
+    InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op, T init)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.template Scan<true>(begin, end, outBegin, &init, op);
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method computing exclusive prefix sums in parallel. It is a drop in
+   * replacement for std::exclusive_scan(): the i-th output is the reduction of `init` and
+   * the first i input values with `op` (std::plus by default). This is the usual way to turn
+   * per-item counts into offsets. The output range may be the input range. Returns the end of
+   * the output range.
+   *
+   * Usage example:
+   * \code
+   * // counts has one more item than the number of cells, the last one being 0
+   * vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets.begin(), vtkIdType(0));
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename T>
+  static OutputIt ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, outBegin, init, std::plus<T>());
+  }
+
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static OutputIt ExclusiveScan(
+    InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.template Scan<false>(begin, end, outBegin, &init, op);
+  }
+  ///@}
+
+  /**
+   * A convenience method for stream compaction. It is a drop in replacement for
+   * std::copy_if(): the values for which `pred` returns true are copied, in order, to the
+   * output range. Returns the end of the output range. The predicate may be evaluated more
+   * than once per value (once to count, once to copy) so it must not have side effects.
+   *
+   * Usage example:
+   * \code
+   * std::vector<vtkIdType> kept(numCells);
+   * auto keptEnd = vtkSMPTools::CopyIf(cellIds.begin(), cellIds.end(), kept.begin(),
+   *   [&](vtkIdType cellId) { return scalars[cellId] > threshold; });
+   * kept.erase(keptEnd, kept.end());
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename UnaryPredicate>
+  static OutputIt CopyIf(InputIt begin, InputIt end, OutputIt outBegin, UnaryPredicate pred)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.CopyIf(begin, end, outBegin, pred);
+  }
+
+  /**
+   * A graph of tasks with dependencies, executed by the backend in use.
+   *
+   * Filters made of dependent phases (count, prefix sum, fill...) usually run one
+   * vtkSMPTools::For per phase, with a full fork/join barrier in between. A TaskGraph
+   * describes the phases as tasks and the dependencies between them so that the backend
+   * starts a task as soon as the tasks it depends on are done, and so that independent
+   * work (e.g. different blocks of a composite dataset) overlaps.
+   *
+   * Tasks are added with Spawn() (a single callable) or SpawnFor() (a range split into
+   * chunks, as vtkSMPTools::For would do). Both return a TaskId that can be given as a
+   * dependency to tasks spawned afterwards, or used with DependsOn(). Nothing is executed
+   * until Wait() is called; Wait() blocks until every task is done, then clears the graph so
+   * that it can be filled again. If a task throws, the tasks that did not start yet are skipped
+   * and the first exception is rethrown by Wait().
+   *
+   * Each backend schedules ready tasks with its own mechanism: a work-stealing scheduler on
+   * top of the thread pool for STDThread, `omp task` for OpenMP, a `tbb::task_group` for TBB
+   * and a plain topological traversal for Sequential.
+   *
+   * Usage example:
+   * \code
+   * vtkSMPTools::TaskGraph graph;
+   * auto count = graph.SpawnFor(0, numCells, countWorker);
+   * auto offsets = graph.Spawn([&]() { ComputeOffsets(); }, { count });
+   * graph.SpawnFor(0, numCells, fillWorker, { offsets });
+   * graph.Spawn([&]() { ProcessOtherBlock(); }); // runs concurrently with the phases above
+   * graph.Wait();
+   * \endcode
+   *
+   * Functors, lambdas and the data they reference must stay alive until Wait() returns.
+   * Tasks must not spawn new tasks into the graph that executes them.
+   */
+  class VTKCOMMONCORE_EXPORT TaskGraph
+  {
+  public:
+    using TaskId = std::size_t;
+
+    TaskGraph();
+    ~TaskGraph();
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /**
+     * Add a task executing `task()`. The task starts once all the given dependencies are done.
+     */
+    template <typename T>
+    TaskId Spawn(T&& task, std::initializer_list<TaskId> dependencies = {})
+    {
+      const TaskId id = this->AddTask(std::function<void()>(std::forward<T>(task)));
+      for (TaskId dependency : dependencies)
+      {
+        this->DependsOn(id, dependency);
+      }
+      return id;
+    }
+
+    ///@{
+    /**
+     * Add the equivalent of a vtkSMPTools::For: the range is split in chunks of `grain` items
+     * (estimated from the number of threads if `grain` is not positive), each chunk being a
+     * task. Initialize() and Reduce() of the functor are honored as in vtkSMPTools::For. The
+     * returned task is done once every chunk (and Reduce()) is done.
+     *
+     * Functors given as lvalues are referenced, as in vtkSMPTools::For, temporaries (e.g.
+     * lambdas) are moved into the graph.
+     */
+    template <typename Functor>
+    TaskId SpawnFor(vtkIdType first, vtkIdType last, vtkIdType grain, Functor&& f,
+      std::initializer_list<TaskId> dependencies = {})
+    {
+      return this->SpawnChunks(first, last, grain, std::forward<Functor>(f), dependencies);
+    }
+
+    template <typename Functor>
+    TaskId SpawnFor(
+      vtkIdType first, vtkIdType last, Functor&& f, std::initializer_list<TaskId> dependencies = {})
+    {
+      return this->SpawnChunks(first, last, 0, std::forward<Functor>(f), dependencies);
+    }
+    ///@}
+
+    /**
+     * Make `task` wait for `dependency`. Returns false if one of the ids is invalid.
+     */
+    bool DependsOn(TaskId task, TaskId dependency);
+
+    /**
+     * Get the number of tasks spawned since the last Wait().
+     */
+    std::size_t GetNumberOfTasks() const;
+
+    /**
+     * Execute the graph and block until every task is done. The graph is empty afterwards.
+     * Nothing is executed (and a warning is emitted) if the dependencies contain a cycle.
+     */
+    void Wait();
+
+  private:
+    TaskId AddTask(std::function<void()> task);
+
+    template <typename Functor>
+    TaskId SpawnChunks(vtkIdType first, vtkIdType last, vtkIdType grain, Functor&& f,
+      std::initializer_list<TaskId> dependencies)
+    {
+      const vtkIdType n = last - first;
+      if (n <= 0)
+      {
+        return this->Spawn([]() {}, dependencies);
+      }
+      if (grain <= 0)
+      {
+        const vtkIdType estimateGrain = n / (vtkSMPTools::GetEstimatedNumberOfThreads() * 4);
+        grain = (estimateGrain > 0) ? estimateGrain : 1;
+      }
+
+      // The task functor holds the thread local "initialized" flags, it is shared by all the
+      // chunks and released with the last task referencing it.
+      auto tf = std::make_shared<vtk::detail::smp::vtkSMPTools_TaskFunctor<Functor>>(
+        std::forward<Functor>(f));
+      std::vector<TaskId> chunks;
+      chunks.reserve(static_cast<std::size_t>((n + grain - 1) / grain));
+
+      // With several chunks, a no-op gate task avoids adding every dependency to every chunk.
+      const bool useGate = dependencies.size() > 0 && grain < n;
+      const TaskId gate = useGate ? this->Spawn([]() {}, dependencies) : 0;
+      for (vtkIdType from = first; from < last; from += grain)
+      {
+        const vtkIdType to = (std::min)(from + grain, last);
+        const TaskId chunk = this->Spawn([tf, from, to]() { tf->Execute(from, to); });
+        if (useGate)
+        {
+          this->DependsOn(chunk, gate);
+        }
+        else
+        {
+          for (TaskId dependency : dependencies)
+          {
+            this->DependsOn(chunk, dependency);
+          }
+        }
+        chunks.push_back(chunk);
+      }
+
+      const TaskId join = this->Spawn([tf]() { tf->Reduce(); });
+      for (TaskId chunk : chunks)
+      {
+        this->DependsOn(join, chunk);
+      }
+      return join;
+    }
+
+    std::unique_ptr<vtk::detail::smp::vtkSMPTaskGraph> Internals;
+  };
 };
 
 VTK_ABI_NAMESPACE_END
@@ -179,6 +179,28 @@ public:
    **/
   void SetArrayFreeFunction(int comp, void (*callback)(void*));
 
+  /**
+   * Back component @a comp with @a size values mapped from @a fileName, starting
+   * at byte @a offset, instead of copying them in memory. The values are
+   * expected with the array value type and native byte order. @a updateMaxId
+   * has the same meaning as in SetArray(). @a mode is one of
+   * vtkMemoryMap::ModeType, see vtkAOSDataArrayTemplate::MapFile().
+   *
+   * Returns false, and leaves the component empty, if the file cannot be mapped.
+   */
+  bool MapComponentFile(int comp, const char* fileName, vtkTypeInt64 offset, vtkIdType size,
+    bool updateMaxId = false, int mode = vtkMemoryMap::READ_ONLY);
+
+  ///@{
+  /**
+   * Set the allocator providing the memory of the components of this array from now on. nullptr
+   * restores vtkArrayAllocator::GetDefaultAllocator(). Memory that has already
+   * been allocated is released by the allocator that provided it.
+   */
+  void SetAllocator(vtkArrayAllocator* allocator);
+  vtkArrayAllocator* GetAllocator();
+  ///@}
+
   /**
    * Return a pointer to a contiguous block of memory containing all values for
    * a particular components (ie. a single array of the struct-of-arrays).
@@ -267,6 +289,10 @@ protected:
 
   void ClearSOAData();
 
+  // Create a buffer using the allocator of this array.
+  vtkBuffer<ValueType>* NewBuffer();
+  vtkSmartPointer<vtkArrayAllocator> Allocator;
+
 private:
   vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate&) = delete;
   void operator=(const vtkSOADataArrayTemplate&) = delete;
@@ -53,8 +53,41 @@ template <class ValueType>
 vtkSOADataArrayTemplate<ValueType>::vtkSOADataArrayTemplate()
   : AoSData(nullptr)
   , StorageType(StorageTypeEnum::AOS)
+  , Allocator(vtkArrayAllocator::GetDefaultAllocator())
 {
-  this->AoSData = vtkBuffer<ValueType>::New();
+  this->AoSData = this->NewBuffer();
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueType>
+vtkBuffer<typename vtkSOADataArrayTemplate<ValueType>::ValueType>*
+vtkSOADataArrayTemplate<ValueType>::NewBuffer()
+{
+  vtkBuffer<ValueType>* buffer = vtkBuffer<ValueType>::New();
+  buffer->SetAllocator(this->Allocator);
+  return buffer;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueType>
+void vtkSOADataArrayTemplate<ValueType>::SetAllocator(vtkArrayAllocator* allocator)
+{
+  this->Allocator = allocator ? allocator : vtkArrayAllocator::GetDefaultAllocator();
+  for (vtkBuffer<ValueType>* buffer : this->Data)
+  {
+    buffer->SetAllocator(this->Allocator);
+  }
+  if (this->AoSData)
+  {
+    this->AoSData->SetAllocator(this->Allocator);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueType>
+vtkArrayAllocator* vtkSOADataArrayTemplate<ValueType>::GetAllocator()
+{
+  return this->Allocator;
 }
 
 //-----------------------------------------------------------------------------
@@ -85,7 +118,7 @@ void vtkSOADataArrayTemplate<ValueType>::SetNumberOfComponents(int val)
     }
     while (this->Data.size() < numComps)
     {
-      this->Data.push_back(vtkBuffer<ValueType>::New());
+      this->Data.push_back(this->NewBuffer());
     }
   }
 }
@@ -263,7 +296,7 @@ void vtkSOADataArrayTemplate<ValueType>::SetArray(
 
   while (this->Data.size() < static_cast<size_t>(numComps))
   {
-    this->Data.push_back(vtkBuffer<ValueType>::New());
+    this->Data.push_back(this->NewBuffer());
   }
 
   this->Data[comp]->SetBuffer(array, size);
@@ -295,6 +328,45 @@ void vtkSOADataArrayTemplate<ValueType>::SetArray(
   this->DataChanged();
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueType>
+bool vtkSOADataArrayTemplate<ValueType>::MapComponentFile(int comp, const char* fileName,
+  vtkTypeInt64 offset, vtkIdType size, bool updateMaxId, int mode)
+{
+  const int numComps = this->GetNumberOfComponents();
+  if (comp >= numComps || comp < 0)
+  {
+    vtkErrorMacro("Invalid component number '"
+      << comp
+      << "' specified. "
+         "Use `SetNumberOfComponents` first to set the number of components.");
+    return false;
+  }
+
+  if (this->StorageType == StorageTypeEnum::AOS && this->AoSData)
+  {
+    this->AoSData->Delete();
+    this->AoSData = nullptr;
+  }
+
+  while (this->Data.size() < static_cast<size_t>(numComps))
+  {
+    this->Data.push_back(this->NewBuffer());
+  }
+
+  const bool mapped = this->Data[comp]->MapFile(fileName, offset, size, mode);
+
+  if (updateMaxId)
+  {
+    this->Size = numComps * this->Data[comp]->GetSize();
+    this->MaxId = this->Size - 1;
+  }
+  this->StorageType = StorageTypeEnum::SOA;
+
+  this->DataChanged();
+  return mapped;
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueType>
 void vtkSOADataArrayTemplate<ValueType>::SetArrayFreeFunction(void (*callback)(void*))
@@ -420,7 +492,7 @@ void* vtkSOADataArrayTemplate<ValueType>::GetVoidPointer(vtkIdType valueIdx)
 
     if (!this->AoSData)
     {
-      this->AoSData = vtkBuffer<ValueType>::New();
+      this->AoSData = this->NewBuffer();
     }
 
     if (!this->AoSData->Allocate(static_cast<vtkIdType>(numValues)))
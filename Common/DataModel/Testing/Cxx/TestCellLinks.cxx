@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded build of editable cell links matches the serial one,
+// and that the links can still be edited afterwards.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool SameLinks(vtkCellLinks* links, vtkCellLinks* expected, vtkIdType begin, vtkIdType end)
+{
+  for (vtkIdType ptId = begin; ptId < end; ++ptId)
+  {
+    const vtkIdType ncells = links->GetNcells(ptId);
+    if (ncells != expected->GetNcells(ptId))
+    {
+      std::cerr << "Point " << ptId << ": " << ncells << " cells instead of "
+                << expected->GetNcells(ptId) << "\n";
+      return false;
+    }
+    for (vtkIdType i = 0; i < ncells; ++i)
+    {
+      if (links->GetCells(ptId)[i] != expected->GetCells(ptId)[i])
+      {
+        std::cerr << "Point " << ptId << ": wrong cell " << links->GetCells(ptId)[i] << "\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCellLinks(int, char*[])
+{
+  // Random triangles and lines, some points being unused
+  const vtkIdType numPts = 1000;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    points->SetPoint(ptId, ptId, 0, 0);
+  }
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  auto randomPoint = [&random]() -> vtkIdType {
+    random->Next();
+    return static_cast<vtkIdType>(random->GetRangeValue(0, numPts - 100));
+  };
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> lines;
+  for (int i = 0; i < 5000; ++i)
+  {
+    const vtkIdType triangle[3] = { randomPoint(), randomPoint(), randomPoint() };
+    polys->InsertNextCell(3, triangle);
+    if (i % 5 == 0)
+    {
+      const vtkIdType line[2] = { randomPoint(), randomPoint() };
+      lines->InsertNextCell(2, line);
+    }
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+  polyData->SetLines(lines);
+
+  vtkNew<vtkCellLinks> expected;
+  expected->SetDataSet(polyData);
+  expected->SequentialProcessingOn();
+  expected->BuildLinks();
+
+  vtkSMPTools::SetBackend("STDThread");
+  vtkSMPTools::Initialize(4);
+  vtkNew<vtkCellLinks> links;
+  links->SetDataSet(polyData);
+  links->BuildLinks();
+  if (!SameLinks(links, expected, 0, numPts))
+  {
+    std::cerr << "Threaded links differ from serial links\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkCellLinks> copy;
+  copy->SetDataSet(polyData);
+  copy->DeepCopy(links);
+  if (!SameLinks(copy, expected, 0, numPts))
+  {
+    std::cerr << "Deep copied links differ\n";
+    return EXIT_FAILURE;
+  }
+
+  // Edit pooled lists: grow one, shrink one, delete one, and add a new point
+  const vtkIdType cellId = polyData->GetNumberOfCells();
+  vtkIdType ncells = links->GetNcells(0);
+  links->ResizeCellList(0, 1);
+  links->AddCellReference(cellId, 0);
+  if (links->GetNcells(0) != ncells + 1 || links->GetCells(0)[ncells] != cellId)
+  {
+    std::cerr << "Failed to add a cell reference\n";
+    return EXIT_FAILURE;
+  }
+  ncells = links->GetNcells(1);
+  if (ncells > 0)
+  {
+    links->RemoveCellReference(links->GetCells(1)[0], 1);
+    if (links->GetNcells(1) != ncells - 1)
+    {
+      std::cerr << "Failed to remove a cell reference\n";
+      return EXIT_FAILURE;
+    }
+  }
+  links->DeletePoint(2);
+  const vtkIdType ptId = links->InsertNextPoint(1);
+  links->InsertNextCellReference(ptId, cellId);
+  if (ptId != numPts || links->GetNcells(ptId) != 1 || links->GetNcells(2) != 0)
+  {
+    std::cerr << "Failed to edit the links\n";
+    return EXIT_FAILURE;
+  }
+
+  // Shallow copies share the links, which are released with the last one
+  vtkNew<vtkCellLinks> shallowCopy;
+  shallowCopy->SetDataSet(polyData);
+  shallowCopy->ShallowCopy(links);
+  links->Initialize();
+  if (shallowCopy->GetNcells(0) != expected->GetNcells(0) + 1 ||
+    !SameLinks(shallowCopy, expected, 3, numPts))
+  {
+    std::cerr << "Shallow copied links differ\n";
+    return EXIT_FAILURE;
+  }
+
+  // Rebuild after the dataset changed
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  polys->InsertNextCell(3, triangle);
+  polyData->SetPolys(polys);
+  polyData->Modified();
+  links->BuildLinks();
+  expected->BuildLinks();
+  if (!SameLinks(links, expected, 0, numPts))
+  {
+    std::cerr << "Rebuilt links differ\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTestErrorObserver.h"
+
+#include <random>
+#include <string>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool TestLocator(vtkDataSet* ds, vtkAbstractCellLocator* loc, bool testClosestPoints)
+{
+  std::cout << "Testing " << loc->GetClassName() << std::endl;
+  loc->SetDataSet(ds);
+
+  // Random queries, some outside of the data set.
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(-1.0, 11.0);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkPoints> ends;
+  points->SetDataTypeToDouble();
+  for (int i = 0; i < 5000; ++i)
+  {
+    double x[3] = { distribution(generator), distribution(generator), distribution(generator) };
+    points->InsertNextPoint(x);
+    ends->InsertNextPoint(x[0] + 1.5, x[1] - 0.5, x[2] + 0.25);
+  }
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  vtkNew<vtkDoubleArray> weights;
+  loc->FindCells(points, cellIds, pcoords, weights);
+  if (cellIds->GetNumberOfIds() != 5000 || weights->GetNumberOfComponents() != 8)
+  {
+    std::cerr << "Wrong FindCells output size" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  double x[3], cellPCoords[3], cellWeights[8];
+  int subId;
+  for (vtkIdType i = 0; i < 5000; ++i)
+  {
+    points->GetPoint(i, x);
+    const vtkIdType cellId = loc->FindCell(x, 0.0, cell, subId, cellPCoords, cellWeights);
+    if (cellId != cellIds->GetId(i) ||
+      (cellId >= 0 &&
+        (vtkMath::Distance2BetweenPoints(cellPCoords, pcoords->GetTuple3(i)) > 1e-20 ||
+          cellWeights[7] != weights->GetComponent(i, 7))))
+    {
+      std::cerr << "FindCells differs from FindCell for point " << i << std::endl;
+      return false;
+    }
+  }
+
+  if (testClosestPoints)
+  {
+    vtkNew<vtkPoints> closestPoints;
+    closestPoints->SetDataTypeToDouble();
+    vtkNew<vtkDoubleArray> dist2;
+    loc->FindClosestPoints(points, closestPoints, cellIds, dist2);
+    double closestPoint[3], pointDist2;
+    vtkIdType cellId;
+    for (vtkIdType i = 0; i < 5000; ++i)
+    {
+      points->GetPoint(i, x);
+      loc->FindClosestPoint(x, closestPoint, cell, cellId, subId, pointDist2);
+      if (pointDist2 != dist2->GetValue(i) ||
+        vtkMath::Distance2BetweenPoints(closestPoint, closestPoints->GetPoint(i)) > 1e-20)
+      {
+        std::cerr << "FindClosestPoints differs from FindClosestPoint for point " << i
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  else
+  {
+    // The batch is rejected up front, with a single error.
+    auto errorObserver = vtkSmartPointer<vtkTest::ErrorObserver>::New();
+    loc->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+    vtkNew<vtkPoints> closestPoints;
+    loc->FindClosestPoints(points, closestPoints, cellIds);
+    loc->RemoveObserver(errorObserver);
+    const std::string message = errorObserver->GetErrorMessage();
+    const std::string expected = "does not yet support FindClosestPoints";
+    if (message.find(expected) == std::string::npos ||
+      message.find(expected) != message.rfind(expected) || closestPoints->GetNumberOfPoints())
+    {
+      std::cerr << "FindClosestPoints should be rejected with a single error" << std::endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkPoints> intersections;
+  intersections->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> ts;
+  loc->IntersectWithLines(points, ends, 0.0, cellIds, intersections, ts);
+  double p2[3], t, intersection[3];
+  vtkIdType cellId;
+  for (vtkIdType i = 0; i < 5000; ++i)
+  {
+    points->GetPoint(i, x);
+    ends->GetPoint(i, p2);
+    if (!loc->IntersectWithLine(x, p2, 0.0, t, intersection, cellPCoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (cellId != cellIds->GetId(i) ||
+      (cellId >= 0 &&
+        (t != ts->GetValue(i) ||
+          vtkMath::Distance2BetweenPoints(intersection, intersections->GetPoint(i)) > 1e-20)))
+    {
+      std::cerr << "IntersectWithLines differs from IntersectWithLine for segment " << i
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCellLocatorsBatchedQueries(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 21, 21);
+  image->SetSpacing(0.5, 0.5, 0.5);
+
+  vtkNew<vtkCellLocator> cellLocator;
+  vtkNew<vtkStaticCellLocator> staticCellLocator;
+  vtkNew<vtkCellTreeLocator> cellTreeLocator;
+  bool success = TestLocator(image, cellLocator, true);
+  success = TestLocator(image, staticCellLocator, true) && success;
+  success = TestLocator(image, cellTreeLocator, false) && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the depth first iterator of vtkHyperTreeLinearLayout visits the same cells, with the
+// same geometry, as a recursive traversal with a non oriented geometry cursor.
+
+#include "vtkBitArray.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridNonOrientedGeometryCursor.h"
+#include "vtkHyperTreeGridPreConfiguredSource.h"
+#include "vtkHyperTreeLinearLayout.h"
+#include "vtkNew.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+struct Visit
+{
+  vtkIdType GlobalIndex;
+  unsigned int Level;
+  bool Leaf;
+  bool Masked;
+  double Bounds[6];
+
+  bool operator!=(const Visit& other) const
+  {
+    bool different = this->GlobalIndex != other.GlobalIndex || this->Level != other.Level ||
+      this->Leaf != other.Leaf || this->Masked != other.Masked;
+    for (int i = 0; i < 6; ++i)
+    {
+      different = different || this->Bounds[i] != other.Bounds[i];
+    }
+    return different;
+  }
+};
+
+//------------------------------------------------------------------------------
+void RecursivelyVisit(vtkHyperTreeGridNonOrientedGeometryCursor* cursor, std::vector<Visit>& visits)
+{
+  Visit visit{ cursor->GetGlobalNodeIndex(), cursor->GetLevel(), cursor->IsLeaf(),
+    cursor->IsMasked(), {} };
+  cursor->GetBounds(visit.Bounds);
+  visits.push_back(visit);
+  if (visit.Leaf || visit.Masked)
+  {
+    return;
+  }
+  for (unsigned char child = 0; child < cursor->GetNumberOfChildren(); ++child)
+  {
+    cursor->ToChild(child);
+    RecursivelyVisit(cursor, visits);
+    cursor->ToParent();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool TestGrid(vtkHyperTreeGrid* htg)
+{
+  vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor;
+  vtkNew<vtkHyperTreeLinearLayout> layout;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator treeIt;
+  htg->InitializeTreeIterator(treeIt);
+  vtkIdType treeIndex;
+  while (treeIt.GetNextTree(treeIndex))
+  {
+    std::vector<Visit> expected;
+    htg->InitializeNonOrientedGeometryCursor(cursor, treeIndex);
+    RecursivelyVisit(cursor, expected);
+
+    if (!layout->Initialize(htg, treeIndex))
+    {
+      std::cerr << "Could not build the layout of tree " << treeIndex << "\n";
+      return false;
+    }
+
+    // Breadth first order: the children of a vertex are contiguous, on the next level.
+    for (unsigned int level = 0; level + 1 < layout->GetNumberOfLevels(); ++level)
+    {
+      vtkIdType nextChild = layout->GetLevelOffset(level + 1);
+      for (vtkIdType v = layout->GetLevelOffset(level); v < layout->GetLevelOffset(level + 1); ++v)
+      {
+        if (!layout->IsLeaf(v))
+        {
+          if (layout->GetFirstChild(v) != nextChild)
+          {
+            std::cerr << "Tree " << treeIndex << ": children are not in breadth first order\n";
+            return false;
+          }
+          nextChild += layout->GetNumberOfChildren();
+        }
+      }
+    }
+
+    std::vector<Visit> visits;
+    vtkHyperTreeLinearLayout::DepthFirstIterator it(layout);
+    for (it.Begin(); !it.IsAtEnd();)
+    {
+      Visit visit{ it.GetGlobalNodeIndex(), it.GetLevel(), it.IsLeaf(), it.IsMasked(), {} };
+      it.GetBounds(visit.Bounds);
+      visits.push_back(visit);
+      it.Next(!visit.Masked);
+    }
+
+    if (visits.size() != expected.size())
+    {
+      std::cerr << "Tree " << treeIndex << ": " << visits.size() << " cells visited instead of "
+                << expected.size() << "\n";
+      return false;
+    }
+    for (size_t i = 0; i < visits.size(); ++i)
+    {
+      if (visits[i] != expected[i])
+      {
+        std::cerr << "Tree " << treeIndex << ": wrong cell " << visits[i].GlobalIndex
+                  << " visited instead of " << expected[i].GlobalIndex << "\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestHyperTreeLinearLayout(int, char*[])
+{
+  const vtkHyperTreeGridPreConfiguredSource::HTGType types[] = {
+    vtkHyperTreeGridPreConfiguredSource::UNBALANCED_3DEPTH_2BRANCH_2X3,
+    vtkHyperTreeGridPreConfiguredSource::UNBALANCED_2DEPTH_3BRANCH_3X3,
+    vtkHyperTreeGridPreConfiguredSource::BALANCED_4DEPTH_3BRANCH_2X2,
+    vtkHyperTreeGridPreConfiguredSource::UNBALANCED_3DEPTH_2BRANCH_3X2X3,
+    vtkHyperTreeGridPreConfiguredSource::BALANCED_2DEPTH_3BRANCH_3X3X2,
+  };
+
+  for (auto type : types)
+  {
+    vtkNew<vtkHyperTreeGridPreConfiguredSource> source;
+    source->SetHTGMode(type);
+    source->Update();
+    vtkHyperTreeGrid* htg = source->GetHyperTreeGridOutput();
+    if (!TestGrid(htg))
+    {
+      std::cerr << "Failed for configuration " << type << "\n";
+      return EXIT_FAILURE;
+    }
+
+    // Mask some of the cells, coarse and leaves.
+    vtkNew<vtkBitArray> mask;
+    mask->SetNumberOfTuples(htg->GetNumberOfCells());
+    for (vtkIdType i = 0; i < htg->GetNumberOfCells(); ++i)
+    {
+      mask->SetValue(i, i % 7 == 3);
+    }
+    htg->SetMask(mask);
+    if (!TestGrid(htg))
+    {
+      std::cerr << "Failed for configuration " << type << " with a mask\n";
+      return EXIT_FAILURE;
+    }
+
+    htg->SetDepthLimiter(1);
+    if (!TestGrid(htg))
+    {
+      std::cerr << "Failed for configuration " << type << " with a depth limiter\n";
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
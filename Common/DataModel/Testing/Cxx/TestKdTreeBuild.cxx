@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the regions and cell lists of a vtkKdTree built on enough cells for the median of the
+// top regions to be found in parallel.
+
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkKdTree.h"
+#include "vtkNew.h"
+
+#include <iostream>
+#include <vector>
+
+int TestKdTreeBuild(int, char*[])
+{
+  // Cell centers of an image are aligned, so many of them share their cut coordinate.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(71, 61, 51);
+  image->SetSpacing(0.5, 1.0, 2.0);
+  const vtkIdType numberOfCells = image->GetNumberOfCells();
+
+  vtkNew<vtkKdTree> kdTree;
+  kdTree->SetDataSet(image);
+  kdTree->SetMinCells(100);
+  kdTree->BuildLocator();
+
+  const int numberOfRegions = kdTree->GetNumberOfRegions();
+  if (numberOfRegions < 512)
+  {
+    std::cerr << "Expected at least 512 regions, got " << numberOfRegions << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // Every cell center must lie in the region of its cell.
+  std::vector<std::vector<double>> regionBounds(numberOfRegions, std::vector<double>(6));
+  for (int region = 0; region < numberOfRegions; ++region)
+  {
+    kdTree->GetRegionBounds(region, regionBounds[region].data());
+  }
+  std::vector<vtkIdType> regionSizes(numberOfRegions, 0);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    const int region = kdTree->GetRegionContainingCell(cellId);
+    if (region < 0 || region >= numberOfRegions)
+    {
+      std::cerr << "Cell " << cellId << " is in no region\n";
+      return EXIT_FAILURE;
+    }
+    ++regionSizes[region];
+    double cellBounds[6];
+    image->GetCellBounds(cellId, cellBounds);
+    const std::vector<double>& bounds = regionBounds[region];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double center = 0.5 * (cellBounds[2 * i] + cellBounds[2 * i + 1]);
+      if (center <= bounds[2 * i] || center > bounds[2 * i + 1])
+      {
+        std::cerr << "Center of cell " << cellId << " is outside of region " << region << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The cell lists contain the cells of each region, sorted by id.
+  kdTree->CreateCellLists();
+  for (int region = 0; region < numberOfRegions; ++region)
+  {
+    vtkIdList* cells = kdTree->GetCellList(region);
+    if (cells->GetNumberOfIds() != regionSizes[region])
+    {
+      std::cerr << "Region " << region << " lists " << cells->GetNumberOfIds()
+                << " cells instead of " << regionSizes[region] << "\n";
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < cells->GetNumberOfIds(); ++i)
+    {
+      if ((i > 0 && cells->GetId(i) <= cells->GetId(i - 1)) ||
+        kdTree->GetRegionContainingCell(cells->GetId(i)) != region)
+      {
+        std::cerr << "Wrong cell list for region " << region << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
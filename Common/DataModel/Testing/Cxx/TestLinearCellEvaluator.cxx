@@ -0,0 +1,229 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkLinearCellEvaluator computes the same values as the cell classes.
+
+#include "vtkCell.h"
+#include "vtkHexahedron.h"
+#include "vtkLinearCellEvaluator.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTetra.h"
+#include "vtkVoxel.h"
+#include "vtkWedge.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr double Tolerance = 1e-9;
+
+//------------------------------------------------------------------------------
+bool IsClose(double a, double b)
+{
+  return std::fabs(a - b) <= Tolerance * (1.0 + std::fabs(a) + std::fabs(b));
+}
+
+//------------------------------------------------------------------------------
+// Reference cell with randomly moved points, the voxel keeping its axes.
+vtkSmartPointer<vtkCell> MakeCell(int cellType, std::mt19937& generator)
+{
+  static const double tetra[4][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+  static const double voxel[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+    { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 } };
+  static const double hexahedron[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+    { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+  static const double wedge[6][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+    { 1, 0, 1 }, { 0, 1, 1 } };
+
+  std::uniform_real_distribution<double> move(-0.15, 0.15);
+  std::uniform_real_distribution<double> scale(0.5, 2.0);
+  const double origin[3] = { 10 * move(generator), 10 * move(generator), 10 * move(generator) };
+  const double size[3] = { scale(generator), scale(generator), scale(generator) };
+
+  vtkSmartPointer<vtkCell> cell;
+  const double(*points)[3] = nullptr;
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      cell = vtkSmartPointer<vtkTetra>::New();
+      points = tetra;
+      break;
+    case VTK_VOXEL:
+      cell = vtkSmartPointer<vtkVoxel>::New();
+      points = voxel;
+      break;
+    case VTK_HEXAHEDRON:
+      cell = vtkSmartPointer<vtkHexahedron>::New();
+      points = hexahedron;
+      break;
+    default:
+      cell = vtkSmartPointer<vtkWedge>::New();
+      points = wedge;
+      break;
+  }
+  const int numPoints = cell->GetNumberOfPoints();
+  for (int i = 0; i < numPoints; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = origin[c] + size[c] * points[i][c] + (cellType == VTK_VOXEL ? 0.0 : move(generator));
+    }
+    cell->GetPoints()->SetPoint(i, x);
+    cell->GetPointIds()->SetId(i, i);
+  }
+  return cell;
+}
+
+//------------------------------------------------------------------------------
+// Evaluate queries either in as many cells (one query per cell) or in a single cell.
+bool TestCellType(int cellType, bool singleCell)
+{
+  std::mt19937 generator(cellType);
+  std::uniform_real_distribution<double> distribution(-0.3, 1.3);
+  const vtkIdType numQueries = 101;
+  const int dim = 2;
+  const vtkIdType cellPointIds[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+  vtkLinearCellEvaluator evaluator(cellType);
+  const int numPoints = evaluator.GetNumberOfPoints();
+  std::vector<vtkSmartPointer<vtkCell>> cells;
+  std::vector<double> queries, parametricQueries, values;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    if (!singleCell || i == 0)
+    {
+      // Cover both ways of inserting cells
+      cells.push_back(MakeCell(cellType, generator));
+      if (singleCell)
+      {
+        evaluator.InsertNextCell(cells.back()->GetPoints(), cellPointIds);
+      }
+      else
+      {
+        std::vector<double> coordinates(3 * numPoints);
+        for (int p = 0; p < numPoints; ++p)
+        {
+          cells.back()->GetPoints()->GetPoint(p, &coordinates[3 * p]);
+        }
+        evaluator.InsertNextCell(coordinates.data());
+      }
+    }
+
+    // Queries around the cell, from random parametric coordinates
+    double pc[3] = { distribution(generator), distribution(generator), distribution(generator) };
+    double w[8], x[3] = { 0.0, 0.0, 0.0 };
+    cells.back()->InterpolateFunctions(pc, w);
+    for (int p = 0; p < numPoints; ++p)
+    {
+      double point[3];
+      cells.back()->GetPoints()->GetPoint(p, point);
+      for (int c = 0; c < 3; ++c)
+      {
+        x[c] += w[p] * point[c];
+      }
+    }
+    queries.insert(queries.end(), x, x + 3);
+    parametricQueries.insert(parametricQueries.end(), pc, pc + 3);
+    for (int k = 0; k < numPoints * dim; ++k)
+    {
+      values.push_back(distribution(generator));
+    }
+  }
+
+  std::vector<double> pcoords(3 * numQueries), weights(numPoints * numQueries);
+  std::vector<double> derivs(3 * dim * numQueries);
+  std::vector<signed char> inside(numQueries);
+  evaluator.EvaluatePosition(
+    numQueries, queries.data(), pcoords.data(), weights.data(), inside.data());
+  evaluator.Derivatives(numQueries, parametricQueries.data(), values.data(), dim, derivs.data());
+  std::vector<double> functions(numPoints * numQueries);
+  evaluator.InterpolateFunctions(numQueries, parametricQueries.data(), functions.data());
+
+  int numInside = 0;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    vtkCell* cell = cells[singleCell ? 0 : i];
+    double pc[3], w[8], dist2;
+    int subId;
+    const int expected = cell->EvaluatePosition(&queries[3 * i], nullptr, subId, pc, dist2, w);
+    if (expected != inside[i])
+    {
+      std::cerr << cell->GetClassName() << ": query " << i << " returned " << int(inside[i])
+                << " instead of " << expected << "\n";
+      return false;
+    }
+    numInside += expected == 1;
+    // Weights are only computed for points inside of the cell
+    if (expected == 1)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        if (!IsClose(pc[c], pcoords[3 * i + c]))
+        {
+          std::cerr << cell->GetClassName() << ": wrong parametric coordinates for query " << i
+                    << "\n";
+          return false;
+        }
+      }
+      for (int p = 0; p < numPoints; ++p)
+      {
+        if (!IsClose(w[p], weights[numPoints * i + p]))
+        {
+          std::cerr << cell->GetClassName() << ": wrong weights for query " << i << "\n";
+          return false;
+        }
+      }
+    }
+
+    double f[8];
+    cell->InterpolateFunctions(&parametricQueries[3 * i], f);
+    for (int p = 0; p < numPoints; ++p)
+    {
+      if (f[p] != functions[numPoints * i + p])
+      {
+        std::cerr << cell->GetClassName() << ": wrong interpolation functions for query " << i
+                  << "\n";
+        return false;
+      }
+    }
+
+    double d[3 * dim];
+    cell->Derivatives(0, &parametricQueries[3 * i], &values[numPoints * dim * i], dim, d);
+    for (int k = 0; k < 3 * dim; ++k)
+    {
+      if (!IsClose(d[k], derivs[3 * dim * i + k]))
+      {
+        std::cerr << cell->GetClassName() << ": wrong derivatives for query " << i << "\n";
+        return false;
+      }
+    }
+  }
+
+  if (numInside == 0 || numInside == numQueries)
+  {
+    std::cerr << "Queries should be both inside and outside of the cells\n";
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestLinearCellEvaluator(int, char*[])
+{
+  bool success = !vtkLinearCellEvaluator::IsTypeSupported(VTK_PYRAMID);
+  const int cellTypes[] = { VTK_TETRA, VTK_VOXEL, VTK_HEXAHEDRON, VTK_WEDGE };
+  for (int cellType : cellTypes)
+  {
+    success &= vtkLinearCellEvaluator::IsTypeSupported(cellType);
+    success &= TestCellType(cellType, false);
+    success &= TestCellType(cellType, true);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
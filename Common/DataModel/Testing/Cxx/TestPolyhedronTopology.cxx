@@ -0,0 +1,267 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the polyhedra of a vtkUnstructuredGrid behave the same whether
+// or not the grid holds a precomputed vtkPolyhedronTopology.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyhedron.h"
+#include "vtkPolyhedronTopology.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Insert the cube of the lattice with the given lower corner as a polyhedron,
+// or as a hexahedron. The top face of a polyhedron is dented when dent >= 0.
+void InsertCube(vtkUnstructuredGrid* grid, int i, int j, int k, bool polyhedron, vtkIdType dent)
+{
+  auto id = [](int x, int y, int z) -> vtkIdType { return x + 3 * (y + 3 * z); };
+  const vtkIdType p[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k), id(i, j + 1, k),
+    id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1), id(i, j + 1, k + 1) };
+  if (!polyhedron)
+  {
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+    return;
+  }
+
+  // Face stream: number of faces, then number of points and points of each face
+  std::vector<vtkIdType> stream = { 0, 4, p[0], p[3], p[2], p[1], 4, p[0], p[1], p[5], p[4], 4,
+    p[1], p[2], p[6], p[5], 4, p[2], p[3], p[7], p[6], 4, p[3], p[0], p[4], p[7] };
+  stream[0] = 5;
+  std::vector<vtkIdType> pts(p, p + 8);
+  if (dent >= 0)
+  {
+    stream[0] += 4;
+    for (int e = 0; e < 4; ++e)
+    {
+      stream.insert(stream.end(), { 3, p[4 + e], p[4 + (e + 1) % 4], dent });
+    }
+    pts.push_back(dent);
+  }
+  else
+  {
+    stream[0] += 1;
+    stream.insert(stream.end(), { 4, p[4], p[5], p[6], p[7] });
+  }
+  grid->InsertNextCell(VTK_POLYHEDRON, static_cast<vtkIdType>(pts.size()), pts.data(),
+    stream[0], stream.data() + 1);
+}
+
+//------------------------------------------------------------------------------
+bool SameIds(vtkCell* cell1, vtkCell* cell2, const char* what, vtkIdType cellId)
+{
+  bool same = cell1 && cell2 && cell1->GetNumberOfPoints() == cell2->GetNumberOfPoints();
+  for (vtkIdType i = 0; same && i < cell1->GetNumberOfPoints(); ++i)
+  {
+    same = cell1->GetPointId(i) == cell2->GetPointId(i);
+  }
+  if (!same)
+  {
+    std::cerr << "Cell " << cellId << ": " << what << " differs\n";
+  }
+  return same;
+}
+
+//------------------------------------------------------------------------------
+bool CompareCells(vtkUnstructuredGrid* grid, vtkUnstructuredGrid* reference, vtkIdType cellId)
+{
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkGenericCell> expected;
+  grid->GetCell(cellId, cell);
+  reference->GetCell(cellId, expected);
+
+  if (cell->GetNumberOfFaces() != expected->GetNumberOfFaces() ||
+    cell->GetNumberOfEdges() != expected->GetNumberOfEdges())
+  {
+    std::cerr << "Cell " << cellId << ": wrong number of faces or edges\n";
+    return false;
+  }
+  for (int i = 0; i < cell->GetNumberOfFaces(); ++i)
+  {
+    if (!SameIds(cell->GetFace(i), expected->GetFace(i), "face", cellId))
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < cell->GetNumberOfEdges(); ++i)
+  {
+    if (!SameIds(cell->GetEdge(i), expected->GetEdge(i), "edge", cellId))
+    {
+      return false;
+    }
+  }
+  if (cell->GetCellType() == VTK_POLYHEDRON &&
+    static_cast<vtkPolyhedron*>(cell->GetRepresentativeCell())->IsConvex() !=
+      static_cast<vtkPolyhedron*>(expected->GetRepresentativeCell())->IsConvex())
+  {
+    std::cerr << "Cell " << cellId << ": convexity differs\n";
+    return false;
+  }
+
+  // Locate a few points around the cell
+  double bounds[6];
+  cell->GetBounds(bounds);
+  std::vector<double> weights(cell->GetNumberOfPoints());
+  std::vector<double> expectedWeights(cell->GetNumberOfPoints());
+  for (double t : { 0.25, 0.5, 0.8, 1.2 })
+  {
+    const double x[3] = { bounds[0] + t * (bounds[1] - bounds[0]),
+      bounds[2] + 0.4 * (bounds[3] - bounds[2]), bounds[4] + t * (bounds[5] - bounds[4]) };
+    double closest[3], pcoords[3], dist2, expectedDist2;
+    int subId;
+    const int inside = cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights.data());
+    const int expectedInside =
+      expected->EvaluatePosition(x, closest, subId, pcoords, expectedDist2, expectedWeights.data());
+    if (inside != expectedInside || std::abs(dist2 - expectedDist2) > 1e-12)
+    {
+      std::cerr << "Cell " << cellId << ": EvaluatePosition differs\n";
+      return false;
+    }
+    for (size_t i = 0; inside == 1 && i < weights.size(); ++i)
+    {
+      if (std::abs(weights[i] - expectedWeights[i]) > 1e-12)
+      {
+        std::cerr << "Cell " << cellId << ": weights differ\n";
+        return false;
+      }
+    }
+  }
+
+  // Contour the cell
+  vtkIdType numPolys[2];
+  vtkGenericCell* cells[2] = { cell, expected };
+  for (int c = 0; c < 2; ++c)
+  {
+    vtkNew<vtkMergePoints> locator;
+    vtkNew<vtkPoints> points;
+    locator->InitPointInsertion(points, bounds);
+    vtkNew<vtkCellArray> verts;
+    vtkNew<vtkCellArray> lines;
+    vtkNew<vtkCellArray> polys;
+    vtkNew<vtkPointData> outPd;
+    outPd->InterpolateAllocate(grid->GetPointData());
+    vtkNew<vtkCellData> outCd;
+    outCd->CopyAllocate(grid->GetCellData());
+    vtkDataArray* scalars = grid->GetPointData()->GetScalars();
+    vtkNew<vtkDoubleArray> cellScalars;
+    cellScalars->SetNumberOfTuples(cells[c]->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < cells[c]->GetNumberOfPoints(); ++i)
+    {
+      cellScalars->SetValue(i, scalars->GetTuple1(cells[c]->GetPointId(i)));
+    }
+    cells[c]->Contour(1.9, cellScalars, locator, verts, lines, polys, grid->GetPointData(), outPd,
+      grid->GetCellData(), cellId, outCd);
+    numPolys[c] = polys->GetNumberOfCells();
+  }
+  if (numPolys[0] != numPolys[1])
+  {
+    std::cerr << "Cell " << cellId << ": contour differs\n";
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestPolyhedronTopology(int, char*[])
+{
+  // A 3x3x3 lattice of points with an extra point denting the top of a cube
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  const vtkIdType dent = points->InsertNextPoint(1.5, 0.5, 0.6);
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    scalars->InsertNextValue(x[0] + 0.5 * x[1] + 0.25 * x[2]);
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->AllocateEstimate(8, 8);
+  for (int c = 0; c < 8; ++c)
+  {
+    InsertCube(grid, c % 2, (c / 2) % 2, c / 4, c != 2, c == 1 ? dent : -1);
+  }
+
+  vtkNew<vtkUnstructuredGrid> reference;
+  reference->DeepCopy(grid);
+  reference->GetPointData()->SetScalars(scalars);
+
+  grid->BuildPolyhedronTopology();
+  vtkPolyhedronTopology* topology = grid->GetPolyhedronTopology();
+  if (!topology || topology->GetNumberOfCells() != 8 || topology->GetNumberOfFaces(1) != 9 ||
+    topology->GetNumberOfEdges(1) != 16 || topology->GetNumberOfFaces(2) != 0)
+  {
+    std::cerr << "Unexpected polyhedron topology\n";
+    return EXIT_FAILURE;
+  }
+
+  // Polyhedra have the same topology, with or without the precomputed one.
+  // Compare twice to check the cells are reused correctly.
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+    {
+      if (!CompareCells(grid, reference, cellId))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  vtkNew<vtkUnstructuredGrid> copy;
+  copy->DeepCopy(grid);
+  if (!copy->GetPolyhedronTopology() || !CompareCells(copy, reference, 1))
+  {
+    std::cerr << "Polyhedron topology not deep copied\n";
+    return EXIT_FAILURE;
+  }
+
+  // The topology is released when the cells are replaced
+  grid->SetPolyhedralCells(reference->GetCellTypesArray(), reference->GetCells(),
+    reference->GetPolyhedronFaceLocations(), reference->GetPolyhedronFaces());
+  if (grid->GetPolyhedronTopology())
+  {
+    std::cerr << "Polyhedron topology not released\n";
+    return EXIT_FAILURE;
+  }
+
+  // Nothing to build without polyhedra
+  vtkNew<vtkUnstructuredGrid> hexahedra;
+  hexahedra->SetPoints(points);
+  hexahedra->AllocateEstimate(1, 8);
+  InsertCube(hexahedra, 0, 0, 0, false, -1);
+  hexahedra->BuildPolyhedronTopology();
+  if (hexahedra->GetPolyhedronTopology())
+  {
+    std::cerr << "Unexpected polyhedron topology without polyhedra\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkStaticPointLocator::UpdateLocator() gives the same buckets as a full rebuild
+// after some points moved, and compare the time taken by both.
+
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkTimerLog.h"
+
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool SameBuckets(vtkStaticPointLocator* locator, vtkStaticPointLocator* reference)
+{
+  if (locator->GetNumberOfBuckets() != reference->GetNumberOfBuckets())
+  {
+    std::cerr << "Different number of buckets\n";
+    return false;
+  }
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdList> referenceIds;
+  for (vtkIdType bucket = 0; bucket < reference->GetNumberOfBuckets(); ++bucket)
+  {
+    locator->GetBucketIds(bucket, ids);
+    reference->GetBucketIds(bucket, referenceIds);
+    if (ids->GetNumberOfIds() != referenceIds->GetNumberOfIds())
+    {
+      std::cerr << "Wrong number of points in bucket " << bucket << "\n";
+      return false;
+    }
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+      if (ids->GetId(i) != referenceIds->GetId(i))
+      {
+        std::cerr << "Wrong points in bucket " << bucket << "\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestStaticPointLocatorUpdate(int, char*[])
+{
+  const vtkIdType numberOfPoints = 200000;
+  const vtkIdType numberOfMovedPoints = numberOfPoints / 100;
+
+  // The first two points pin the bounds of the points.
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfPoints);
+  points->SetPoint(0, -1.0, -1.0, -1.0);
+  points->SetPoint(1, 1.0, 1.0, 1.0);
+  vtkMath::RandomSeed(314159);
+  for (vtkIdType i = 2; i < numberOfPoints; ++i)
+  {
+    points->SetPoint(i, vtkMath::Random(-1, 1), vtkMath::Random(-1, 1), vtkMath::Random(-1, 1));
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  vtkNew<vtkStaticPointLocator> listLocator;
+  listLocator->SetDataSet(polyData);
+  listLocator->BuildLocator();
+  vtkNew<vtkStaticPointLocator> detectLocator;
+  detectLocator->SetDataSet(polyData);
+  detectLocator->BuildLocator();
+
+  // Move some of the points, some of them within their bucket.
+  vtkNew<vtkIdList> movedPoints;
+  movedPoints->SetNumberOfIds(numberOfMovedPoints);
+  for (vtkIdType i = 0; i < numberOfMovedPoints; ++i)
+  {
+    vtkIdType ptId = 2 + (i * 7919) % (numberOfPoints - 2);
+    movedPoints->SetId(i, ptId);
+    double x[3];
+    points->GetPoint(ptId, x);
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = vtkMath::ClampValue(x[j] + vtkMath::Random(-0.1, 0.1), -1.0, 1.0);
+    }
+    points->SetPoint(ptId, x);
+  }
+  points->Modified();
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkIdType listMoved = listLocator->UpdateLocator(movedPoints);
+  timer->StopTimer();
+  double listTime = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  vtkIdType detectMoved = detectLocator->UpdateLocator();
+  timer->StopTimer();
+  double detectTime = timer->GetElapsedTime();
+
+  vtkNew<vtkStaticPointLocator> reference;
+  reference->SetDataSet(polyData);
+  timer->StartTimer();
+  reference->BuildLocator();
+  timer->StopTimer();
+  double buildTime = timer->GetElapsedTime();
+
+  std::cout << "Re-binned " << listMoved << " points out of " << numberOfMovedPoints
+            << " moved points\n";
+  std::cout << "Update with a list of moved points: " << listTime << "\n";
+  std::cout << "Update detecting moved points: " << detectTime << "\n";
+  std::cout << "Full rebuild: " << buildTime << "\n";
+
+  if (listMoved <= 0 || listMoved > numberOfMovedPoints || detectMoved != listMoved)
+  {
+    std::cerr << "Unexpected number of re-binned points: " << listMoved << " and " << detectMoved
+              << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // The locators must not be rebuilt when queried.
+  vtkMTimeType buildStamp = listLocator->GetBuildTime();
+  if (!SameBuckets(listLocator, reference) || !SameBuckets(detectLocator, reference))
+  {
+    return EXIT_FAILURE;
+  }
+  if (listLocator->GetBuildTime() != buildStamp)
+  {
+    std::cerr << "The locator was rebuilt after its update\n";
+    return EXIT_FAILURE;
+  }
+
+  // A point leaving the bounds requires a full rebuild.
+  points->SetPoint(numberOfPoints - 1, 1.5, 0.0, 0.0);
+  points->Modified();
+  if (detectLocator->UpdateLocator() != -1)
+  {
+    std::cerr << "Expected the locator to be rebuilt\n";
+    return EXIT_FAILURE;
+  }
+  reference->BuildLocator();
+  if (!SameBuckets(detectLocator, reference))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
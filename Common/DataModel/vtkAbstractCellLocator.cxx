@@ -6,6 +6,7 @@
 #include "vtkCellArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -13,11 +14,55 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
-//------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Batched queries are not sorted below this number of queries.
+constexpr vtkIdType MinimumNumberOfSortedQueries = 1024;
+// Number of bits per dimension of the space filling curve ordering the queries.
+constexpr int QueryOrderBits = 21;
+
+//------------------------------------------------------------------------------
+// Interleave the QueryOrderBits lowest bits of value with two zero bits, to build Morton codes.
+uint64_t SpreadBits(uint64_t value)
+{
+  value &= 0x1fffff;
+  value = (value | value << 32) & 0x1f00000000ffff;
+  value = (value | value << 16) & 0x1f0000ff0000ff;
+  value = (value | value << 8) & 0x100f00f00f00f00f;
+  value = (value | value << 4) & 0x10c30c30c30c30c3;
+  value = (value | value << 2) & 0x1249249249249249;
+  return value;
+}
+
+//------------------------------------------------------------------------------
+// Run the batched queries in [0, numberOfQueries) in parallel, or serially for locators that do
+// not support concurrent queries.
+template <typename Functor>
+void ForEachQuery(vtkIdType numberOfQueries, bool parallel, Functor& functor)
+{
+  if (parallel)
+  {
+    vtkSMPTools::For(0, numberOfQueries, functor);
+  }
+  else
+  {
+    functor(0, numberOfQueries);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
 {
   this->CacheCellBounds = 1;
@@ -32,6 +77,51 @@ vtkAbstractCellLocator::vtkAbstractCellLocator()
 //------------------------------------------------------------------------------
 vtkAbstractCellLocator::~vtkAbstractCellLocator() = default;
 
+//------------------------------------------------------------------------------
+vtkAbstractCellLocator::vtkVisitedCells::vtkVisitedCells(
+  vtkAbstractCellLocator* locator, vtkIdType numberOfCells)
+  : Locator(locator)
+{
+  {
+    std::lock_guard<std::mutex> lock(locator->VisitedCellsMutex);
+    if (!locator->VisitedCellsPool.empty())
+    {
+      this->Flags = std::move(locator->VisitedCellsPool.back());
+      locator->VisitedCellsPool.pop_back();
+    }
+  }
+  if (!this->Flags)
+  {
+    this->Flags.reset(new FlagSet);
+  }
+  if (static_cast<vtkIdType>(this->Flags->Visited.size()) != numberOfCells)
+  {
+    this->Flags->Visited.assign(numberOfCells, false);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkAbstractCellLocator::vtkVisitedCells::~vtkVisitedCells()
+{
+  // Unset the flags one by one unless the query went through a good part of the cells
+  std::vector<bool>& visited = this->Flags->Visited;
+  std::vector<vtkIdType>& touched = this->Flags->Touched;
+  if (touched.size() > visited.size() / 64)
+  {
+    std::fill(visited.begin(), visited.end(), false);
+  }
+  else
+  {
+    for (vtkIdType cellId : touched)
+    {
+      visited[cellId] = false;
+    }
+  }
+  touched.clear();
+  std::lock_guard<std::mutex> lock(this->Locator->VisitedCellsMutex);
+  this->Locator->VisitedCellsPool.push_back(std::move(this->Flags));
+}
+
 //------------------------------------------------------------------------------
 bool vtkAbstractCellLocator::StoreCellBounds()
 {
@@ -286,6 +376,215 @@ void vtkAbstractCellLocator::GetCellBounds(vtkIdType cellId, double*& cellBounds
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::ComputeQueryOrder(vtkPoints* points, std::vector<vtkIdType>& order)
+{
+  const vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  order.resize(numberOfPoints);
+  if (numberOfPoints < MinimumNumberOfSortedQueries || !this->DataSet)
+  {
+    std::iota(order.begin(), order.end(), 0);
+    return;
+  }
+
+  double bounds[6], scale[3];
+  this->DataSet->GetBounds(bounds);
+  const double maxCoordinate = static_cast<double>((1 << QueryOrderBits) - 1);
+  for (int d = 0; d < 3; ++d)
+  {
+    const double length = bounds[2 * d + 1] - bounds[2 * d];
+    scale[d] = length > 0.0 ? maxCoordinate / length : 0.0;
+  }
+
+  std::vector<std::pair<uint64_t, vtkIdType>> keys(numberOfPoints);
+  vtkSMPTools::For(0, numberOfPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double x[3];
+      for (vtkIdType pointId = begin; pointId < end; ++pointId)
+      {
+        points->GetPoint(pointId, x);
+        uint64_t key = 0;
+        for (int d = 0; d < 3; ++d)
+        {
+          const double coordinate =
+            vtkMath::ClampValue((x[d] - bounds[2 * d]) * scale[d], 0.0, maxCoordinate);
+          key |= SpreadBits(static_cast<uint64_t>(coordinate)) << d;
+        }
+        keys[pointId] = std::make_pair(key, pointId);
+      }
+    });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    order[i] = keys[i].second;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  if (!points || !cellIds || !this->DataSet)
+  {
+    vtkErrorMacro(<< "FindCells needs points, a cell id list and a data set");
+    return;
+  }
+  this->BuildLocator();
+
+  const vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  const int maxCellSize = std::max(this->DataSet->GetMaxCellSize(), 1);
+  cellIds->SetNumberOfIds(numberOfPoints);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numberOfPoints);
+  }
+  if (weights)
+  {
+    weights->SetNumberOfComponents(maxCellSize);
+    weights->SetNumberOfTuples(numberOfPoints);
+  }
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* pcoordsPtr = pcoords ? pcoords->GetPointer(0) : nullptr;
+  double* weightsPtr = weights ? weights->GetPointer(0) : nullptr;
+
+  std::vector<vtkIdType> order;
+  this->ComputeQueryOrder(points, order);
+
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+  auto findCells = [&](vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = localCell.Local();
+    std::vector<double>& cellWeights = localWeights.Local();
+    cellWeights.resize(maxCellSize);
+    double x[3], cellPCoords[3];
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType pointId = order[i];
+      points->GetPoint(pointId, x);
+      double* pc = pcoordsPtr ? pcoordsPtr + 3 * pointId : cellPCoords;
+      double* w = weightsPtr ? weightsPtr + maxCellSize * pointId : cellWeights.data();
+      cellIdsPtr[pointId] = this->FindCell(x, 0.0, cell, subId, pc, w);
+    }
+  };
+  ForEachQuery(numberOfPoints, this->SupportsConcurrentQueries(), findCells);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoints(
+  vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds, vtkDoubleArray* dist2)
+{
+  if (!points || !closestPoints || !cellIds || !this->DataSet)
+  {
+    vtkErrorMacro(<< "FindClosestPoints needs points, closest points, a cell id list and a "
+                     "data set");
+    return;
+  }
+  this->BuildLocator();
+
+  const vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  closestPoints->SetNumberOfPoints(numberOfPoints);
+  cellIds->SetNumberOfIds(numberOfPoints);
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfTuples(numberOfPoints);
+  }
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* dist2Ptr = dist2 ? dist2->GetPointer(0) : nullptr;
+
+  std::vector<vtkIdType> order;
+  this->ComputeQueryOrder(points, order);
+
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  auto findClosestPoints = [&](vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = localCell.Local();
+    double x[3], closestPoint[3], pointDist2;
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType pointId = order[i];
+      points->GetPoint(pointId, x);
+      this->FindClosestPoint(x, closestPoint, cell, cellIdsPtr[pointId], subId, pointDist2);
+      closestPoints->SetPoint(pointId, closestPoint);
+      if (dist2Ptr)
+      {
+        dist2Ptr[pointId] = pointDist2;
+      }
+    }
+  };
+  ForEachQuery(numberOfPoints, this->SupportsConcurrentQueries(), findClosestPoints);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(
+  vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds, vtkPoints* x, vtkDoubleArray* t)
+{
+  if (!p1s || !p2s || !cellIds || !this->DataSet)
+  {
+    vtkErrorMacro(<< "IntersectWithLines needs segment end points, a cell id list and a data set");
+    return;
+  }
+  const vtkIdType numberOfLines = p1s->GetNumberOfPoints();
+  if (p2s->GetNumberOfPoints() != numberOfLines)
+  {
+    vtkErrorMacro(<< "The segments must have as many start points as end points");
+    return;
+  }
+  this->BuildLocator();
+
+  cellIds->SetNumberOfIds(numberOfLines);
+  if (x)
+  {
+    x->SetNumberOfPoints(numberOfLines);
+  }
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numberOfLines);
+  }
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* tPtr = t ? t->GetPointer(0) : nullptr;
+
+  std::vector<vtkIdType> order;
+  this->ComputeQueryOrder(p1s, order);
+
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  auto intersectWithLines = [&](vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = localCell.Local();
+    double p1[3], p2[3], lineT, lineX[3], pcoords[3];
+    int subId;
+    vtkIdType cellId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType lineId = order[i];
+      p1s->GetPoint(lineId, p1);
+      p2s->GetPoint(lineId, p2);
+      cellId = -1;
+      if (!this->IntersectWithLine(p1, p2, tol, lineT, lineX, pcoords, subId, cellId, cell))
+      {
+        cellIdsPtr[lineId] = -1;
+        continue;
+      }
+      cellIdsPtr[lineId] = cellId;
+      if (x)
+      {
+        x->SetPoint(lineId, lineX);
+      }
+      if (tPtr)
+      {
+        tPtr[lineId] = lineT;
+      }
+    }
+  };
+  ForEachQuery(numberOfLines, this->SupportsConcurrentQueries(), intersectWithLines);
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -30,10 +30,12 @@
 #include "vtkNew.h" // For vtkNew
 
 #include <memory> // For shared_ptr
+#include <mutex>  // For std::mutex
 #include <vector> // For Weights
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPoints;
@@ -287,6 +289,78 @@ public:
     double pcoords[3], double* weights);
   ///@}
 
+  ///@{
+  /**
+   * Batched versions of FindCell, FindClosestPoint and IntersectWithLine, processing all the
+   * points (or the segments going from p1s to p2s) at once. The locator is built if needed, then
+   * the queries are sorted so that neighboring queries are processed together, and dispatched
+   * over threads with vtkSMPTools when the locator supports concurrent queries (see
+   * SupportsConcurrentQueries()). The results are stored at the index of their query.
+   *
+   * FindCells stores the ids of the cells containing the points, or -1, in cellIds. The optional
+   * pcoords array receives 3 components per point, and the optional weights array
+   * `GetDataSet()->GetMaxCellSize()` components per point, of which only the number of points of
+   * the found cell are meaningful.
+   *
+   * FindClosestPoints stores the closest points in closestPoints, the ids of the cells they lie on
+   * in cellIds, and optionally their squared distances to the points in dist2. vtkCellTreeLocator,
+   * which does not implement FindClosestPoint, rejects the whole batch with a single error.
+   *
+   * IntersectWithLines stores the id of the first cell intersected by each segment, or -1, in
+   * cellIds, and optionally the intersection points in x and their parametric positions along the
+   * segments in t. Intersection points and positions of segments that miss are left undefined.
+   *
+   * THESE FUNCTIONS ARE NOT THREAD SAFE, as they may build the locator.
+   */
+  virtual void FindCells(vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr,
+    vtkDoubleArray* weights = nullptr);
+  virtual void FindClosestPoints(vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds,
+    vtkDoubleArray* dist2 = nullptr);
+  virtual void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds,
+    vtkPoints* x = nullptr, vtkDoubleArray* t = nullptr);
+  ///@}
+
+  /**
+   * Return true if the thread safe query methods, taking a vtkGenericCell, can be called
+   * concurrently once the locator is built. Batched queries are processed in parallel for such
+   * locators only. Default is false.
+   */
+  virtual bool SupportsConcurrentQueries() { return false; }
+
+  /**
+   * Flags of the cells visited by one query, for use in the implementation of thread safe
+   * queries. The flags are borrowed from the locator on construction, all unset, and given back
+   * on destruction after unsetting the ones set by the query. Concurrent queries thus each get
+   * their own flags without allocating a flag per cell for every query.
+   */
+  class VTKCOMMONDATAMODEL_EXPORT vtkVisitedCells
+  {
+  public:
+    vtkVisitedCells(vtkAbstractCellLocator* locator, vtkIdType numberOfCells);
+    ~vtkVisitedCells();
+
+    bool IsVisited(vtkIdType cellId) const { return this->Flags->Visited[cellId]; }
+    void Visit(vtkIdType cellId)
+    {
+      this->Flags->Visited[cellId] = true;
+      this->Flags->Touched.push_back(cellId);
+    }
+    void Unvisit(vtkIdType cellId) { this->Flags->Visited[cellId] = false; }
+
+    struct FlagSet
+    {
+      std::vector<bool> Visited;
+      std::vector<vtkIdType> Touched; // cells set since the flags were borrowed
+    };
+
+  private:
+    vtkAbstractCellLocator* Locator;
+    std::unique_ptr<FlagSet> Flags;
+
+    vtkVisitedCells(const vtkVisitedCells&) = delete;
+    void operator=(const vtkVisitedCells&) = delete;
+  };
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
@@ -343,6 +417,13 @@ protected:
    */
   void GetCellBounds(vtkIdType cellId, double*& cellBoundsPtr);
 
+  /**
+   * Compute the order in which the batched queries located at points are processed: queries are
+   * sorted along a space filling curve over the bounds of the data set, so that consecutive
+   * queries visit the same parts of the locator.
+   */
+  void ComputeQueryOrder(vtkPoints* points, std::vector<vtkIdType>& order);
+
   /**
    * This array is resized so that it can fit points from the cell hosting the most in the input
    * data set. Resizing is done in `UpdateInternalWeights`.
@@ -352,6 +433,10 @@ protected:
   std::vector<double> Weights;
 
 private:
+  // Flags of visited cells given back by the queries, see vtkVisitedCells
+  std::vector<std::unique_ptr<vtkVisitedCells::FlagSet>> VisitedCellsPool;
+  std::mutex VisitedCellsMutex;
+
   vtkAbstractCellLocator(const vtkAbstractCellLocator&) = delete;
   void operator=(const vtkAbstractCellLocator&) = delete;
 };
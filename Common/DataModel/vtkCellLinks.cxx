@@ -7,8 +7,12 @@
 #include "vtkGenericCell.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -22,6 +26,8 @@ vtkCellLinks::vtkCellLinks()
   , Size(0)
   , MaxId(-1)
   , Extend(1000)
+  , Pool(nullptr)
+  , PoolSize(0)
   , NumberOfPoints(0)
   , NumberOfCells(0)
 {
@@ -43,12 +49,15 @@ void vtkCellLinks::Initialize()
     {
       for (vtkIdType i = 0; i <= this->MaxId; i++)
       {
-        delete[] this->Array[i].cells;
+        this->FreeCells(this->Array[i].cells);
       }
     }
     // this->ArraySharedPtr will be reset by the destructor
     this->Array = nullptr;
   }
+  this->PoolSharedPtr.reset();
+  this->Pool = nullptr;
+  this->PoolSize = 0;
   this->Size = 0;
   this->NumberOfPoints = 0;
   this->NumberOfCells = 0;
@@ -68,13 +77,26 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 }
 
 //----------------------------------------------------------------------------
-// Allocate memory for the list of lists of cell ids.
+// Allocate memory for the list of lists of cell ids. All the lists are taken
+// from one pool, which saves an allocation per point. The pool has an extra
+// entry so that empty lists at the end are not null.
 void vtkCellLinks::AllocateLinks(vtkIdType n)
 {
+  std::vector<vtkIdType> offsets(n);
+  vtkIdType size = 0;
+  for (vtkIdType ptId = 0; ptId < n; ++ptId)
+  {
+    offsets[ptId] = size;
+    size += this->Array[ptId].ncells;
+  }
+
+  this->PoolSharedPtr.reset(new vtkIdType[size + 1], std::default_delete<vtkIdType[]>());
+  this->Pool = this->PoolSharedPtr.get();
+  this->PoolSize = size + 1;
   vtkSMPTools::For(0, n, [&](vtkIdType beginPtId, vtkIdType endPtId) {
     for (vtkIdType ptId = beginPtId; ptId < endPtId; ++ptId)
     {
-      this->Array[ptId].cells = new vtkIdType[this->Array[ptId].ncells];
+      this->Array[ptId].cells = this->Pool + offsets[ptId];
     }
   });
 }
@@ -140,29 +162,44 @@ void vtkCellLinks::BuildLinks()
   }
   vtkIdType numPts = this->NumberOfPoints = this->DataSet->GetNumberOfPoints();
   vtkIdType numCells = this->NumberOfCells = this->DataSet->GetNumberOfCells();
-  int j;
-  vtkIdType cellId;
 
-  if (this->Array == nullptr)
+  // Start from empty lists. This is checked to capture changes in the size of
+  // the allocation, otherwise the allocated size, which may account for points
+  // inserted later, is kept.
+  if (this->Array == nullptr ||
+    (this->DataSet->GetMTime() > this->BuildTime && this->DataSet->GetMTime() > this->MTime))
   {
-    this->Allocate(numPts);
+    this->Allocate(numPts, this->Extend);
   }
-  // This is checked to capture changes in the size of the allocation
-  else if (this->DataSet->GetMTime() > this->BuildTime && this->DataSet->GetMTime() > this->MTime)
+  else
   {
-    this->Allocate(numPts);
+    this->Allocate(std::max(this->Size, numPts), this->Extend);
   }
 
-  // Use fast path if polydata
+  if (this->SequentialProcessing)
+  {
+    this->SerialBuildLinks(numPts, numCells);
+  }
+  else
+  {
+    this->ThreadedBuildLinks(numPts, numCells);
+  }
+  this->MaxId = numPts - 1;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkCellLinks::SerialBuildLinks(vtkIdType numPts, vtkIdType numCells)
+{
   vtkIdType npts;
   const vtkIdType* pts;
   vtkNew<vtkIdList> tempIds;
 
   // traverse data to determine number of uses of each point
-  for (cellId = 0; cellId < numCells; cellId++)
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
   {
     this->DataSet->GetCellPoints(cellId, npts, pts, tempIds);
-    for (j = 0; j < npts; j++)
+    for (vtkIdType j = 0; j < npts; j++)
     {
       this->IncrementLinkCount(pts[j]);
     }
@@ -174,16 +211,79 @@ void vtkCellLinks::BuildLinks()
   // now allocate storage for the links
   this->AllocateLinks(numPts);
   // fill out lists with cell ids
-  for (cellId = 0; cellId < numCells; cellId++)
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
   {
     this->DataSet->GetCellPoints(cellId, npts, pts, tempIds);
-    for (j = 0; j < npts; j++)
+    for (vtkIdType j = 0; j < npts; j++)
     {
       this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);
     }
   }
-  this->MaxId = numPts - 1;
-  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+// Same as SerialBuildLinks(), counting and inserting the uses of each point
+// with atomics.
+void vtkCellLinks::ThreadedBuildLinks(vtkIdType numPts, vtkIdType numCells)
+{
+  // Make GetCellPoints() thread safe by calling it once from a single thread
+  if (numCells > 0)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkNew<vtkIdList> tempIds;
+    this->DataSet->GetCellPoints(0, npts, pts, tempIds);
+  }
+
+  // memory_order_relaxed is safe here, since we're not using the atomics for synchronization.
+  std::unique_ptr<std::atomic<vtkIdType>[]> counts(new std::atomic<vtkIdType>[numPts]());
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* tempIds = tlIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      this->DataSet->GetCellPoints(cellId, npts, pts, tempIds);
+      for (vtkIdType j = 0; j < npts; j++)
+      {
+        counts[pts[j]].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->Array[ptId].ncells = counts[ptId].load(std::memory_order_relaxed);
+      counts[ptId].store(0, std::memory_order_relaxed);
+    }
+  });
+  this->AllocateLinks(numPts);
+
+  // Reuse the counts as insertion locations
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* tempIds = tlIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      this->DataSet->GetCellPoints(cellId, npts, pts, tempIds);
+      for (vtkIdType j = 0; j < npts; j++)
+      {
+        this->InsertCellReference(
+          pts[j], counts[pts[j]].fetch_add(1, std::memory_order_relaxed), cellId);
+      }
+    }
+  });
+
+  // Cells were inserted in any order: sort them as the serial build does
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      std::sort(this->Array[ptId].cells, this->Array[ptId].cells + this->Array[ptId].ncells);
+    }
+  });
 }
 
 //------------------------------------------------------------------------------
@@ -248,13 +348,15 @@ void vtkCellLinks::DeepCopy(vtkAbstractCellLinks* src)
   }
   this->SetSequentialProcessing(src->GetSequentialProcessing());
   this->Allocate(cellLinks->Size, cellLinks->Extend);
+  for (vtkIdType ptId = 0; ptId <= cellLinks->MaxId; ++ptId)
+  {
+    this->Array[ptId].ncells = cellLinks->GetNcells(ptId);
+  }
+  this->AllocateLinks(cellLinks->MaxId + 1);
   vtkSMPTools::For(0, cellLinks->MaxId + 1, [&](vtkIdType ptId, vtkIdType endPtId) {
     for (; ptId < endPtId; ++ptId)
     {
-      vtkIdType ncells = cellLinks->GetNcells(ptId);
-      this->Array[ptId].cells = new vtkIdType[ncells];
-      this->Array[ptId].ncells = ncells;
-      std::copy_n(cellLinks->Array[ptId].cells, ncells, this->Array[ptId].cells);
+      std::copy_n(cellLinks->Array[ptId].cells, this->Array[ptId].ncells, this->Array[ptId].cells);
     }
   });
   this->MaxId = cellLinks->MaxId;
@@ -275,6 +377,9 @@ void vtkCellLinks::ShallowCopy(vtkAbstractCellLinks* src)
   this->SetSequentialProcessing(src->GetSequentialProcessing());
   this->ArraySharedPtr = cellLinks->ArraySharedPtr;
   this->Array = this->ArraySharedPtr.get();
+  this->PoolSharedPtr = cellLinks->PoolSharedPtr;
+  this->Pool = cellLinks->Pool;
+  this->PoolSize = cellLinks->PoolSize;
   this->Size = cellLinks->Size;
   this->MaxId = cellLinks->MaxId;
   this->Extend = cellLinks->Extend;
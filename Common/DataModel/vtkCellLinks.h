@@ -10,6 +10,11 @@
  * using the point. The information provided by this object can be used to
  * determine neighbors and construct other local topological information.
  *
+ * BuildLinks() is threaded unless SequentialProcessing is enabled. The lists
+ * it builds are carved out of a single pooled allocation rather than
+ * allocated point by point; they remain editable, a list leaving the pool
+ * when it is resized.
+ *
  * @warning
  * vtkCellLinks supports incremental (i.e., "editable") operations such as
  * inserting a new cell, or deleting a point. Because of this, it is less
@@ -181,8 +186,32 @@ protected:
    */
   void IncrementLinkCount(vtkIdType ptId) { this->Array[ptId].ncells++; }
 
+  /**
+   * Allocate the lists of cell ids of the first n points, sized by their
+   * number of cells, from a single pool.
+   */
   void AllocateLinks(vtkIdType n);
 
+  ///@{
+  /**
+   * Fill the links from the cells of the dataset, either serially or with
+   * vtkSMPTools.
+   */
+  void SerialBuildLinks(vtkIdType numPts, vtkIdType numCells);
+  void ThreadedBuildLinks(vtkIdType numPts, vtkIdType numCells);
+  ///@}
+
+  /**
+   * Free a list of cell ids unless it belongs to the pool.
+   */
+  void FreeCells(vtkIdType* cells)
+  {
+    if (cells < this->Pool || cells >= this->Pool + this->PoolSize)
+    {
+      delete[] cells;
+    }
+  }
+
   /**
    * Insert a cell id into the list of cells using the point.
    */
@@ -195,6 +224,11 @@ protected:
   vtkIdType Extend;                     // grow array by this point
   Link* Resize(vtkIdType sz);           // function to resize data
 
+  // Pool holding the lists built by BuildLinks(), shared by shallow copies
+  std::shared_ptr<vtkIdType> PoolSharedPtr;
+  vtkIdType* Pool;
+  vtkIdType PoolSize;
+
   // Some information recorded at build time
   vtkIdType NumberOfPoints;
   vtkIdType NumberOfCells;
@@ -214,7 +248,7 @@ inline void vtkCellLinks::InsertCellReference(vtkIdType ptId, vtkIdType pos, vtk
 inline void vtkCellLinks::DeletePoint(vtkIdType ptId)
 {
   this->Array[ptId].ncells = 0;
-  delete[] this->Array[ptId].cells;
+  this->FreeCells(this->Array[ptId].cells);
   this->Array[ptId].cells = nullptr;
 }
 
@@ -257,7 +291,7 @@ inline void vtkCellLinks::ResizeCellList(vtkIdType ptId, int size)
   vtkIdType* cells = new vtkIdType[newSize];
   memcpy(cells, this->Array[ptId].cells,
     static_cast<size_t>(this->Array[ptId].ncells) * sizeof(vtkIdType));
-  delete[] this->Array[ptId].cells;
+  this->FreeCells(this->Array[ptId].cells);
   this->Array[ptId].cells = cells;
 }
 
@@ -164,9 +164,9 @@ int vtkCellLocator::IntersectWithLine(const double p1[3], const double p2[3], do
     return 0; // No intersections possible, line is outside the locator
   }
 
-  // Initialize intersection query array if necessary. This is done
-  // locally to ensure thread safety.
-  std::vector<bool> cellHasBeenVisited(this->DataSet->GetNumberOfCells(), false);
+  // Flags of the cells already tested, borrowed from the locator for this
+  // query only to ensure thread safety.
+  vtkVisitedCells visitedCells(this, this->DataSet->GetNumberOfCells());
 
   // Get the i-j-k point of intersection and bin index. This is
   // clamped to the boundary of the locator.
@@ -202,9 +202,9 @@ int vtkCellLocator::IntersectWithLine(const double p1[3], const double p2[3], do
       for (i = 0; i < numberOfCellsInBucket; ++i)
       {
         cId = this->Tree[idx]->GetId(i);
-        if (!cellHasBeenVisited[cId])
+        if (!visitedCells.IsVisited(cId))
         {
-          cellHasBeenVisited[cId] = true;
+          visitedCells.Visit(cId);
 
           // check whether we intersect the cell bounds
           cellBoundsPtr = cellBounds;
@@ -223,7 +223,7 @@ int vtkCellLocator::IntersectWithLine(const double p1[3], const double p2[3], do
               // intersections can occur behind this bin which are not the correct answer.
               if (!vtkAbstractCellLocator::IsInBounds(octantBounds, x, tol))
               {
-                cellHasBeenVisited[cId] = false; // mark the cell non-visited
+                visitedCells.Unvisit(cId); // mark the cell non-visited
               }
               else
               {
@@ -335,7 +335,7 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
   size_t nPoints;
   int returnVal = 0;
   vtkIdList* cellIds;
-  std::vector<bool> cellHasBeenVisited(this->DataSet->GetNumberOfCells(), false);
+  vtkVisitedCells visitedCells(this, this->DataSet->GetNumberOfCells());
   vtkNeighborCells buckets(10);
   std::vector<double> weights(8);
 
@@ -374,11 +374,11 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
       // get the cell
       cellId = cellIds->GetId(j);
       // skip if it has been visited
-      if (cellHasBeenVisited[cellId])
+      if (visitedCells.IsVisited(cellId))
       {
         continue;
       }
-      cellHasBeenVisited[cellId] = true;
+      visitedCells.Visit(cellId);
 
       // check whether we could be close enough to the cell by
       this->GetCellBounds(cellId, cellBoundsPtr);
@@ -491,11 +491,11 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
             // get the cell
             cellId = cellIds->GetId(j);
             // skip if it has been visited
-            if (cellHasBeenVisited[cellId])
+            if (visitedCells.IsVisited(cellId))
             {
               continue;
             }
-            cellHasBeenVisited[cellId] = true;
+            visitedCells.Visit(cellId);
 
             // check whether we could be close enough to the cell by
             this->GetCellBounds(cellId, cellBoundsPtr);
@@ -1257,9 +1257,9 @@ int vtkCellLocator::IntersectWithLine(const double p1[3], const double p2[3], do
     return 0; // No intersections possible, line is outside the locator
   }
 
-  // Initialize intersection query array if necessary. This is done
-  // locally to ensure thread safety.
-  std::vector<bool> cellHasBeenVisited(this->DataSet->GetNumberOfCells(), false);
+  // Flags of the cells already tested, borrowed from the locator for this
+  // query only to ensure thread safety.
+  vtkVisitedCells visitedCells(this, this->DataSet->GetNumberOfCells());
 
   // Get the i-j-k point of intersection and bin index. This is
   // clamped to the boundary of the locator.
@@ -1298,9 +1298,9 @@ int vtkCellLocator::IntersectWithLine(const double p1[3], const double p2[3], do
       for (i = 0; i < numberOfCellsInBucket; ++i)
       {
         cId = this->Tree[idx]->GetId(i);
-        if (!cellHasBeenVisited[cId])
+        if (!visitedCells.IsVisited(cId))
         {
-          cellHasBeenVisited[cId] = true;
+          visitedCells.Visit(cId);
 
           // check whether we intersect the cell bounds
           this->GetCellBounds(cId, cellBoundsPtr);
@@ -1309,7 +1309,7 @@ int vtkCellLocator::IntersectWithLine(const double p1[3], const double p2[3], do
 
           if (hitCellBounds)
           {
-            // Note because of cellHasBeenVisited[], we know this cId is unique
+            // Note because of visitedCells, we know this cId is unique
             if (cell)
             {
               this->DataSet->GetCell(cId, cell);
@@ -1319,7 +1319,7 @@ int vtkCellLocator::IntersectWithLine(const double p1[3], const double p2[3], do
                 // intersections can occur behind this bin which are not the correct answer.
                 if (!vtkAbstractCellLocator::IsInBounds(octantBounds, x, tol))
                 {
-                  cellHasBeenVisited[cId] = false; // mark the cell non-visited
+                  visitedCells.Unvisit(cId); // mark the cell non-visited
                 }
                 else
                 {
@@ -150,6 +150,11 @@ public:
     this->Superclass::FindCellsAlongLine(p1, p2, tolerance, cellsIds);
   }
 
+  /**
+   * Queries only read the octree once it is built, so batched queries run in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   ///@{
   /**
    * Satisfy vtkLocator abstract interface.
@@ -10,6 +10,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <array>
@@ -319,6 +321,13 @@ private:
         this->Max = max;
       }
     }
+
+    inline void Merge(const Bucket& other)
+    {
+      this->Cnt += other.Cnt;
+      this->Min = std::min(this->Min, other.Min);
+      this->Max = std::max(this->Max, other.Max);
+    }
   };
 
   struct CellInfo
@@ -375,15 +384,24 @@ private:
   using TCellTree = CellTree<T>;
   using TCellTreeNode = typename TCellTree::TCellTreeNode;
 
+  using NodesType = std::vector<TCellTreeNode>;
+  using SplitStackType = std::stack<SplitInfo>;
+
+  // Nodes holding less cells are split as independent subtrees, in parallel.
+  static constexpr T MinimumSubtreeSize = 4096;
+  // Nodes holding more cells than this are bucketed in parallel.
+  static constexpr T MinimumParallelBucketingSize = 65536;
+
   vtkCellTreeLocator* Locator;
   TCellTree& Tree;
   vtkDataSet* DataSet;
   int NumberOfBuckets;
   int NumberOfNodesPerLeaf;
+  T SubtreeSize;
 
   std::vector<CellInfo> CellsInfo;
-  std::vector<CellTreeNode<T>> Nodes;
-  std::stack<SplitInfo> SplitStack;
+  NodesType Nodes;
+  SplitStackType SplitStack;
 
   struct BucketsType : public std::array<std::vector<Bucket>, 3>
   {
@@ -437,10 +455,53 @@ private:
   }
 
   // -------------------------------------------------------------------------
-  void Split(T index, double min[3], double max[3], BucketsType& buckets)
+  void FillBuckets(const CellInfo* begin, const CellInfo* end, const double* min,
+    const double* iext, BucketsType& buckets)
+  {
+    for (const CellInfo* pc = begin; pc != end; ++pc)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        double cen = (pc->Min[d] + pc->Max[d]) / 2.0;
+        double dblIdx = (cen - min[d]) * iext[d];
+        dblIdx = vtkMath::ClampValue(dblIdx, 0.0, static_cast<double>(this->NumberOfBuckets - 1));
+        size_t ind = static_cast<size_t>(dblIdx);
+
+        buckets[d][ind].Add(pc->Min[d], pc->Max[d]);
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // Bucket large nodes in parallel. Counts are summed and bounds are merged, so that the buckets
+  // are the same as the ones filled serially.
+  void FillBucketsInParallel(const CellInfo* begin, const CellInfo* end, const double* min,
+    const double* iext, BucketsType& buckets)
+  {
+    vtkSMPThreadLocal<BucketsType> localBuckets(BucketsType(this->NumberOfBuckets));
+    vtkSMPTools::For(0, end - begin,
+      [&](vtkIdType first, vtkIdType last)
+      { this->FillBuckets(begin + first, begin + last, min, iext, localBuckets.Local()); });
+
+    for (const auto& local : localBuckets)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        for (int n = 0; n < this->NumberOfBuckets; ++n)
+        {
+          buckets[d][n].Merge(local[d][n]);
+        }
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // Split the node at index in nodes, pushing its children on splitStack.
+  void Split(NodesType& nodes, SplitStackType& splitStack, T index, double min[3], double max[3],
+    BucketsType& buckets, bool parallelBucketing)
   {
-    const T& start = this->Nodes[index].Start();
-    const T& size = this->Nodes[index].Size();
+    const T& start = nodes[index].Start();
+    const T& size = nodes[index].Size();
 
     if (size < this->NumberOfNodesPerLeaf)
     {
@@ -456,18 +517,13 @@ private:
       this->NumberOfBuckets / ext[2] };
 
     buckets.Reset();
-
-    for (const CellInfo* pc = begin; pc != end; ++pc)
+    if (parallelBucketing && size > MinimumParallelBucketingSize)
     {
-      for (uint8_t d = 0; d < 3; ++d)
-      {
-        double cen = (pc->Min[d] + pc->Max[d]) / 2.0;
-        double dblIdx = (cen - min[d]) * iext[d];
-        dblIdx = vtkMath::ClampValue(dblIdx, 0.0, static_cast<double>(this->NumberOfBuckets - 1));
-        size_t ind = static_cast<size_t>(dblIdx);
-
-        buckets[d][ind].Add(pc->Min[d], pc->Max[d]);
-      }
+      this->FillBucketsInParallel(begin, end, min, iext, buckets);
+    }
+    else
+    {
+      this->FillBuckets(begin, end, min, iext, buckets);
     }
 
     double cost = VTK_DOUBLE_MAX;
@@ -546,11 +602,27 @@ private:
     child[0].MakeLeaf(begin - this->CellsInfo.data(), mid - begin);
     child[1].MakeLeaf(mid - this->CellsInfo.data(), end - mid);
 
-    this->Nodes[index].MakeNode(static_cast<T>(this->Nodes.size()), dim, clip);
-    this->Nodes.insert(this->Nodes.end(), child, child + 2);
+    nodes[index].MakeNode(static_cast<T>(nodes.size()), dim, clip);
+    nodes.insert(nodes.end(), child, child + 2);
 
-    this->SplitStack.emplace(this->Nodes[index].GetRightChildIndex(), rMin, rMax);
-    this->SplitStack.emplace(this->Nodes[index].GetLeftChildIndex(), lMin, lMax);
+    splitStack.emplace(nodes[index].GetRightChildIndex(), rMin, rMax);
+    splitStack.emplace(nodes[index].GetLeftChildIndex(), lMin, lMax);
+  }
+
+  // -------------------------------------------------------------------------
+  // Build the subtree below the leaf at index in this->Nodes, in nodes. The subtree root is
+  // nodes[0], its other nodes are indexed relative to it.
+  void BuildSubtree(const SplitInfo& subtree, NodesType& nodes, BucketsType& buckets)
+  {
+    nodes.push_back(this->Nodes[subtree.Index]);
+    SplitStackType splitStack;
+    splitStack.emplace(0, subtree.Min, subtree.Max);
+    while (!splitStack.empty())
+    {
+      auto splitInfo = std::move(splitStack.top());
+      splitStack.pop();
+      this->Split(nodes, splitStack, splitInfo.Index, splitInfo.Min, splitInfo.Max, buckets, false);
+    }
   }
 
 public:
@@ -564,36 +636,34 @@ public:
   {
     const auto numberOfCells = static_cast<T>(this->DataSet->GetNumberOfCells());
     this->CellsInfo.resize(static_cast<size_t>(numberOfCells));
+    this->SubtreeSize = std::max(numberOfCells / 256, static_cast<T>(MinimumSubtreeSize));
 
-    double min[3] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
-    double max[3] = {
-      -VTK_DOUBLE_MAX,
-      -VTK_DOUBLE_MAX,
-      -VTK_DOUBLE_MAX,
-    };
-
+    // This is done to cause non-thread safe initialization to occur due to
+    // side effects from GetCellBounds().
     double cellBounds[6], *cellBoundsPtr;
     cellBoundsPtr = cellBounds;
-    for (T i = 0; i < numberOfCells; ++i)
-    {
-      this->CellsInfo[i].Ind = i;
-      this->Locator->GetCellBounds(i, cellBoundsPtr);
+    this->Locator->GetCellBounds(0, cellBoundsPtr);
 
-      for (uint8_t d = 0; d < 3; ++d)
+    vtkSMPTools::For(0, numberOfCells,
+      [&](T begin, T end)
       {
-        this->CellsInfo[i].Min[d] = cellBoundsPtr[2 * d + 0];
-        this->CellsInfo[i].Max[d] = cellBoundsPtr[2 * d + 1];
-
-        if (this->CellsInfo[i].Min[d] < min[d])
-        {
-          min[d] = this->CellsInfo[i].Min[d];
-        }
-        if (this->CellsInfo[i].Max[d] > max[d])
+        double localBounds[6], *localBoundsPtr;
+        for (T i = begin; i < end; ++i)
         {
-          max[d] = this->CellsInfo[i].Max[d];
+          localBoundsPtr = localBounds;
+          this->CellsInfo[i].Ind = i;
+          this->Locator->GetCellBounds(i, localBoundsPtr);
+
+          for (uint8_t d = 0; d < 3; ++d)
+          {
+            this->CellsInfo[i].Min[d] = localBoundsPtr[2 * d + 0];
+            this->CellsInfo[i].Max[d] = localBoundsPtr[2 * d + 1];
+          }
         }
-      }
-    }
+      });
+
+    double min[3], max[3];
+    this->FindMinMax(this->CellsInfo.data(), this->CellsInfo.data() + numberOfCells, min, max);
 
     this->Tree.DataBBox[0] = min[0];
     this->Tree.DataBBox[1] = max[0];
@@ -617,12 +687,51 @@ public:
 
   void operator()()
   {
+    // Split the top of the tree until the nodes are small enough to be built independently. Each
+    // split only reorders the cells of its node, so the tree does not depend on the order in which
+    // the nodes are split.
+    std::vector<SplitInfo> subtrees;
     auto& buckets = this->Buckets;
     while (!this->SplitStack.empty())
     {
       auto splitInfo = std::move(this->SplitStack.top());
       this->SplitStack.pop();
-      this->Split(splitInfo.Index, splitInfo.Min, splitInfo.Max, buckets);
+      if (this->Nodes[splitInfo.Index].Size() <= this->SubtreeSize)
+      {
+        subtrees.push_back(std::move(splitInfo));
+        continue;
+      }
+      this->Split(this->Nodes, this->SplitStack, splitInfo.Index, splitInfo.Min, splitInfo.Max,
+        buckets, true);
+    }
+
+    std::vector<NodesType> subtreesNodes(subtrees.size());
+    vtkSMPThreadLocal<BucketsType> localBuckets(BucketsType(this->NumberOfBuckets));
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          this->BuildSubtree(subtrees[i], subtreesNodes[i], localBuckets.Local());
+        }
+      });
+
+    // Append the subtrees to the top of the tree. The subtree nodes following their root are
+    // moved at the end of the tree nodes.
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      NodesType& nodes = subtreesNodes[i];
+      const T offset = static_cast<T>(this->Nodes.size()) - 1;
+      for (auto& node : nodes)
+      {
+        if (node.IsNode())
+        {
+          node.SetChildren(node.GetLeftChildIndex() + offset);
+        }
+      }
+      this->Nodes[subtrees[i].Index] = nodes[0];
+      this->Nodes.insert(this->Nodes.end(), nodes.begin() + 1, nodes.end());
+      nodes = NodesType();
     }
   }
 
@@ -1318,7 +1427,7 @@ void vtkCellTreeLocator::BuildLocatorInternal()
 {
   using namespace detail;
   vtkIdType numCells;
-  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells() < 1))
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
   {
     vtkErrorMacro(<< " No Cells in the data set\n");
     return;
@@ -1399,6 +1508,15 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
   return this->Tree->IntersectWithLine(p1, p2, tol, points, cellIds, cell);
 }
 
+//------------------------------------------------------------------------------
+void vtkCellTreeLocator::FindClosestPoints(vtkPoints* vtkNotUsed(points),
+  vtkPoints* vtkNotUsed(closestPoints), vtkIdList* vtkNotUsed(cellIds),
+  vtkDoubleArray* vtkNotUsed(dist2))
+{
+  vtkErrorMacro(<< "The locator class - " << this->GetClassName()
+                << " does not yet support FindClosestPoints");
+}
+
 //------------------------------------------------------------------------------
 void vtkCellTreeLocator::GenerateRepresentation(int level, vtkPolyData* pd)
 {
@@ -13,6 +13,9 @@
  * Some methods in building and traversing the cell tree in this class were derived
  * from avtCellLocatorBIH class in the VisIT Visualization Tool.
  *
+ * The cell bounds are computed, the largest nodes are bucketed, and the subtrees below them are
+ * built in parallel using vtkSMPTools. The resulting tree does not depend on the number of threads.
+ *
  * vtkCellTreeLocator utilizes the following parent class parameters:
  * - NumberOfCellsPerNode        (default 8)
  * - CacheCellBounds             (default true)
@@ -147,6 +150,18 @@ public:
   vtkIdType FindCell(double pos[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * The cell tree does not support closest point queries: the batch is rejected with a single
+   * error, leaving the outputs untouched.
+   */
+  void FindClosestPoints(vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds,
+    vtkDoubleArray* dist2 = nullptr) override;
+
+  /**
+   * Traversing the cell tree does not modify it, so batched queries are processed in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   ///@{
   /**
    * Satisfy vtkLocator abstract interface.
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkHyperTreeGridSMPTools.h"
+
+#include "vtkBitArray.h"
+#include "vtkHyperTree.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridScales.h"
+
+#include <algorithm>
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkHyperTreeGridSMPTools::GetTreeIndices(
+  vtkHyperTreeGrid* grid, std::vector<vtkIdType>& treeIndices)
+{
+  treeIndices.clear();
+  if (!grid)
+  {
+    return;
+  }
+
+  // Cursors may look one level below the deepest leaf of a tree (super cursors
+  // follow their neighbors), so sizes are computed down to that level.
+  const unsigned int numberOfLevels = grid->GetNumberOfLevels() + 1;
+
+  vtkIdType index;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  grid->InitializeTreeIterator(it);
+  while (vtkHyperTree* tree = it.GetNextTree(index))
+  {
+    treeIndices.push_back(index);
+    if (tree->HasScales())
+    {
+      tree->GetScales()->GetScale(numberOfLevels);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeGridSMPTools::GetTreeRanges(vtkHyperTreeGrid* grid,
+  const std::vector<vtkIdType>& treeIndices, std::vector<vtkIdType>& ranges)
+{
+  const vtkIdType numberOfTrees = static_cast<vtkIdType>(treeIndices.size());
+  const vtkIdType numberOfRanges = std::min<vtkIdType>(
+    numberOfTrees, 4 * static_cast<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads()));
+  ranges.assign(1, 0);
+  if (numberOfRanges <= 1)
+  {
+    ranges.push_back(numberOfTrees);
+    return;
+  }
+
+  // Trees are weighted with their number of vertices: a few deep trees may
+  // hold most of the cells of the grid.
+  std::vector<vtkIdType> sizes(numberOfTrees);
+  vtkIdType totalSize = 0;
+  for (vtkIdType position = 0; position < numberOfTrees; ++position)
+  {
+    vtkHyperTree* tree = grid->GetTree(treeIndices[position]);
+    sizes[position] = tree ? tree->GetNumberOfVertices() : 1;
+    totalSize += sizes[position];
+  }
+
+  vtkIdType accumulated = 0;
+  for (vtkIdType position = 0; position < numberOfTrees; ++position)
+  {
+    accumulated += sizes[position];
+    const vtkIdType range = static_cast<vtkIdType>(ranges.size());
+    if (range < numberOfRanges && accumulated * numberOfRanges >= range * totalSize)
+    {
+      ranges.push_back(position + 1);
+    }
+  }
+  if (ranges.back() != numberOfTrees)
+  {
+    ranges.push_back(numberOfTrees);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkHyperTreeGridSMPTools::ComputeOffsets(std::vector<vtkIdType>& counts)
+{
+  vtkIdType offset = 0;
+  for (vtkIdType& count : counts)
+  {
+    const vtkIdType next = offset + count;
+    count = offset;
+    offset = next;
+  }
+  return offset;
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeGridSMPTools::CopyToBitArray(
+  const std::vector<unsigned char>& values, vtkBitArray* array)
+{
+  const vtkIdType numberOfValues = static_cast<vtkIdType>(values.size());
+  array->SetNumberOfComponents(1);
+  array->SetNumberOfTuples(numberOfValues);
+
+  // Each thread packs whole bytes, most significant bit first as vtkBitArray does
+  unsigned char* bytes = array->GetPointer(0);
+  vtkSMPTools::For(0, (numberOfValues + 7) / 8,
+    [&values, bytes, numberOfValues](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType byte = begin; byte < end; ++byte)
+      {
+        unsigned char packed = 0;
+        const vtkIdType first = 8 * byte;
+        const vtkIdType last = std::min(first + 8, numberOfValues);
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          if (values[i])
+          {
+            packed |= static_cast<unsigned char>(0x80 >> (i - first));
+          }
+        }
+        bytes[byte] = packed;
+      }
+    });
+  array->DataChanged();
+}
+VTK_ABI_NAMESPACE_END
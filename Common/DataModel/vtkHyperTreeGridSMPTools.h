@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkHyperTreeGridSMPTools
+ * @brief   process the trees of a hypertree grid in parallel
+ *
+ * The trees of a vtkHyperTreeGrid do not depend on each other, so filters
+ * which visit them one at a time with a vtkHyperTreeGrid::vtkHyperTreeGridIterator
+ * can as well visit them concurrently with vtkSMPTools. This class gathers
+ * what is needed to do so safely:
+ *
+ * - GetTreeIndices() lists the trees in the order of the tree iterator, and
+ *   computes beforehand the cell sizes of all the levels of their scales.
+ *   These sizes are otherwise cached lazily by the geometry cursors, which
+ *   cannot be done from several threads.
+ * - ForEachTree() calls a functor for each tree, in parallel. The functor is
+ *   given a cursor of the requested type, owned by the calling thread and
+ *   initialized at the root of the tree.
+ * - GetTreeRanges() splits the trees into contiguous ranges of similar sizes,
+ *   for filters that build one partial output per range and append them.
+ * - ComputeOffsets() turns per tree output sizes into output offsets.
+ * - CopyToBitArray() fills a bit array from values computed concurrently
+ *   with one byte each.
+ *
+ * The last two keep the output of a filter identical to the output of a
+ * serial traversal: either outputs are first counted per tree, then written
+ * in parallel at their final position, or they are built per range of trees
+ * and appended in the order of the ranges.
+ *
+ * The grid must not be modified while its trees are processed in parallel.
+ * In particular the trees of an output grid must be created beforehand with
+ * vtkHyperTreeGrid::GetTree(index, true), and bit arrays must not be written
+ * from several threads since neighboring values share the same byte.
+ *
+ * @sa
+ * vtkHyperTreeGrid vtkSMPTools vtkHyperTreeGridNonOrientedCursor
+ */
+
+#ifndef vtkHyperTreeGridSMPTools_h
+#define vtkHyperTreeGridSMPTools_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkSMPThreadLocalObject.h"  // For thread local cursors
+#include "vtkSMPTools.h"              // For vtkSMPTools::For
+#include "vtkType.h"                  // For vtkIdType
+
+#include <atomic> // For std::atomic
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkBitArray;
+class vtkHyperTreeGrid;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkHyperTreeGridSMPTools
+{
+public:
+  /**
+   * Fill treeIndices with the indices of the trees of grid, in the order of
+   * vtkHyperTreeGrid::vtkHyperTreeGridIterator, and prepare the scales of the
+   * trees for concurrent traversals. This must be called, from a single
+   * thread, before traversing the trees of grid with ForEachTree().
+   */
+  static void GetTreeIndices(vtkHyperTreeGrid* grid, std::vector<vtkIdType>& treeIndices);
+
+  /**
+   * Call functor(position, cursor) for each position in treeIndices, in
+   * parallel. cursor is a CursorType (vtkHyperTreeGridNonOrientedCursor,
+   * vtkHyperTreeGridNonOrientedGeometryCursor, a super cursor, ...) local to
+   * the calling thread and initialized at the root of tree
+   * treeIndices[position]. The functor returns false to stop the traversal,
+   * for instance when the filter is aborted: the trees not yet processed are
+   * then skipped.
+   */
+  template <typename CursorType, typename Functor>
+  static void ForEachTree(
+    vtkHyperTreeGrid* grid, const std::vector<vtkIdType>& treeIndices, Functor& functor)
+  {
+    ForEachTreeWorker<CursorType, Functor> worker(grid, treeIndices, functor);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(treeIndices.size()), worker);
+  }
+
+  /**
+   * Split the trees listed in treeIndices into contiguous ranges with about
+   * as many vertices each, a few per thread. On output, the trees of range i
+   * are at positions ranges[i] to ranges[i + 1] - 1 of treeIndices. There is a
+   * single range if only one thread is available.
+   */
+  static void GetTreeRanges(vtkHyperTreeGrid* grid, const std::vector<vtkIdType>& treeIndices,
+    std::vector<vtkIdType>& ranges);
+
+  /**
+   * Replace each value of counts with the sum of the values before it, and
+   * return the sum of all of them. When counts holds the number of output
+   * items generated by each tree, this gives the output id of the first item
+   * of each tree.
+   */
+  static vtkIdType ComputeOffsets(std::vector<vtkIdType>& counts);
+
+  /**
+   * Resize array to the number of values and set its bits from them, a
+   * non-zero value giving a set bit. Filters set per cell flags (masks,
+   * selections) in such a byte vector while processing trees in parallel,
+   * then copy it into the bit array.
+   */
+  static void CopyToBitArray(const std::vector<unsigned char>& values, vtkBitArray* array);
+
+private:
+  template <typename CursorType, typename Functor>
+  struct ForEachTreeWorker
+  {
+    vtkHyperTreeGrid* Grid;
+    const std::vector<vtkIdType>& TreeIndices;
+    Functor& TreeFunctor;
+    vtkSMPThreadLocalObject<CursorType> Cursors;
+    std::atomic<bool> Stop;
+
+    ForEachTreeWorker(
+      vtkHyperTreeGrid* grid, const std::vector<vtkIdType>& treeIndices, Functor& functor)
+      : Grid(grid)
+      , TreeIndices(treeIndices)
+      , TreeFunctor(functor)
+      , Stop(false)
+    {
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      CursorType* cursor = this->Cursors.Local();
+      for (vtkIdType position = begin; position < end; ++position)
+      {
+        if (this->Stop.load(std::memory_order_relaxed))
+        {
+          return;
+        }
+        cursor->Initialize(this->Grid, this->TreeIndices[position]);
+        if (!this->TreeFunctor(position, cursor))
+        {
+          this->Stop = true;
+          return;
+        }
+      }
+    }
+  };
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkHyperTreeGridSMPTools.h
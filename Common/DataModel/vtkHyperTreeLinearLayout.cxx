@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkHyperTreeLinearLayout.h"
+
+#include "vtkBitArray.h"
+#include "vtkHyperTree.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkHyperTreeLinearLayout);
+
+//------------------------------------------------------------------------------
+vtkHyperTreeLinearLayout::vtkHyperTreeLinearLayout()
+{
+  this->NumberOfChildren = 0;
+  this->Origin[0] = this->Origin[1] = this->Origin[2] = 0.0;
+}
+
+//------------------------------------------------------------------------------
+vtkHyperTreeLinearLayout::~vtkHyperTreeLinearLayout() = default;
+
+//------------------------------------------------------------------------------
+bool vtkHyperTreeLinearLayout::Initialize(vtkHyperTreeGrid* grid, vtkIdType treeIndex)
+{
+  this->GlobalIndices.clear();
+  this->FirstChildren.clear();
+  this->Masked.clear();
+  this->LevelOffsets.clear();
+  this->LevelSizes.clear();
+  this->ChildOffsets.clear();
+  this->NumberOfChildren = 0;
+
+  vtkHyperTree* tree = grid ? grid->GetTree(treeIndex) : nullptr;
+  if (!tree)
+  {
+    return false;
+  }
+
+  // Offsets of the children along each axis, see vtkHyperTreeGridGeometryEntry::ToChild()
+  this->NumberOfChildren = tree->GetNumberOfChildren();
+  const unsigned int factor = tree->GetBranchFactor();
+  unsigned int axes[3] = { 0, 1, 2 };
+  if (tree->GetDimension() == 1)
+  {
+    axes[0] = grid->GetOrientation();
+  }
+  else if (tree->GetDimension() == 2)
+  {
+    axes[0] = grid->GetOrientation() == 0 ? 1 : 0;
+    axes[1] = grid->GetOrientation() == 2 ? 1 : 2;
+  }
+  this->ChildOffsets.assign(3 * this->NumberOfChildren, 0);
+  for (unsigned int child = 0; child < this->NumberOfChildren; ++child)
+  {
+    unsigned int digits = child;
+    for (int d = 0; d < tree->GetDimension(); ++d, digits /= factor)
+    {
+      this->ChildOffsets[3 * child + axes[d]] = static_cast<unsigned char>(digits % factor);
+    }
+  }
+
+  double size[3];
+  grid->GetLevelZeroOriginAndSizeFromIndex(treeIndex, this->Origin, size);
+  if (tree->HasScales())
+  {
+    tree->GetScale(size);
+  }
+
+  vtkBitArray* mask = grid->HasMask() ? grid->GetMask() : nullptr;
+  const vtkIdType maskSize = mask ? mask->GetNumberOfTuples() : 0;
+  const unsigned int depthLimiter = grid->GetDepthLimiter();
+
+  // Breadth first traversal of the tree. The local index of the vertices
+  // still to visit is queued at the position they will have in the layout.
+  const vtkIdType numberOfVertices = tree->GetNumberOfVertices();
+  std::vector<vtkIdType> localIndices(1, 0);
+  localIndices.reserve(numberOfVertices);
+  this->GlobalIndices.reserve(numberOfVertices);
+  this->FirstChildren.reserve(numberOfVertices);
+  if (mask)
+  {
+    this->Masked.reserve(numberOfVertices);
+  }
+  this->LevelOffsets.push_back(0);
+  unsigned int level = 0;
+  vtkIdType levelEnd = 1;
+  for (vtkIdType vertex = 0; vertex < static_cast<vtkIdType>(localIndices.size()); ++vertex)
+  {
+    if (vertex == levelEnd)
+    {
+      ++level;
+      this->LevelOffsets.push_back(vertex);
+      levelEnd = static_cast<vtkIdType>(localIndices.size());
+    }
+    const vtkIdType local = localIndices[vertex];
+    const vtkIdType global = tree->GetGlobalIndexFromLocal(local);
+    this->GlobalIndices.push_back(global);
+    if (mask)
+    {
+      this->Masked.push_back(global < maskSize && mask->GetValue(global) ? 1 : 0);
+    }
+    if (level == depthLimiter || tree->IsLeaf(local))
+    {
+      this->FirstChildren.push_back(-1);
+    }
+    else
+    {
+      this->FirstChildren.push_back(static_cast<vtkIdType>(localIndices.size()));
+      const vtkIdType elder = tree->GetElderChildIndex(static_cast<unsigned int>(local));
+      for (unsigned int child = 0; child < this->NumberOfChildren; ++child)
+      {
+        localIndices.push_back(elder + child);
+      }
+    }
+  }
+  this->LevelOffsets.push_back(static_cast<vtkIdType>(localIndices.size()));
+
+  // Cell sizes per level, computed as vtkHyperTreeGridScales does
+  this->LevelSizes.resize(3 * (level + 1));
+  std::copy(size, size + 3, this->LevelSizes.begin());
+  for (size_t i = 3; i < this->LevelSizes.size(); ++i)
+  {
+    this->LevelSizes[i] = this->LevelSizes[i - 3] / static_cast<double>(factor);
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkHyperTreeLinearLayout::GetActualMemorySizeBytes() const
+{
+  return static_cast<unsigned long>(sizeof(vtkIdType) *
+      (this->GlobalIndices.capacity() + this->FirstChildren.capacity() +
+        this->LevelOffsets.capacity()) +
+    this->Masked.capacity() + sizeof(double) * this->LevelSizes.capacity() +
+    this->ChildOffsets.capacity() + sizeof(vtkHyperTreeLinearLayout));
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeLinearLayout::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Vertices: " << this->GetNumberOfVertices() << "\n";
+  os << indent << "Number Of Levels: " << this->GetNumberOfLevels() << "\n";
+  os << indent << "Number Of Children: " << this->NumberOfChildren << "\n";
+  os << indent << "Masked: " << (this->Masked.empty() ? "Off\n" : "On\n");
+  os << indent << "Origin: (" << this->Origin[0] << ", " << this->Origin[1] << ", "
+     << this->Origin[2] << ")\n";
+}
+
+//------------------------------------------------------------------------------
+vtkHyperTreeLinearLayout::DepthFirstIterator::DepthFirstIterator(
+  const vtkHyperTreeLinearLayout* layout)
+  : Layout(layout)
+{
+  this->Stack.reserve(layout->GetNumberOfLevels() * layout->GetNumberOfChildren() + 1);
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeLinearLayout::DepthFirstIterator::Begin()
+{
+  this->Stack.clear();
+  if (this->Layout->GetNumberOfVertices() > 0)
+  {
+    const double* origin = this->Layout->GetOrigin();
+    this->Stack.push_back(Entry{ 0, 0, { origin[0], origin[1], origin[2] } });
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeLinearLayout::DepthFirstIterator::Next(bool descend)
+{
+  const Entry parent = this->Stack.back();
+  this->Stack.pop_back();
+  const vtkIdType firstChild = this->Layout->GetFirstChild(parent.Vertex);
+  if (!descend || firstChild < 0)
+  {
+    return;
+  }
+
+  // Push the children last to first so that the first child is visited next
+  const double* size = this->Layout->GetSize(parent.Level + 1);
+  const unsigned int numberOfChildren = this->Layout->GetNumberOfChildren();
+  for (unsigned int child = numberOfChildren; child-- > 0;)
+  {
+    const unsigned char* offsets = this->Layout->ChildOffsets.data() + 3 * child;
+    Entry entry;
+    entry.Vertex = firstChild + child;
+    entry.Level = parent.Level + 1;
+    for (int d = 0; d < 3; ++d)
+    {
+      entry.Origin[d] = parent.Origin[d] + offsets[d] * size[d];
+    }
+    this->Stack.push_back(entry);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeLinearLayout::DepthFirstIterator::GetBounds(double bounds[6]) const
+{
+  const double* origin = this->GetOrigin();
+  const double* size = this->GetSize();
+  for (int d = 0; d < 3; ++d)
+  {
+    bounds[2 * d] = origin[d];
+    bounds[2 * d + 1] = origin[d] + size[d];
+  }
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkHyperTreeLinearLayout
+ * @brief   linearized, read-only copy of a hypertree for fast traversal
+ *
+ * vtkHyperTreeLinearLayout stores the vertices of one tree of a hypertree
+ * grid in breadth first order in a few contiguous arrays: the global index of
+ * each vertex, the position of its first child in the layout (the children of
+ * a coarse cell are stored next to each other), and its mask value. The
+ * vertices of each level are also contiguous. The depth limiter of the grid is
+ * applied when building the layout: vertices at the limiting level are
+ * leaves and deeper vertices are not stored.
+ *
+ * Once built, the layout does not reference the grid or the tree anymore and
+ * reading it is thread safe. Its DepthFirstIterator visits the vertices in the
+ * same order as a recursive traversal with a
+ * vtkHyperTreeGridNonOrientedGeometryCursor, and computes the same origins
+ * and sizes, but without virtual calls, mask lookups or heap allocations
+ * in the loop. This is meant for filters that traverse whole trees several
+ * times, or very large trees where cursor traversal is dominated by cache
+ * misses.
+ *
+ * The layout is a snapshot: it must be rebuilt if the tree, its mask or the
+ * depth limiter of the grid are modified.
+ *
+ * @sa
+ * vtkHyperTree vtkHyperTreeGrid vtkHyperTreeGridNonOrientedGeometryCursor
+ */
+
+#ifndef vtkHyperTreeLinearLayout_h
+#define vtkHyperTreeLinearLayout_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkHyperTreeGrid;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkHyperTreeLinearLayout : public vtkObject
+{
+public:
+  static vtkHyperTreeLinearLayout* New();
+  vtkTypeMacro(vtkHyperTreeLinearLayout, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Build the layout of the tree of index treeIndex in grid. Return false,
+   * leaving the layout empty, if the grid has no such tree.
+   */
+  bool Initialize(vtkHyperTreeGrid* grid, vtkIdType treeIndex);
+
+  /**
+   * Return the number of vertices (coarse and leaves) in the layout.
+   */
+  vtkIdType GetNumberOfVertices() const
+  {
+    return static_cast<vtkIdType>(this->GlobalIndices.size());
+  }
+
+  /**
+   * Return the number of levels in the layout.
+   */
+  unsigned int GetNumberOfLevels() const
+  {
+    return this->LevelOffsets.empty() ? 0
+                                      : static_cast<unsigned int>(this->LevelOffsets.size() - 1);
+  }
+
+  /**
+   * Return the position in the layout of the first vertex of the given level.
+   * The vertices of the level are at positions GetLevelOffset(level) to
+   * GetLevelOffset(level + 1) - 1.
+   */
+  vtkIdType GetLevelOffset(unsigned int level) const { return this->LevelOffsets[level]; }
+
+  /**
+   * Return the global index of the vertex at the given position.
+   */
+  vtkIdType GetGlobalNodeIndex(vtkIdType vertex) const { return this->GlobalIndices[vertex]; }
+
+  /**
+   * Return the position of the first child of the vertex at the given
+   * position, or -1 if the vertex is a leaf. The other children follow it.
+   */
+  vtkIdType GetFirstChild(vtkIdType vertex) const { return this->FirstChildren[vertex]; }
+
+  /**
+   * Return whether the vertex at the given position is a leaf.
+   */
+  bool IsLeaf(vtkIdType vertex) const { return this->FirstChildren[vertex] < 0; }
+
+  /**
+   * Return whether the vertex at the given position is masked.
+   */
+  bool IsMasked(vtkIdType vertex) const
+  {
+    return !this->Masked.empty() && this->Masked[vertex] != 0;
+  }
+
+  /**
+   * Return the number of children of the coarse vertices.
+   */
+  unsigned int GetNumberOfChildren() const { return this->NumberOfChildren; }
+
+  /**
+   * Return the size of the cells of the given level.
+   */
+  const double* GetSize(unsigned int level) const { return this->LevelSizes.data() + 3 * level; }
+
+  /**
+   * Return the origin of the root cell.
+   */
+  const double* GetOrigin() const { return this->Origin; }
+
+  /**
+   * Return the memory used by the layout, in bytes.
+   */
+  unsigned long GetActualMemorySizeBytes() const;
+
+  /**
+   * Iterate over the vertices of a layout in depth first order, computing
+   * the level and the geometry of each vertex along the way. Iterators are
+   * lightweight: several threads may iterate over the same layout with their
+   * own iterator.
+   *
+   * \code
+   * vtkHyperTreeLinearLayout::DepthFirstIterator it(layout);
+   * for (it.Begin(); !it.IsAtEnd();)
+   * {
+   *   if (it.IsMasked())
+   *   {
+   *     it.Next(false); // skip the children
+   *     continue;
+   *   }
+   *   if (it.IsLeaf())
+   *   {
+   *     // process leaf it.GetGlobalNodeIndex(), it.GetOrigin(), it.GetSize()
+   *   }
+   *   it.Next();
+   * }
+   * \endcode
+   */
+  class VTKCOMMONDATAMODEL_EXPORT DepthFirstIterator
+  {
+  public:
+    DepthFirstIterator(const vtkHyperTreeLinearLayout* layout);
+
+    /**
+     * Move the iterator to the root of the tree.
+     */
+    void Begin();
+
+    /**
+     * Return true once all the vertices have been visited.
+     */
+    bool IsAtEnd() const { return this->Stack.empty(); }
+
+    /**
+     * Move to the next vertex in depth first order. If descend is false, the
+     * children of the current vertex are skipped.
+     */
+    void Next(bool descend = true);
+
+    /**
+     * Return the position of the current vertex in the layout.
+     */
+    vtkIdType GetVertex() const { return this->Stack.back().Vertex; }
+
+    ///@{
+    /**
+     * Return information about the current vertex.
+     */
+    vtkIdType GetGlobalNodeIndex() const
+    {
+      return this->Layout->GetGlobalNodeIndex(this->Stack.back().Vertex);
+    }
+    unsigned int GetLevel() const { return this->Stack.back().Level; }
+    bool IsLeaf() const { return this->Layout->IsLeaf(this->Stack.back().Vertex); }
+    bool IsMasked() const { return this->Layout->IsMasked(this->Stack.back().Vertex); }
+    const double* GetOrigin() const { return this->Stack.back().Origin; }
+    const double* GetSize() const { return this->Layout->GetSize(this->Stack.back().Level); }
+    void GetBounds(double bounds[6]) const;
+    ///@}
+
+  private:
+    struct Entry
+    {
+      vtkIdType Vertex;
+      unsigned int Level;
+      double Origin[3];
+    };
+    const vtkHyperTreeLinearLayout* Layout;
+    std::vector<Entry> Stack;
+  };
+
+protected:
+  vtkHyperTreeLinearLayout();
+  ~vtkHyperTreeLinearLayout() override;
+
+  std::vector<vtkIdType> GlobalIndices;
+  std::vector<vtkIdType> FirstChildren;
+  std::vector<unsigned char> Masked; // empty if the grid has no mask
+  std::vector<vtkIdType> LevelOffsets;
+  std::vector<double> LevelSizes;
+
+  // Offset of each child in units of the child size, along x, y and z
+  std::vector<unsigned char> ChildOffsets;
+  unsigned int NumberOfChildren;
+  double Origin[3];
+
+private:
+  vtkHyperTreeLinearLayout(const vtkHyperTreeLinearLayout&) = delete;
+  void operator=(const vtkHyperTreeLinearLayout&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -12,26 +12,33 @@
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkKdNode.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <limits>
 #include <list>
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -637,52 +644,58 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     }
   }
 
-  double* weights = new double[maxCellSize];
+  // The centers are computed in parallel, each thread with its own cell and weights.
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+  auto computeCenters = [&](vtkDataSet* iset, float* cptr)
+  {
+    const vtkIdType nCells = iset->GetNumberOfCells();
+    if (nCells == 0)
+    {
+      return;
+    }
+    // Make sure the data set is ready for thread safe GetCell calls.
+    vtkNew<vtkGenericCell> firstCell;
+    iset->GetCell(0, firstCell);
 
-  float* cptr = center;
-  double dcenter[3];
+    vtkSMPTools::For(0, nCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        vtkGenericCell* cell = localCell.Local();
+        std::vector<double>& weights = localWeights.Local();
+        weights.resize(maxCellSize);
+        double dcenter[3];
+        for (vtkIdType j = begin; j < end; j++)
+        {
+          iset->GetCell(j, cell);
+          this->ComputeCellCenter(cell, dcenter, weights.data());
+          cptr[3 * j] = static_cast<float>(dcenter[0]);
+          cptr[3 * j + 1] = static_cast<float>(dcenter[1]);
+          cptr[3 * j + 2] = static_cast<float>(dcenter[2]);
+        }
+      });
+  };
 
   if (set)
   {
-    for (int j = 0; j < totalCells; j++)
-    {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
-      {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-      }
-    }
+    computeCenters(set, center);
   }
   else
   {
+    float* cptr = center;
+    int done = 0;
     vtkCollectionSimpleIterator cookie;
     this->DataSets->InitTraversal(cookie);
     for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
          iset = this->DataSets->GetNextDataSet(cookie))
     {
-      int nCells = iset->GetNumberOfCells();
-
-      for (int j = 0; j < nCells; j++)
-      {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
-        {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-        }
-      }
+      computeCenters(iset, cptr);
+      cptr += 3 * iset->GetNumberOfCells();
+      done += iset->GetNumberOfCells();
+      this->UpdateSubOperationProgress(static_cast<double>(done) / totalCells);
     }
   }
 
-  delete[] weights;
-
   this->UpdateSubOperationProgress(1.0);
   return center;
 }
@@ -912,7 +925,7 @@ void vtkKdTree::BuildLocatorInternal()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    this->DivideRegionInParallel(kd, ptarray, nullptr);
 
     TIMERDONE("Build tree");
 
@@ -1232,6 +1245,98 @@ int vtkKdTree::SelectCutDirection(vtkKdNode* kd)
   return dim;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Regions with at least this many cell centers find their median with SelectInParallel.
+constexpr int ParallelSelectSize = 1 << 16;
+// Number of points moved by each task of SelectInParallel.
+constexpr vtkIdType PartitionChunkSize = 1 << 14;
+
+//------------------------------------------------------------------------------
+// Split the points like vtkKdTree::Select does, but in parallel and without any id: the median
+// coordinate along dim is found on a copy of the coordinates, then the points strictly below it
+// are moved in front of the others, keeping their relative order in each half. The cut, and the
+// content of each half, are the same as with vtkKdTree::Select.
+int SelectInParallel(int dim, float* c1, int nvals, double& coord)
+{
+  const int mid = nvals / 2;
+  std::vector<float> values(nvals);
+  vtkSMPTools::For(0, nvals,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        values[i] = c1[3 * i + dim];
+      }
+    });
+  std::nth_element(values.begin(), values.begin() + mid, values.end());
+  const float median = values[mid];
+
+  // Count the points below the median in each chunk, and find the largest of them.
+  const vtkIdType numberOfChunks = (nvals + PartitionChunkSize - 1) / PartitionChunkSize;
+  std::vector<vtkIdType> leftOffsets(numberOfChunks);
+  std::vector<float> leftMax(numberOfChunks, std::numeric_limits<float>::lowest());
+  vtkSMPTools::For(0, numberOfChunks,
+    [&](vtkIdType beginChunk, vtkIdType endChunk)
+    {
+      for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+      {
+        const vtkIdType end = std::min<vtkIdType>((chunk + 1) * PartitionChunkSize, nvals);
+        vtkIdType count = 0;
+        for (vtkIdType i = chunk * PartitionChunkSize; i < end; ++i)
+        {
+          const float value = c1[3 * i + dim];
+          if (value < median)
+          {
+            ++count;
+            leftMax[chunk] = std::max(leftMax[chunk], value);
+          }
+        }
+        leftOffsets[chunk] = count;
+      }
+    });
+  vtkIdType nleft = 0;
+  float maxLeftValue = std::numeric_limits<float>::lowest();
+  for (vtkIdType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    const vtkIdType count = leftOffsets[chunk];
+    leftOffsets[chunk] = nleft;
+    nleft += count;
+    maxLeftValue = std::max(maxLeftValue, leftMax[chunk]);
+  }
+  if (nleft == 0)
+  {
+    return 0; // failed to divide region
+  }
+
+  std::vector<float> partitioned(3 * static_cast<size_t>(nvals));
+  vtkSMPTools::For(0, numberOfChunks,
+    [&](vtkIdType beginChunk, vtkIdType endChunk)
+    {
+      for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+      {
+        const vtkIdType begin = chunk * PartitionChunkSize;
+        const vtkIdType end = std::min<vtkIdType>(begin + PartitionChunkSize, nvals);
+        vtkIdType left = leftOffsets[chunk];
+        vtkIdType right = nleft + begin - leftOffsets[chunk];
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          vtkIdType& destination = c1[3 * i + dim] < median ? left : right;
+          std::copy_n(c1 + 3 * i, 3, partitioned.data() + 3 * destination);
+          ++destination;
+        }
+      }
+    });
+  vtkSMPTools::For(0, nvals,
+    [&](vtkIdType begin, vtkIdType end)
+    { std::copy(partitioned.data() + 3 * begin, partitioned.data() + 3 * end, c1 + 3 * begin); });
+
+  coord = (static_cast<double>(median) + static_cast<double>(maxLeftValue)) / 2.0;
+  return static_cast<int>(nleft);
+}
+}
+
 //------------------------------------------------------------------------------
 int vtkKdTree::DivideTest(int size, int level)
 {
@@ -1256,6 +1361,73 @@ int vtkKdTree::DivideTest(int size, int level)
 
 //------------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (!this->SplitRegion(kd, c1, ids, level))
+  {
+    return 0;
+  }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int* leftIds = ids;
+  int* rightIds = ids ? ids + nleft : nullptr;
+
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+
+  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkKdTree::DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids)
+{
+  // The top of the tree is split one region at a time, the largest regions finding their median
+  // in parallel. The remaining regions are then divided concurrently, and since they cover
+  // disjoint parts of the point array, the tree is the same as the one of DivideRegion.
+  struct Region
+  {
+    vtkKdNode* Node;
+    float* Points;
+    int* Ids;
+    int Level;
+  };
+  const int subtreeSize = std::max(kd->GetNumberOfPoints() / 256, 4096);
+  std::vector<Region> regions(1, Region{ kd, c1, ids, 0 });
+  std::vector<Region> subtrees;
+  while (!regions.empty())
+  {
+    const Region region = regions.back();
+    regions.pop_back();
+    if (region.Node->GetNumberOfPoints() <= subtreeSize)
+    {
+      subtrees.push_back(region);
+      continue;
+    }
+    if (!this->SplitRegion(region.Node, region.Points, region.Ids, region.Level))
+    {
+      continue;
+    }
+    const int nleft = region.Node->GetLeft()->GetNumberOfPoints();
+    regions.push_back(
+      Region{ region.Node->GetLeft(), region.Points, region.Ids, region.Level + 1 });
+    regions.push_back(Region{ region.Node->GetRight(), region.Points + nleft * 3,
+      region.Ids ? region.Ids + nleft : nullptr, region.Level + 1 });
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const Region& region = subtrees[i];
+        this->DivideRegion(region.Node, region.Points, region.Ids, region.Level);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+int vtkKdTree::SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1315,16 +1487,7 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
     return 0; // unable to divide region further
   }
 
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
-
-  int* leftIds = ids;
-  int* rightIds = ids ? ids + nleft : nullptr;
-
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
-
-  return 0;
+  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -1348,7 +1511,16 @@ void vtkKdTree::DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int dim1, int d
       break;
     }
 
-    midpt = vtkKdTree::Select(dims[dim], c1, ids, npoints, coord);
+    // The order of the cell centers within the regions does not matter, so the median of the
+    // large regions can be found in parallel outside of the concurrent subtree builds.
+    if (!ids && npoints >= ParallelSelectSize && !vtkSMPTools::IsParallelScope())
+    {
+      midpt = SelectInParallel(dims[dim], c1, npoints, coord);
+    }
+    else
+    {
+      midpt = vtkKdTree::Select(dims[dim], c1, ids, npoints, coord);
+    }
 
     if (midpt == 0)
     {
@@ -1873,7 +2045,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionInParallel(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
@@ -3807,9 +3979,9 @@ void vtkKdTree::CreateCellLists(vtkDataSet* set, int* regionList, int listSize)
 
   int nCells = set->GetNumberOfCells();
 
-  for (int cellId = 0; cellId < nCells; cellId++)
+  if (this->IncludeRegionBoundaryCells)
   {
-    if (this->IncludeRegionBoundaryCells)
+    for (int cellId = 0; cellId < nCells; cellId++)
     {
       // Find all regions the cell intersects, including
       // the region the cell centroid lies in.
@@ -3852,19 +4024,69 @@ void vtkKdTree::CreateCellLists(vtkDataSet* set, int* regionList, int listSize)
         }
       }
     }
-    else
+  }
+  else
+  {
+    // Just find the region the cell centroid lies in. The cells are binned with a counting sort
+    // over chunks of cells processed in parallel: each chunk counts its cells per region, then
+    // writes them at its own offset, so that every list is sorted by cell id.
+    const vtkIdType maxChunks = 8 * vtkSMPTools::GetEstimatedNumberOfThreads();
+    const vtkIdType numberOfChunks =
+      std::max<vtkIdType>(1, std::min<vtkIdType>((nCells + 65535) / 65536, maxChunks));
+    const vtkIdType chunkSize = (nCells + numberOfChunks - 1) / numberOfChunks;
+    const int nRegions = list->nRegions;
+    auto regionIndex = [&](vtkIdType cellId)
     {
-      // just find the region the cell centroid lies in - easy
-
       int regionId = regList[cellId];
+      return (listptr && regionId >= 0) ? listptr[regionId] : regionId;
+    };
 
-      int idx = (listptr) ? listptr[regionId] : regionId;
-
-      if (idx >= 0)
+    std::vector<vtkIdType> offsets(numberOfChunks * nRegions, 0);
+    vtkSMPTools::For(0, numberOfChunks,
+      [&](vtkIdType beginChunk, vtkIdType endChunk)
+      {
+        for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+        {
+          vtkIdType* counts = offsets.data() + chunk * nRegions;
+          const vtkIdType end = std::min<vtkIdType>((chunk + 1) * chunkSize, nCells);
+          for (vtkIdType cellId = chunk * chunkSize; cellId < end; ++cellId)
+          {
+            const int idx = regionIndex(cellId);
+            if (idx >= 0)
+            {
+              ++counts[idx];
+            }
+          }
+        }
+      });
+    for (int idx = 0; idx < nRegions; idx++)
+    {
+      vtkIdType size = 0;
+      for (vtkIdType chunk = 0; chunk < numberOfChunks; ++chunk)
       {
-        list->cells[idx]->InsertNextId(cellId);
+        const vtkIdType count = offsets[chunk * nRegions + idx];
+        offsets[chunk * nRegions + idx] = size;
+        size += count;
       }
+      list->cells[idx]->SetNumberOfIds(size);
     }
+    vtkSMPTools::For(0, numberOfChunks,
+      [&](vtkIdType beginChunk, vtkIdType endChunk)
+      {
+        for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+        {
+          vtkIdType* next = offsets.data() + chunk * nRegions;
+          const vtkIdType end = std::min<vtkIdType>((chunk + 1) * chunkSize, nCells);
+          for (vtkIdType cellId = chunk * chunkSize; cellId < end; ++cellId)
+          {
+            const int idx = regionIndex(cellId);
+            if (idx >= 0)
+            {
+              list->cells[idx]->SetId(next[idx]++, cellId);
+            }
+          }
+        }
+      });
   }
 
   delete[] listptr;
@@ -4194,14 +4416,15 @@ int* vtkKdTree::AllGetRegionContainingCell()
 
     float* centers = this->ComputeCellCenters(iset);
 
-    float* pt = centers;
-
-    for (int cellId = 0; cellId < setCells; cellId++)
-    {
-      listPtr[cellId] = this->GetRegionContainingPoint(pt[0], pt[1], pt[2]);
-
-      pt += 3;
-    }
+    vtkSMPTools::For(0, setCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cellId = begin; cellId < end; cellId++)
+        {
+          const float* pt = centers + 3 * cellId;
+          listPtr[cellId] = this->GetRegionContainingPoint(pt[0], pt[1], pt[2]);
+        }
+      });
 
     listPtr += setCells;
 
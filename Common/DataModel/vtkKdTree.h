@@ -768,6 +768,13 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  // Same as DivideRegion from the root, with the median of the largest regions found in
+  // parallel and the smaller regions divided concurrently with vtkSMPTools.
+  void DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids);
+
+  // Split a single region in two, return 1 if it was split.
+  int SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level);
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
@@ -0,0 +1,867 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLinearCellEvaluator.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkPoints.h"
+
+#include <algorithm>
+#include <cmath>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+constexpr int W = vtkLinearCellEvaluator::BlockSize;
+
+// Same expression as vtkMath::Determinant3x3(c1, c2, c3), so that results
+// match the cell classes bit for bit.
+inline double Determinant(const double c1[3], const double c2[3], const double c3[3])
+{
+  return c1[0] * c2[1] * c3[2] + c2[0] * c3[1] * c1[2] + c3[0] * c1[1] * c2[2] -
+    c1[0] * c3[1] * c2[2] - c2[0] * c1[1] * c3[2] - c3[0] * c2[1] * c1[2];
+}
+
+//------------------------------------------------------------------------------
+// Interpolation functions and derivatives, copied from the cell classes. The
+// derivatives are stored as in vtkCell: all the r-derivatives, then the s and
+// t-derivatives.
+struct TetraFunctions
+{
+  static constexpr int NumberOfPoints = 4;
+
+  static void Functions(double r, double s, double t, double sf[4])
+  {
+    sf[0] = 1.0 - r - s - t;
+    sf[1] = r;
+    sf[2] = s;
+    sf[3] = t;
+  }
+
+  static void Derivs(double, double, double, double d[12])
+  {
+    d[0] = -1.0;
+    d[1] = 1.0;
+    d[2] = 0.0;
+    d[3] = 0.0;
+    d[4] = -1.0;
+    d[5] = 0.0;
+    d[6] = 1.0;
+    d[7] = 0.0;
+    d[8] = -1.0;
+    d[9] = 0.0;
+    d[10] = 0.0;
+    d[11] = 1.0;
+  }
+};
+
+struct VoxelFunctions
+{
+  static constexpr int NumberOfPoints = 8;
+
+  static void Functions(double r, double s, double t, double sf[8])
+  {
+    const double rm = 1. - r;
+    const double sm = 1. - s;
+    const double tm = 1. - t;
+    sf[0] = rm * sm * tm;
+    sf[1] = r * sm * tm;
+    sf[2] = rm * s * tm;
+    sf[3] = r * s * tm;
+    sf[4] = rm * sm * t;
+    sf[5] = r * sm * t;
+    sf[6] = rm * s * t;
+    sf[7] = r * s * t;
+  }
+
+  static void Derivs(double r, double s, double t, double d[24])
+  {
+    const double rm = 1. - r;
+    const double sm = 1. - s;
+    const double tm = 1. - t;
+    d[0] = -sm * tm;
+    d[1] = sm * tm;
+    d[2] = -s * tm;
+    d[3] = s * tm;
+    d[4] = -sm * t;
+    d[5] = sm * t;
+    d[6] = -s * t;
+    d[7] = s * t;
+    d[8] = -rm * tm;
+    d[9] = -r * tm;
+    d[10] = rm * tm;
+    d[11] = r * tm;
+    d[12] = -rm * t;
+    d[13] = -r * t;
+    d[14] = rm * t;
+    d[15] = r * t;
+    d[16] = -rm * sm;
+    d[17] = -r * sm;
+    d[18] = -rm * s;
+    d[19] = -r * s;
+    d[20] = rm * sm;
+    d[21] = r * sm;
+    d[22] = rm * s;
+    d[23] = r * s;
+  }
+};
+
+struct HexahedronFunctions
+{
+  static constexpr int NumberOfPoints = 8;
+
+  static void Functions(double r, double s, double t, double sf[8])
+  {
+    const double rm = 1. - r;
+    const double sm = 1. - s;
+    const double tm = 1. - t;
+    const double rmXsm = rm * sm;
+    const double p0Xsm = r * sm;
+    const double p0Xp1 = r * s;
+    const double rmXp1 = rm * s;
+    sf[0] = rmXsm * tm;
+    sf[1] = p0Xsm * tm;
+    sf[2] = p0Xp1 * tm;
+    sf[3] = rmXp1 * tm;
+    sf[4] = rmXsm * t;
+    sf[5] = p0Xsm * t;
+    sf[6] = p0Xp1 * t;
+    sf[7] = rmXp1 * t;
+  }
+
+  static void Derivs(double r, double s, double t, double d[24])
+  {
+    const double rm = 1. - r;
+    const double sm = 1. - s;
+    const double tm = 1. - t;
+    d[0] = -sm * tm;
+    d[1] = -d[0];
+    d[2] = s * tm;
+    d[3] = -d[2];
+    d[4] = -sm * t;
+    d[5] = -d[4];
+    d[6] = s * t;
+    d[7] = -d[6];
+    d[8] = -rm * tm;
+    d[9] = -r * tm;
+    d[10] = -d[9];
+    d[11] = -d[8];
+    d[12] = -rm * t;
+    d[13] = -r * t;
+    d[14] = -d[13];
+    d[15] = -d[12];
+    d[16] = -rm * sm;
+    d[17] = -r * sm;
+    d[18] = -r * s;
+    d[19] = -rm * s;
+    d[20] = -d[16];
+    d[21] = -d[17];
+    d[22] = -d[18];
+    d[23] = -d[19];
+  }
+
+  // Parameters of the Newton iterations of vtkHexahedron::EvaluatePosition()
+  static constexpr int MaxIterations = 10;
+  static constexpr double Converged = 1.e-05;
+  static constexpr int NumberOfSizeSegments = 4;
+  static const int SizeSegments[4][2];
+
+  static bool Inside(double r, double s, double t)
+  {
+    const double lower = 0.0 - 1.e-06;
+    const double upper = 1.0 + 1.e-06;
+    return r >= lower && r <= upper && s >= lower && s <= upper && t >= lower && t <= upper;
+  }
+};
+// The diagonals, which bound the volume of the cell
+const int HexahedronFunctions::SizeSegments[4][2] = { { 0, 6 }, { 1, 7 }, { 2, 4 }, { 3, 5 } };
+
+struct WedgeFunctions
+{
+  static constexpr int NumberOfPoints = 6;
+
+  static void Functions(double r, double s, double t, double sf[6])
+  {
+    sf[0] = (1.0 - r - s) * (1.0 - t);
+    sf[1] = r * (1.0 - t);
+    sf[2] = s * (1.0 - t);
+    sf[3] = (1.0 - r - s) * t;
+    sf[4] = r * t;
+    sf[5] = s * t;
+  }
+
+  static void Derivs(double r, double s, double t, double d[18])
+  {
+    d[0] = -1.0 + t;
+    d[1] = 1.0 - t;
+    d[2] = 0.0;
+    d[3] = -t;
+    d[4] = t;
+    d[5] = 0.0;
+    d[6] = -1.0 + t;
+    d[7] = 0.0;
+    d[8] = 1.0 - t;
+    d[9] = -t;
+    d[10] = 0.0;
+    d[11] = t;
+    d[12] = -1.0 + r + s;
+    d[13] = -r;
+    d[14] = -s;
+    d[15] = 1.0 - r - s;
+    d[16] = r;
+    d[17] = s;
+  }
+
+  // Parameters of the Newton iterations of vtkWedge::EvaluatePosition()
+  static constexpr int MaxIterations = 10;
+  static constexpr double Converged = 1.e-03;
+  static constexpr int NumberOfSizeSegments = 9;
+  static const int SizeSegments[9][2];
+
+  static bool Inside(double r, double s, double t)
+  {
+    return r >= -0.001 && r <= 1.001 && s >= -0.001 && s <= 1.001 && t >= -0.001 && t <= 1.001 &&
+      r + s <= 1.001;
+  }
+};
+// The edges, which bound the volume of the cell
+const int WedgeFunctions::SizeSegments[9][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 3, 4 }, { 4, 5 },
+  { 5, 3 }, { 0, 3 }, { 1, 4 }, { 2, 5 } };
+
+//------------------------------------------------------------------------------
+// Coordinates of the points of the cells of a block. Step is 0 when all the
+// queries of the block are evaluated in the same cell.
+template <int Step>
+struct BlockCoordinates
+{
+  const double* Values;
+
+  double operator()(int point, int c, int lane) const
+  {
+    return this->Values[(point * 3 + c) * W + lane * Step];
+  }
+};
+
+//------------------------------------------------------------------------------
+// Queries of a block, transposed so that each value is contiguous over the lanes.
+struct BlockQueries
+{
+  int Count;
+  double P[3][W];
+
+  void Load(const double* values, vtkIdType count)
+  {
+    this->Count = static_cast<int>(count);
+    for (int lane = 0; lane < W; ++lane)
+    {
+      // Lanes past the end repeat the last query, their results are dropped
+      const double* value = values + 3 * std::min(lane, this->Count - 1);
+      this->P[0][lane] = value[0];
+      this->P[1][lane] = value[1];
+      this->P[2][lane] = value[2];
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+template <typename Functions>
+void StoreResults(const BlockQueries& queries, const double pc[3][W], const signed char status[W],
+  double* pcoords, double* weights, signed char* inside)
+{
+  constexpr int N = Functions::NumberOfPoints;
+  for (int lane = 0; lane < queries.Count; ++lane)
+  {
+    pcoords[3 * lane] = pc[0][lane];
+    pcoords[3 * lane + 1] = pc[1][lane];
+    pcoords[3 * lane + 2] = pc[2][lane];
+    inside[lane] = status[lane];
+    if (weights)
+    {
+      Functions::Functions(pc[0][lane], pc[1][lane], pc[2][lane], weights + N * lane);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// See vtkTetra::EvaluatePosition()
+template <int Step>
+void EvaluateTetraBlock(const BlockCoordinates<Step>& X, const BlockQueries& q, double pc[3][W],
+  signed char status[W])
+{
+  for (int lane = 0; lane < W; ++lane)
+  {
+    double rhs[3], c1[3], c2[3], c3[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      const double p0 = X(0, c, lane);
+      rhs[c] = q.P[c][lane] - p0;
+      c1[c] = X(1, c, lane) - p0;
+      c2[c] = X(2, c, lane) - p0;
+      c3[c] = X(3, c, lane) - p0;
+    }
+    const double det = Determinant(c1, c2, c3);
+    const double r = Determinant(rhs, c2, c3) / det;
+    const double s = Determinant(c1, rhs, c3) / det;
+    const double t = Determinant(c1, c2, rhs) / det;
+    const double p4 = 1.0 - r - s - t;
+    const bool inside = r >= -0.001 && r <= 1.001 && s >= -0.001 && s <= 1.001 && t >= -0.001 &&
+      t <= 1.001 && p4 >= -0.001 && p4 <= 1.001;
+    pc[0][lane] = r;
+    pc[1][lane] = s;
+    pc[2][lane] = t;
+    status[lane] = det == 0.0 ? -1 : (inside ? 1 : 0);
+  }
+}
+
+//------------------------------------------------------------------------------
+// See vtkVoxel::EvaluatePosition()
+template <int Step>
+void EvaluateVoxelBlock(const BlockCoordinates<Step>& X, const BlockQueries& q, double pc[3][W],
+  signed char status[W])
+{
+  for (int lane = 0; lane < W; ++lane)
+  {
+    const double r = (q.P[0][lane] - X(0, 0, lane)) / (X(1, 0, lane) - X(0, 0, lane));
+    const double s = (q.P[1][lane] - X(0, 1, lane)) / (X(2, 1, lane) - X(0, 1, lane));
+    const double t = (q.P[2][lane] - X(0, 2, lane)) / (X(4, 2, lane) - X(0, 2, lane));
+    pc[0][lane] = r;
+    pc[1][lane] = s;
+    pc[2][lane] = t;
+    status[lane] = r >= 0.0 && r <= 1.0 && s >= 0.0 && s <= 1.0 && t >= 0.0 && t <= 1.0 ? 1 : 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+// See vtkHexahedron::EvaluatePosition() and vtkWedge::EvaluatePosition().
+// All the lanes are updated at each iteration, the status of a lane telling
+// whether its iterations are over (1 converged, -1 failed) or not (0).
+template <typename Functions, int Step>
+void EvaluateNewtonBlock(const BlockCoordinates<Step>& X, const BlockQueries& q,
+  double pc[3][W], signed char status[W])
+{
+  constexpr int N = Functions::NumberOfPoints;
+
+  // Scale for an acceptable determinant, from a bound on the volume of the cell
+  double tolerance[W];
+  for (int lane = 0; lane < W; ++lane)
+  {
+    double longest = 0.0;
+    for (int i = 0; i < Functions::NumberOfSizeSegments; ++i)
+    {
+      const int p0 = Functions::SizeSegments[i][0];
+      const int p1 = Functions::SizeSegments[i][1];
+      double d2 = 0.0;
+      for (int c = 0; c < 3; ++c)
+      {
+        const double delta = X(p1, c, lane) - X(p0, c, lane);
+        d2 += delta * delta;
+      }
+      longest = longest < d2 ? d2 : longest;
+    }
+    const double bound = 0.00001 * longest * std::sqrt(longest);
+    tolerance[lane] = 1e-20 < bound ? 1e-20 : bound;
+    pc[0][lane] = pc[1][lane] = pc[2][lane] = 0.5;
+    status[lane] = 0;
+  }
+
+  for (int iteration = 0; iteration < Functions::MaxIterations; ++iteration)
+  {
+    bool running = false;
+    for (int lane = 0; lane < W; ++lane)
+    {
+      const double r = pc[0][lane];
+      const double s = pc[1][lane];
+      const double t = pc[2][lane];
+      double sf[N], d[3 * N];
+      Functions::Functions(r, s, t, sf);
+      Functions::Derivs(r, s, t, d);
+
+      double fcol[3] = { 0, 0, 0 }, rcol[3] = { 0, 0, 0 }, scol[3] = { 0, 0, 0 },
+             tcol[3] = { 0, 0, 0 };
+      for (int i = 0; i < N; ++i)
+      {
+        for (int c = 0; c < 3; ++c)
+        {
+          const double coord = X(i, c, lane);
+          fcol[c] += coord * sf[i];
+          rcol[c] += coord * d[i];
+          scol[c] += coord * d[i + N];
+          tcol[c] += coord * d[i + 2 * N];
+        }
+      }
+      for (int c = 0; c < 3; ++c)
+      {
+        fcol[c] -= q.P[c][lane];
+      }
+
+      const double det = Determinant(rcol, scol, tcol);
+      const double nr = r - Determinant(fcol, scol, tcol) / det;
+      const double ns = s - Determinant(rcol, fcol, tcol) / det;
+      const double nt = t - Determinant(rcol, scol, fcol) / det;
+
+      const bool active = status[lane] == 0;
+      const bool degenerate = std::fabs(det) < tolerance[lane];
+      const bool converged = std::fabs(nr - r) < Functions::Converged &&
+        std::fabs(ns - s) < Functions::Converged && std::fabs(nt - t) < Functions::Converged;
+      const bool diverged = std::fabs(nr) > 1.e6 || std::fabs(ns) > 1.e6 || std::fabs(nt) > 1.e6;
+      const bool update = active && !degenerate;
+      pc[0][lane] = update ? nr : r;
+      pc[1][lane] = update ? ns : s;
+      pc[2][lane] = update ? nt : t;
+      const signed char next = degenerate ? -1 : (converged ? 1 : (diverged ? -1 : 0));
+      status[lane] = active ? next : status[lane];
+      running |= active && next == 0;
+    }
+    if (!running)
+    {
+      break;
+    }
+  }
+
+  for (int lane = 0; lane < W; ++lane)
+  {
+    // Not converged, or converged outside of the cell
+    const bool inside = Functions::Inside(pc[0][lane], pc[1][lane], pc[2][lane]);
+    status[lane] = status[lane] == 1 ? (inside ? 1 : 0) : -1;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Inverse of the Jacobian matrix at the parametric coordinates of the
+// queries, and derivatives of the interpolation functions. The inverse is
+// zero for degenerate cells.
+template <typename Functions, int Step>
+void JacobianInverseBlock(const BlockCoordinates<Step>& X, const BlockQueries& q,
+  double inverse[9][W], double derivs[3 * Functions::NumberOfPoints][W])
+{
+  constexpr int N = Functions::NumberOfPoints;
+  for (int lane = 0; lane < W; ++lane)
+  {
+    double d[3 * N];
+    Functions::Derivs(q.P[0][lane], q.P[1][lane], q.P[2][lane], d);
+    double m[3][3] = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
+    for (int i = 0; i < N; ++i)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        const double coord = X(i, c, lane);
+        m[0][c] += coord * d[i];
+        m[1][c] += coord * d[N + i];
+        m[2][c] += coord * d[2 * N + i];
+      }
+    }
+    for (int i = 0; i < 3 * N; ++i)
+    {
+      derivs[i][lane] = d[i];
+    }
+
+    const double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    const double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    const double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    const double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+    const double f = det != 0.0 ? 1.0 / det : 0.0;
+    inverse[0][lane] = c00 * f;
+    inverse[1][lane] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * f;
+    inverse[2][lane] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * f;
+    inverse[3][lane] = c01 * f;
+    inverse[4][lane] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * f;
+    inverse[5][lane] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * f;
+    inverse[6][lane] = c02 * f;
+    inverse[7][lane] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * f;
+    inverse[8][lane] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * f;
+  }
+}
+
+//------------------------------------------------------------------------------
+// The axes of a voxel are aligned with the parametric axes, so its inverse
+// Jacobian matrix is diagonal, see vtkVoxel::Derivatives().
+template <int Step>
+void VoxelJacobianInverseBlock(const BlockCoordinates<Step>& X, const BlockQueries& q,
+  double inverse[9][W], double derivs[24][W])
+{
+  for (int lane = 0; lane < W; ++lane)
+  {
+    double d[24];
+    VoxelFunctions::Derivs(q.P[0][lane], q.P[1][lane], q.P[2][lane], d);
+    for (int i = 0; i < 24; ++i)
+    {
+      derivs[i][lane] = d[i];
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+      inverse[i][lane] = 0.0;
+    }
+    inverse[0][lane] = 1.0 / (X(1, 0, lane) - X(0, 0, lane));
+    inverse[4][lane] = 1.0 / (X(2, 1, lane) - X(0, 1, lane));
+    inverse[8][lane] = 1.0 / (X(4, 2, lane) - X(0, 2, lane));
+  }
+}
+
+//------------------------------------------------------------------------------
+template <typename Functions>
+struct Kernels
+{
+  static constexpr int N = Functions::NumberOfPoints;
+
+  //----------------------------------------------------------------------------
+  template <int Step>
+  static void EvaluatePosition(const double* coordinates, vtkIdType n, const double* x,
+    double* pcoords, double* weights, signed char* inside)
+  {
+    BlockQueries queries;
+    double pc[3][W];
+    signed char status[W];
+    for (vtkIdType begin = 0; begin < n; begin += W)
+    {
+      const vtkIdType block = begin / W;
+      const BlockCoordinates<Step> X{ coordinates + Step * block * N * 3 * W };
+      queries.Load(x + 3 * begin, std::min<vtkIdType>(W, n - begin));
+      Functions::template EvaluateBlock<Step>(X, queries, pc, status);
+      StoreResults<Functions>(queries, pc, status, pcoords + 3 * begin,
+        weights ? weights + N * begin : nullptr, inside + begin);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template <int Step>
+  static void Derivatives(const double* coordinates, vtkIdType n, const double* pcoords,
+    const double* values, int dim, double* derivs)
+  {
+    BlockQueries queries;
+    double inverse[9][W];
+    double functionDerivs[3 * N][W];
+    for (vtkIdType begin = 0; begin < n; begin += W)
+    {
+      const vtkIdType block = begin / W;
+      const BlockCoordinates<Step> X{ coordinates + Step * block * N * 3 * W };
+      queries.Load(pcoords + 3 * begin, std::min<vtkIdType>(W, n - begin));
+      Functions::template JacobianInverse<Step>(X, queries, inverse, functionDerivs);
+
+      for (int lane = 0; lane < queries.Count; ++lane)
+      {
+        const double* v = values + (begin + lane) * N * dim;
+        double* out = derivs + (begin + lane) * 3 * dim;
+        for (int k = 0; k < dim; ++k)
+        {
+          double sum[3] = { 0.0, 0.0, 0.0 };
+          for (int i = 0; i < N; ++i)
+          {
+            const double value = v[dim * i + k];
+            sum[0] += functionDerivs[i][lane] * value;
+            sum[1] += functionDerivs[N + i][lane] * value;
+            sum[2] += functionDerivs[2 * N + i][lane] * value;
+          }
+          for (int j = 0; j < 3; ++j)
+          {
+            out[3 * k + j] = sum[0] * inverse[3 * j][lane] + sum[1] * inverse[3 * j + 1][lane] +
+              sum[2] * inverse[3 * j + 2][lane];
+          }
+        }
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Block kernels of each cell type
+struct Tetra : TetraFunctions
+{
+  template <int Step>
+  static void EvaluateBlock(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double pc[3][W], signed char status[W])
+  {
+    EvaluateTetraBlock(X, q, pc, status);
+  }
+  template <int Step>
+  static void JacobianInverse(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double inverse[9][W], double derivs[12][W])
+  {
+    JacobianInverseBlock<TetraFunctions>(X, q, inverse, derivs);
+  }
+};
+
+struct Voxel : VoxelFunctions
+{
+  template <int Step>
+  static void EvaluateBlock(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double pc[3][W], signed char status[W])
+  {
+    EvaluateVoxelBlock(X, q, pc, status);
+  }
+  template <int Step>
+  static void JacobianInverse(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double inverse[9][W], double derivs[24][W])
+  {
+    VoxelJacobianInverseBlock(X, q, inverse, derivs);
+  }
+};
+
+struct Hexahedron : HexahedronFunctions
+{
+  template <int Step>
+  static void EvaluateBlock(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double pc[3][W], signed char status[W])
+  {
+    EvaluateNewtonBlock<HexahedronFunctions>(X, q, pc, status);
+  }
+  template <int Step>
+  static void JacobianInverse(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double inverse[9][W], double derivs[24][W])
+  {
+    JacobianInverseBlock<HexahedronFunctions>(X, q, inverse, derivs);
+  }
+};
+
+struct Wedge : WedgeFunctions
+{
+  template <int Step>
+  static void EvaluateBlock(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double pc[3][W], signed char status[W])
+  {
+    EvaluateNewtonBlock<WedgeFunctions>(X, q, pc, status);
+  }
+  template <int Step>
+  static void JacobianInverse(const BlockCoordinates<Step>& X, const BlockQueries& q,
+    double inverse[9][W], double derivs[18][W])
+  {
+    JacobianInverseBlock<WedgeFunctions>(X, q, inverse, derivs);
+  }
+};
+
+//------------------------------------------------------------------------------
+template <typename Functions>
+void InterpolateFunctionsImpl(vtkIdType n, const double* pcoords, double* weights)
+{
+  constexpr int N = Functions::NumberOfPoints;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const double* pc = pcoords + 3 * i;
+    Functions::Functions(pc[0], pc[1], pc[2], weights + N * i);
+  }
+}
+
+//------------------------------------------------------------------------------
+template <typename Point>
+void CopyPoint(const Point* values, vtkIdType id, double* block, int point, int lane)
+{
+  for (int c = 0; c < 3; ++c)
+  {
+    block[(point * 3 + c) * W + lane] = static_cast<double>(values[3 * id + c]);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkLinearCellEvaluator::IsTypeSupported(int cellType)
+{
+  return cellType == VTK_TETRA || cellType == VTK_VOXEL || cellType == VTK_HEXAHEDRON ||
+    cellType == VTK_WEDGE;
+}
+
+//------------------------------------------------------------------------------
+vtkLinearCellEvaluator::vtkLinearCellEvaluator(int cellType)
+  : CellType(VTK_TETRA)
+  , NumberOfPoints(4)
+  , NumberOfCells(0)
+{
+  this->SetCellType(cellType);
+}
+
+//------------------------------------------------------------------------------
+bool vtkLinearCellEvaluator::SetCellType(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      this->NumberOfPoints = 4;
+      break;
+    case VTK_VOXEL:
+    case VTK_HEXAHEDRON:
+      this->NumberOfPoints = 8;
+      break;
+    case VTK_WEDGE:
+      this->NumberOfPoints = 6;
+      break;
+    default:
+      return false;
+  }
+  this->CellType = cellType;
+  this->Reset();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkLinearCellEvaluator::GetParametricCenter(double pcoords[3]) const
+{
+  switch (this->CellType)
+  {
+    case VTK_TETRA:
+      pcoords[0] = pcoords[1] = pcoords[2] = 0.25;
+      break;
+    case VTK_WEDGE:
+      pcoords[0] = pcoords[1] = 0.333333;
+      pcoords[2] = 0.5;
+      break;
+    default:
+      pcoords[0] = pcoords[1] = pcoords[2] = 0.5;
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkLinearCellEvaluator::Reset()
+{
+  this->NumberOfCells = 0;
+  this->Coordinates.clear();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkLinearCellEvaluator::InsertNextCell(const double* coordinates)
+{
+  const vtkIdType cellId = this->NumberOfCells++;
+  const int lane = static_cast<int>(cellId % W);
+  const size_t blockSize = static_cast<size_t>(this->NumberOfPoints) * 3 * W;
+  if (lane == 0)
+  {
+    this->Coordinates.resize(this->Coordinates.size() + blockSize, 0.0);
+  }
+  double* block = this->Coordinates.data() + this->Coordinates.size() - blockSize;
+  for (int point = 0; point < this->NumberOfPoints; ++point)
+  {
+    CopyPoint(coordinates, point, block, point, lane);
+  }
+  return cellId;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkLinearCellEvaluator::InsertNextCell(vtkPoints* points, const vtkIdType* pointIds)
+{
+  const vtkIdType cellId = this->NumberOfCells++;
+  const int lane = static_cast<int>(cellId % W);
+  const size_t blockSize = static_cast<size_t>(this->NumberOfPoints) * 3 * W;
+  if (lane == 0)
+  {
+    this->Coordinates.resize(this->Coordinates.size() + blockSize, 0.0);
+  }
+  double* block = this->Coordinates.data() + this->Coordinates.size() - blockSize;
+
+  // Read the usual point types directly, other ones through the virtual API
+  vtkDataArray* data = points->GetData();
+  if (vtkDoubleArray* doubles = vtkDoubleArray::FastDownCast(data))
+  {
+    const double* values = doubles->GetPointer(0);
+    for (int point = 0; point < this->NumberOfPoints; ++point)
+    {
+      CopyPoint(values, pointIds[point], block, point, lane);
+    }
+  }
+  else if (vtkFloatArray* floats = vtkFloatArray::FastDownCast(data))
+  {
+    const float* values = floats->GetPointer(0);
+    for (int point = 0; point < this->NumberOfPoints; ++point)
+    {
+      CopyPoint(values, pointIds[point], block, point, lane);
+    }
+  }
+  else
+  {
+    for (int point = 0; point < this->NumberOfPoints; ++point)
+    {
+      double x[3];
+      points->GetPoint(pointIds[point], x);
+      CopyPoint(x, 0, block, point, lane);
+    }
+  }
+  return cellId;
+}
+
+//------------------------------------------------------------------------------
+void vtkLinearCellEvaluator::EvaluatePosition(
+  vtkIdType n, const double* x, double* pcoords, double* weights, signed char* inside) const
+{
+  if (n <= 0 || this->NumberOfCells == 0)
+  {
+    return;
+  }
+  const double* coordinates = this->Coordinates.data();
+  const bool single = this->NumberOfCells == 1;
+  switch (this->CellType)
+  {
+    case VTK_TETRA:
+      single ? Kernels<Tetra>::EvaluatePosition<0>(coordinates, n, x, pcoords, weights, inside)
+             : Kernels<Tetra>::EvaluatePosition<1>(coordinates, n, x, pcoords, weights, inside);
+      break;
+    case VTK_VOXEL:
+      single ? Kernels<Voxel>::EvaluatePosition<0>(coordinates, n, x, pcoords, weights, inside)
+             : Kernels<Voxel>::EvaluatePosition<1>(coordinates, n, x, pcoords, weights, inside);
+      break;
+    case VTK_HEXAHEDRON:
+      single
+        ? Kernels<Hexahedron>::EvaluatePosition<0>(coordinates, n, x, pcoords, weights, inside)
+        : Kernels<Hexahedron>::EvaluatePosition<1>(coordinates, n, x, pcoords, weights, inside);
+      break;
+    case VTK_WEDGE:
+      single ? Kernels<Wedge>::EvaluatePosition<0>(coordinates, n, x, pcoords, weights, inside)
+             : Kernels<Wedge>::EvaluatePosition<1>(coordinates, n, x, pcoords, weights, inside);
+      break;
+    default:
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkLinearCellEvaluator::InterpolateFunctions(
+  vtkIdType n, const double* pcoords, double* weights) const
+{
+  switch (this->CellType)
+  {
+    case VTK_TETRA:
+      InterpolateFunctionsImpl<TetraFunctions>(n, pcoords, weights);
+      break;
+    case VTK_VOXEL:
+      InterpolateFunctionsImpl<VoxelFunctions>(n, pcoords, weights);
+      break;
+    case VTK_HEXAHEDRON:
+      InterpolateFunctionsImpl<HexahedronFunctions>(n, pcoords, weights);
+      break;
+    case VTK_WEDGE:
+      InterpolateFunctionsImpl<WedgeFunctions>(n, pcoords, weights);
+      break;
+    default:
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkLinearCellEvaluator::Derivatives(
+  vtkIdType n, const double* pcoords, const double* values, int dim, double* derivs) const
+{
+  if (n <= 0 || this->NumberOfCells == 0)
+  {
+    return;
+  }
+  const double* coordinates = this->Coordinates.data();
+  const bool single = this->NumberOfCells == 1;
+  switch (this->CellType)
+  {
+    case VTK_TETRA:
+      single ? Kernels<Tetra>::Derivatives<0>(coordinates, n, pcoords, values, dim, derivs)
+             : Kernels<Tetra>::Derivatives<1>(coordinates, n, pcoords, values, dim, derivs);
+      break;
+    case VTK_VOXEL:
+      single ? Kernels<Voxel>::Derivatives<0>(coordinates, n, pcoords, values, dim, derivs)
+             : Kernels<Voxel>::Derivatives<1>(coordinates, n, pcoords, values, dim, derivs);
+      break;
+    case VTK_HEXAHEDRON:
+      single ? Kernels<Hexahedron>::Derivatives<0>(coordinates, n, pcoords, values, dim, derivs)
+             : Kernels<Hexahedron>::Derivatives<1>(coordinates, n, pcoords, values, dim, derivs);
+      break;
+    case VTK_WEDGE:
+      single ? Kernels<Wedge>::Derivatives<0>(coordinates, n, pcoords, values, dim, derivs)
+             : Kernels<Wedge>::Derivatives<1>(coordinates, n, pcoords, values, dim, derivs);
+      break;
+    default:
+      break;
+  }
+}
+VTK_ABI_NAMESPACE_END
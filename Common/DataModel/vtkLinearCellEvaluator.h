@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkLinearCellEvaluator
+ * @brief   evaluate many linear 3D cells of the same type at once
+ *
+ * vtkLinearCellEvaluator evaluates positions, interpolation functions and
+ * derivatives in batches of cells of a single linear 3D type: VTK_TETRA,
+ * VTK_VOXEL, VTK_HEXAHEDRON or VTK_WEDGE. It computes the same values as the
+ * EvaluatePosition(), InterpolateFunctions() and Derivatives() methods of
+ * vtkTetra, vtkVoxel, vtkHexahedron and vtkWedge, without a virtual call per
+ * cell and without copying the cell points into a vtkGenericCell.
+ *
+ * The coordinates of the cell points are stored by blocks of a few cells,
+ * each coordinate of a block being contiguous. The kernels process a block
+ * at a time with the same operations on all its cells, which lets the
+ * compiler vectorize them. This includes the Newton iterations of
+ * hexahedra and wedges: all the cells of a block iterate until the last one
+ * converges, cells which already converged keeping their result.
+ *
+ * Cells are added with InsertNextCell(). The batch methods then take n
+ * queries, query i being evaluated in cell i. As a special case, when the
+ * evaluator holds a single cell all the queries are evaluated in it, which
+ * is how a set of points is located in one cell.
+ *
+ * Queries and results use the layout of the vtkCell methods, one query after
+ * the other: 3 parametric coordinates, GetNumberOfPoints() weights, or
+ * 3 * dim derivatives per query.
+ *
+ * An evaluator is not thread safe, but it is cheap: threads should use their
+ * own instance, reusing it with Reset() between batches.
+ *
+ * @sa
+ * vtkTetra vtkVoxel vtkHexahedron vtkWedge vtkGenericCell
+ */
+
+#ifndef vtkLinearCellEvaluator_h
+#define vtkLinearCellEvaluator_h
+
+#include "vtkCellType.h"              // For VTK_TETRA
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkType.h"                  // For vtkIdType
+
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkPoints;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkLinearCellEvaluator
+{
+public:
+  /**
+   * Return whether cells of the given type can be evaluated.
+   */
+  static bool IsTypeSupported(int cellType);
+
+  /**
+   * Construct an evaluator for cells of the given type, VTK_TETRA by
+   * default.
+   */
+  vtkLinearCellEvaluator(int cellType = VTK_TETRA);
+
+  ///@{
+  /**
+   * Set/Get the type of the cells to evaluate. Setting a type removes all
+   * the cells. Return false, leaving the evaluator unchanged, if the type
+   * is not supported.
+   */
+  bool SetCellType(int cellType);
+  int GetCellType() const { return this->CellType; }
+  ///@}
+
+  /**
+   * Return the number of points of the cells.
+   */
+  int GetNumberOfPoints() const { return this->NumberOfPoints; }
+
+  /**
+   * Get the parametric center of the cells, as vtkCell::GetParametricCenter().
+   */
+  void GetParametricCenter(double pcoords[3]) const;
+
+  /**
+   * Remove all the cells, keeping the allocated memory.
+   */
+  void Reset();
+
+  /**
+   * Return the number of cells in the evaluator.
+   */
+  vtkIdType GetNumberOfCells() const { return this->NumberOfCells; }
+
+  ///@{
+  /**
+   * Add a cell and return its index in the evaluator. The coordinates of its
+   * points are either given, GetNumberOfPoints() triplets in the order of
+   * the points of the cell, or read from points at the given point ids.
+   */
+  vtkIdType InsertNextCell(const double* coordinates);
+  vtkIdType InsertNextCell(vtkPoints* points, const vtkIdType* pointIds);
+  ///@}
+
+  /**
+   * Compute the parametric coordinates and the interpolation weights of the
+   * n points x (3 * n coordinates), and whether they are inside their cell,
+   * as vtkCell::EvaluatePosition() does: inside[i] is 1 if point i is inside,
+   * 0 if it is outside and -1 if the computation failed (degenerate cell or
+   * no convergence), in which case pcoords and weights are undefined. Closest
+   * points are not computed. weights may be nullptr.
+   */
+  void EvaluatePosition(vtkIdType n, const double* x, double* pcoords, double* weights,
+    signed char* inside) const;
+
+  /**
+   * Compute the interpolation weights at the n given parametric coordinates.
+   * This does not depend on the cells of the evaluator.
+   */
+  void InterpolateFunctions(vtkIdType n, const double* pcoords, double* weights) const;
+
+  /**
+   * Compute the derivatives of point data at the n given parametric
+   * coordinates, as vtkCell::Derivatives() does. values holds dim values per
+   * point of the cell of each query, GetNumberOfPoints() * dim values per
+   * query, and derivs receives 3 * dim derivatives per query. The derivatives
+   * are zero for degenerate cells.
+   */
+  void Derivatives(
+    vtkIdType n, const double* pcoords, const double* values, int dim, double* derivs) const;
+
+  /**
+   * Number of cells stored together in a block of coordinates.
+   */
+  static constexpr int BlockSize = 8;
+
+private:
+  int CellType;
+  int NumberOfPoints;
+  vtkIdType NumberOfCells;
+
+  // Coordinates of the cell points by blocks of BlockSize cells: the value of
+  // coordinate c of point p of the j-th cell of block b is at
+  // ((b * NumberOfPoints + p) * 3 + c) * BlockSize + j.
+  std::vector<double> Coordinates;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkLinearCellEvaluator.h
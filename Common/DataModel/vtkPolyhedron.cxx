@@ -17,11 +17,13 @@
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkPolyhedronTopology.h"
 #include "vtkQuad.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkVector.h"
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <map>
@@ -189,6 +191,8 @@ vtkPolyhedron::vtkPolyhedron()
 
   this->FacesGenerated = 0;
   this->Faces = vtkCellArray::New();
+  this->Topology = nullptr;
+  this->TopologyCellId = 0;
 
   this->BoundsComputed = 0;
 
@@ -356,6 +360,40 @@ void vtkPolyhedron::Initialize()
   // No supplemental geometric stuff created
   this->PolyDataConstructed = 0;
   this->LocatorConstructed = 0;
+
+  // Take the edges and canonical faces from the precomputed topology if any
+  if (this->Topology)
+  {
+    vtkIdType numEdges;
+    const vtkIdType* edges;
+    const vtkIdType* edgeFaces;
+    this->Topology->GetEdges(this->TopologyCellId, numEdges, edges, edgeFaces);
+    this->Edges->SetNumberOfTuples(numEdges);
+    this->EdgeFaces->SetNumberOfTuples(numEdges);
+    std::copy(edges, edges + 2 * numEdges, this->Edges->GetPointer(0));
+    std::copy(edgeFaces, edgeFaces + 2 * numEdges, this->EdgeFaces->GetPointer(0));
+    this->EdgesGenerated = 1;
+
+    const vtkIdType numFaces = this->Topology->GetNumberOfFaces(this->TopologyCellId);
+    vtkIdType npts;
+    const vtkIdType* face;
+    this->Faces->AllocateExact(numFaces, 2 * numEdges);
+    for (vtkIdType faceId = 0; faceId < numFaces; ++faceId)
+    {
+      this->Topology->GetFace(this->TopologyCellId, faceId, npts, face);
+      this->Faces->InsertNextCell(npts, face);
+    }
+    this->FacesGenerated = 1;
+
+    this->Topology = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedron::SetPolyhedronTopology(vtkPolyhedronTopology* topology, vtkIdType cellId)
+{
+  this->Topology = topology;
+  this->TopologyCellId = cellId;
 }
 
 //------------------------------------------------------------------------------
@@ -864,9 +902,11 @@ bool vtkPolyhedron::IsConvex()
   this->ComputeBounds();
 
   // loop over all edges in the polyhedron
-  this->EdgeTable->InitTraversal();
-  while ((edgeId = this->EdgeTable->GetNextEdge(w[0], w[1])) >= 0)
+  const vtkIdType numEdges = this->Edges->GetNumberOfTuples();
+  for (edgeId = 0; edgeId < numEdges; ++edgeId)
   {
+    this->Edges->GetTypedTuple(edgeId, w);
+
     // get the edge points
     this->Points->GetPoint(w[0], x[0]);
     this->Points->GetPoint(w[1], x[1]);
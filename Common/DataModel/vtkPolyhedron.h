@@ -138,6 +138,7 @@ class vtkPolyData;
 class vtkCellLocator;
 class vtkGenericCell;
 class vtkPointLocator;
+class vtkPolyhedronTopology;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkPolyhedron : public vtkCell3D
 {
@@ -220,6 +221,15 @@ public:
    */
   void Initialize() override;
 
+  /**
+   * Have the next call to Initialize() take the canonical faces and the edges
+   * of the polyhedron from the precomputed topology of a cell of a grid
+   * instead of computing them. The point ids and faces of the polyhedron must
+   * be those of this cell. vtkUnstructuredGrid::GetCell() does this when the
+   * grid holds a vtkPolyhedronTopology.
+   */
+  void SetPolyhedronTopology(vtkPolyhedronTopology* topology, vtkIdType cellId);
+
   ///@{
   /**
    * A polyhedron is represented internally by a set of polygonal faces.
@@ -475,6 +485,10 @@ protected:
   vtkCellArray* Faces; // These are numbered in canonical id space
   int FacesGenerated;  // True when Faces have been successfully constructed
 
+  // Precomputed topology used by the next call to Initialize(), if any
+  vtkPolyhedronTopology* Topology;
+  vtkIdType TopologyCellId;
+
   // Bounds management
   int BoundsComputed;
   void ComputeBounds();
@@ -0,0 +1,333 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPolyhedronTopology.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkPolyhedronTopology);
+
+//------------------------------------------------------------------------------
+// Local topology of one cell, computed as vtkPolyhedron::Initialize(),
+// vtkPolyhedron::GenerateFaces() and vtkPolyhedron::GenerateEdges() do.
+struct vtkPolyhedronTopology::CellTopology
+{
+  vtkUnstructuredGrid* Grid;
+  vtkSmartPointer<vtkIdList> PointIds;
+  vtkSmartPointer<vtkIdList> FaceIds;
+  vtkSmartPointer<vtkIdList> FacePointIds;
+
+  // (global id, canonical id) pairs of the cell points, sorted
+  std::vector<std::pair<vtkIdType, vtkIdType>> PointIdMap;
+  std::unordered_map<vtkIdType, vtkIdType> EdgeIds;
+
+  std::vector<vtkIdType> FaceOffsets;
+  std::vector<vtkIdType> FaceConnectivity;
+  std::vector<vtkIdType> Edges;
+  std::vector<vtkIdType> EdgeFaces;
+
+  void Initialize(vtkUnstructuredGrid* grid)
+  {
+    this->Grid = grid;
+    this->PointIds = vtkSmartPointer<vtkIdList>::New();
+    this->FaceIds = vtkSmartPointer<vtkIdList>::New();
+    this->FacePointIds = vtkSmartPointer<vtkIdList>::New();
+  }
+
+  // Map a global point id to its canonical id. As with the std::map of
+  // vtkPolyhedron, the last occurrence of a repeated point wins and unknown
+  // points map to 0.
+  vtkIdType GetCanonicalId(vtkIdType pointId) const
+  {
+    auto it = std::upper_bound(this->PointIdMap.begin(), this->PointIdMap.end(), pointId,
+      [](vtkIdType id, const std::pair<vtkIdType, vtkIdType>& entry) { return id < entry.first; });
+    if (it == this->PointIdMap.begin() || (--it)->first != pointId)
+    {
+      return 0;
+    }
+    return it->second;
+  }
+
+  // Return false if the cell is not a polyhedron with faces
+  bool Compute(vtkIdType cellId)
+  {
+    this->FaceOffsets.assign(1, 0);
+    this->FaceConnectivity.clear();
+    this->Edges.clear();
+    this->EdgeFaces.clear();
+
+    vtkCellArray* faceLocations = this->Grid->GetPolyhedronFaceLocations();
+    vtkCellArray* faces = this->Grid->GetPolyhedronFaces();
+    if (this->Grid->GetCellType(cellId) != VTK_POLYHEDRON || !faceLocations || !faces ||
+      cellId >= faceLocations->GetNumberOfCells())
+    {
+      return false;
+    }
+
+    vtkIdType nfaces;
+    const vtkIdType* faceIds;
+    faceLocations->GetCellAtId(cellId, nfaces, faceIds, this->FaceIds);
+    if (nfaces == 0)
+    {
+      return false;
+    }
+
+    vtkIdType npts;
+    const vtkIdType* pts;
+    this->Grid->GetCells()->GetCellAtId(cellId, npts, pts, this->PointIds);
+    this->PointIdMap.resize(npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      this->PointIdMap[i] = std::make_pair(pts[i], i);
+    }
+    std::sort(this->PointIdMap.begin(), this->PointIdMap.end());
+
+    this->EdgeIds.clear();
+    for (vtkIdType fid = 0; fid < nfaces; ++fid)
+    {
+      vtkIdType nfacePts;
+      const vtkIdType* facePts;
+      faces->GetCellAtId(faceIds[fid], nfacePts, facePts, this->FacePointIds);
+      const vtkIdType first = static_cast<vtkIdType>(this->FaceConnectivity.size());
+      for (vtkIdType i = 0; i < nfacePts; ++i)
+      {
+        this->FaceConnectivity.push_back(this->GetCanonicalId(facePts[i]));
+      }
+      this->FaceOffsets.push_back(static_cast<vtkIdType>(this->FaceConnectivity.size()));
+
+      // Edges are numbered in order of appearance. The second face of an
+      // edge is the last other face using it.
+      for (vtkIdType i = 0; i < nfacePts; ++i)
+      {
+        const vtkIdType p0 = this->FaceConnectivity[first + i];
+        const vtkIdType p1 = this->FaceConnectivity[first + (i + 1 != nfacePts ? i + 1 : 0)];
+        const vtkIdType key = std::min(p0, p1) * npts + std::max(p0, p1);
+        auto inserted =
+          this->EdgeIds.insert(std::make_pair(key, static_cast<vtkIdType>(this->Edges.size())));
+        if (inserted.second)
+        {
+          this->Edges.push_back(p0);
+          this->Edges.push_back(p1);
+          this->EdgeFaces.push_back(fid);
+          this->EdgeFaces.push_back(-1);
+        }
+        else
+        {
+          this->EdgeFaces[inserted.first->second + 1] = fid;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+//------------------------------------------------------------------------------
+// First pass: count the faces, face points and edges of each cell
+struct vtkPolyhedronTopology::CountFunctor
+{
+  vtkPolyhedronTopology* Self;
+  vtkUnstructuredGrid* Grid;
+  std::vector<vtkIdType>& NumberOfPoints;
+  vtkSMPThreadLocal<CellTopology> Topology;
+
+  CountFunctor(vtkPolyhedronTopology* self, vtkUnstructuredGrid* grid,
+    std::vector<vtkIdType>& numberOfPoints)
+    : Self(self)
+    , Grid(grid)
+    , NumberOfPoints(numberOfPoints)
+  {
+  }
+
+  void Initialize() { this->Topology.Local().Initialize(this->Grid); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    CellTopology& topology = this->Topology.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (topology.Compute(cellId))
+      {
+        this->Self->CellFaceOffsets[cellId] =
+          static_cast<vtkIdType>(topology.FaceOffsets.size()) - 1;
+        this->Self->CellEdgeOffsets[cellId] = static_cast<vtkIdType>(topology.Edges.size()) / 2;
+        this->NumberOfPoints[cellId] = static_cast<vtkIdType>(topology.FaceConnectivity.size());
+      }
+      else
+      {
+        this->Self->CellFaceOffsets[cellId] = 0;
+        this->Self->CellEdgeOffsets[cellId] = 0;
+        this->NumberOfPoints[cellId] = 0;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Second pass: fill the topology at the offsets of each cell
+struct vtkPolyhedronTopology::FillFunctor
+{
+  vtkPolyhedronTopology* Self;
+  vtkUnstructuredGrid* Grid;
+  const std::vector<vtkIdType>& PointOffsets;
+  vtkSMPThreadLocal<CellTopology> Topology;
+
+  FillFunctor(vtkPolyhedronTopology* self, vtkUnstructuredGrid* grid,
+    const std::vector<vtkIdType>& pointOffsets)
+    : Self(self)
+    , Grid(grid)
+    , PointOffsets(pointOffsets)
+  {
+  }
+
+  void Initialize() { this->Topology.Local().Initialize(this->Grid); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    CellTopology& topology = this->Topology.Local();
+    vtkPolyhedronTopology* self = this->Self;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (self->GetNumberOfFaces(cellId) == 0 || !topology.Compute(cellId))
+      {
+        continue;
+      }
+      const vtkIdType faceOffset = self->CellFaceOffsets[cellId];
+      const vtkIdType pointOffset = this->PointOffsets[cellId];
+      const vtkIdType nfaces = static_cast<vtkIdType>(topology.FaceOffsets.size()) - 1;
+      for (vtkIdType fid = 0; fid < nfaces; ++fid)
+      {
+        self->FaceOffsets[faceOffset + fid] = pointOffset + topology.FaceOffsets[fid];
+      }
+      std::copy(topology.FaceConnectivity.begin(), topology.FaceConnectivity.end(),
+        self->FaceConnectivity.begin() + pointOffset);
+      const vtkIdType edgeOffset = 2 * self->CellEdgeOffsets[cellId];
+      std::copy(topology.Edges.begin(), topology.Edges.end(), self->Edges.begin() + edgeOffset);
+      std::copy(
+        topology.EdgeFaces.begin(), topology.EdgeFaces.end(), self->EdgeFaces.begin() + edgeOffset);
+    }
+  }
+
+  void Reduce() {}
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Replace counts with offsets, the last entry receiving the total
+vtkIdType CountsToOffsets(std::vector<vtkIdType>& counts)
+{
+  vtkIdType offset = 0;
+  for (vtkIdType& count : counts)
+  {
+    const vtkIdType next = offset + count;
+    count = offset;
+    offset = next;
+  }
+  return offset;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkPolyhedronTopology::vtkPolyhedronTopology()
+{
+  this->Initialize();
+}
+
+//------------------------------------------------------------------------------
+vtkPolyhedronTopology::~vtkPolyhedronTopology() = default;
+
+//------------------------------------------------------------------------------
+void vtkPolyhedronTopology::Initialize()
+{
+  this->CellFaceOffsets.assign(1, 0);
+  this->CellEdgeOffsets.assign(1, 0);
+  this->FaceOffsets.assign(1, 0);
+  this->FaceConnectivity.clear();
+  this->Edges.clear();
+  this->EdgeFaces.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedronTopology::Build(vtkUnstructuredGrid* grid)
+{
+  this->Initialize();
+  if (!grid || !grid->GetCells())
+  {
+    return;
+  }
+
+  // Make the grid API thread safe by calling it once in a single thread
+  const vtkIdType numCells = grid->GetNumberOfCells();
+  if (numCells > 0)
+  {
+    grid->GetCellType(0);
+  }
+
+  std::vector<vtkIdType> pointOffsets(numCells + 1, 0);
+  this->CellFaceOffsets.assign(numCells + 1, 0);
+  this->CellEdgeOffsets.assign(numCells + 1, 0);
+  CountFunctor count(this, grid, pointOffsets);
+  vtkSMPTools::For(0, numCells, count);
+
+  const vtkIdType numFaces = CountsToOffsets(this->CellFaceOffsets);
+  const vtkIdType numEdges = CountsToOffsets(this->CellEdgeOffsets);
+  const vtkIdType numPoints = CountsToOffsets(pointOffsets);
+  this->FaceOffsets.resize(numFaces + 1);
+  this->FaceOffsets[numFaces] = numPoints;
+  this->FaceConnectivity.resize(numPoints);
+  this->Edges.resize(2 * numEdges);
+  this->EdgeFaces.resize(2 * numEdges);
+
+  FillFunctor fill(this, grid, pointOffsets);
+  vtkSMPTools::For(0, numCells, fill);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkPolyhedronTopology::GetActualMemorySize() const
+{
+  const size_t size = this->CellFaceOffsets.capacity() + this->CellEdgeOffsets.capacity() +
+    this->FaceOffsets.capacity() + this->FaceConnectivity.capacity() + this->Edges.capacity() +
+    this->EdgeFaces.capacity();
+  return static_cast<unsigned long>(size * sizeof(vtkIdType) / 1024);
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedronTopology::DeepCopy(vtkPolyhedronTopology* source)
+{
+  if (!source || source == this)
+  {
+    return;
+  }
+  this->CellFaceOffsets = source->CellFaceOffsets;
+  this->CellEdgeOffsets = source->CellEdgeOffsets;
+  this->FaceOffsets = source->FaceOffsets;
+  this->FaceConnectivity = source->FaceConnectivity;
+  this->Edges = source->Edges;
+  this->EdgeFaces = source->EdgeFaces;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkPolyhedronTopology::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << "\n";
+  os << indent << "Number Of Faces: " << this->FaceOffsets.size() - 1 << "\n";
+  os << indent << "Number Of Edges: " << this->Edges.size() / 2 << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPolyhedronTopology
+ * @brief   precomputed local topology of the polyhedral cells of a grid
+ *
+ * vtkPolyhedronTopology is a supplemental object to vtkUnstructuredGrid
+ * storing, for each of its polyhedral cells, the local topology which
+ * vtkPolyhedron otherwise rebuilds each time the cell is loaded: the faces
+ * in canonical point ids (indices in the point ids of the cell, 0 to
+ * npts-1), the edges in canonical point ids, and the faces using each edge.
+ * Edges and faces are numbered as vtkPolyhedron numbers them.
+ *
+ * The topology is built once for all the cells, in parallel, with
+ * vtkUnstructuredGrid::BuildPolyhedronTopology(). vtkUnstructuredGrid::GetCell()
+ * then passes it to the vtkPolyhedron it fills. Like cell links, it must be
+ * rebuilt when the cells of the grid change.
+ *
+ * @sa
+ * vtkPolyhedron vtkUnstructuredGrid vtkStaticCellLinks
+ */
+
+#ifndef vtkPolyhedronTopology_h
+#define vtkPolyhedronTopology_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkUnstructuredGrid;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkPolyhedronTopology : public vtkObject
+{
+public:
+  ///@{
+  /**
+   * Standard methods for instantiation, type manipulation and printing.
+   */
+  static vtkPolyhedronTopology* New();
+  vtkTypeMacro(vtkPolyhedronTopology, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  ///@}
+
+  /**
+   * Build the topology of all the polyhedral cells of the grid.
+   */
+  void Build(vtkUnstructuredGrid* grid);
+
+  /**
+   * Release the topology.
+   */
+  void Initialize();
+
+  /**
+   * Return the number of cells of the grid the topology was built from.
+   */
+  vtkIdType GetNumberOfCells() const
+  {
+    return static_cast<vtkIdType>(this->CellFaceOffsets.size()) - 1;
+  }
+
+  /**
+   * Return the number of faces of a cell, 0 for a non-polyhedral cell.
+   */
+  vtkIdType GetNumberOfFaces(vtkIdType cellId) const
+  {
+    return this->CellFaceOffsets[cellId + 1] - this->CellFaceOffsets[cellId];
+  }
+
+  /**
+   * Return the number of edges of a cell, 0 for a non-polyhedral cell.
+   */
+  vtkIdType GetNumberOfEdges(vtkIdType cellId) const
+  {
+    return this->CellEdgeOffsets[cellId + 1] - this->CellEdgeOffsets[cellId];
+  }
+
+  /**
+   * Get a face of a cell in canonical point ids.
+   */
+  void GetFace(vtkIdType cellId, vtkIdType faceId, vtkIdType& npts, vtkIdType const*& pts) const
+  {
+    const vtkIdType face = this->CellFaceOffsets[cellId] + faceId;
+    npts = this->FaceOffsets[face + 1] - this->FaceOffsets[face];
+    pts = this->FaceConnectivity.data() + this->FaceOffsets[face];
+  }
+
+  /**
+   * Get the edges of a cell and the faces using them, both as pairs. Edges
+   * are in canonical point ids. The second face of an edge is -1 when only
+   * one face uses it.
+   */
+  void GetEdges(
+    vtkIdType cellId, vtkIdType& nedges, vtkIdType const*& edges, vtkIdType const*& faces) const
+  {
+    const vtkIdType offset = 2 * this->CellEdgeOffsets[cellId];
+    nedges = this->GetNumberOfEdges(cellId);
+    edges = this->Edges.data() + offset;
+    faces = this->EdgeFaces.data() + offset;
+  }
+
+  /**
+   * Return the memory used by the topology in kibibytes.
+   */
+  unsigned long GetActualMemorySize() const;
+
+  /**
+   * Copy the topology of another object.
+   */
+  void DeepCopy(vtkPolyhedronTopology* source);
+
+protected:
+  vtkPolyhedronTopology();
+  ~vtkPolyhedronTopology() override;
+
+private:
+  vtkPolyhedronTopology(const vtkPolyhedronTopology&) = delete;
+  void operator=(const vtkPolyhedronTopology&) = delete;
+
+  struct CellTopology;
+  struct CountFunctor;
+  struct FillFunctor;
+
+  // For each cell, offsets of its faces in FaceOffsets and of its edges in
+  // Edges and EdgeFaces (counted in pairs).
+  std::vector<vtkIdType> CellFaceOffsets;
+  std::vector<vtkIdType> CellEdgeOffsets;
+
+  // Faces of all the cells, in canonical point ids
+  std::vector<vtkIdType> FaceOffsets;
+  std::vector<vtkIdType> FaceConnectivity;
+
+  // Edges of all the cells, in canonical point ids, and faces using them
+  std::vector<vtkIdType> Edges;
+  std::vector<vtkIdType> EdgeFaces;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
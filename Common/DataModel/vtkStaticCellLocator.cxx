@@ -631,9 +631,10 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
   double step[3], next[3], tMax[3], tDelta[3];
   double binBounds[6];
 
-  // Initialize intersection query array if necessary. This is done
-  // locally to ensure thread safety.
-  std::vector<bool> cellHasBeenVisited(this->NumCells, false);
+  // Flags of the cells already tested, borrowed from the locator for this
+  // query only to ensure thread safety.
+  vtkAbstractCellLocator::vtkVisitedCells visitedCells(
+    this->Binner->Locator, this->NumCells);
 
   // Get the i-j-k point of intersection and bin index. This is
   // clamped to the boundary of the locator. Also get the exit bin
@@ -675,9 +676,9 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
       for (i = 0; i < numCellsInBin; i++)
       {
         cId = cellFragments[i].CellId;
-        if (!cellHasBeenVisited[cId])
+        if (!visitedCells.IsVisited(cId))
         {
-          cellHasBeenVisited[cId] = true;
+          visitedCells.Visit(cId);
 
           // check whether we intersect the cell bounds
           int hitCellBounds = vtkBox::IntersectBox(
@@ -685,7 +686,7 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
 
           if (hitCellBounds)
           {
-            // Note because of cellHasBeenVisited[], we know this cId is unique
+            // Note because of visitedCells, we know this cId is unique
             if (cell)
             {
               this->DataSet->GetCell(cId, cell);
@@ -695,7 +696,7 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
                 // intersections can occur behind this bin which are not the correct answer.
                 if (!CellProcessor::IsInBounds(binBounds, x, tol))
                 {
-                  cellHasBeenVisited[cId] = false; // mark the cell non-visited
+                  visitedCells.Unvisit(cId); // mark the cell non-visited
                 }
                 else
                 {
@@ -708,7 +709,7 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
               cellIntersections.emplace_back(cId, hitCellBoundsPosition, tHitCell);
             }
           } // if (hitCellBounds)
-        }   // if (!cellHasBeenVisited[cId])
+        }   // if (!visitedCells.IsVisited(cId))
       }     // over all cells in bin
     }       // if cells in bin
 
@@ -1157,9 +1158,10 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
     return 0; // No intersections possible, line is outside the locator
   }
 
-  // Initialize intersection query array if necessary. This is done
-  // locally to ensure thread safety.
-  std::vector<bool> cellHasBeenVisited(this->NumCells, false);
+  // Flags of the cells already tested, borrowed from the locator for this
+  // query only to ensure thread safety.
+  vtkAbstractCellLocator::vtkVisitedCells visitedCells(
+    this->Binner->Locator, this->NumCells);
 
   // Get the i-j-k point of intersection and bin index. This is
   // clamped to the boundary of the locator.
@@ -1198,9 +1200,9 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
       for (i = 0; i < numCellsInBin; i++)
       {
         cId = cellIds[i].CellId;
-        if (!cellHasBeenVisited[cId])
+        if (!visitedCells.IsVisited(cId))
         {
-          cellHasBeenVisited[cId] = true;
+          visitedCells.Visit(cId);
 
           // check whether we intersect the cell bounds
           int hitCellBounds = vtkBox::IntersectBox(
@@ -1217,7 +1219,7 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
               // intersections can occur behind this bin which are not the correct answer.
               if (!CellProcessor::IsInBounds(binBounds, x, tol))
               {
-                cellHasBeenVisited[cId] = false; // mark the cell non-visited
+                visitedCells.Unvisit(cId); // mark the cell non-visited
               }
               else
               {
@@ -1233,7 +1235,7 @@ int CellProcessor<T>::IntersectWithLine(const double p1[3], const double p2[3],
               }
             } // if intersection
           }   // if (hitCellBounds)
-        }     // if (!cellHasBeenVisited[cId])
+        }     // if (!visitedCells.IsVisited(cId))
       }       // over all cells in bin
     }         // if cells in bin
 
@@ -199,6 +199,11 @@ public:
    */
   bool InsideCellBounds(double x[3], vtkIdType cellId) override;
 
+  /**
+   * The static locator is read only once built: batched queries are processed in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   ///@{
   /**
    * Satisfy vtkLocator abstract interface.
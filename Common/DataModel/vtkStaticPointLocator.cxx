@@ -18,6 +18,7 @@
 #include "vtkSMPTools.h"
 #include "vtkStructuredData.h"
 
+#include <algorithm>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -30,7 +31,8 @@ constexpr size_t VTK_INITIAL_BUCKET_SIZE = 10000;
 //------------------------------------------------------------------------------
 // The following code supports threaded point locator construction. The locator
 // is assumed to be constructed once (i.e., it does not allow incremental point
-// insertion). The algorithm proceeds in three steps:
+// insertion, although points that move can be re-binned, see UpdateMap()).
+// The algorithm proceeds in three steps:
 // 1) All points are assigned a bucket index (combined i-j-k bucket location).
 // The index is computed in parallel. This requires a one time allocation of an
 // index array (which is also associated with the originating point ids).
@@ -612,6 +614,212 @@ struct BucketList : public vtkBucketList
     }   // operator()
   };
 
+  // Support incremental updates of the map. A moved tuple records the position
+  // in the sorted map of a point that no longer lies in its bucket, and the
+  // bucket the point now lies in.
+  struct MovedTuple
+  {
+    vtkIdType Position;
+    TIds Bucket;
+  };
+
+  // Accessors to the point coordinates, used when looking for moved points.
+  template <typename TPts>
+  struct PointsArrayAccessor
+  {
+    const TPts* Points;
+    void GetPoint(vtkIdType ptId, double p[3]) const
+    {
+      const TPts* x = this->Points + 3 * ptId;
+      p[0] = static_cast<double>(x[0]);
+      p[1] = static_cast<double>(x[1]);
+      p[2] = static_cast<double>(x[2]);
+    }
+  };
+  struct DataSetAccessor
+  {
+    vtkDataSet* DataSet;
+    void GetPoint(vtkIdType ptId, double p[3]) const { this->DataSet->GetPoint(ptId, p); }
+  };
+
+  // Traverse batches of the sorted map and recompute the bucket of the
+  // candidate points (all the points if no candidates are given). Each batch
+  // gathers its moved tuples in map order, and flags points that left the
+  // bounds of the locator: these cannot be binned without rebuilding.
+  template <typename TAccessor>
+  struct FindMovedPoints
+  {
+    BucketList<TIds>* BList;
+    TAccessor Accessor;
+    const unsigned char* Candidates;
+    std::vector<std::vector<MovedTuple>>& Moved;
+    std::vector<unsigned char>& Outside;
+
+    FindMovedPoints(BucketList<TIds>* blist, TAccessor accessor, const unsigned char* candidates,
+      std::vector<std::vector<MovedTuple>>& moved, std::vector<unsigned char>& outside)
+      : BList(blist)
+      , Accessor(accessor)
+      , Candidates(candidates)
+      , Moved(moved)
+      , Outside(outside)
+    {
+    }
+
+    void operator()(vtkIdType batch, vtkIdType batchEnd)
+    {
+      const double* bds = this->BList->Bounds;
+      double p[3];
+      for (; batch < batchEnd; ++batch)
+      {
+        vtkIdType pos = batch * this->BList->BatchSize;
+        vtkIdType endPos = std::min(pos + this->BList->BatchSize, this->BList->NumPts);
+        std::vector<MovedTuple>& moved = this->Moved[batch];
+        for (; pos < endPos; ++pos)
+        {
+          const LocatorTuple<TIds>& tuple = this->BList->Map[pos];
+          if (this->Candidates && !this->Candidates[tuple.PtId])
+          {
+            continue;
+          }
+          this->Accessor.GetPoint(tuple.PtId, p);
+          if (p[0] < bds[0] || p[0] > bds[1] || p[1] < bds[2] || p[1] > bds[3] || p[2] < bds[4] ||
+            p[2] > bds[5])
+          {
+            this->Outside[batch] = 1;
+            break;
+          }
+          TIds bucket = static_cast<TIds>(this->BList->GetBucketIndex(p));
+          if (bucket != tuple.Bucket)
+          {
+            moved.push_back(MovedTuple{ pos, bucket });
+          }
+        }
+      }
+    }
+  };
+
+  // Re-bin the points that moved since the map was built. The tuples of the
+  // points that changed bucket are pulled out of the map, sorted, and merged
+  // back in: each batch of the old map is merged with the moved tuples that
+  // fall between it and the next batch, so the batches are processed in
+  // parallel and the whole map is never sorted again. Returns the number of
+  // points that changed bucket, or -1 (leaving the map untouched) if the
+  // locator has to be rebuilt.
+  vtkIdType UpdateMap(const unsigned char* candidates, vtkIdType maxMoved)
+  {
+    vtkIdType numBatches =
+      static_cast<vtkIdType>(ceil(static_cast<double>(this->NumPts) / this->BatchSize));
+    std::vector<std::vector<MovedTuple>> moved(numBatches);
+    std::vector<unsigned char> outside(numBatches, 0);
+
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(this->DataSet);
+    int dataType = (ps && ps->GetPoints() ? ps->GetPoints()->GetDataType() : VTK_VOID);
+    if (dataType == VTK_FLOAT)
+    {
+      PointsArrayAccessor<float> accessor{ static_cast<float*>(
+        ps->GetPoints()->GetVoidPointer(0)) };
+      FindMovedPoints<PointsArrayAccessor<float>> finder(
+        this, accessor, candidates, moved, outside);
+      vtkSMPTools::For(0, numBatches, finder);
+    }
+    else if (dataType == VTK_DOUBLE)
+    {
+      PointsArrayAccessor<double> accessor{ static_cast<double*>(
+        ps->GetPoints()->GetVoidPointer(0)) };
+      FindMovedPoints<PointsArrayAccessor<double>> finder(
+        this, accessor, candidates, moved, outside);
+      vtkSMPTools::For(0, numBatches, finder);
+    }
+    else
+    {
+      DataSetAccessor accessor{ this->DataSet };
+      FindMovedPoints<DataSetAccessor> finder(this, accessor, candidates, moved, outside);
+      vtkSMPTools::For(0, numBatches, finder);
+    }
+
+    // Offsets of the moved tuples of each batch
+    std::vector<vtkIdType> movedOffsets(numBatches + 1, 0);
+    for (vtkIdType batch = 0; batch < numBatches; ++batch)
+    {
+      if (outside[batch])
+      {
+        return -1;
+      }
+      movedOffsets[batch + 1] = movedOffsets[batch] + static_cast<vtkIdType>(moved[batch].size());
+    }
+    vtkIdType numMoved = movedOffsets[numBatches];
+    if (numMoved == 0)
+    {
+      return 0;
+    }
+    if (numMoved > maxMoved)
+    {
+      return -1;
+    }
+
+    // The moved tuples, sorted in their new buckets
+    LocatorTuple<TIds>* map = this->Map;
+    std::vector<LocatorTuple<TIds>> inserted(numMoved);
+    vtkSMPTools::For(0, numBatches,
+      [&](vtkIdType batch, vtkIdType batchEnd)
+      {
+        for (; batch < batchEnd; ++batch)
+        {
+          LocatorTuple<TIds>* tuple = inserted.data() + movedOffsets[batch];
+          for (const MovedTuple& mt : moved[batch])
+          {
+            tuple->PtId = map[mt.Position].PtId;
+            tuple->Bucket = mt.Bucket;
+            ++tuple;
+          }
+        }
+      });
+    vtkSMPTools::Sort(inserted.begin(), inserted.end());
+
+    // Merge them with the tuples left in each batch
+    LocatorTuple<TIds>* newMap = new LocatorTuple<TIds>[this->NumPts + 1];
+    newMap[this->NumPts] = map[this->NumPts];
+    vtkSMPTools::For(0, numBatches,
+      [&](vtkIdType batch, vtkIdType batchEnd)
+      {
+        for (; batch < batchEnd; ++batch)
+        {
+          vtkIdType begin = batch * this->BatchSize;
+          vtkIdType end = std::min(begin + this->BatchSize, this->NumPts);
+          auto ins = (batch == 0 ? inserted.begin()
+                                 : std::lower_bound(inserted.begin(), inserted.end(), map[begin]));
+          auto insEnd = (batch == numBatches - 1
+              ? inserted.end()
+              : std::lower_bound(inserted.begin(), inserted.end(), map[end]));
+          LocatorTuple<TIds>* out =
+            newMap + begin - movedOffsets[batch] + (ins - inserted.begin());
+          auto mt = moved[batch].begin();
+          for (vtkIdType pos = begin; pos < end; ++pos)
+          {
+            if (mt != moved[batch].end() && mt->Position == pos)
+            {
+              ++mt; // this tuple moved to another bucket
+              continue;
+            }
+            for (; ins != insEnd && *ins < map[pos]; ++ins)
+            {
+              *out++ = *ins;
+            }
+            *out++ = map[pos];
+          }
+          std::copy(ins, insEnd, out);
+        }
+      });
+    delete[] this->Map;
+    this->Map = newMap;
+
+    // Finally rebuild the offsets
+    MapOffsets<TIds> offMapper(this);
+    vtkSMPTools::For(0, numBatches, offMapper);
+
+    return numMoved;
+  }
+
   // Merge points that are pecisely coincident. Operates in parallel on
   // locator buckets. Does not need to check neighbor buckets.
   template <typename T>
@@ -1919,6 +2127,7 @@ vtkStaticPointLocator::vtkStaticPointLocator()
   this->MaxNumberOfBuckets = VTK_INT_MAX;
   this->LargeIds = false;
   this->TraversalOrder = BIN_ORDER;
+  this->MaximumUpdateFraction = 0.25;
 }
 
 //------------------------------------------------------------------------------
@@ -2139,6 +2348,54 @@ void vtkStaticPointLocator::BuildLocator(const double* inBounds)
   this->BuildTime.Modified();
 }
 
+//------------------------------------------------------------------------------
+// Re-bin the points that moved instead of rebuilding the locator.
+vtkIdType vtkStaticPointLocator::UpdateLocator(vtkIdList* movedPoints)
+{
+  if (!this->Buckets || !this->DataSet ||
+    this->DataSet->GetNumberOfPoints() != this->Buckets->NumPts)
+  {
+    this->BuildLocatorInternal();
+    return -1;
+  }
+
+  vtkIdType numPts = this->Buckets->NumPts;
+  std::vector<unsigned char> candidates;
+  if (movedPoints)
+  {
+    candidates.resize(numPts, 0);
+    for (vtkIdType i = 0; i < movedPoints->GetNumberOfIds(); ++i)
+    {
+      vtkIdType ptId = movedPoints->GetId(i);
+      if (ptId >= 0 && ptId < numPts)
+      {
+        candidates[ptId] = 1;
+      }
+    }
+  }
+
+  vtkIdType maxMoved = static_cast<vtkIdType>(this->MaximumUpdateFraction * numPts);
+  const unsigned char* cand = (movedPoints ? candidates.data() : nullptr);
+  vtkIdType numMoved;
+  if (this->LargeIds)
+  {
+    numMoved = static_cast<BucketList<vtkIdType>*>(this->Buckets)->UpdateMap(cand, maxMoved);
+  }
+  else
+  {
+    numMoved = static_cast<BucketList<int>*>(this->Buckets)->UpdateMap(cand, maxMoved);
+  }
+
+  if (numMoved < 0)
+  {
+    vtkDebugMacro(<< "UpdateLocator rebuilding the locator");
+    this->BuildLocatorInternal();
+    return -1;
+  }
+  this->BuildTime.Modified();
+  return numMoved;
+}
+
 //------------------------------------------------------------------------------
 // These methods satisfy the vtkStaticPointLocator API. The implementation is
 // with the templated BucketList class. Note that a lot of the complexity here
@@ -2381,5 +2638,7 @@ void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Large IDs: " << this->LargeIds << "\n";
 
   os << indent << "Traversal Order: " << (this->TraversalOrder ? "On\n" : "Off\n");
+
+  os << indent << "Maximum Update Fraction: " << this->MaximumUpdateFraction << "\n";
 }
 VTK_ABI_NAMESPACE_END
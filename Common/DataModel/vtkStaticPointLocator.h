@@ -15,6 +15,9 @@
  * threaded (via vtkSMPTools), and supports one-time static construction
  * (i.e., incremental point insertion is not supported). If you need to
  * incrementally insert points, use the vtkPointLocator or its kin to do so.
+ * However once built, the locator can follow points that move (e.g., particles
+ * or a deforming mesh) with UpdateLocator(), which re-bins only the points
+ * that changed bucket.
  *
  * @warning
  * This class is templated. It may run slower than serial execution if the code
@@ -187,6 +190,29 @@ public:
   void BuildLocator(const double* inBounds);
   ///@}
 
+  /**
+   * Update the locator after the points of the dataset moved, without rebuilding it from
+   * scratch. The points listed in movedPoints are re-binned; if movedPoints is nullptr, the
+   * bucket of every point is recomputed to detect the points that moved. In both cases the
+   * bucket lookups and the update of the bucket contents are threaded, and the points that
+   * changed bucket are merged back into the sorted map instead of sorting all the points
+   * again, so that the result is identical to a full rebuild. The locator is rebuilt from
+   * scratch instead if it was not built yet, if the number of points changed, if a point
+   * left the bounds of the locator, or if the fraction of the points that changed bucket
+   * exceeds MaximumUpdateFraction. Return the number of points that changed bucket, or -1 if
+   * the locator was rebuilt. This method is not thread safe.
+   */
+  vtkIdType UpdateLocator(vtkIdList* movedPoints = nullptr);
+
+  ///@{
+  /**
+   * Specify the fraction of the points that may change bucket during UpdateLocator() before
+   * the locator is rebuilt from scratch instead (default 0.25).
+   */
+  vtkSetClampMacro(MaximumUpdateFraction, double, 0.0, 1.0);
+  vtkGetMacro(MaximumUpdateFraction, double);
+  ///@}
+
   /**
    * Populate a polydata with the faces of the bins that potentially contain cells.
    * Note that the level parameter has no effect on this method as there is no
@@ -295,6 +321,7 @@ protected:
   vtkIdType MaxNumberOfBuckets; // Maximum number of buckets in locator
   bool LargeIds;                // indicate whether integer ids are small or large
   int TraversalOrder;           // Control traversal order when threading
+  double MaximumUpdateFraction; // Control when UpdateLocator() rebuilds the locator
 
 private:
   vtkStaticPointLocator(const vtkStaticPointLocator&) = delete;
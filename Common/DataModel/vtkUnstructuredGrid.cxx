@@ -19,6 +19,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkPolyhedronTopology.h"
 #include "vtkStaticCellLinks.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGridCellIterator.h"
@@ -296,6 +297,7 @@ void vtkUnstructuredGrid::CopyStructure(vtkDataSet* ds)
   this->DistinctCellTypesUpdateMTime = 0;
   this->Faces = ug->Faces;
   this->FaceLocations = ug->FaceLocations;
+  this->PolyhedronTopology = ug->PolyhedronTopology;
 }
 
 //------------------------------------------------------------------------------
@@ -308,6 +310,7 @@ void vtkUnstructuredGrid::Cleanup()
   this->DistinctCellTypesUpdateMTime = 0;
   this->Faces = nullptr;
   this->FaceLocations = nullptr;
+  this->PolyhedronTopology = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -358,6 +361,15 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell* cell)
   if (cell->RequiresExplicitFaceRepresentation())
   {
     this->GetPolyhedronFaces(cellId, cell->GetCellFaces());
+
+    // Save the polyhedron from recomputing its topology
+    if (cellType == VTK_POLYHEDRON && this->PolyhedronTopology &&
+      cellId < this->PolyhedronTopology->GetNumberOfCells() &&
+      this->PolyhedronTopology->GetNumberOfFaces(cellId) > 0)
+    {
+      static_cast<vtkPolyhedron*>(cell->GetRepresentativeCell())
+        ->SetPolyhedronTopology(this->PolyhedronTopology, cellId);
+    }
   }
 
   // Some cells require special initialization to build data structures and such.
@@ -1039,6 +1051,7 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray* cellTypes, vtkCellArray
   this->Types = cellTypes;
   this->DistinctCellTypes = nullptr;
   this->DistinctCellTypesUpdateMTime = 0;
+  this->PolyhedronTopology = nullptr;
   this->Faces = nullptr;
   this->FaceLocations = nullptr;
   if (faceLocations != nullptr && faces != nullptr)
@@ -1090,6 +1103,7 @@ void vtkUnstructuredGrid::SetPolyhedralCells(vtkUnsignedCharArray* cellTypes, vt
   this->Types = cellTypes;
   this->DistinctCellTypes = nullptr;
   this->DistinctCellTypesUpdateMTime = 0;
+  this->PolyhedronTopology = nullptr;
   this->Faces = faces;
   this->FaceLocations = faceLocations;
   this->LegacyFaces = nullptr;
@@ -1126,6 +1140,27 @@ void vtkUnstructuredGrid::BuildLinks()
   this->Links->BuildLinks();
 }
 
+//------------------------------------------------------------------------------
+void vtkUnstructuredGrid::BuildPolyhedronTopology()
+{
+  if (!this->Faces || !this->FaceLocations)
+  {
+    this->PolyhedronTopology = nullptr;
+    return;
+  }
+
+  // The topology may be shared with shallow copies of the grid: build a new one
+  vtkNew<vtkPolyhedronTopology> topology;
+  topology->Build(this);
+  this->PolyhedronTopology = topology;
+}
+
+//------------------------------------------------------------------------------
+vtkPolyhedronTopology* vtkUnstructuredGrid::GetPolyhedronTopology()
+{
+  return this->PolyhedronTopology;
+}
+
 //------------------------------------------------------------------------------
 vtkAbstractCellLinks* vtkUnstructuredGrid::GetCellLinks()
 {
@@ -1379,6 +1414,7 @@ void vtkUnstructuredGrid::Reset()
   {
     this->FaceLocations->Reset();
   }
+  this->PolyhedronTopology = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -1447,6 +1483,7 @@ void vtkUnstructuredGrid::ResizeCellList(vtkIdType ptId, int size)
 void vtkUnstructuredGrid::InternalReplaceCell(vtkIdType cellId, int npts, const vtkIdType pts[])
 {
   this->Connectivity->ReplaceCellAtId(cellId, npts, pts);
+  this->PolyhedronTopology = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -1506,6 +1543,11 @@ unsigned long vtkUnstructuredGrid::GetActualMemorySize()
     size += this->FaceLocations->GetActualMemorySize();
   }
 
+  if (this->PolyhedronTopology)
+  {
+    size += this->PolyhedronTopology->GetActualMemorySize();
+  }
+
   return size;
 }
 
@@ -1529,6 +1571,7 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject* dataObject)
     this->DistinctCellTypesUpdateMTime = 0;
     this->Faces = grid->Faces;
     this->FaceLocations = grid->FaceLocations;
+    this->PolyhedronTopology = grid->PolyhedronTopology;
 
     if (grid->Links)
     {
@@ -1624,6 +1667,15 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject* dataObject)
     {
       this->FaceLocations = nullptr;
     }
+    if (grid->PolyhedronTopology)
+    {
+      this->PolyhedronTopology = vtkSmartPointer<vtkPolyhedronTopology>::New();
+      this->PolyhedronTopology->DeepCopy(grid->PolyhedronTopology);
+    }
+    else
+    {
+      this->PolyhedronTopology = nullptr;
+    }
     if (grid->Links)
     {
       this->Links = vtkSmartPointer<vtkAbstractCellLinks>::Take(grid->Links->NewInstance());
@@ -1668,6 +1720,7 @@ bool vtkUnstructuredGrid::AllocateExact(vtkIdType numCells, vtkIdType connectivi
   this->DistinctCellTypes = vtkSmartPointer<vtkCellTypes>::New();
   this->Types = vtkSmartPointer<vtkUnsignedCharArray>::New();
   this->Connectivity = vtkSmartPointer<vtkCellArray>::New();
+  this->PolyhedronTopology = nullptr;
 
   bool result = this->Connectivity->AllocateExact(numCells, connectivitySize);
   if (result)
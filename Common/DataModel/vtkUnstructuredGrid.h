@@ -29,6 +29,7 @@ VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
 class vtkIdList;
 class vtkIdTypeArray;
+class vtkPolyhedronTopology;
 class vtkUnsignedCharArray;
 class vtkIdTypeArray;
 
@@ -442,6 +443,22 @@ public:
    */
   int InitializeFacesRepresentation(vtkIdType numPrevCells);
 
+  /**
+   * Build the local topology of the polyhedral cells (canonical faces, edges
+   * and faces using each edge) once for all of them, in parallel. GetCell()
+   * then passes it to the vtkPolyhedron it fills instead of having it
+   * recompute the topology each time. This pays off when the polyhedral cells
+   * are loaded several times, e.g. by a filter visiting each cell more than
+   * once or by several filters. The topology is released when the cells of
+   * the grid are replaced. This does nothing if the grid has no faces.
+   */
+  void BuildPolyhedronTopology();
+
+  /**
+   * Get the topology built by BuildPolyhedronTopology(), nullptr if there is none.
+   */
+  vtkPolyhedronTopology* GetPolyhedronTopology();
+
   /**
    * Return the mesh (geometry/topology) modification time.
    * This time is different from the usual MTime which also takes into
@@ -578,6 +595,9 @@ protected:
   vtkSmartPointer<vtkCellArray> Faces;
   vtkSmartPointer<vtkCellArray> FaceLocations;
 
+  // Local topology of the polyhedral cells, see BuildPolyhedronTopology()
+  vtkSmartPointer<vtkPolyhedronTopology> PolyhedronTopology;
+
   // Legacy support -- stores the old-style cell array locations.
   vtkSmartPointer<vtkIdTypeArray> CellLocations;
 
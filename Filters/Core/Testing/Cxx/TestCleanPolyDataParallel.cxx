@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded path of vtkCleanPolyData produces the same output
+// as the serial path, with and without merging, tolerance or global ids.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCleanPolyData.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Points on a 10x10x9 lattice of sites. Each site has exact duplicates and
+// slightly moved copies, so that cells built on neighboring sites are often
+// degenerate once points are merged.
+vtkSmartPointer<vtkPolyData> MakeInput()
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  auto next = [&random](int n) -> int {
+    random->Next();
+    return static_cast<int>(random->GetRangeValue(0, n - 0.001));
+  };
+
+  const int numSites = 900;
+  const int copies = 4;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> globalIds;
+  globalIds->SetName("GlobalIds");
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int copy = 0; copy < copies; ++copy)
+  {
+    for (int site = 0; site < numSites; ++site)
+    {
+      const double shift = copy < 2 ? 0.0 : 1e-4 * copy;
+      points->InsertNextPoint(site % 10 + shift, site / 10 % 10, site / 100 + shift);
+      globalIds->InsertNextValue(site);
+      scalars->InsertNextValue(copy + 10 * site);
+    }
+  }
+
+  auto randomPoint = [&](int site) -> vtkIdType {
+    return next(copies) * numSites + (site + next(3) + 10 * next(2)) % numSites;
+  };
+  vtkNew<vtkCellArray> cells[4];
+  std::vector<vtkIdType> pts;
+  for (int i = 0; i < 4000; ++i)
+  {
+    const int kind = next(4);
+    const int site = next(numSites);
+    const int npts = kind == 0 ? 1 + next(3) : kind == 1 ? 2 + next(3) : 3 + next(3);
+    pts.clear();
+    for (int j = 0; j < npts; ++j)
+    {
+      pts.push_back(randomPoint(site));
+    }
+    if (kind == 2 && next(4) == 0)
+    {
+      pts.push_back(pts[0]);
+    }
+    cells[kind]->InsertNextCell(static_cast<vtkIdType>(pts.size()), pts.data());
+  }
+
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->SetVerts(cells[0]);
+  input->SetLines(cells[1]);
+  input->SetPolys(cells[2]);
+  input->SetStrips(cells[3]);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetGlobalIds(globalIds);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(input->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, cellId);
+  }
+  input->GetCellData()->AddArray(cellIds);
+  return input;
+}
+
+//------------------------------------------------------------------------------
+bool SameCells(vtkCellArray* cells, vtkCellArray* expected)
+{
+  if (cells->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << cells->GetNumberOfCells() << " cells instead of " << expected->GetNumberOfCells()
+              << "\n";
+    return false;
+  }
+  vtkIdType npts, expectedNpts;
+  const vtkIdType *pts, *expectedPts;
+  for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+  {
+    cells->GetCellAtId(cellId, npts, pts);
+    expected->GetCellAtId(cellId, expectedNpts, expectedPts);
+    bool same = npts == expectedNpts;
+    for (vtkIdType i = 0; same && i < npts; ++i)
+    {
+      same = pts[i] == expectedPts[i];
+    }
+    if (!same)
+    {
+      std::cerr << "Cell " << cellId << " differs\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SameArrays(vtkFieldData* data, vtkFieldData* expected)
+{
+  if (data->GetNumberOfArrays() != expected->GetNumberOfArrays())
+  {
+    std::cerr << data->GetNumberOfArrays() << " arrays instead of "
+              << expected->GetNumberOfArrays() << "\n";
+    return false;
+  }
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkAbstractArray* expectedArray = expected->GetAbstractArray(a);
+    vtkDataArray* array = data->GetArray(expectedArray->GetName());
+    if (!array || array->GetNumberOfValues() != expectedArray->GetNumberOfValues())
+    {
+      std::cerr << "Array " << expectedArray->GetName() << " differs\n";
+      return false;
+    }
+    for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+    {
+      if (array->GetVariantValue(i) != expectedArray->GetVariantValue(i))
+      {
+        std::cerr << "Value " << i << " of " << expectedArray->GetName() << " differs\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    std::cerr << output->GetNumberOfPoints() << " points instead of "
+              << expected->GetNumberOfPoints() << "\n";
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    expected->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << ptId << " differs\n";
+      return false;
+    }
+  }
+  return SameCells(output->GetVerts(), expected->GetVerts()) &&
+    SameCells(output->GetLines(), expected->GetLines()) &&
+    SameCells(output->GetPolys(), expected->GetPolys()) &&
+    SameCells(output->GetStrips(), expected->GetStrips()) &&
+    SameArrays(output->GetPointData(), expected->GetPointData()) &&
+    SameArrays(output->GetCellData(), expected->GetCellData());
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCleanPolyDataParallel(int, char*[])
+{
+  auto input = MakeInput();
+  vtkNew<vtkPolyData> noGlobalIds;
+  noGlobalIds->ShallowCopy(input);
+  noGlobalIds->GetPointData()->SetGlobalIds(nullptr);
+
+  struct Configuration
+  {
+    const char* Name;
+    vtkPolyData* Input;
+    bool PointMerging;
+    double Tolerance;
+    bool Convert;
+  };
+  const Configuration configurations[] = { { "exact merging", noGlobalIds, true, 0.0, true },
+    { "merging within tolerance", noGlobalIds, true, 1e-3, true },
+    { "no conversion", noGlobalIds, true, 1e-3, false },
+    { "no merging", noGlobalIds, false, 0.0, true },
+    { "global ids", input, true, 0.0, true } };
+
+  for (const auto& configuration : configurations)
+  {
+    vtkSmartPointer<vtkPolyData> outputs[3];
+    for (int run = 0; run < 3; ++run)
+    {
+      vtkSMPTools::LocalScope(vtkSMPTools::Config{ run == 2 ? 4 : 1 }, [&]() {
+        vtkNew<vtkCleanPolyData> clean;
+        clean->SetInputData(configuration.Input);
+        clean->SetPointMerging(configuration.PointMerging);
+        clean->ToleranceIsAbsoluteOn();
+        clean->SetAbsoluteTolerance(configuration.Tolerance);
+        clean->SetConvertLinesToPoints(configuration.Convert);
+        clean->SetConvertPolysToLines(configuration.Convert);
+        clean->SetConvertStripsToPolys(configuration.Convert);
+        clean->SetParallelMerging(run > 0);
+        clean->Update();
+        outputs[run] = clean->GetOutput();
+      });
+    }
+    std::cout << configuration.Name << ": " << outputs[0]->GetNumberOfPoints() << " points, "
+              << outputs[0]->GetNumberOfCells() << " cells\n";
+    if (!SameOutput(outputs[1], outputs[0]) || !SameOutput(outputs[2], outputs[0]))
+    {
+      std::cerr << "Parallel cleaning differs from serial cleaning with " << configuration.Name
+                << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
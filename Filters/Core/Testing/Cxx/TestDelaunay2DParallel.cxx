@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel triangulation of vtkDelaunay2D produces a valid
+// Delaunay triangulation, matching the serial one on points in general
+// position and covering a regular lattice.
+
+#include <vtkCellArray.h>
+#include <vtkDelaunay2D.h>
+#include <vtkIdList.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkTriangle.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> Triangulate(vtkPolyData* input, bool parallel)
+{
+  vtkNew<vtkDelaunay2D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->SetParallelTriangulation(parallel);
+  // Use several partitions even if the machine has a single core
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 }, [&]() { delaunay->Update(); });
+  return delaunay->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+// Sorted triangles, each with sorted point ids
+std::vector<std::array<vtkIdType, 3>> GetTriangles(vtkPolyData* output)
+{
+  std::vector<std::array<vtkIdType, 3>> triangles;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto polys = output->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    std::array<vtkIdType, 3> triangle = { { pts[0], pts[1], pts[2] } };
+    std::sort(triangle.begin(), triangle.end());
+    triangles.push_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+//------------------------------------------------------------------------------
+// Check that the triangles are not degenerate, that no edge is shared by more
+// than two triangles, and that no point lies inside a circumcircle. Return the
+// total area, or -1 if the triangulation is invalid.
+double CheckTriangulation(vtkPolyData* output)
+{
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(output);
+  locator->BuildLocator();
+  vtkNew<vtkIdList> ids;
+  std::map<std::pair<vtkIdType, vtkIdType>, int> edges;
+  double area = 0;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto polys = output->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    double x[3][3], center[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      output->GetPoint(pts[i], x[i]);
+      const vtkIdType next = pts[(i + 1) % 3];
+      edges[std::make_pair(std::min(pts[i], next), std::max(pts[i], next))]++;
+    }
+    // Points inserted on an edge may produce triangles of either orientation
+    const double triangleArea = 0.5 *
+      std::abs(
+        (x[1][0] - x[0][0]) * (x[2][1] - x[0][1]) - (x[1][1] - x[0][1]) * (x[2][0] - x[0][0]));
+    if (triangleArea == 0)
+    {
+      std::cerr << "Degenerate triangle\n";
+      return -1;
+    }
+    area += triangleArea;
+
+    const double radius2 = vtkTriangle::Circumcircle(x[0], x[1], x[2], center);
+    center[2] = 0;
+    locator->FindPointsWithinRadius(std::sqrt(radius2) * (1 - 1e-6), center, ids);
+    if (ids->GetNumberOfIds() > 0)
+    {
+      std::cerr << "Point " << ids->GetId(0) << " in the circumcircle of a triangle\n";
+      return -1;
+    }
+  }
+  for (const auto& edge : edges)
+  {
+    if (edge.second > 2)
+    {
+      std::cerr << "Non-manifold edge\n";
+      return -1;
+    }
+  }
+  return area;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDelaunay2DParallel(int, char*[])
+{
+  // Random points in a disk, in general position
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  vtkNew<vtkPoints> randomPoints;
+  while (randomPoints->GetNumberOfPoints() < 20000)
+  {
+    random->Next();
+    const double x = random->GetRangeValue(-1, 1);
+    random->Next();
+    const double y = random->GetRangeValue(-1, 1);
+    if (x * x + y * y < 1)
+    {
+      randomPoints->InsertNextPoint(x, y, x * y);
+    }
+  }
+  vtkNew<vtkPolyData> disk;
+  disk->SetPoints(randomPoints);
+
+  auto serial = Triangulate(disk, false);
+  auto parallel = Triangulate(disk, true);
+  const double serialArea = CheckTriangulation(serial);
+  const double parallelArea = CheckTriangulation(parallel);
+  std::cout << "Disk: " << serial->GetNumberOfPolys() << " serial triangles, "
+            << parallel->GetNumberOfPolys() << " parallel triangles\n";
+  if (parallelArea < 0 || std::abs(parallelArea - serialArea) > 1e-9 * serialArea)
+  {
+    std::cerr << "Area of " << parallelArea << " instead of " << serialArea << "\n";
+    return EXIT_FAILURE;
+  }
+  if (GetTriangles(parallel) != GetTriangles(serial))
+  {
+    std::cerr << "Parallel triangles differ from serial triangles\n";
+    return EXIT_FAILURE;
+  }
+
+  // A lattice, where the Delaunay triangulation is not unique
+  vtkNew<vtkPoints> latticePoints;
+  for (int j = 0; j < 60; ++j)
+  {
+    for (int i = 0; i < 80; ++i)
+    {
+      latticePoints->InsertNextPoint(i, j, 0);
+    }
+  }
+  vtkNew<vtkPolyData> lattice;
+  lattice->SetPoints(latticePoints);
+  parallel = Triangulate(lattice, true);
+  const double latticeArea = CheckTriangulation(parallel);
+  std::cout << "Lattice: " << parallel->GetNumberOfPolys() << " triangles\n";
+  if (parallel->GetNumberOfPolys() != 2 * 79 * 59 || std::abs(latticeArea - 79 * 59) > 1e-6)
+  {
+    std::cerr << "The lattice is not covered\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
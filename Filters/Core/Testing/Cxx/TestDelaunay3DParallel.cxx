@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel triangulation of vtkDelaunay3D produces a valid
+// Delaunay tetrahedralization, matching the serial one on points in general
+// position whatever the number of threads, and filling a regular lattice.
+
+#include <vtkCellArray.h>
+#include <vtkDelaunay3D.h>
+#include <vtkIdList.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkTetra.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkUnstructuredGrid> Triangulate(
+  vtkPolyData* input, bool parallel, int numberOfThreads = 4)
+{
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->SetParallelTriangulation(parallel);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads }, [&]() { delaunay->Update(); });
+  return delaunay->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+// Number of points of the ball before adding duplicates of every 37th one
+const vtkIdType NumberOfUniquePoints = 8000;
+
+//------------------------------------------------------------------------------
+// Sorted tetrahedra, each with sorted point ids. Either copy of a duplicated
+// point may be kept, so duplicates are replaced by the original point.
+std::vector<std::array<vtkIdType, 4>> GetTetras(vtkUnstructuredGrid* output)
+{
+  auto original = [](vtkIdType ptId) -> vtkIdType {
+    return ptId < NumberOfUniquePoints ? ptId : 37 * (ptId - NumberOfUniquePoints);
+  };
+  std::vector<std::array<vtkIdType, 4>> tetras;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto cells = output->GetCells();
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+  {
+    std::array<vtkIdType, 4> tetra = { { original(pts[0]), original(pts[1]), original(pts[2]),
+      original(pts[3]) } };
+    std::sort(tetra.begin(), tetra.end());
+    tetras.push_back(tetra);
+  }
+  std::sort(tetras.begin(), tetras.end());
+  return tetras;
+}
+
+//------------------------------------------------------------------------------
+// Check that the tetrahedra are positively oriented, that no face is shared by
+// more than two tetrahedra, and that no point lies inside a circumsphere.
+// Return the total volume, or -1 if the tetrahedralization is invalid.
+double CheckTetrahedralization(vtkUnstructuredGrid* output)
+{
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(output);
+  locator->BuildLocator();
+  vtkNew<vtkIdList> ids;
+  std::map<std::array<vtkIdType, 3>, int> faces;
+  double volume = 0;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto cells = output->GetCells();
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+  {
+    double x[4][3], center[3];
+    for (int i = 0; i < 4; ++i)
+    {
+      output->GetPoint(pts[i], x[i]);
+      std::array<vtkIdType, 3> face = { { pts[i], pts[(i + 1) % 4], pts[(i + 2) % 4] } };
+      std::sort(face.begin(), face.end());
+      faces[face]++;
+    }
+    const double tetraVolume = vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]);
+    if (tetraVolume <= 0)
+    {
+      std::cerr << "Inverted or flat tetrahedron\n";
+      return -1;
+    }
+    volume += tetraVolume;
+
+    const double radius2 = vtkTetra::Circumsphere(x[0], x[1], x[2], x[3], center);
+    locator->FindPointsWithinRadius(std::sqrt(radius2) * (1 - 1e-6), center, ids);
+    if (ids->GetNumberOfIds() > 0)
+    {
+      std::cerr << "Point " << ids->GetId(0) << " in the circumsphere of a tetrahedron\n";
+      return -1;
+    }
+  }
+  for (const auto& face : faces)
+  {
+    if (face.second > 2)
+    {
+      std::cerr << "Non-manifold face\n";
+      return -1;
+    }
+  }
+  return volume;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDelaunay3DParallel(int, char*[])
+{
+  // Random points in a ball, in general position, and a few duplicates
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(5);
+  vtkNew<vtkPoints> randomPoints;
+  while (randomPoints->GetNumberOfPoints() < NumberOfUniquePoints)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      random->Next();
+      x[i] = random->GetRangeValue(-1, 1);
+    }
+    if (x[0] * x[0] + x[1] * x[1] + x[2] * x[2] < 1)
+    {
+      randomPoints->InsertNextPoint(x);
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < 100; ++ptId)
+  {
+    randomPoints->InsertNextPoint(randomPoints->GetPoint(37 * ptId));
+  }
+  vtkNew<vtkPolyData> ball;
+  ball->SetPoints(randomPoints);
+
+  auto serial = Triangulate(ball, false, 1);
+  auto parallel = Triangulate(ball, true, 1);
+  auto threaded = Triangulate(ball, true);
+  const double serialVolume = CheckTetrahedralization(serial);
+  const double threadedVolume = CheckTetrahedralization(threaded);
+  std::cout << "Ball: " << serial->GetNumberOfCells() << " serial tetrahedra, "
+            << threaded->GetNumberOfCells() << " parallel tetrahedra\n";
+  if (threadedVolume < 0 || std::abs(threadedVolume - serialVolume) > 1e-9 * serialVolume)
+  {
+    std::cerr << "Volume of " << threadedVolume << " instead of " << serialVolume << "\n";
+    return EXIT_FAILURE;
+  }
+  if (GetTetras(threaded) != GetTetras(serial))
+  {
+    std::cerr << "Parallel tetrahedra differ from serial tetrahedra\n";
+    return EXIT_FAILURE;
+  }
+  if (parallel->GetNumberOfCells() != threaded->GetNumberOfCells())
+  {
+    std::cerr << "The parallel triangulation depends on the number of threads\n";
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType cellId = 0; cellId < threaded->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts, expectedNpts;
+    const vtkIdType *pts, *expectedPts;
+    threaded->GetCells()->GetCellAtId(cellId, npts, pts);
+    parallel->GetCells()->GetCellAtId(cellId, expectedNpts, expectedPts);
+    if (!std::equal(pts, pts + 4, expectedPts))
+    {
+      std::cerr << "The parallel triangulation depends on the number of threads\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A lattice, where the Delaunay tetrahedralization is not unique
+  vtkNew<vtkPoints> latticePoints;
+  for (int k = 0; k < 12; ++k)
+  {
+    for (int j = 0; j < 12; ++j)
+    {
+      for (int i = 0; i < 12; ++i)
+      {
+        latticePoints->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  vtkNew<vtkPolyData> lattice;
+  lattice->SetPoints(latticePoints);
+  threaded = Triangulate(lattice, true);
+  const double latticeVolume = CheckTetrahedralization(threaded);
+  std::cout << "Lattice: " << threaded->GetNumberOfCells() << " tetrahedra\n";
+  if (std::abs(latticeVolume - 11 * 11 * 11) > 1e-6)
+  {
+    std::cerr << "The lattice is not filled: volume of " << latticeVolume << "\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
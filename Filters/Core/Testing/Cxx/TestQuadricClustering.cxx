@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded accumulation of vtkQuadricClustering does not depend
+// on the number of threads, and that very fine divisions only use memory for
+// the visited bins.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkIdTypeArray.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkQuadricClustering.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> Cluster(vtkPolyData* input, int divisions, bool useInputPoints)
+{
+  vtkNew<vtkQuadricClustering> cluster;
+  cluster->SetInputData(input);
+  cluster->SetNumberOfDivisions(divisions, divisions, divisions);
+  cluster->AutoAdjustNumberOfDivisionsOff();
+  cluster->SetUseInputPoints(useInputPoints);
+  cluster->CopyCellDataOn();
+  cluster->Update();
+  return cluster->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPolys() != expected->GetNumberOfPolys() ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    std::cerr << output->GetNumberOfPolys() << " triangles and " << output->GetNumberOfPoints()
+              << " points instead of " << expected->GetNumberOfPolys() << " and "
+              << expected->GetNumberOfPoints() << "\n";
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ptId++)
+  {
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    expected->GetPoint(ptId, y);
+    if (std::abs(x[0] - y[0]) + std::abs(x[1] - y[1]) + std::abs(x[2] - y[2]) > 1e-6)
+    {
+      std::cerr << "Point " << ptId << " differs\n";
+      return false;
+    }
+  }
+  vtkIdType npts, expectedNpts;
+  const vtkIdType *pts, *expectedPts;
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  vtkDataArray* expectedCellIds = expected->GetCellData()->GetArray("CellIds");
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfPolys(); cellId++)
+  {
+    output->GetPolys()->GetCellAtId(cellId, npts, pts);
+    expected->GetPolys()->GetCellAtId(cellId, expectedNpts, expectedPts);
+    if (npts != 3 || expectedNpts != 3 || pts[0] != expectedPts[0] || pts[1] != expectedPts[1] ||
+      pts[2] != expectedPts[2] || cellIds->GetTuple1(cellId) != expectedCellIds->GetTuple1(cellId))
+    {
+      std::cerr << "Triangle " << cellId << " differs\n";
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestQuadricClustering(int, char*[])
+{
+  vtkSMPTools::SetBackend("STDThread");
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(1.0);
+  sphere->SetThetaResolution(120);
+  sphere->SetPhiResolution(120);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
+  {
+    cellIds->SetValue(cellId, cellId);
+  }
+  input->GetCellData()->AddArray(cellIds);
+
+  for (bool useInputPoints : { false, true })
+  {
+    vtkSMPTools::Initialize(1);
+    auto serial = Cluster(input, 20, useInputPoints);
+    vtkSMPTools::Initialize(4);
+    auto threaded = Cluster(input, 20, useInputPoints);
+    if (serial->GetNumberOfPolys() == 0 || !SameOutput(threaded, serial))
+    {
+      std::cerr << "Threaded clustering differs from serial clustering\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A dense grid of 4000^3 bins would not fit in memory. The bins are much
+  // smaller than the triangles, so that no triangle is removed.
+  auto fine = Cluster(input, 4000, false);
+  if (fine->GetNumberOfPolys() != input->GetNumberOfPolys() ||
+    fine->GetNumberOfPoints() != input->GetNumberOfPoints())
+  {
+    std::cerr << "Fine divisions produced " << fine->GetNumberOfPolys() << " triangles instead of "
+              << input->GetNumberOfPolys() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
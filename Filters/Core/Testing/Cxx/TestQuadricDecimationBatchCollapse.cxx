@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that collapsing edges in parallel batches reaches the requested
+// reduction with an error comparable to the serial decimation, and that the
+// result does not depend on the number of threads.
+
+#include <vtkCellArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkQuadricDecimation.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> Decimate(vtkPolyData* input, bool batch, bool attributes)
+{
+  vtkNew<vtkQuadricDecimation> decimator;
+  decimator->SetInputData(input);
+  decimator->SetTargetReduction(0.9);
+  decimator->SetVolumePreservation(attributes);
+  decimator->SetAttributeErrorMetric(attributes);
+  decimator->SetBatchCollapse(batch);
+  decimator->Update();
+  if (decimator->GetActualReduction() < 0.9)
+  {
+    std::cerr << "Reduction of " << decimator->GetActualReduction() << " instead of 0.9\n";
+    return nullptr;
+  }
+  return decimator->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+// Return the maximum distance of the points of the triangles to the unit
+// sphere, or -1 if a triangle is degenerate.
+double SphereError(vtkPolyData* output)
+{
+  double error = 0;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto polys = output->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    if (npts != 3 || pts[0] == pts[1] || pts[1] == pts[2] || pts[2] == pts[0])
+    {
+      return -1;
+    }
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      double x[3];
+      output->GetPoint(pts[i], x);
+      error = std::max(error, std::abs(std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]) - 1));
+    }
+  }
+  return error;
+}
+
+//------------------------------------------------------------------------------
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPolys() != expected->GetNumberOfPolys() ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ptId++)
+  {
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    expected->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestQuadricDecimationBatchCollapse(int, char*[])
+{
+  vtkSMPTools::SetBackend("STDThread");
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(1.0);
+  sphere->SetThetaResolution(80);
+  sphere->SetPhiResolution(80);
+  sphere->Update();
+  vtkPolyData* closed = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetNumberOfTuples(closed->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < closed->GetNumberOfPoints(); ptId++)
+  {
+    double x[3];
+    closed->GetPoint(ptId, x);
+    scalars->SetValue(ptId, std::sin(3.0 * (x[0] + x[1] + x[2])));
+  }
+  closed->GetPointData()->SetScalars(scalars);
+
+  // A sphere with a slice cut out, to have boundary edges
+  vtkNew<vtkSphereSource> openSphere;
+  openSphere->SetRadius(1.0);
+  openSphere->SetThetaResolution(80);
+  openSphere->SetPhiResolution(80);
+  openSphere->SetEndTheta(300);
+  openSphere->Update();
+
+  for (vtkPolyData* input : { closed, openSphere->GetOutput() })
+  {
+    for (bool attributes : { false, true })
+    {
+      vtkSMPTools::Initialize(1);
+      auto serial = Decimate(input, false, attributes);
+      auto batch = Decimate(input, true, attributes);
+      vtkSMPTools::Initialize(4);
+      auto threaded = Decimate(input, true, attributes);
+      if (!serial || !batch || !threaded)
+      {
+        return EXIT_FAILURE;
+      }
+
+      const double serialError = SphereError(serial);
+      const double batchError = SphereError(batch);
+      std::cout << "Serial: " << serial->GetNumberOfPolys() << " triangles, error "
+                << serialError << "; batches: " << batch->GetNumberOfPolys()
+                << " triangles, error " << batchError << "\n";
+      if (batchError < 0 || batchError > 2 * serialError + 1e-3)
+      {
+        std::cerr << "Decimation by batches is too coarse\n";
+        return EXIT_FAILURE;
+      }
+      if (!SameOutput(threaded, batch))
+      {
+        std::cerr << "Decimation by batches depends on the number of threads\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -2,20 +2,37 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkCleanPolyData.h"
 
+#include "vtkArrayListTemplate.h"
+#include "vtkBatch.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <numeric>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCleanPolyData);
@@ -36,6 +53,204 @@ bool InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
   ptId = it->second;
   return false;
 }
+
+//------------------------------------------------------------------------------
+// The threaded path traverses the cells of the input with a single id, in the
+// order of the cell data: verts, lines, polys then strips.
+enum CellKind
+{
+  VERTS = 0,
+  LINES = 1,
+  POLYS = 2,
+  STRIPS = 3
+};
+
+struct CellTraversal
+{
+  vtkCellArray* Arrays[4];
+  vtkIdType Begin[5];
+  vtkSMPThreadLocal<std::array<vtkSmartPointer<vtkCellArrayIterator>, 4>> Iterators;
+
+  CellTraversal(vtkPolyData* input)
+  {
+    this->Arrays[VERTS] = input->GetVerts();
+    this->Arrays[LINES] = input->GetLines();
+    this->Arrays[POLYS] = input->GetPolys();
+    this->Arrays[STRIPS] = input->GetStrips();
+    this->Begin[0] = 0;
+    for (int kind = 0; kind < 4; ++kind)
+    {
+      this->Begin[kind + 1] = this->Begin[kind] + this->Arrays[kind]->GetNumberOfCells();
+    }
+  }
+
+  vtkIdType GetNumberOfCells() const { return this->Begin[4]; }
+
+  // Return the kind of the cell along with its points.
+  int GetCell(std::array<vtkSmartPointer<vtkCellArrayIterator>, 4>& iters, vtkIdType cellId,
+    vtkIdType& npts, const vtkIdType*& pts)
+  {
+    int kind = VERTS;
+    while (cellId >= this->Begin[kind + 1])
+    {
+      ++kind;
+    }
+    if (!iters[kind])
+    {
+      iters[kind].TakeReference(this->Arrays[kind]->NewIterator());
+    }
+    iters[kind]->GetCellAtId(cellId - this->Begin[kind], npts, pts);
+    return kind;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Map the points of a cell to output points, dropping consecutive duplicates
+// (except for vertices), and return the kind of output cell it becomes, or -1
+// if it is removed. These are the rules of the serial path.
+struct CellReducer
+{
+  const vtkIdType* PointMap;
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+
+  int Reduce(int kind, vtkIdType npts, const vtkIdType* pts, vtkIdType* newPts,
+    vtkIdType& numNewPts) const
+  {
+    numNewPts = 0;
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType ptId = this->PointMap[pts[i]];
+      if (kind == VERTS || numNewPts == 0 || ptId != newPts[numNewPts - 1])
+      {
+        newPts[numNewPts++] = ptId;
+      }
+    }
+    if (kind == VERTS)
+    {
+      return numNewPts > 0 ? VERTS : -1;
+    }
+
+    // Closed polygons and strips lose their repeated last point
+    if (((kind == POLYS && numNewPts > 2) || (kind == STRIPS && numNewPts > 1)) &&
+      newPts[0] == newPts[numNewPts - 1])
+    {
+      numNewPts--;
+    }
+    if (numNewPts > 2 && kind != LINES)
+    {
+      if (kind == POLYS || numNewPts > 3)
+      {
+        return kind;
+      }
+      return (npts == 3 || this->ConvertStripsToPolys) ? POLYS : -1;
+    }
+    if (numNewPts > 1)
+    {
+      if (kind == LINES)
+      {
+        return LINES;
+      }
+      return (npts == 2 || this->ConvertPolysToLines) ? LINES : -1;
+    }
+    if (numNewPts == 1 && (npts == 1 || this->ConvertLinesToPoints))
+    {
+      return VERTS;
+    }
+    return -1;
+  }
+};
+
+//------------------------------------------------------------------------------
+struct CountBatchData
+{
+  vtkIdType Count;
+
+  CountBatchData()
+    : Count(0)
+  {
+  }
+  CountBatchData& operator+=(const CountBatchData& other)
+  {
+    this->Count += other.Count;
+    return *this;
+  }
+  CountBatchData operator+(const CountBatchData& other) const
+  {
+    CountBatchData result = *this;
+    result += other;
+    return result;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Number of output cells and connectivity size of each kind
+struct CellsBatchData
+{
+  vtkIdType Cells[4];
+  vtkIdType Connectivity[4];
+
+  CellsBatchData()
+  {
+    std::fill_n(this->Cells, 4, 0);
+    std::fill_n(this->Connectivity, 4, 0);
+  }
+  CellsBatchData& operator+=(const CellsBatchData& other)
+  {
+    for (int kind = 0; kind < 4; ++kind)
+    {
+      this->Cells[kind] += other.Cells[kind];
+      this->Connectivity[kind] += other.Connectivity[kind];
+    }
+    return *this;
+  }
+  CellsBatchData operator+(const CellsBatchData& other) const
+  {
+    CellsBatchData result = *this;
+    result += other;
+    return result;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Return, in increasing order, the ids in [0, n) satisfying the predicate.
+template <typename TPredicate>
+std::vector<vtkIdType> SelectIds(vtkIdType n, const TPredicate& predicate)
+{
+  if (n == 0)
+  {
+    return std::vector<vtkIdType>();
+  }
+  vtkBatches<CountBatchData> batches;
+  batches.Initialize(n);
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      auto& batch = batches[batchId];
+      for (vtkIdType id = batch.BeginId; id < batch.EndId; ++id)
+      {
+        batch.Data.Count += predicate(id) ? 1 : 0;
+      }
+    }
+  });
+  std::vector<vtkIdType> ids(batches.BuildOffsetsAndGetGlobalSum().Count);
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      auto& batch = batches[batchId];
+      vtkIdType offset = batch.Data.Count;
+      for (vtkIdType id = batch.BeginId; id < batch.EndId; ++id)
+      {
+        if (predicate(id))
+        {
+          ids[offset++] = id;
+        }
+      }
+    }
+  });
+  return ids;
+}
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -48,6 +263,7 @@ vtkCxxSetObjectMacro(vtkCleanPolyData, Locator, vtkIncrementalPointLocator);
 vtkCleanPolyData::vtkCleanPolyData()
 {
   this->PointMerging = 1;
+  this->ParallelMerging = 0;
   this->ToleranceIsAbsolute = 0;
   this->Tolerance = 0.0;
   this->AbsoluteTolerance = 1.0;
@@ -140,6 +356,10 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+  if (this->ParallelMerging)
+  {
+    return this->ParallelClean(input, output);
+  }
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -666,6 +886,328 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkCleanPolyData::ParallelClean(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  CellTraversal cells(input);
+  const vtkIdType numCells = cells.GetNumberOfCells();
+  const vtkIdType maxCellSize = std::max<vtkIdType>(input->GetMaxCellSize(), 1);
+
+  // The serial path numbers the points in order of first use. Find the first
+  // use of each point, as the position of the point in the traversal of cells.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUse(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstUse[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    auto& iters = cells.Iterators.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cells.GetCell(iters, cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        // memory_order_relaxed is safe here, since only the final minimum is
+        // used, after the threads are joined.
+        const vtkIdType use = cellId * maxCellSize + i;
+        vtkIdType current = firstUse[pts[i]].load(std::memory_order_relaxed);
+        while (use < current &&
+          !firstUse[pts[i]].compare_exchange_weak(current, use, std::memory_order_relaxed))
+        {
+        }
+      }
+    }
+  });
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Rank the used points by first use, and apply OperateOnPoint to them
+  auto getFirstUse = [&firstUse](vtkIdType ptId) -> vtkIdType {
+    return firstUse[ptId].load(std::memory_order_relaxed);
+  };
+  std::vector<vtkIdType> order =
+    SelectIds(numPts, [&](vtkIdType ptId) { return getFirstUse(ptId) != VTK_ID_MAX; });
+  vtkSMPTools::Sort(order.begin(), order.end(),
+    [&](vtkIdType a, vtkIdType b) { return getFirstUse(a) < getFirstUse(b); });
+  firstUse.reset();
+  const vtkIdType numUsedPts = static_cast<vtkIdType>(order.size());
+  vtkNew<vtkPoints> rankedPts;
+  rankedPts->SetDataTypeToDouble();
+  rankedPts->SetNumberOfPoints(numUsedPts);
+  vtkSMPTools::For(0, numUsedPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3], newx[3];
+    for (vtkIdType rank = begin; rank < end; ++rank)
+    {
+      inPts->GetPoint(order[rank], x);
+      this->OperateOnPoint(x, newx);
+      rankedPts->SetPoint(rank, newx);
+    }
+  });
+  this->UpdateProgress(0.25);
+
+  // Map each ranked point to the ranked point it is merged with, which is
+  // itself for the points that are kept.
+  std::vector<vtkIdType> mergeMap(numUsedPts);
+  std::iota(mergeMap.begin(), mergeMap.end(), 0);
+  vtkIdTypeArray* globalIdsArray = vtkIdTypeArray::SafeDownCast(inputPD->GetGlobalIds());
+  if (this->PointMerging && globalIdsArray)
+  {
+    // Points sharing a global id are merged with the first one of them
+    std::vector<vtkIdType> sorted(mergeMap);
+    const vtkIdType* globalIds = globalIdsArray->GetPointer(0);
+    vtkSMPTools::Sort(sorted.begin(), sorted.end(), [&](vtkIdType a, vtkIdType b) {
+      const vtkIdType ga = globalIds[order[a]];
+      const vtkIdType gb = globalIds[order[b]];
+      return ga < gb || (ga == gb && a < b);
+    });
+    for (vtkIdType i = 1; i < numUsedPts; ++i)
+    {
+      if (globalIds[order[sorted[i]]] == globalIds[order[sorted[i - 1]]])
+      {
+        mergeMap[sorted[i]] = mergeMap[sorted[i - 1]];
+      }
+    }
+  }
+  else if (this->PointMerging && numUsedPts > 0)
+  {
+    const double tol =
+      this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength();
+    vtkNew<vtkPolyData> rankedData;
+    rankedData->SetPoints(rankedPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(rankedData);
+    locator->BuildLocator();
+    if (tol <= 0.0)
+    {
+      // Coincident points are merged with the one of lowest id, i.e. the first used
+      locator->MergePoints(0.0, mergeMap.data());
+    }
+    else
+    {
+      // Gather the earlier points within tolerance of each point, then merge
+      // each point with the first of them that is kept. This last step is
+      // inherently sequential but only walks through the candidates.
+      using Candidates = std::vector<std::pair<vtkIdType, vtkIdType>>;
+      vtkSMPThreadLocal<Candidates> localCandidates;
+      vtkSMPThreadLocalObject<vtkIdList> localIds;
+      vtkSMPTools::For(0, numUsedPts, [&](vtkIdType begin, vtkIdType end) {
+        Candidates& candidates = localCandidates.Local();
+        vtkIdList* ids = localIds.Local();
+        double x[3];
+        for (vtkIdType rank = begin; rank < end; ++rank)
+        {
+          rankedPts->GetPoint(rank, x);
+          locator->FindPointsWithinRadius(tol, x, ids);
+          for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+          {
+            if (ids->GetId(i) < rank)
+            {
+              candidates.emplace_back(rank, ids->GetId(i));
+            }
+          }
+        }
+      });
+      Candidates candidates;
+      for (auto& local : localCandidates)
+      {
+        candidates.insert(candidates.end(), local.begin(), local.end());
+      }
+      vtkSMPTools::Sort(candidates.begin(), candidates.end());
+      for (const auto& candidate : candidates)
+      {
+        if (mergeMap[candidate.first] == candidate.first &&
+          mergeMap[candidate.second] == candidate.second)
+        {
+          mergeMap[candidate.first] = candidate.second;
+        }
+      }
+    }
+  }
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+  this->UpdateProgress(0.5);
+
+  // Number the kept points in rank order, and build the map from input points
+  // to output points.
+  std::vector<vtkIdType> keptRanks =
+    SelectIds(numUsedPts, [&mergeMap](vtkIdType rank) { return mergeMap[rank] == rank; });
+  const vtkIdType numNewPts = static_cast<vtkIdType>(keptRanks.size());
+  std::vector<vtkIdType> newIds(numUsedPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newId = begin; newId < end; ++newId)
+    {
+      newIds[keptRanks[newId]] = newId;
+    }
+  });
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkSMPTools::For(0, numUsedPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType rank = begin; rank < end; ++rank)
+    {
+      pointMap[order[rank]] = newIds[mergeMap[rank]];
+    }
+  });
+
+  // Produce the output points and their data
+  vtkSmartPointer<vtkPoints> newPts = vtkSmartPointer<vtkPoints>::Take(inPts->NewInstance());
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  if (!this->PointMerging || globalIdsArray)
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, inputPD, outputPD);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType newId = begin; newId < end; ++newId)
+    {
+      const vtkIdType rank = keptRanks[newId];
+      rankedPts->GetPoint(rank, x);
+      newPts->SetPoint(newId, x);
+      pointArrays.Copy(order[rank], newId);
+    }
+  });
+  output->SetPoints(newPts);
+  this->UpdateProgress(0.75);
+
+  // Rewrite the cells in two passes: count the output cells of each kind in
+  // batches of input cells, then write them at the offsets of their batch.
+  CellReducer reducer;
+  reducer.PointMap = pointMap.data();
+  reducer.ConvertLinesToPoints = this->ConvertLinesToPoints != 0;
+  reducer.ConvertPolysToLines = this->ConvertPolysToLines != 0;
+  reducer.ConvertStripsToPolys = this->ConvertStripsToPolys != 0;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localUpdatedPts;
+  vtkBatches<CellsBatchData> batches;
+  batches.Initialize(numCells);
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    auto& iters = cells.Iterators.Local();
+    auto& updatedPts = localUpdatedPts.Local();
+    updatedPts.resize(maxCellSize);
+    vtkIdType npts, numNewCellPts;
+    const vtkIdType* pts;
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      auto& batch = batches[batchId];
+      for (vtkIdType cellId = batch.BeginId; cellId < batch.EndId; ++cellId)
+      {
+        const int kind = cells.GetCell(iters, cellId, npts, pts);
+        const int newKind = reducer.Reduce(kind, npts, pts, updatedPts.data(), numNewCellPts);
+        if (newKind >= 0)
+        {
+          batch.Data.Cells[newKind]++;
+          batch.Data.Connectivity[newKind] += numNewCellPts;
+        }
+      }
+    }
+  });
+  const CellsBatchData totals = batches.BuildOffsetsAndGetGlobalSum();
+
+  vtkSmartPointer<vtkIdTypeArray> offsets[4];
+  vtkSmartPointer<vtkIdTypeArray> connectivity[4];
+  vtkIdType firstCellId[4];
+  vtkIdType numNewCells = 0;
+  for (int kind = 0; kind < 4; ++kind)
+  {
+    firstCellId[kind] = numNewCells;
+    numNewCells += totals.Cells[kind];
+    offsets[kind] = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets[kind]->SetNumberOfValues(totals.Cells[kind] + 1);
+    offsets[kind]->SetValue(totals.Cells[kind], totals.Connectivity[kind]);
+    connectivity[kind] = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity[kind]->SetNumberOfValues(totals.Connectivity[kind]);
+  }
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD, numNewCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, inputCD, outputCD);
+
+  vtkSMPTools::For(0, batches.GetNumberOfBatches(), [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    auto& iters = cells.Iterators.Local();
+    auto& updatedPts = localUpdatedPts.Local();
+    updatedPts.resize(maxCellSize);
+    vtkIdType npts, numNewCellPts;
+    const vtkIdType* pts;
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      CellsBatchData next = batches[batchId].Data;
+      for (vtkIdType cellId = batches[batchId].BeginId; cellId < batches[batchId].EndId; ++cellId)
+      {
+        const int kind = cells.GetCell(iters, cellId, npts, pts);
+        const int newKind = reducer.Reduce(kind, npts, pts, updatedPts.data(), numNewCellPts);
+        if (newKind < 0)
+        {
+          continue;
+        }
+        const vtkIdType newCellId = next.Cells[newKind]++;
+        vtkIdType& offset = next.Connectivity[newKind];
+        offsets[newKind]->SetValue(newCellId, offset);
+        std::copy(updatedPts.data(), updatedPts.data() + numNewCellPts,
+          connectivity[newKind]->GetPointer(offset));
+        offset += numNewCellPts;
+        cellArrays.Copy(cellId, firstCellId[newKind] + newCellId);
+      }
+    }
+  });
+
+  // As in the serial path, a kind of cells is only output if the input or
+  // the conversions produced some.
+  for (int kind = 0; kind < 4; ++kind)
+  {
+    if (cells.Arrays[kind]->GetNumberOfCells() == 0 && totals.Cells[kind] == 0)
+    {
+      continue;
+    }
+    vtkNew<vtkCellArray> newCells;
+    newCells->SetData(offsets[kind], connectivity[kind]);
+    switch (kind)
+    {
+      case VERTS:
+        output->SetVerts(newCells);
+        break;
+      case LINES:
+        output->SetLines(newCells);
+        break;
+      case POLYS:
+        output->SetPolys(newCells);
+        break;
+      default:
+        output->SetStrips(newCells);
+    }
+  }
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points and "
+                << numCells - numNewCells << " cells");
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -722,6 +1264,7 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "Point Merging: " << (this->PointMerging ? "On\n" : "Off\n");
+  os << indent << "Parallel Merging: " << (this->ParallelMerging ? "On\n" : "Off\n");
   os << indent << "ToleranceIsAbsolute: " << (this->ToleranceIsAbsolute ? "On\n" : "Off\n");
   os << indent << "Tolerance: " << (this->Tolerance ? "On\n" : "Off\n");
   os << indent << "AbsoluteTolerance: " << (this->AbsoluteTolerance ? "On\n" : "Off\n");
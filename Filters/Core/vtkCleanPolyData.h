@@ -61,6 +61,13 @@
  * difference in the traversal order in the point merging process, the output
  * of the filters may be different.
  *
+ * @warning
+ * When ParallelMerging is enabled, vtkCleanPolyData itself runs threaded
+ * (with vtkSMPTools) and produces the same output as the serial filter: the
+ * points are numbered in order of first use and cells are converted with the
+ * same rules. The Locator is not used in that case, and OperateOnPoint must be
+ * thread-safe.
+ *
  * @sa
  * vtkQuantizePolyDataPoints vtkStaticCleanPolyData
  * vtkStaticCleanUnstructuredGrid
@@ -149,6 +156,20 @@ public:
   vtkBooleanMacro(PointMerging, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get a boolean value that controls whether points are merged and cells
+   * are rewritten in parallel. If on, the incremental Locator is replaced by a
+   * vtkStaticPointLocator and the output matches the serial output. The only
+   * exception is a point lying within a non-zero tolerance of several merged
+   * points: it is merged with the one used first, rather than with the first
+   * one found by the locator. By default this is off.
+   */
+  vtkSetMacro(ParallelMerging, vtkTypeBool);
+  vtkGetMacro(ParallelMerging, vtkTypeBool);
+  vtkBooleanMacro(ParallelMerging, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set/Get a spatial locator for speeding the search process. By
@@ -210,7 +231,13 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Threaded implementation of RequestData, used when ParallelMerging is on.
+   */
+  int ParallelClean(vtkPolyData* input, vtkPolyData* output);
+
   vtkTypeBool PointMerging;
+  vtkTypeBool ParallelMerging;
   double Tolerance;
   double AbsoluteTolerance;
   vtkTypeBool ConvertLinesToPoints;
@@ -5,6 +5,7 @@
 #include "vtkAbstractTransform.h"
 #include "vtkCellArray.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -13,10 +14,14 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <set>
 #include <vector>
 
@@ -33,6 +38,8 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->BoundingTriangulation = 0;
   this->Offset = 1.0;
   this->RandomPointInsertion = 0;
+  this->ParallelTriangulation = 0;
+  this->ThreadSafeWalk = false;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
 
@@ -132,8 +139,15 @@ vtkIdType vtkDelaunay2D::FindTriangle(double x[3], vtkIdType ptIds[3], vtkIdType
 
   // Randomization (of find edge neighbors) helps avoid walking in
   // circles in certain weird cases.
-  srand(tri);
-  ir = rand() % 3;
+  if (this->ThreadSafeWalk)
+  {
+    ir = static_cast<int>(((static_cast<vtkTypeUInt64>(tri) * 2654435761ULL) >> 16) % 3);
+  }
+  else
+  {
+    srand(tri);
+    ir = rand() % 3;
+  }
   // evaluate in/out of each edge
   for (inside = 1, minProj = VTK_DEL2D_TOLERANCE, ic = 0; ic < 3; ic++)
   {
@@ -296,6 +310,14 @@ bool vtkDelaunay2D::CheckEdge(vtkIdType ptId, double x[3], vtkIdType p1, vtkIdTy
 
 namespace // anonymous
 {
+// Why InsertPoints() did not insert a point
+enum DiscardReason : char
+{
+  NOT_DISCARDED = 0,
+  DUPLICATE_POINT = 1,
+  DEGENERACY = 2
+};
+
 // To provide a low-cost, simple, pseudo-random traversal of points, we use
 // a GCD (greatest common divisor) traversal with ptId = a*idx + b, where
 // idx is the index into the points list; a is a coprime factor of npts;
@@ -328,140 +350,35 @@ struct GCDTraversal
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
-// 2D Delaunay triangulation. Steps are as follows:
-//   1. For each point
-//   2. Find triangle point is in
-//   3. Create 3 triangles from each edge of triangle that point is in
-//   4. Recursively evaluate Delaunay criterion for each edge neighbor
-//   5. If criterion not satisfied; swap diagonal
-//
-int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+// Create the initial bounding triangulation, then insert the points one at a
+// time. The bounding points are added at the end of the points, and the
+// triangulation is left in this->Mesh.
+void vtkDelaunay2D::InsertPoints(vtkPoints* points, vtkIdType numPoints, double radius,
+  double tol, bool reportProgress, char* discarded)
 {
-  // get the info objects
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation* sourceInfo = inputVector[1]->GetInformationObject(0);
-  vtkInformation* outInfo = outputVector->GetInformationObject(0);
-
-  // get the input and output
-  vtkPointSet* input = vtkPointSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
-  vtkPolyData* source = nullptr;
-  if (sourceInfo)
-  {
-    source = vtkPolyData::SafeDownCast(sourceInfo->Get(vtkDataObject::DATA_OBJECT()));
-  }
-  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
-
-  vtkIdType numPoints, i;
-  vtkIdType numTriangles = 0;
   vtkIdType ptId, tri[4], nei[3];
   vtkIdType p1 = 0;
   vtkIdType p2 = 0;
-  vtkIdType p3 = 0;
-  vtkPoints* inPoints;
-  vtkSmartPointer<vtkPoints> tPoints;
-  int ncells;
   vtkIdType nodes[4][3];
   const vtkIdType* neiPts;
-  const vtkIdType* triPts = nullptr;
   vtkIdType numNeiPts;
-  vtkIdType npts = 0;
-  vtkIdType pts[3], swapPts[3];
-  vtkIdType tri1, tri2;
-  double center[3], radius, tol, x[3];
-  double n1[3], n2[3];
-  int* triUse = nullptr;
-
-  vtkDebugMacro(<< "Generating 2D Delaunay triangulation");
-
-  if (this->Transform && this->BoundingTriangulation)
-  {
-    vtkWarningMacro(<< "Bounding triangulation cannot be used when an input transform is "
-                       "specified.  Output will not contain bounding triangulation.");
-  }
-
-  if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE && this->BoundingTriangulation)
-  {
-    vtkWarningMacro(<< "Bounding triangulation cannot be used when the best fitting plane option "
-                       "is on.  Output will not contain bounding triangulation.");
-  }
-
-  // Initialize; check input
-  //
-  if ((inPoints = input->GetPoints()) == nullptr)
-  {
-    vtkDebugMacro("Cannot triangulate; no input points");
-    return 1;
-  }
-
-  if ((numPoints = inPoints->GetNumberOfPoints()) <= 2)
-  {
-    vtkDebugMacro("Cannot triangulate; need at least 3 input points");
-    return 1;
-  }
+  vtkIdType pts[3];
+  vtkIdType i;
+  double center[3], x[3];
 
   vtkNew<vtkIdList> neighbors;
   neighbors->Allocate(2);
-  vtkNew<vtkIdList> cells;
-  cells->Allocate(64);
 
   this->NumberOfDuplicatePoints = 0;
   this->NumberOfDegeneracies = 0;
 
   this->Mesh = vtkSmartPointer<vtkPolyData>::New();
 
-  // If the user specified a transform, apply it to the input data.
-  //
-  // Only the input points are transformed.  We do not bother
-  // transforming the source points (if specified).  The reason is
-  // that only the topology of the Source is used during the constrain
-  // operation.  The point ids in the Source topology are assumed to
-  // reference points in the input. So, when an input transform is
-  // used, only the input points are transformed.  We do not bother
-  // with transforming the Source points since they are never
-  // referenced.
-  if (this->Transform)
-  {
-    tPoints = vtkSmartPointer<vtkPoints>::New();
-    this->Transform->TransformPoints(inPoints, tPoints);
-  }
-  else
-  {
-    // If the user asked this filter to compute the best fitting plane,
-    // proceed to compute the plane and generate a transform that will
-    // map the input points into that plane.
-    if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE)
-    {
-      this->Transform.TakeReference(vtkDelaunay2D::ComputeBestFittingPlane(input));
-      tPoints = vtkSmartPointer<vtkPoints>::New();
-      this->Transform->TransformPoints(inPoints, tPoints);
-    }
-  }
-
-  // Create initial bounding triangulation. Have to create bounding points.
-  // Initialize mesh structure.
-  //
-  vtkNew<vtkPoints> points;
-  // This will copy doubles to doubles if the input is double.
-  points->SetDataTypeToDouble();
-  points->SetNumberOfPoints(numPoints);
-  if (!this->Transform)
-  {
-    points->DeepCopy(inPoints);
-  }
-  else
-  {
-    points->DeepCopy(tPoints);
-  }
-
   const double* bounds = points->GetBounds();
   center[0] = (bounds[0] + bounds[1]) / 2.0;
   center[1] = (bounds[2] + bounds[3]) / 2.0;
   center[2] = (bounds[4] + bounds[5]) / 2.0;
-  tol = input->GetLength();
-  radius = this->Offset * tol;
   this->BoundingRadius2 = 4 * radius * radius; // use (2*r)**2
-  tol *= this->Tolerance;
 
   // Add the eight bounding points to the end of the points list.
   for (ptId = 0; ptId < 8; ptId++)
@@ -521,6 +438,7 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
     ptId = (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
     this->GetPoint(ptId, x);
     nei[0] = (-1); // where we are coming from...nowhere initially
+    const int numberOfDuplicatePoints = this->NumberOfDuplicatePoints;
 
     if ((tri[0] = this->FindTriangle(x, pts, tri[0], tol, nei, neighbors)) >= 0)
     {
@@ -611,9 +529,15 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
     else
     {
       tri[0] = 0; // no triangle found
+      if (discarded)
+      {
+        discarded[ptId] = this->NumberOfDuplicatePoints > numberOfDuplicatePoints
+          ? DUPLICATE_POINT
+          : DEGENERACY;
+      }
     }
 
-    if (!(ptId % 1000))
+    if (reportProgress && !(ptId % 1000))
     {
       vtkDebugMacro(<< "point #" << ptId);
       this->UpdateProgress(static_cast<double>(ptId) / numPoints);
@@ -624,6 +548,153 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
   } // for all points
+}
+
+//------------------------------------------------------------------------------
+// 2D Delaunay triangulation. Steps are as follows:
+//   1. For each point
+//   2. Find triangle point is in
+//   3. Create 3 triangles from each edge of triangle that point is in
+//   4. Recursively evaluate Delaunay criterion for each edge neighbor
+//   5. If criterion not satisfied; swap diagonal
+//
+int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* sourceInfo = inputVector[1]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkPointSet* input = vtkPointSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData* source = nullptr;
+  if (sourceInfo)
+  {
+    source = vtkPolyData::SafeDownCast(sourceInfo->Get(vtkDataObject::DATA_OBJECT()));
+  }
+  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkIdType numPoints, i;
+  vtkIdType numTriangles = 0;
+  vtkIdType ptId;
+  vtkIdType p1 = 0;
+  vtkIdType p2 = 0;
+  vtkIdType p3 = 0;
+  vtkPoints* inPoints;
+  vtkSmartPointer<vtkPoints> tPoints;
+  int ncells;
+  const vtkIdType* neiPts;
+  const vtkIdType* triPts = nullptr;
+  vtkIdType npts = 0;
+  vtkIdType pts[3], swapPts[3];
+  vtkIdType tri1, tri2;
+  double center[3], radius, tol;
+  double n1[3], n2[3];
+  int* triUse = nullptr;
+
+  vtkDebugMacro(<< "Generating 2D Delaunay triangulation");
+
+  if (this->Transform && this->BoundingTriangulation)
+  {
+    vtkWarningMacro(<< "Bounding triangulation cannot be used when an input transform is "
+                       "specified.  Output will not contain bounding triangulation.");
+  }
+
+  if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE && this->BoundingTriangulation)
+  {
+    vtkWarningMacro(<< "Bounding triangulation cannot be used when the best fitting plane option "
+                       "is on.  Output will not contain bounding triangulation.");
+  }
+
+  // Initialize; check input
+  //
+  if ((inPoints = input->GetPoints()) == nullptr)
+  {
+    vtkDebugMacro("Cannot triangulate; no input points");
+    return 1;
+  }
+
+  if ((numPoints = inPoints->GetNumberOfPoints()) <= 2)
+  {
+    vtkDebugMacro("Cannot triangulate; need at least 3 input points");
+    return 1;
+  }
+
+  vtkNew<vtkIdList> neighbors;
+  neighbors->Allocate(2);
+  vtkNew<vtkIdList> cells;
+  cells->Allocate(64);
+
+  // If the user specified a transform, apply it to the input data.
+  //
+  // Only the input points are transformed.  We do not bother
+  // transforming the source points (if specified).  The reason is
+  // that only the topology of the Source is used during the constrain
+  // operation.  The point ids in the Source topology are assumed to
+  // reference points in the input. So, when an input transform is
+  // used, only the input points are transformed.  We do not bother
+  // with transforming the Source points since they are never
+  // referenced.
+  if (this->Transform)
+  {
+    tPoints = vtkSmartPointer<vtkPoints>::New();
+    this->Transform->TransformPoints(inPoints, tPoints);
+  }
+  else
+  {
+    // If the user asked this filter to compute the best fitting plane,
+    // proceed to compute the plane and generate a transform that will
+    // map the input points into that plane.
+    if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE)
+    {
+      this->Transform.TakeReference(vtkDelaunay2D::ComputeBestFittingPlane(input));
+      tPoints = vtkSmartPointer<vtkPoints>::New();
+      this->Transform->TransformPoints(inPoints, tPoints);
+    }
+  }
+
+  // Copy the points in double precision, leaving room for the bounding points
+  vtkNew<vtkPoints> points;
+  // This will copy doubles to doubles if the input is double.
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPoints);
+  if (!this->Transform)
+  {
+    points->DeepCopy(inPoints);
+  }
+  else
+  {
+    points->DeepCopy(tPoints);
+  }
+
+  tol = input->GetLength();
+  radius = this->Offset * tol;
+  tol *= this->Tolerance;
+
+  // Without constraints, alpha shapes or bounding triangulation, the points
+  // may be triangulated in spatial partitions that are stitched together.
+  if (this->ParallelTriangulation && !source && this->Alpha == 0.0 && !this->BoundingTriangulation)
+  {
+    vtkNew<vtkCellArray> partitionedTriangles;
+    this->TriangulatePartitions(points, numPoints, radius, tol, partitionedTriangles);
+    vtkDebugMacro(<< "Triangulated " << numPoints << " points, " << this->NumberOfDuplicatePoints
+                  << " of which were duplicates");
+    if (this->NumberOfDegeneracies > 0)
+    {
+      vtkDebugMacro(<< this->NumberOfDegeneracies
+                    << " degenerate triangles encountered, mesh quality suspect");
+    }
+    output->SetPoints(inPoints);
+    output->GetPointData()->PassData(input->GetPointData());
+    output->SetPolys(partitionedTriangles);
+    this->Transform = nullptr;
+    output->Squeeze();
+    return 1;
+  }
+
+  this->InsertPoints(points, numPoints, radius, tol, true);
+  vtkCellArray* triangles = this->Mesh->GetPolys();
 
   vtkDebugMacro(<< "Triangulated " << numPoints << " points, " << this->NumberOfDuplicatePoints
                 << " of which were duplicates");
@@ -1017,6 +1088,399 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+namespace // anonymous
+{
+// An edge of the triangles kept from the partitions, with the opposite vertex
+// of its triangle, used to stitch the seams.
+struct PartitionEdge
+{
+  vtkIdType Points[2];
+  vtkIdType Opposite;
+
+  bool operator<(const PartitionEdge& other) const
+  {
+    return this->Points[0] < other.Points[0] ||
+      (this->Points[0] == other.Points[0] && this->Points[1] < other.Points[1]);
+  }
+};
+
+// Twice the signed area of the triangle (x1, x2, x3) in the x-y plane
+double Orientation(const double* x1, const double* x2, const double* x3)
+{
+  return (x2[0] - x1[0]) * (x3[1] - x1[1]) - (x2[1] - x1[1]) * (x3[0] - x1[0]);
+}
+
+// Index of the cell (x, y) along a Hilbert curve filling a 2^16 x 2^16 grid
+vtkTypeUInt32 HilbertKey(vtkTypeUInt32 x, vtkTypeUInt32 y)
+{
+  const vtkTypeUInt32 n = 1u << 16;
+  vtkTypeUInt32 key = 0;
+  for (vtkTypeUInt32 s = n >> 1; s > 0; s >>= 1)
+  {
+    const vtkTypeUInt32 rx = (x & s) ? 1 : 0;
+    const vtkTypeUInt32 ry = (y & s) ? 1 : 0;
+    key += s * s * ((3 * rx) ^ ry);
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return key;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Parallel 2D Delaunay triangulation. Steps are as follows:
+//   1. Sort the points along x and split them in strips
+//   2. Triangulate the strips concurrently, inserting the points of each strip
+//      along a Hilbert curve so that the point location walks stay short
+//   3. Keep the triangles whose circumcircle lies inside their strip and the
+//      bounds of the points: no point of another strip nor bounding point lies
+//      in it, so they are triangles of the serial triangulation
+//   4. Triangulate the other points: those of the other triangles, on the
+//      boundary of the triangulation of their strip, or discarded
+//   5. From this seam triangulation, keep the triangles lying outside of the
+//      triangles kept in step 3, by flooding from the boundary of these
+// Step 4 is serial: it only involves the points near the seams, also
+// inserted along the Hilbert curve.
+//
+void vtkDelaunay2D::TriangulatePartitions(
+  vtkPoints* points, vtkIdType numPoints, double radius, double tol, vtkCellArray* triangles)
+{
+  const double* coords = static_cast<vtkDoubleArray*>(points->GetData())->GetPointer(0);
+  const double margin = tol + 1.0e-10 * radius;
+  this->NumberOfDuplicatePoints = 0;
+  this->NumberOfDegeneracies = 0;
+
+  std::vector<vtkIdType> sorted(numPoints);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  vtkSMPTools::Sort(sorted.begin(), sorted.end(), [coords](vtkIdType a, vtkIdType b) {
+    return coords[3 * a] < coords[3 * b] || (coords[3 * a] == coords[3 * b] && a < b);
+  });
+  const vtkIdType numPartitions = std::max<vtkIdType>(
+    1, std::min<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads(), numPoints / 3));
+  // The bounding points of the serial triangulation lie outside of the bounds
+  // of the points, so the circumcircles kept in step 3 must not cross these.
+  const double* bounds = points->GetBounds();
+  std::vector<vtkIdType> firstPoint(numPartitions + 1);
+  std::vector<double> cuts(numPartitions + 1);
+  for (vtkIdType part = 0; part <= numPartitions; ++part)
+  {
+    firstPoint[part] = part * numPoints / numPartitions;
+    cuts[part] = part < numPartitions ? coords[3 * sorted[firstPoint[part]]] : bounds[1];
+  }
+  cuts[0] = bounds[0];
+
+  // The x order only assigns the points to the strips: inserting them in this
+  // order would make every walk cross the whole strip.
+  const double scale[2] = { bounds[1] > bounds[0] ? 65535.0 / (bounds[1] - bounds[0]) : 0.0,
+    bounds[3] > bounds[2] ? 65535.0 / (bounds[3] - bounds[2]) : 0.0 };
+  std::vector<vtkTypeUInt32> keys(numPoints);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType beginPt, vtkIdType endPt) {
+    for (vtkIdType ptId = beginPt; ptId < endPt; ++ptId)
+    {
+      const double* x = coords + 3 * ptId;
+      keys[ptId] = HilbertKey(static_cast<vtkTypeUInt32>((x[0] - bounds[0]) * scale[0]),
+        static_cast<vtkTypeUInt32>((x[1] - bounds[2]) * scale[1]));
+    }
+  });
+  auto hilbertOrder = [&keys](vtkIdType a, vtkIdType b) {
+    return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+  };
+
+  std::vector<vtkSmartPointer<vtkDelaunay2D>> workers(numPartitions);
+  for (auto& worker : workers)
+  {
+    worker = vtkSmartPointer<vtkDelaunay2D>::New();
+    worker->RandomPointInsertion = this->RandomPointInsertion;
+    worker->ThreadSafeWalk = true;
+  }
+  std::vector<std::vector<vtkIdType>> keptTriangles(numPartitions);
+  std::vector<char> onSeam(numPoints, 0);
+  std::vector<char> discarded(numPoints, NOT_DISCARDED);
+
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType beginPart, vtkIdType endPart) {
+    for (vtkIdType part = beginPart; part < endPart; ++part)
+    {
+      std::vector<vtkIdType> ids(
+        sorted.begin() + firstPoint[part], sorted.begin() + firstPoint[part + 1]);
+      std::sort(ids.begin(), ids.end(), hilbertOrder);
+      const vtkIdType numLocal = static_cast<vtkIdType>(ids.size());
+      vtkNew<vtkPoints> local;
+      local->SetDataTypeToDouble();
+      local->SetNumberOfPoints(numLocal);
+      for (vtkIdType i = 0; i < numLocal; ++i)
+      {
+        local->SetPoint(i, coords + 3 * ids[i]);
+      }
+      vtkDelaunay2D* worker = workers[part];
+      std::vector<char> localDiscarded(numLocal, NOT_DISCARDED);
+      worker->InsertPoints(local, numLocal, radius, tol, false, localDiscarded.data());
+      vtkPolyData* mesh = worker->Mesh;
+
+      auto& kept = keptTriangles[part];
+      vtkIdType npts;
+      const vtkIdType* pts;
+      double x[3][3], center[2];
+      for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+      {
+        mesh->GetCellPoints(cellId, npts, pts);
+        if (pts[0] >= numLocal || pts[1] >= numLocal || pts[2] >= numLocal)
+        {
+          continue;
+        }
+        for (int j = 0; j < 3; ++j)
+        {
+          worker->GetPoint(pts[j], x[j]);
+        }
+        const double r = std::sqrt(vtkTriangle::Circumcircle(x[0], x[1], x[2], center));
+        if (center[0] - r > cuts[part] + margin && center[0] + r < cuts[part + 1] - margin &&
+          center[1] - r > bounds[2] + margin && center[1] + r < bounds[3] - margin)
+        {
+          kept.insert(kept.end(), { ids[pts[0]], ids[pts[1]], ids[pts[2]] });
+        }
+        else
+        {
+          onSeam[ids[pts[0]]] = onSeam[ids[pts[1]]] = onSeam[ids[pts[2]]] = 1;
+        }
+      }
+
+      // Points whose triangles do not close around them
+      vtkIdType ncells;
+      vtkIdType* cells;
+      for (vtkIdType i = 0; i < numLocal; ++i)
+      {
+        mesh->GetPointCells(i, ncells, cells);
+        bool closed = ncells > 0;
+        for (vtkIdType c = 0; closed && c < ncells; ++c)
+        {
+          mesh->GetCellPoints(cells[c], npts, pts);
+          closed = pts[0] < numLocal && pts[1] < numLocal && pts[2] < numLocal;
+        }
+        if (!closed)
+        {
+          onSeam[ids[i]] = 1;
+        }
+        discarded[ids[i]] = localDiscarded[i];
+      }
+      worker->Mesh = nullptr;
+    }
+  });
+  workers.clear();
+  this->UpdateProgress(0.5);
+  if (this->CheckAbort())
+  {
+    return;
+  }
+
+  // Edges on the boundary of the kept triangles, between points on the seams
+  std::vector<std::vector<PartitionEdge>> localEdges(numPartitions);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType beginPart, vtkIdType endPart) {
+    for (vtkIdType part = beginPart; part < endPart; ++part)
+    {
+      const auto& kept = keptTriangles[part];
+      for (size_t t = 0; t < kept.size(); t += 3)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          const vtkIdType a = kept[t + j];
+          const vtkIdType b = kept[t + (j + 1) % 3];
+          if (onSeam[a] && onSeam[b])
+          {
+            localEdges[part].push_back(
+              PartitionEdge{ { std::min(a, b), std::max(a, b) }, kept[t + (j + 2) % 3] });
+          }
+        }
+      }
+    }
+  });
+  std::vector<PartitionEdge> boundaryEdges;
+  for (const auto& edges : localEdges)
+  {
+    boundaryEdges.insert(boundaryEdges.end(), edges.begin(), edges.end());
+  }
+  localEdges.clear();
+  vtkSMPTools::Sort(boundaryEdges.begin(), boundaryEdges.end());
+  size_t numBoundaryEdges = 0;
+  for (size_t e = 0; e < boundaryEdges.size();)
+  {
+    size_t next = e + 1;
+    while (next < boundaryEdges.size() && !(boundaryEdges[e] < boundaryEdges[next]))
+    {
+      ++next;
+    }
+    if (next == e + 1)
+    {
+      boundaryEdges[numBoundaryEdges++] = boundaryEdges[e];
+    }
+    e = next;
+  }
+  boundaryEdges.resize(numBoundaryEdges);
+
+  // Triangulate the seams
+  std::vector<vtkIdType> seamIds;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (onSeam[ptId])
+    {
+      seamIds.push_back(ptId);
+    }
+  }
+  vtkSMPTools::Sort(seamIds.begin(), seamIds.end(), hilbertOrder);
+  const vtkIdType numSeamPoints = static_cast<vtkIdType>(seamIds.size());
+  vtkNew<vtkPoints> seamPoints;
+  seamPoints->SetDataTypeToDouble();
+  seamPoints->SetNumberOfPoints(numSeamPoints);
+  for (vtkIdType i = 0; i < numSeamPoints; ++i)
+  {
+    seamPoints->SetPoint(i, coords + 3 * seamIds[i]);
+  }
+  std::vector<char> seamDiscarded(numSeamPoints, NOT_DISCARDED);
+  this->InsertPoints(seamPoints, numSeamPoints, radius, tol, false, seamDiscarded.data());
+  for (vtkIdType i = 0; i < numSeamPoints; ++i)
+  {
+    if (seamDiscarded[i] != NOT_DISCARDED)
+    {
+      discarded[seamIds[i]] = seamDiscarded[i];
+    }
+  }
+  this->UpdateProgress(0.8);
+
+  // Classify the seam triangles adjacent to the boundary of the kept
+  // triangles, then flood the classification through the other edges.
+  const vtkIdType numSeamCells = this->Mesh->GetNumberOfCells();
+  std::vector<signed char> outside(numSeamCells, 0); // 1: kept, -1: covered, -2: bounding
+  std::vector<vtkIdType> front;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto findBoundaryEdge = [&](vtkIdType a, vtkIdType b) -> const PartitionEdge* {
+    PartitionEdge key{ { std::min(a, b), std::max(a, b) }, 0 };
+    auto it = std::lower_bound(boundaryEdges.begin(), boundaryEdges.end(), key);
+    return (it != boundaryEdges.end() && !(key < *it)) ? &*it : nullptr;
+  };
+  for (vtkIdType cellId = 0; cellId < numSeamCells; ++cellId)
+  {
+    this->Mesh->GetCellPoints(cellId, npts, pts);
+    if (pts[0] >= numSeamPoints || pts[1] >= numSeamPoints || pts[2] >= numSeamPoints)
+    {
+      outside[cellId] = -2;
+      continue;
+    }
+    for (int j = 0; j < 3 && outside[cellId] == 0; ++j)
+    {
+      const vtkIdType a = seamIds[pts[j]];
+      const vtkIdType b = seamIds[pts[(j + 1) % 3]];
+      if (const PartitionEdge* edge = findBoundaryEdge(a, b))
+      {
+        const double* xa = coords + 3 * a;
+        const double* xb = coords + 3 * b;
+        const double side = Orientation(xa, xb, coords + 3 * seamIds[pts[(j + 2) % 3]]) *
+          Orientation(xa, xb, coords + 3 * edge->Opposite);
+        outside[cellId] = side > 0.0 ? -1 : 1;
+      }
+    }
+    if (outside[cellId] != 0)
+    {
+      front.push_back(cellId);
+    }
+  }
+  vtkNew<vtkIdList> neighbors;
+  while (!front.empty())
+  {
+    const vtkIdType cellId = front.back();
+    front.pop_back();
+    this->Mesh->GetCellPoints(cellId, npts, pts);
+    const vtkIdType cellPts[3] = { pts[0], pts[1], pts[2] };
+    for (int j = 0; j < 3; ++j)
+    {
+      const vtkIdType p1 = cellPts[j];
+      const vtkIdType p2 = cellPts[(j + 1) % 3];
+      if (findBoundaryEdge(seamIds[p1], seamIds[p2]))
+      {
+        continue;
+      }
+      this->Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
+      for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+      {
+        const vtkIdType neighbor = neighbors->GetId(i);
+        if (outside[neighbor] == 0)
+        {
+          outside[neighbor] = outside[cellId];
+          front.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  // Gather the kept triangles of the partitions, then of the seams
+  std::vector<vtkIdType> firstTriangle(numPartitions + 1, 0);
+  for (vtkIdType part = 0; part < numPartitions; ++part)
+  {
+    firstTriangle[part + 1] =
+      firstTriangle[part] + static_cast<vtkIdType>(keptTriangles[part].size() / 3);
+  }
+  std::vector<vtkIdType> seamTriangles;
+  for (vtkIdType cellId = 0; cellId < numSeamCells; ++cellId)
+  {
+    if (outside[cellId] >= 0)
+    {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      seamTriangles.insert(
+        seamTriangles.end(), { seamIds[pts[0]], seamIds[pts[1]], seamIds[pts[2]] });
+    }
+  }
+  this->Mesh = nullptr;
+
+  const vtkIdType numTriangles =
+    firstTriangle[numPartitions] + static_cast<vtkIdType>(seamTriangles.size() / 3);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTriangles + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numTriangles);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numTriangles + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      offsets->SetValue(i, 3 * i);
+    }
+  });
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType beginPart, vtkIdType endPart) {
+    for (vtkIdType part = beginPart; part < endPart; ++part)
+    {
+      std::copy(keptTriangles[part].begin(), keptTriangles[part].end(),
+        conn + 3 * firstTriangle[part]);
+    }
+  });
+  std::copy(seamTriangles.begin(), seamTriangles.end(), conn + 3 * firstTriangle[numPartitions]);
+  triangles->SetData(offsets, connectivity);
+
+  // The points discarded in a strip are inserted again with the seams, where
+  // they may be kept. Count the discarded points missing from the output.
+  std::vector<char> used(numPoints, 0);
+  for (vtkIdType i = 0; i < 3 * numTriangles; ++i)
+  {
+    used[conn[i]] = 1;
+  }
+  this->NumberOfDuplicatePoints = 0; // reset by the seam triangulation
+  this->NumberOfDegeneracies = 0;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (!used[ptId])
+    {
+      this->NumberOfDuplicatePoints += discarded[ptId] == DUPLICATE_POINT;
+      this->NumberOfDegeneracies += discarded[ptId] == DEGENERACY;
+    }
+  }
+
+  vtkDebugMacro(<< "Triangulated " << numPoints << " points in " << numPartitions
+                << " partitions, with " << numSeamPoints << " points on the seams");
+}
+
 //------------------------------------------------------------------------------
 // Methods used to recover edges. Uses lines and polygons to determine boundary
 // and inside/outside.
@@ -1641,6 +2105,7 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Random Point Insertion: " << (this->RandomPointInsertion ? "On" : "Off") << "\n";
+  os << indent << "Parallel Triangulation: " << (this->ParallelTriangulation ? "On\n" : "Off\n");
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
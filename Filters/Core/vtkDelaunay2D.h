@@ -255,6 +255,27 @@ public:
   vtkBooleanMacro(RandomPointInsertion, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to triangulate the points in parallel. The points are
+   * split in strips along the x axis (after the input transform, if any), one
+   * per thread, which are triangulated concurrently. The triangles whose
+   * circumcircle lies within their strip are Delaunay triangles of all the
+   * points and are kept; the remaining points along the seams are then
+   * triangulated again, serially, to fill the gaps. Within each strip the
+   * points are inserted along a Hilbert curve rather than in input order,
+   * which keeps point location local whatever the input order. This is only
+   * used when there is no Source, Alpha is 0 and BoundingTriangulation is off;
+   * it is off by default.
+   * Unlike the serial triangulation, points only connected to the bounding
+   * triangulation are not reconnected, and the order of the output triangles
+   * depends on the number of threads.
+   */
+  vtkSetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkGetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkBooleanMacro(ParallelTriangulation, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay2D();
 
@@ -265,6 +286,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   vtkTypeBool RandomPointInsertion;
+  vtkTypeBool ParallelTriangulation;
 
   // Transform input points (if necessary)
   vtkSmartPointer<vtkAbstractTransform> Transform;
@@ -300,7 +322,17 @@ private:
   int NumberOfDuplicatePoints;
   int NumberOfDegeneracies;
 
-  // Various methods to support the Delaunay algorithm
+  // Set for the partitions of a parallel triangulation, which must not use
+  // the global state of rand() when walking through the mesh.
+  bool ThreadSafeWalk;
+
+  // Various methods to support the Delaunay algorithm. If discarded is given,
+  // InsertPoints() sets the entries of the points it does not insert to 1 for
+  // duplicate points and to 2 for degeneracies.
+  void InsertPoints(vtkPoints* points, vtkIdType numPoints, double radius, double tol,
+    bool reportProgress, char* discarded = nullptr);
+  void TriangulatePartitions(
+    vtkPoints* points, vtkIdType numPoints, double radius, double tol, vtkCellArray* triangles);
   int* RecoverBoundary(vtkPolyData* source);
   int RecoverEdge(vtkPolyData* source, vtkIdType p1, vtkIdType p2);
   void FillPolygons(vtkCellArray* polys, int* triUse);
@@ -3,20 +3,32 @@
 
 #include "vtkDelaunay3D.h"
 
+#include "vtkCellArray.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -110,6 +122,621 @@ vtkDelaunayTetra* vtkTetraArray::Resize(vtkIdType sz)
   return this->Array;
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Scramble the bits of a value, used to pick pseudo-random numbers without
+// shared state (splitmix64 finalizer).
+vtkTypeUInt64 Mix(vtkTypeUInt64 x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+//------------------------------------------------------------------------------
+// Index along a 3D Hilbert curve of a point with integer coordinates of the
+// given number of bits (Skilling, "Programming the Hilbert curve", 2004).
+vtkTypeUInt64 HilbertKey(vtkTypeUInt32 x[3], int bits)
+{
+  const vtkTypeUInt32 m = 1u << (bits - 1);
+  for (vtkTypeUInt32 q = m; q > 1; q >>= 1)
+  {
+    const vtkTypeUInt32 p = q - 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (x[i] & q)
+      {
+        x[0] ^= p;
+      }
+      else
+      {
+        const vtkTypeUInt32 t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  vtkTypeUInt32 t = 0;
+  for (vtkTypeUInt32 q = m; q > 1; q >>= 1)
+  {
+    if (x[2] & q)
+    {
+      t ^= q - 1;
+    }
+  }
+  vtkTypeUInt64 key = 0;
+  for (int b = bits - 1; b >= 0; --b)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      key = (key << 1) | (((x[i] ^ t) >> b) & 1);
+    }
+  }
+  return key;
+}
+
+//------------------------------------------------------------------------------
+// Position of a point in the insertion order: by decreasing round of the
+// biased randomized insertion order, then along the Hilbert curve.
+struct InsertionKey
+{
+  int Round;
+  vtkTypeUInt64 Hilbert;
+  vtkIdType PointId;
+
+  bool operator<(const InsertionKey& other) const
+  {
+    if (this->Round != other.Round)
+    {
+      return this->Round > other.Round;
+    }
+    if (this->Hilbert != other.Hilbert)
+    {
+      return this->Hilbert < other.Hilbert;
+    }
+    return this->PointId < other.PointId;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Delaunay tetrahedralization used by the parallel triangulation. Tetrahedra
+// are positively oriented and stored in flat arrays of four point ids and
+// four face neighbors; circumspheres are not stored. Face i is opposite to
+// point i, and its neighbor is encoded as 4 * tetra + face of the neighbor, so
+// that it is updated without searching; it is -1 on the boundary. A deleted
+// tetrahedron has a negative first point id; its slot is kept in the free
+// list of the thread which deleted it.
+//
+// Points are inserted with the Bowyer-Watson algorithm by several threads at
+// once. Each tetrahedron has a lock holding the owner of the insertion using
+// it (twice the owner id, plus one if the tetrahedron is in its cavity). An
+// insertion locks the tetrahedra it walks through (releasing them as it
+// moves), the tetrahedra of its cavity and their neighbors; if one of them is
+// held by another thread, nothing is modified and the point is retried later.
+// The storage only grows between passes, so that it is never reallocated
+// while threads read it.
+class CompactTetrahedralization
+{
+public:
+  enum Status
+  {
+    INSERTED,
+    DUPLICATE,
+    DEGENERATE,
+    CONFLICT
+  };
+
+  struct Face
+  {
+    vtkIdType Points[4]; // points of the new tetrahedron
+    int Index;           // face of the new tetrahedron on the cavity boundary
+    vtkIdType Neighbor;  // neighbor across this face
+  };
+
+  struct Edge
+  {
+    vtkIdType A;
+    vtkIdType B;
+    vtkIdType Face; // 4 * new tetrahedron + face containing the edge
+
+    bool operator<(const Edge& other) const
+    {
+      return this->A < other.A || (this->A == other.A && this->B < other.B);
+    }
+  };
+
+  // State of one thread
+  struct Worker
+  {
+    int Owner = 1;
+    bool Serial = true;
+    vtkIdType Hint = 0;
+    std::vector<vtkIdType> Locked;
+    std::vector<vtkIdType> Cavity;
+    std::vector<Face> Faces;
+    std::vector<Edge> Edges;
+    std::vector<vtkIdType> Slots;
+    std::vector<vtkIdType> Free;
+  };
+
+  CompactTetrahedralization(const double* x, vtkIdType numPts, double tol2)
+    : X(x)
+    , NumberOfPoints(numPts)
+    , Tolerance2(tol2)
+    , Capacity(0)
+    , NumberOfTetras(0)
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Create the bounding octahedron of InitPointInsertion(), whose points must
+  // follow the points to insert in X.
+  void Initialize(vtkIdType capacity)
+  {
+    const vtkIdType n = this->NumberOfPoints;
+    const vtkIdType tetras[4][4] = { { n + 4, n + 5, n, n + 2 }, { n + 4, n + 5, n + 2, n + 1 },
+      { n + 4, n + 5, n + 1, n + 3 }, { n + 4, n + 5, n + 3, n } };
+    this->Reserve(std::max<vtkIdType>(capacity, 4));
+    for (vtkIdType tetra = 0; tetra < 4; ++tetra)
+    {
+      vtkIdType* pts = &this->Points[4 * tetra];
+      std::copy(tetras[tetra], tetras[tetra] + 4, pts);
+      if (this->FaceOrientation(pts, 0, this->X + 3 * pts[0]) < 0)
+      {
+        std::swap(pts[2], pts[3]);
+      }
+    }
+    for (vtkIdType tetra = 0; tetra < 4; ++tetra)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        for (vtkIdType other = 0; other < 4; ++other)
+        {
+          for (int j = 0; other != tetra && j < 4; ++j)
+          {
+            if (this->SameFace(tetra, i, other, j))
+            {
+              this->Neighbors[4 * tetra + i] = 4 * other + j;
+            }
+          }
+        }
+      }
+    }
+    this->NumberOfTetras = 4;
+  }
+
+  //----------------------------------------------------------------------------
+  // Grow the storage to hold at least numTetras tetrahedra. Must not be called
+  // while points are inserted.
+  void Reserve(vtkIdType numTetras)
+  {
+    if (numTetras <= this->Capacity)
+    {
+      return;
+    }
+    const vtkIdType capacity = numTetras;
+    this->Points.resize(4 * capacity, -1);
+    this->Neighbors.resize(4 * capacity, -1);
+    this->Locks.reset(new std::atomic<int>[capacity]);
+    for (vtkIdType tetra = 0; tetra < capacity; ++tetra)
+    {
+      this->Locks[tetra].store(0, std::memory_order_relaxed);
+    }
+    this->Capacity = capacity;
+  }
+
+  vtkIdType GetCapacity() const { return this->Capacity; }
+  vtkIdType GetNumberOfSlots() const { return this->NumberOfTetras.load(); }
+  const vtkIdType* GetTetra(vtkIdType tetra) const { return &this->Points[4 * tetra]; }
+
+  //----------------------------------------------------------------------------
+  // Insert a point. Nothing is modified unless the point is inserted.
+  Status Insert(vtkIdType ptId, Worker& w)
+  {
+    const double* p = this->X + 3 * ptId;
+    Status status = CONFLICT;
+    const vtkIdType tetra = this->Locate(p, ptId, w, status);
+    if (tetra >= 0)
+    {
+      status = this->Connect(p, ptId, tetra, w);
+      if (status == CONFLICT)
+      {
+        // Return the slots taken for the new tetrahedra
+        for (size_t slot = std::min(w.Cavity.size(), w.Slots.size()); slot < w.Slots.size();
+             ++slot)
+        {
+          w.Free.push_back(w.Slots[slot]);
+        }
+      }
+    }
+    for (vtkIdType locked : w.Locked)
+    {
+      this->Locks[locked].store(0, std::memory_order_release);
+    }
+    w.Locked.clear();
+    return status;
+  }
+
+private:
+  const double* X;
+  vtkIdType NumberOfPoints;
+  double Tolerance2;
+  vtkIdType Capacity;
+  std::atomic<vtkIdType> NumberOfTetras; // slots used, alive or free
+  std::vector<vtkIdType> Points;
+  std::vector<vtkIdType> Neighbors;
+  std::unique_ptr<std::atomic<int>[]> Locks;
+
+  //----------------------------------------------------------------------------
+  bool Lock(vtkIdType tetra, Worker& w)
+  {
+    int state = this->Locks[tetra].load(std::memory_order_relaxed);
+    if ((state >> 1) == w.Owner)
+    {
+      return true;
+    }
+    if (state != 0 ||
+      !this->Locks[tetra].compare_exchange_strong(
+        state, 2 * w.Owner, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      return false;
+    }
+    w.Locked.push_back(tetra);
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Release the last locked tetrahedron
+  void UnlockLast(Worker& w)
+  {
+    this->Locks[w.Locked.back()].store(0, std::memory_order_release);
+    w.Locked.pop_back();
+  }
+
+  //----------------------------------------------------------------------------
+  bool InCavity(vtkIdType tetra, const Worker& w) const
+  {
+    return this->Locks[tetra].load(std::memory_order_relaxed) == 2 * w.Owner + 1;
+  }
+
+  //----------------------------------------------------------------------------
+  // Only called on tetrahedra locked by w
+  void AddToCavity(vtkIdType tetra, Worker& w)
+  {
+    this->Locks[tetra].store(2 * w.Owner + 1, std::memory_order_relaxed);
+    w.Cavity.push_back(tetra);
+  }
+
+  //----------------------------------------------------------------------------
+  bool SameFace(vtkIdType tetra, int i, vtkIdType other, int j) const
+  {
+    vtkIdType a[3], b[3];
+    for (int k = 0, ka = 0, kb = 0; k < 4; ++k)
+    {
+      if (k != i)
+      {
+        a[ka++] = this->Points[4 * tetra + k];
+      }
+      if (k != j)
+      {
+        b[kb++] = this->Points[4 * other + k];
+      }
+    }
+    std::sort(a, a + 3);
+    std::sort(b, b + 3);
+    return std::equal(a, a + 3, b);
+  }
+
+  //----------------------------------------------------------------------------
+  // Orientation of the tetrahedron where point i is replaced by p: positive
+  // when p is on the same side of face i as point i. It is computed from the
+  // face points sorted by id, so that both tetrahedra sharing a face round it
+  // the same way and walks cannot cycle across it.
+  double FaceOrientation(const vtkIdType* pts, int i, const double* p) const
+  {
+    vtkIdType face[3];
+    for (int k = 0, f = 0; k < 4; ++k)
+    {
+      if (k != i)
+      {
+        face[f++] = pts[k];
+      }
+    }
+    // Parity of moving p last and sorting the face
+    bool odd = (3 - i) % 2 == 1;
+    for (int a = 0; a < 2; ++a)
+    {
+      for (int b = 0; b < 2 - a; ++b)
+      {
+        if (face[b] > face[b + 1])
+        {
+          std::swap(face[b], face[b + 1]);
+          odd = !odd;
+        }
+      }
+    }
+    const double* x0 = this->X + 3 * face[0];
+    const double* x1 = this->X + 3 * face[1];
+    const double* x2 = this->X + 3 * face[2];
+    const double u[3] = { x1[0] - x0[0], x1[1] - x0[1], x1[2] - x0[2] };
+    const double v[3] = { x2[0] - x0[0], x2[1] - x0[1], x2[2] - x0[2] };
+    const double w[3] = { p[0] - x0[0], p[1] - x0[1], p[2] - x0[2] };
+    const double orientation = vtkMath::Determinant3x3(u, v, w);
+    return odd ? -orientation : orientation;
+  }
+
+  //----------------------------------------------------------------------------
+  // Whether p is strictly inside the circumsphere of a tetrahedron. It is the
+  // sign of the determinant of the rows (q - p, |q - p|^2) for the points q of
+  // the tetrahedron, which is negative inside for a positive orientation. As
+  // with vtkDelaunay3D::InSphere(), points on the sphere up to roundoff are
+  // outside, which is relative to the magnitude of the terms.
+  bool InSphere(vtkIdType tetra, const double* p) const
+  {
+    double r[4][3], w[4];
+    for (int k = 0; k < 4; ++k)
+    {
+      const double* q = this->X + 3 * this->Points[4 * tetra + k];
+      r[k][0] = q[0] - p[0];
+      r[k][1] = q[1] - p[1];
+      r[k][2] = q[2] - p[2];
+      w[k] = r[k][0] * r[k][0] + r[k][1] * r[k][1] + r[k][2] * r[k][2];
+    }
+    const double terms[4] = { -w[0] * vtkMath::Determinant3x3(r[1], r[2], r[3]),
+      w[1] * vtkMath::Determinant3x3(r[0], r[2], r[3]),
+      -w[2] * vtkMath::Determinant3x3(r[0], r[1], r[3]),
+      w[3] * vtkMath::Determinant3x3(r[0], r[1], r[2]) };
+    return terms[0] + terms[1] + terms[2] + terms[3] <
+      -1e-10 *
+      (std::abs(terms[0]) + std::abs(terms[1]) + std::abs(terms[2]) + std::abs(terms[3]));
+  }
+
+  //----------------------------------------------------------------------------
+  bool IsDuplicate(const double* p, vtkIdType ptId) const
+  {
+    return ptId < this->NumberOfPoints &&
+      vtkMath::Distance2BetweenPoints(p, this->X + 3 * ptId) <= this->Tolerance2;
+  }
+
+  //----------------------------------------------------------------------------
+  // Lock a live tetrahedron to start walking from, preferably the last one
+  // created by this thread.
+  vtkIdType FindStart(Worker& w)
+  {
+    const vtkIdType numTetras = this->NumberOfTetras.load(std::memory_order_relaxed);
+    vtkIdType tetra = w.Hint;
+    for (vtkIdType attempt = 0; attempt < numTetras && (w.Serial || attempt < 64); ++attempt)
+    {
+      tetra = tetra < numTetras ? tetra : 0;
+      if (this->Lock(tetra, w))
+      {
+        if (this->Points[4 * tetra] >= 0)
+        {
+          return tetra;
+        }
+        this->UnlockLast(w);
+      }
+      ++tetra;
+    }
+    return -1;
+  }
+
+  //----------------------------------------------------------------------------
+  // Walk towards p through the faces it is beyond, visited in a pseudo-random
+  // order to avoid cycling. Only the current tetrahedron is kept locked, so
+  // that its neighbors cannot be deleted while moving to one of them.
+  vtkIdType Locate(const double* p, vtkIdType ptId, Worker& w, Status& status)
+  {
+    vtkIdType tetra = this->FindStart(w);
+    if (tetra < 0)
+    {
+      status = CONFLICT;
+      return -1;
+    }
+    for (vtkTypeUInt64 step = 0; step < (1 << 20); ++step)
+    {
+      const vtkIdType* pts = &this->Points[4 * tetra];
+      const int first = static_cast<int>(Mix(static_cast<vtkTypeUInt64>(ptId) + step) & 3);
+      int exit = -1;
+      for (int k = 0; k < 4 && exit < 0; ++k)
+      {
+        const int i = (first + k) & 3;
+        if (this->FaceOrientation(pts, i, p) < 0)
+        {
+          exit = i;
+        }
+      }
+      if (exit < 0)
+      {
+        return tetra;
+      }
+      const vtkIdType neighbor = this->Neighbors[4 * tetra + exit];
+      if (neighbor < 0)
+      {
+        status = DEGENERATE; // outside of the bounding octahedron
+        return -1;
+      }
+      if (!this->Lock(neighbor / 4, w))
+      {
+        status = CONFLICT;
+        return -1;
+      }
+      std::swap(w.Locked[0], w.Locked[1]);
+      this->UnlockLast(w);
+      tetra = neighbor / 4;
+    }
+    status = DEGENERATE;
+    return -1;
+  }
+
+  //----------------------------------------------------------------------------
+  // Find the cavity of p, made of the tetrahedra whose circumsphere contains
+  // it, and replace it with the tetrahedra joining p to its boundary faces.
+  // The cavity is grown across the faces which p does not strictly see, so
+  // that the new tetrahedra are never inverted or flat.
+  Status Connect(const double* p, vtkIdType ptId, vtkIdType first, Worker& w)
+  {
+    w.Cavity.clear();
+    w.Slots.clear();
+    for (int i = 0; i < 4; ++i)
+    {
+      if (this->IsDuplicate(p, this->Points[4 * first + i]))
+      {
+        return DUPLICATE;
+      }
+    }
+    this->AddToCavity(first, w);
+    for (size_t c = 0; c < w.Cavity.size(); ++c)
+    {
+      const vtkIdType tetra = w.Cavity[c];
+      for (int i = 0; i < 4; ++i)
+      {
+        const vtkIdType neighbor = this->Neighbors[4 * tetra + i];
+        if (neighbor >= 0)
+        {
+          if (this->InCavity(neighbor / 4, w))
+          {
+            continue;
+          }
+          if (!this->Lock(neighbor / 4, w))
+          {
+            return CONFLICT;
+          }
+          if (this->InSphere(neighbor / 4, p))
+          {
+            this->AddToCavity(neighbor / 4, w);
+            continue;
+          }
+        }
+        if (this->FaceOrientation(&this->Points[4 * tetra], i, p) <= 0)
+        {
+          if (neighbor < 0)
+          {
+            return DEGENERATE;
+          }
+          this->AddToCavity(neighbor / 4, w);
+        }
+      }
+    }
+
+    // Each boundary face of the cavity makes a new tetrahedron with p, which
+    // is the cavity tetrahedron with the opposite point replaced by p.
+    w.Faces.clear();
+    for (vtkIdType tetra : w.Cavity)
+    {
+      const vtkIdType* pts = &this->Points[4 * tetra];
+      for (int i = 0; i < 4; ++i)
+      {
+        if (this->IsDuplicate(p, pts[i]))
+        {
+          return DUPLICATE;
+        }
+        const vtkIdType neighbor = this->Neighbors[4 * tetra + i];
+        if (neighbor < 0 || !this->InCavity(neighbor / 4, w))
+        {
+          Face face;
+          std::copy(pts, pts + 4, face.Points);
+          face.Points[i] = ptId;
+          face.Index = i;
+          face.Neighbor = neighbor;
+          w.Faces.push_back(face);
+        }
+      }
+    }
+
+    // The other faces of the new tetrahedra contain p and an edge of the
+    // cavity boundary, which is shared by exactly two boundary faces.
+    w.Edges.clear();
+    for (size_t f = 0; f < w.Faces.size(); ++f)
+    {
+      const Face& face = w.Faces[f];
+      for (int j = 0; j < 4; ++j)
+      {
+        if (j != face.Index)
+        {
+          const int k = (j + 1) % 4 == face.Index ? (j + 2) % 4 : (j + 1) % 4;
+          const int l = 6 - face.Index - j - k;
+          const vtkIdType a = face.Points[k];
+          const vtkIdType b = face.Points[l];
+          const vtkIdType code = static_cast<vtkIdType>(4 * f) + j;
+          w.Edges.push_back(Edge{ std::min(a, b), std::max(a, b), code });
+        }
+      }
+    }
+    std::sort(w.Edges.begin(), w.Edges.end());
+    for (size_t e = 0; e < w.Edges.size(); e += 2)
+    {
+      if (e + 1 >= w.Edges.size() || w.Edges[e] < w.Edges[e + 1] ||
+        (e + 2 < w.Edges.size() && !(w.Edges[e + 1] < w.Edges[e + 2])))
+      {
+        return DEGENERATE;
+      }
+    }
+
+    // Reuse the cavity slots, then the free ones, then new ones
+    const size_t numFaces = w.Faces.size();
+    w.Slots.assign(w.Cavity.begin(), w.Cavity.begin() + std::min(numFaces, w.Cavity.size()));
+    while (w.Slots.size() < numFaces)
+    {
+      vtkIdType slot;
+      if (!w.Free.empty())
+      {
+        slot = w.Free.back();
+        w.Free.pop_back();
+      }
+      else
+      {
+        slot = this->NumberOfTetras.load(std::memory_order_relaxed);
+        do
+        {
+          if (slot >= this->Capacity)
+          {
+            return CONFLICT;
+          }
+        } while (!this->NumberOfTetras.compare_exchange_weak(
+          slot, slot + 1, std::memory_order_relaxed, std::memory_order_relaxed));
+      }
+      // Other threads only lock a free slot briefly, when looking for a start
+      w.Slots.push_back(slot);
+      if (!this->Lock(slot, w))
+      {
+        return CONFLICT;
+      }
+    }
+
+    for (size_t f = 0; f < numFaces; ++f)
+    {
+      const Face& face = w.Faces[f];
+      const vtkIdType slot = w.Slots[f];
+      std::copy(face.Points, face.Points + 4, &this->Points[4 * slot]);
+      this->Neighbors[4 * slot + face.Index] = face.Neighbor;
+      if (face.Neighbor >= 0)
+      {
+        this->Neighbors[face.Neighbor] = 4 * slot + face.Index;
+      }
+    }
+    for (size_t e = 0; e < w.Edges.size(); e += 2)
+    {
+      const vtkIdType a = 4 * w.Slots[w.Edges[e].Face / 4] + w.Edges[e].Face % 4;
+      const vtkIdType b = 4 * w.Slots[w.Edges[e + 1].Face / 4] + w.Edges[e + 1].Face % 4;
+      this->Neighbors[a] = b;
+      this->Neighbors[b] = a;
+    }
+    for (size_t c = numFaces; c < w.Cavity.size(); ++c)
+    {
+      this->Points[4 * w.Cavity[c]] = -1;
+      w.Free.push_back(w.Cavity[c]);
+    }
+    w.Hint = w.Slots[0];
+    return INSERTED;
+  }
+};
+}
+
 // vtkDelaunay3D methods
 //
 
@@ -127,6 +754,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->ParallelTriangulation = 0;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
   this->References = nullptr;
@@ -451,6 +1079,12 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  if (this->ParallelTriangulation && this->Alpha <= 0.0)
+  {
+    this->TriangulateInParallel(input, output);
+    return 1;
+  }
+
   cells = vtkIdList::New();
   cells->Allocate(64);
   holeTetras = vtkIdList::New();
@@ -760,6 +1394,272 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Triangulate the points with CompactTetrahedralization. The points are split
+// in rounds of geometrically increasing size (each point is put in the last
+// round with probability 1/2, in the one before with probability 1/4, and so
+// on) which are inserted from the smallest one, each round being sorted along
+// a Hilbert curve. The points of a round are split into contiguous chunks of
+// the curve which are inserted concurrently, once the mesh is large enough;
+// points whose insertion conflicts with another thread are retried in a later
+// pass, serially if a pass makes no progress.
+void vtkDelaunay3D::TriangulateInParallel(vtkPointSet* input, vtkUnstructuredGrid* output)
+{
+  vtkPoints* inPoints = input->GetPoints();
+  vtkDataArray* inCoords = inPoints->GetData();
+  const vtkIdType numPoints = inPoints->GetNumberOfPoints();
+
+  // Same bounding octahedron and point merging as the serial insertion
+  double center[3], bounds[6];
+  input->GetCenter(center);
+  input->GetBounds(bounds);
+  double length = this->Offset * input->GetLength();
+  if (length <= 0.0)
+  {
+    length = 1.0;
+  }
+  if (this->Locator == nullptr)
+  {
+    this->CreateDefaultLocator();
+  }
+  const double tol = this->Locator->GetTolerance();
+
+  std::vector<double> x(3 * (numPoints + 6));
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      inCoords->GetTuple(ptId, &x[3 * ptId]);
+    }
+  });
+  for (int i = 0; i < 6; ++i)
+  {
+    double* bound = &x[3 * (numPoints + i)];
+    std::copy(center, center + 3, bound);
+    bound[i / 2] += i % 2 ? length : -length;
+  }
+
+  // Insertion order
+  const int bits = 21;
+  double scale[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double extent = bounds[2 * i + 1] - bounds[2 * i];
+    scale[i] = extent > 0.0 ? ((1u << bits) - 1) / extent : 0.0;
+  }
+  int maxRound = 0;
+  while ((numPoints >> (maxRound + 1)) > 1024)
+  {
+    ++maxRound;
+  }
+  std::vector<InsertionKey> keys(numPoints);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      vtkTypeUInt32 ix[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        ix[i] = static_cast<vtkTypeUInt32>((x[3 * ptId + i] - bounds[2 * i]) * scale[i]);
+      }
+      vtkTypeUInt64 random = Mix(static_cast<vtkTypeUInt64>(ptId));
+      int round = 0;
+      for (; round < maxRound && (random & 1); random >>= 1)
+      {
+        ++round;
+      }
+      keys[ptId] = InsertionKey{ round, HilbertKey(ix, bits), ptId };
+    }
+  });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  std::unique_ptr<CompactTetrahedralization> mesh(
+    new CompactTetrahedralization(x.data(), numPoints, tol * tol));
+  mesh->Initialize(7 * numPoints + 1024);
+  vtkSMPThreadLocal<CompactTetrahedralization::Worker> workers;
+  std::atomic<vtkIdType> numDuplicates(0);
+  std::atomic<vtkIdType> numDegeneracies(0);
+  auto count = [&](CompactTetrahedralization::Status status) {
+    if (status == CompactTetrahedralization::DUPLICATE)
+    {
+      numDuplicates.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (status == CompactTetrahedralization::DEGENERATE)
+    {
+      numDegeneracies.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+  const vtkIdType numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+
+  std::vector<vtkIdType> pending, deferred;
+  for (vtkIdType begin = 0, end = 0; begin < numPoints && !this->CheckAbort(); begin = end)
+  {
+    bool serial = numThreads < 2;
+    for (end = begin; end < numPoints && keys[end].Round == keys[begin].Round; ++end)
+    {
+    }
+    pending.resize(end - begin);
+    std::transform(keys.begin() + begin, keys.begin() + end, pending.begin(),
+      [](const InsertionKey& key) { return key.PointId; });
+
+    while (!pending.empty())
+    {
+      const vtkIdType numPending = static_cast<vtkIdType>(pending.size());
+      // Chunks should be much smaller than the mesh, so that they rarely
+      // touch each other
+      const vtkIdType numChunks = std::min(std::min(4 * numThreads, numPending / 64), begin / 256);
+      mesh->Reserve(mesh->GetNumberOfSlots() + 7 * numPending + 1024);
+      if (serial || numChunks < 2)
+      {
+        CompactTetrahedralization::Worker& worker = workers.Local();
+        worker.Owner = 1;
+        worker.Serial = true;
+        for (vtkIdType ptId : pending)
+        {
+          CompactTetrahedralization::Status status;
+          while ((status = mesh->Insert(ptId, worker)) == CompactTetrahedralization::CONFLICT)
+          {
+            mesh->Reserve(mesh->GetCapacity() + mesh->GetCapacity() / 2);
+          }
+          count(status);
+        }
+        pending.clear();
+        continue;
+      }
+
+      std::vector<std::vector<vtkIdType>> conflicts(numChunks);
+      vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType beginChunk, vtkIdType endChunk) {
+        CompactTetrahedralization::Worker& worker = workers.Local();
+        worker.Serial = false;
+        for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+        {
+          worker.Owner = static_cast<int>(chunk + 1);
+          for (vtkIdType i = chunk * numPending / numChunks;
+               i < (chunk + 1) * numPending / numChunks; ++i)
+          {
+            const auto status = mesh->Insert(pending[i], worker);
+            if (status == CompactTetrahedralization::CONFLICT)
+            {
+              conflicts[chunk].push_back(pending[i]);
+            }
+            count(status);
+          }
+        }
+      });
+      deferred.clear();
+      for (const auto& chunkConflicts : conflicts)
+      {
+        deferred.insert(deferred.end(), chunkConflicts.begin(), chunkConflicts.end());
+      }
+      serial = deferred.size() == pending.size();
+      pending.swap(deferred);
+    }
+    this->UpdateProgress(0.9 * end / numPoints);
+  }
+
+  this->NumberOfDuplicatePoints = static_cast<int>(numDuplicates.load());
+  this->NumberOfDegeneracies = static_cast<int>(numDegeneracies.load());
+  vtkDebugMacro(<< "Triangulated " << numPoints << " points, " << this->NumberOfDuplicatePoints
+                << " of which were duplicates");
+  if (this->NumberOfDegeneracies > 0)
+  {
+    vtkWarningMacro(<< this->NumberOfDegeneracies
+                    << " degenerate triangles encountered, mesh quality suspect");
+  }
+
+  // Gather the tetrahedra in a canonical order: each one starts with its
+  // smallest point id followed by the next smallest one (with an even
+  // permutation, to keep its orientation), then they are sorted.
+  std::vector<std::array<vtkIdType, 4>> tetras;
+  tetras.reserve(mesh->GetNumberOfSlots());
+  for (vtkIdType tetra = 0; tetra < mesh->GetNumberOfSlots(); ++tetra)
+  {
+    const vtkIdType* pts = mesh->GetTetra(tetra);
+    if (pts[0] >= 0 &&
+      (this->BoundingTriangulation ||
+        std::max(std::max(pts[0], pts[1]), std::max(pts[2], pts[3])) < numPoints))
+    {
+      tetras.push_back(std::array<vtkIdType, 4>{ { pts[0], pts[1], pts[2], pts[3] } });
+    }
+  }
+  mesh.reset();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tetras.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tetra = begin; tetra < end; ++tetra)
+    {
+      auto& pts = tetras[tetra];
+      const int smallest = static_cast<int>(std::min_element(pts.begin(), pts.end()) - pts.begin());
+      if (smallest > 0)
+      {
+        const int other = smallest == 1 ? 2 : 1;
+        std::swap(pts[0], pts[smallest]);
+        std::swap(pts[other], pts[6 - smallest - other]);
+      }
+      while (pts[1] > pts[2] || pts[1] > pts[3])
+      {
+        std::rotate(pts.begin() + 1, pts.begin() + 2, pts.end());
+      }
+    }
+  });
+  vtkSMPTools::Sort(tetras.begin(), tetras.end());
+  this->UpdateProgress(0.95);
+
+  const vtkIdType numTetras = static_cast<vtkIdType>(tetras.size());
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> connectivity;
+  offsets->SetNumberOfValues(numTetras + 1);
+  connectivity->SetNumberOfValues(4 * numTetras);
+  vtkSMPTools::For(0, numTetras + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tetra = begin; tetra < end; ++tetra)
+    {
+      offsets->SetValue(tetra, 4 * tetra);
+      for (int i = 0; tetra < numTetras && i < 4; ++i)
+      {
+        connectivity->SetValue(4 * tetra + i, tetras[tetra][i]);
+      }
+    }
+  });
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+
+  // Update output, as the serial insertion
+  vtkNew<vtkPoints> points;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    points->SetDataType(inPoints->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    points->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    points->SetDataType(VTK_DOUBLE);
+  }
+  if (this->BoundingTriangulation)
+  {
+    points->SetNumberOfPoints(numPoints + 6);
+    for (vtkIdType ptId = 0; ptId < numPoints + 6; ++ptId)
+    {
+      points->SetPoint(ptId, &x[3 * ptId]);
+    }
+    output->SetPoints(points);
+  }
+  else
+  {
+    if (inPoints->GetDataType() != points->GetDataType())
+    {
+      points->DeepCopy(inPoints);
+      output->SetPoints(points);
+    }
+    else
+    {
+      output->SetPoints(inPoints);
+    }
+    output->GetPointData()->PassData(input->GetPointData());
+  }
+  output->SetCells(VTK_TETRA, cells);
+  vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
+                << output->GetNumberOfCells() << " tetrahedra");
+}
+
 //------------------------------------------------------------------------------
 // This is a helper method used with InsertPoint() to create
 // tetrahedronalizations of points. Its purpose is construct an initial
@@ -1062,6 +1962,7 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Triangulation: " << (this->ParallelTriangulation ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
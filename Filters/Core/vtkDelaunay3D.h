@@ -252,6 +252,26 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to triangulate the points with the parallel insertion
+   * engine. It stores the tetrahedra compactly, with their points and packed
+   * face neighbors, instead of an editable unstructured grid, circumspheres and
+   * a point locator. The points are inserted in rounds of increasing size (biased
+   * randomized insertion order), sorted along a Hilbert curve within each
+   * round. The points of a round are inserted concurrently: each insertion
+   * locks the tetrahedra it walks through and modifies, and is retried later
+   * if another thread holds one of them. Points closer than the tolerance of
+   * the locator to an inserted point are discarded, as with the serial
+   * insertion. This is only used when Alpha is 0; it is off by default. In
+   * general position the output tetrahedra are the same as the serial ones,
+   * in an order that does not depend on the number of threads.
+   */
+  vtkSetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkGetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkBooleanMacro(ParallelTriangulation, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay3D();
   ~vtkDelaunay3D() override;
@@ -267,6 +287,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  vtkTypeBool ParallelTriangulation;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -291,6 +312,8 @@ private:                    // members added for performance
   vtkIdList* Faces;         // used in InsertPoint
   vtkIdList* CheckedTetras; // used by InsertPoint
 
+  void TriangulateInParallel(vtkPointSet* input, vtkUnstructuredGrid* output);
+
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
   void operator=(const vtkDelaunay3D&) = delete;
 };
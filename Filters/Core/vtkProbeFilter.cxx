@@ -15,6 +15,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLinearCellEvaluator.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -777,10 +778,23 @@ static void GetPointIdsInRange(double rangeMin, double rangeMax, double start, d
   }
 }
 
+//------------------------------------------------------------------------------
+// Per thread buffers used to evaluate the image points of a cell in one batch
+struct vtkProbeFilter::ProbeImageCellBuffers
+{
+  vtkLinearCellEvaluator Evaluator;
+  std::vector<vtkIdType> PointIds;
+  std::vector<double> Points;
+  std::vector<double> PCoords;
+  std::vector<double> Weights;
+  std::vector<signed char> Inside;
+};
+
 //------------------------------------------------------------------------------
 void vtkProbeFilter::ProbeImagePointsInCell(vtkGenericCell* cell, vtkIdType cellId,
   vtkDataSet* source, int srcBlockId, const double start[3], const double spacing[3],
-  const int dim[3], vtkPointData* outPD, char* maskArray, double* wtsBuff)
+  const int dim[3], vtkPointData* outPD, char* maskArray, double* wtsBuff,
+  ProbeImageCellBuffers& buffers)
 {
   vtkPointData* pd = source->GetPointData();
 
@@ -804,6 +818,68 @@ void vtkProbeFilter::ProbeImagePointsInCell(vtkGenericCell* cell, vtkIdType cell
 
   source->GetCell(cellId, cell);
 
+  if (cell->GetCellDimension() == 3 && buffers.Evaluator.SetCellType(cell->GetCellType()))
+  {
+    // Linear 3D cells evaluate all the unprocessed image points at once. Their
+    // EvaluatePosition() reports a null distance inside, so the tolerance does
+    // not matter.
+    buffers.PointIds.clear();
+    buffers.Points.clear();
+    for (vtkIdType iz = idxBounds[4]; iz <= idxBounds[5]; iz++)
+    {
+      for (vtkIdType iy = idxBounds[2]; iy <= idxBounds[3]; iy++)
+      {
+        for (vtkIdType ix = idxBounds[0]; ix <= idxBounds[1]; ix++)
+        {
+          const vtkIdType ptId = ix + dim[0] * (iy + dim[1] * iz);
+          if (maskArray[ptId] != 1)
+          {
+            buffers.PointIds.push_back(ptId);
+            buffers.Points.push_back(start[0] + ix * spacing[0]);
+            buffers.Points.push_back(start[1] + iy * spacing[1]);
+            buffers.Points.push_back(start[2] + iz * spacing[2]);
+          }
+        }
+      }
+    }
+    const vtkIdType numPoints = static_cast<vtkIdType>(buffers.PointIds.size());
+    if (numPoints == 0)
+    {
+      return;
+    }
+
+    static const vtkIdType cellPointIds[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    buffers.Evaluator.InsertNextCell(cell->Points, cellPointIds);
+    const int numCellPoints = buffers.Evaluator.GetNumberOfPoints();
+    buffers.PCoords.resize(3 * numPoints);
+    buffers.Weights.resize(numCellPoints * numPoints);
+    buffers.Inside.resize(numPoints);
+    buffers.Evaluator.EvaluatePosition(numPoints, buffers.Points.data(), buffers.PCoords.data(),
+      buffers.Weights.data(), buffers.Inside.data());
+
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      if (buffers.Inside[i] != 1)
+      {
+        continue;
+      }
+      const vtkIdType ptId = buffers.PointIds[i];
+      outPD->InterpolatePoint(*this->PointList, pd, srcBlockId, ptId, cell->PointIds,
+        &buffers.Weights[numCellPoints * i]);
+      for (size_t j = 0, numArrays = this->InputCellArrays.size(); j < numArrays; ++j)
+      {
+        auto inputArray = this->InputCellArrays[j];
+        auto sourceArray = this->SourceCellArrays[j];
+        if (sourceArray)
+        {
+          inputArray->SetTuple(ptId, cellId, sourceArray);
+        }
+      }
+      maskArray[ptId] = static_cast<char>(1);
+    }
+    return;
+  }
+
   double cpbuf[3];
   double dist2 = 0;
   double* closestPoint = cpbuf;
@@ -903,6 +979,7 @@ public:
       this->Source->GetCellData()->GetArray(vtkDataSetAttributes::GhostArrayName()));
 
     auto& cell = this->TLGenericCell.Local();
+    auto& buffers = this->TLBuffers.Local();
     bool isFirst = vtkSMPTools::GetSingleThread();
     vtkIdType checkAbortInterval = std::min((cellEnd - cellBegin) / 10 + 1, (vtkIdType)1000);
     for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
@@ -924,7 +1001,8 @@ public:
       }
 
       this->ProbeFilter->ProbeImagePointsInCell(cell, cellId, this->Source, this->SrcBlockId,
-        this->Start, this->Spacing, this->Dim, this->OutPointData, this->MaskArray, weights);
+        this->Start, this->Spacing, this->Dim, this->OutPointData, this->MaskArray, weights,
+        buffers);
     }
   }
 
@@ -942,6 +1020,7 @@ private:
   int MaxCellSize;
 
   vtkSMPThreadLocal<std::vector<double>> TLWeights;
+  vtkSMPThreadLocal<vtkProbeFilter::ProbeImageCellBuffers> TLBuffers;
   vtkSMPThreadLocalObject<vtkGenericCell> TLGenericCell;
 };
 
@@ -299,9 +299,10 @@ private:
   // A faster implementation for vtkImageData input.
   void ProbePointsImageData(
     vtkImageData* input, int srcIdx, vtkDataSet* source, vtkImageData* output);
+  struct ProbeImageCellBuffers;
   void ProbeImagePointsInCell(vtkGenericCell* cell, vtkIdType cellId, vtkDataSet* source,
     int srcBlockId, const double start[3], const double spacing[3], const int dim[3],
-    vtkPointData* outPD, char* maskArray, double* wtsBuff);
+    vtkPointData* outPD, char* maskArray, double* wtsBuff, ProbeImageCellBuffers& buffers);
 
   class ProbeImageDataWorklet;
 
@@ -2,9 +2,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkQuadricClustering.h"
 
-#include <cstdint>
-
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkExecutive.h"
 #include "vtkFeatureEdges.h"
@@ -14,25 +13,180 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>     // std::sort
+#include <array>         // triangle keys
+#include <unordered_map> // sparse bins
 #include <unordered_set> // keep track of inserted triangles
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricClustering);
 
 //------------------------------------------------------------------------------
-// PIMPLd STL set for keeping track of inserted cells
+// PIMPLd STL set for keeping track of inserted cells. Triangles are keyed by
+// their sorted bin ids, which do not fit in a single integer for fine
+// divisions.
 struct vtkQuadricClusteringIdxHash
 {
-  size_t operator()(int64_t val) const { return static_cast<size_t>(val); }
+  size_t operator()(const std::array<vtkIdType, 3>& tri) const
+  {
+    std::hash<vtkIdType> hash;
+    size_t h = hash(tri[0]);
+    h ^= hash(tri[1]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= hash(tri[2]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+  }
 };
-class vtkQuadricClusteringCellSet : public std::unordered_set<int64_t, vtkQuadricClusteringIdxHash>
+class vtkQuadricClusteringCellSet
+  : public std::unordered_set<std::array<vtkIdType, 3>, vtkQuadricClusteringIdxHash>
 {
 };
 typedef vtkQuadricClusteringCellSet::iterator vtkQuadricClusteringCellSetIterator;
 
+//------------------------------------------------------------------------------
+// PIMPLd STL map of the visited bins. Bins are created on first access, with
+// no vertex and an uninitialized quadric, as they were in a dense grid.
+class vtkQuadricClustering::PointQuadricMap
+  : public std::unordered_map<vtkIdType, vtkQuadricClustering::PointQuadric>
+{
+};
+
+//------------------------------------------------------------------------------
+// Accumulate the quadrics of the triangles of polygons in thread local sparse
+// bins. Each thread also records the first use of its bins (cell and corner
+// in the serial traversal) and the triangles spanning three bins, so that
+// vertex ids and output triangles can be assigned in serial order afterwards.
+struct vtkQuadricClustering::AddPolygonsFunctor
+{
+  struct LocalBin
+  {
+    vtkIdType FirstCell;
+    vtkIdType FirstCorner;
+    double Quadric[9];
+  };
+
+  struct LocalTriangle
+  {
+    vtkIdType CellId;
+    vtkIdType SubId;
+    vtkIdType BinIds[3];
+
+    bool operator<(const LocalTriangle& other) const
+    {
+      return this->CellId < other.CellId ||
+        (this->CellId == other.CellId && this->SubId < other.SubId);
+    }
+  };
+
+  struct LocalData
+  {
+    std::unordered_map<vtkIdType, LocalBin> Bins;
+    std::vector<LocalTriangle> Triangles;
+    vtkSmartPointer<vtkCellArrayIterator> Iterator;
+  };
+
+  vtkQuadricClustering* Self;
+  vtkCellArray* Polys;
+  vtkPoints* Points;
+  bool Geometry;
+  vtkSMPThreadLocal<LocalData> Local;
+
+  AddPolygonsFunctor(vtkQuadricClustering* self, vtkCellArray* polys, vtkPoints* points, bool geom)
+    : Self(self)
+    , Polys(polys)
+    , Points(points)
+    , Geometry(geom)
+  {
+  }
+
+  void Initialize() { this->Local.Local().Iterator.TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData& local = this->Local.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3][3], quadric4x4[4][4];
+    vtkIdType binIds[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Self->CheckAbort();
+        }
+        if (this->Self->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      local.Iterator->GetCellAtId(cellId, npts, pts);
+      if (npts < 3)
+      {
+        continue;
+      }
+      this->Points->GetPoint(pts[0], x[0]);
+      binIds[0] = this->Self->HashPoint(x[0]);
+      for (vtkIdType j = 0; j < npts - 2; j++) // creates triangles; assumes poly is convex
+      {
+        this->Points->GetPoint(pts[j + 1], x[1]);
+        binIds[1] = this->Self->HashPoint(x[1]);
+        this->Points->GetPoint(pts[j + 2], x[2]);
+        binIds[2] = this->Self->HashPoint(x[2]);
+        const bool distinct =
+          binIds[0] != binIds[1] && binIds[0] != binIds[2] && binIds[1] != binIds[2];
+        if (!distinct && !this->Self->UseInternalTriangles)
+        {
+          continue;
+        }
+
+        vtkTriangle::ComputeQuadric(x[0], x[1], x[2], quadric4x4);
+        const double quadric[9] = { quadric4x4[0][0], quadric4x4[0][1], quadric4x4[0][2],
+          quadric4x4[0][3], quadric4x4[1][1], quadric4x4[1][2], quadric4x4[1][3],
+          quadric4x4[2][2], quadric4x4[2][3] };
+        for (int i = 0; i < 3; ++i)
+        {
+          auto inserted = local.Bins.emplace(binIds[i], LocalBin());
+          LocalBin& bin = inserted.first->second;
+          if (inserted.second)
+          {
+            bin.FirstCell = cellId;
+            bin.FirstCorner = 3 * j + i;
+            std::fill(bin.Quadric, bin.Quadric + 9, 0.0);
+          }
+          else if (cellId < bin.FirstCell)
+          {
+            // A thread does not necessarily process its ranges in order
+            bin.FirstCell = cellId;
+            bin.FirstCorner = 3 * j + i;
+          }
+          for (int k = 0; k < 9; ++k)
+          {
+            bin.Quadric[k] += quadric[k];
+          }
+        }
+
+        if (this->Geometry && distinct)
+        {
+          local.Triangles.push_back({ cellId, j, { binIds[0], binIds[1], binIds[2] } });
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
 //------------------------------------------------------------------------------
 // Construct with default NumberOfDivisions to 50, DivisionSpacing to 1
 // in all (x,y,z) directions. AutoAdjustNumberOfDivisions is set to ON.
@@ -47,7 +201,7 @@ vtkQuadricClustering::vtkQuadricClustering()
   this->NumberOfXDivisions = 50;
   this->NumberOfYDivisions = 50;
   this->NumberOfZDivisions = 50;
-  this->QuadricArray = nullptr;
+  this->QuadricMap = nullptr;
   this->NumberOfBinsUsed = 0;
   this->AbortExecute = 0;
 
@@ -94,8 +248,8 @@ vtkQuadricClustering::~vtkQuadricClustering()
   this->FeaturePoints = nullptr;
   delete this->CellSet;
   this->CellSet = nullptr;
-  delete[] this->QuadricArray;
-  this->QuadricArray = nullptr;
+  delete this->QuadricMap;
+  this->QuadricMap = nullptr;
   if (this->OutputTriangleArray)
   {
     this->OutputTriangleArray->Delete();
@@ -172,7 +326,6 @@ int vtkQuadricClustering::RequestData(vtkInformation* vtkNotUsed(request),
 
   this->StartAppend(input->GetBounds());
   this->UpdateProgress(.2);
-  this->SliceSize = this->NumberOfDivisions[0] * this->NumberOfDivisions[1];
 
   this->Append(input);
   if (this->UseFeatureEdges)
@@ -190,8 +343,8 @@ int vtkQuadricClustering::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Free up some memory.
-  delete[] this->QuadricArray;
-  this->QuadricArray = nullptr;
+  delete this->QuadricMap;
+  this->QuadricMap = nullptr;
 
   if (this->Debug)
   {
@@ -210,8 +363,8 @@ void vtkQuadricClustering::StartAppend(double* bounds)
   if (this->PreventDuplicateCells)
   {
     this->CellSet = new vtkQuadricClusteringCellSet;
-    this->NumberOfBins =
-      this->NumberOfDivisions[0] * this->NumberOfDivisions[1] * this->NumberOfDivisions[2];
+    this->NumberOfBins = static_cast<vtkIdType>(this->NumberOfDivisions[0]) *
+      this->NumberOfDivisions[1] * this->NumberOfDivisions[2];
   }
 
   // Copy over the bounds.
@@ -275,16 +428,11 @@ void vtkQuadricClustering::StartAppend(double* bounds)
   this->XBinStep = (this->XBinSize > 0.0) ? (1.0 / this->XBinSize) : 0.0;
   this->YBinStep = (this->YBinSize > 0.0) ? (1.0 / this->YBinSize) : 0.0;
   this->ZBinStep = (this->ZBinSize > 0.0) ? (1.0 / this->ZBinSize) : 0.0;
+  this->SliceSize = static_cast<vtkIdType>(this->NumberOfDivisions[0]) * this->NumberOfDivisions[1];
 
   this->NumberOfBinsUsed = 0;
-  delete[] this->QuadricArray;
-  this->QuadricArray = new vtkQuadricClustering::PointQuadric[this->NumberOfDivisions[0] *
-    this->NumberOfDivisions[1] * this->NumberOfDivisions[2]];
-  if (this->QuadricArray == nullptr)
-  {
-    vtkErrorMacro("Could not allocate quadric grid.");
-    return;
-  }
+  delete this->QuadricMap;
+  this->QuadricMap = new vtkQuadricClustering::PointQuadricMap;
 
   vtkInformation* inInfo = this->GetExecutive()->GetInputInformation(0, 0);
   vtkInformation* outInfo = this->GetExecutive()->GetOutputInformation(0);
@@ -351,44 +499,78 @@ void vtkQuadricClustering::Append(vtkPolyData* pd)
 void vtkQuadricClustering::AddPolygons(
   vtkCellArray* polys, vtkPoints* points, int geometryFlag, vtkPolyData* input, vtkPolyData* output)
 {
-  const vtkIdType* ptIds = nullptr;
-  vtkIdType numPts = 0;
-  double pts0[3], pts1[3], pts2[3];
-  vtkIdType binIds[3];
+  const vtkIdType numCells = polys->GetNumberOfCells();
+  if (numCells == 0)
+  {
+    return;
+  }
 
-  double total = polys->GetNumberOfCells();
-  double curr = 0;
-  double step = total / 10;
-  if (step < 1000.0)
+  // Accumulate the quadrics in thread local bins.
+  AddPolygonsFunctor functor(this, polys, points, geometryFlag != 0);
+  vtkSMPTools::For(0, numCells, functor);
+  if (this->GetAbortOutput())
   {
-    step = 1000.0;
+    return;
   }
-  double cstep = step;
 
-  for (polys->InitTraversal(); polys->GetNextCell(numPts, ptIds);)
+  // Merge the local quadrics into the bins. Points and segments supersede
+  // triangles.
+  std::vector<AddPolygonsFunctor::LocalTriangle> triangles;
+  std::vector<AddPolygonsFunctor::LocalTriangle> firstUses;
+  for (auto& local : functor.Local)
   {
-    points->GetPoint(ptIds[0], pts0);
-    binIds[0] = this->HashPoint(pts0);
-    for (vtkIdType j = 0; j < numPts - 2; j++) // creates triangles; assumes poly is convex
-    {
-      points->GetPoint(ptIds[j + 1], pts1);
-      binIds[1] = this->HashPoint(pts1);
-      points->GetPoint(ptIds[j + 2], pts2);
-      binIds[2] = this->HashPoint(pts2);
-      this->AddTriangle(binIds, pts0, pts1, pts2, geometryFlag, input, output);
-    }
-    ++this->InCellCount;
-    if (curr > cstep)
+    for (auto& entry : local.Bins)
     {
-      if (this->CheckAbort())
+      PointQuadric& bin = (*this->QuadricMap)[entry.first];
+      if (bin.Dimension > 2)
+      {
+        bin.Dimension = 2;
+        this->InitializeQuadric(bin.Quadric);
+      }
+      if (bin.Dimension == 2)
+      {
+        this->AddQuadric(entry.first, entry.second.Quadric);
+      }
+      if (geometryFlag && bin.VertexId == -1)
       {
-        break;
+        firstUses.push_back(
+          { entry.second.FirstCell, entry.second.FirstCorner, { entry.first, 0, 0 } });
       }
-      this->UpdateProgress(.6 + .2 * curr / total);
-      cstep += step;
     }
-    curr += 1;
-  } // for all polygons
+    local.Bins.clear();
+    triangles.insert(triangles.end(), local.Triangles.begin(), local.Triangles.end());
+    local.Triangles.clear();
+  }
+  if (!geometryFlag)
+  {
+    return;
+  }
+
+  // Number the new vertices in the order of their first use, as the serial
+  // traversal of the polygons would.
+  vtkSMPTools::Sort(firstUses.begin(), firstUses.end());
+  for (const auto& firstUse : firstUses)
+  {
+    PointQuadric& bin = (*this->QuadricMap)[firstUse.BinIds[0]];
+    if (bin.VertexId == -1)
+    {
+      bin.VertexId = this->NumberOfBinsUsed;
+      this->NumberOfBinsUsed++;
+    }
+  }
+
+  // Add the triangles in the order of the input polygons.
+  vtkSMPTools::Sort(triangles.begin(), triangles.end());
+  vtkIdType triPtIds[3];
+  for (const auto& tri : triangles)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      triPtIds[i] = (*this->QuadricMap)[tri.BinIds[i]].VertexId;
+    }
+    this->InsertTriangle(tri.BinIds, triPtIds, this->InCellCount + tri.CellId, input, output);
+  }
+  this->InCellCount += numCells;
 }
 
 //------------------------------------------------------------------------------
@@ -479,14 +661,15 @@ void vtkQuadricClustering::AddTriangle(vtkIdType* binIds, double* pt0, double* p
   // Add the quadric to each of the three corner bins.
   for (int i = 0; i < 3; ++i)
   {
+    PointQuadric& bin = (*this->QuadricMap)[binIds[i]];
     // If the current quadric is not initialized, then clear it out.
-    if (this->QuadricArray[binIds[i]].Dimension > 2)
+    if (bin.Dimension > 2)
     {
-      this->QuadricArray[binIds[i]].Dimension = 2;
+      bin.Dimension = 2;
       // Initialize the coeff
-      this->InitializeQuadric(this->QuadricArray[binIds[i]].Quadric);
+      this->InitializeQuadric(bin.Quadric);
     }
-    if (this->QuadricArray[binIds[i]].Dimension == 2)
+    if (bin.Dimension == 2)
     { // Points and segments supersede triangles.
       this->AddQuadric(binIds[i], quadric);
     }
@@ -499,88 +682,41 @@ void vtkQuadricClustering::AddTriangle(vtkIdType* binIds, double* pt0, double* p
     for (int i = 0; i < 3; i++)
     {
       // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
+      PointQuadric& bin = (*this->QuadricMap)[binIds[i]];
+      if (bin.VertexId == -1)
       {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
+        bin.VertexId = this->NumberOfBinsUsed;
         this->NumberOfBinsUsed++;
       }
-      triPtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      triPtIds[i] = bin.VertexId;
     }
-    // This comparison could just as well be on triPtIds.
-    if (binIds[0] != binIds[1] && binIds[0] != binIds[2] && binIds[1] != binIds[2])
+    this->InsertTriangle(binIds, triPtIds, this->InCellCount, input, output);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkQuadricClustering::InsertTriangle(const vtkIdType binIds[3], const vtkIdType triPtIds[3],
+  vtkIdType inCellId, vtkPolyData* input, vtkPolyData* output)
+{
+  // This comparison could just as well be on triPtIds.
+  if (binIds[0] == binIds[1] || binIds[0] == binIds[2] || binIds[1] == binIds[2])
+  {
+    return;
+  }
+  if (this->PreventDuplicateCells)
+  {
+    std::array<vtkIdType, 3> key = { { binIds[0], binIds[1], binIds[2] } };
+    std::sort(key.begin(), key.end());
+    if (!this->CellSet->insert(key).second)
     {
-      if (this->PreventDuplicateCells)
-      {
-        vtkIdType minIdx = (binIds[0] < binIds[1] ? (binIds[0] < binIds[2] ? 0 : 2)
-                                                  : (binIds[1] < binIds[2] ? 1 : 2));
-        vtkIdType midIdx = 0;
-        vtkIdType maxIdx = 0;
-        switch (minIdx)
-        {
-          case 0:
-            if (binIds[1] > binIds[2])
-            {
-              maxIdx = 1;
-              midIdx = 2;
-            }
-            else
-            {
-              maxIdx = 2;
-              midIdx = 1;
-            }
-            break;
-          case 1:
-            if (binIds[0] > binIds[2])
-            {
-              maxIdx = 0;
-              midIdx = 2;
-            }
-            else
-            {
-              maxIdx = 2;
-              midIdx = 0;
-            }
-            break;
-          case 2:
-            if (binIds[0] > binIds[1])
-            {
-              maxIdx = 0;
-              midIdx = 1;
-            }
-            else
-            {
-              maxIdx = 1;
-              midIdx = 0;
-            }
-            break;
-        }
-        int64_t upsizedBinMin = static_cast<int64_t>(binIds[minIdx]);
-        int64_t upsizedBinMid = static_cast<int64_t>(binIds[midIdx]);
-        int64_t upsizedBinMax = static_cast<int64_t>(binIds[maxIdx]);
-        int64_t idx = upsizedBinMin + this->NumberOfBins * upsizedBinMid +
-          this->NumberOfBins * this->NumberOfBins * upsizedBinMax;
-        if (this->CellSet->find(idx) == this->CellSet->end())
-        {
-          this->CellSet->insert(idx);
-          this->OutputTriangleArray->InsertNextCell(3, triPtIds);
-          if (this->CopyCellData && input)
-          {
-            output->GetCellData()->CopyData(
-              input->GetCellData(), this->InCellCount, this->OutCellCount++);
-          } // if cell data
-        }   // if not a duplicate
-      }
-      else // don't check for duplicates
-      {
-        this->OutputTriangleArray->InsertNextCell(3, triPtIds);
-        if (this->CopyCellData && input)
-        {
-          output->GetCellData()->CopyData(
-            input->GetCellData(), this->InCellCount, this->OutCellCount++);
-        } // if cell data
-      }   // don't check for duplicates
-    }     // if not duplicate vertices
-  }       // if this should be inserted
+      return;
+    }
+  }
+  this->OutputTriangleArray->InsertNextCell(3, triPtIds);
+  if (this->CopyCellData && input)
+  {
+    output->GetCellData()->CopyData(input->GetCellData(), inCellId, this->OutCellCount++);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -690,14 +826,15 @@ void vtkQuadricClustering::AddEdge(vtkIdType* binIds, double* pt0, double* pt1,
 
   for (int i = 0; i < 2; ++i)
   {
+    PointQuadric& bin = (*this->QuadricMap)[binIds[i]];
     // If the current quadric is from triangles (or not initialized), then clear it out.
-    if (this->QuadricArray[binIds[i]].Dimension > 1)
+    if (bin.Dimension > 1)
     {
-      this->QuadricArray[binIds[i]].Dimension = 1;
+      bin.Dimension = 1;
       // Initialize the coeff
-      this->InitializeQuadric(this->QuadricArray[binIds[i]].Quadric);
+      this->InitializeQuadric(bin.Quadric);
     }
-    if (this->QuadricArray[binIds[i]].Dimension == 1)
+    if (bin.Dimension == 1)
     { // Points supersede segments.
       this->AddQuadric(binIds[i], q);
     }
@@ -709,12 +846,13 @@ void vtkQuadricClustering::AddEdge(vtkIdType* binIds, double* pt0, double* pt1,
     for (int i = 0; i < 2; i++)
     {
       // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
+      PointQuadric& bin = (*this->QuadricMap)[binIds[i]];
+      if (bin.VertexId == -1)
       {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
+        bin.VertexId = this->NumberOfBinsUsed;
         this->NumberOfBinsUsed++;
       }
-      edgePtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      edgePtIds[i] = bin.VertexId;
     }
     // This comparison could just as well be on edgePtIds.
     if (binIds[0] != binIds[1])
@@ -810,13 +948,14 @@ void vtkQuadricClustering::AddVertex(
 
   // If the current quadric is from triangles, edges (or not initialized),
   // then clear it out.
-  if (this->QuadricArray[binId].Dimension > 0)
+  PointQuadric& bin = (*this->QuadricMap)[binId];
+  if (bin.Dimension > 0)
   {
-    this->QuadricArray[binId].Dimension = 0;
+    bin.Dimension = 0;
     // Initialize the coeff
-    this->InitializeQuadric(this->QuadricArray[binId].Quadric);
+    this->InitializeQuadric(bin.Quadric);
   }
-  if (this->QuadricArray[binId].Dimension == 0)
+  if (bin.Dimension == 0)
   { // Points supersede all other types of quadrics.
     this->AddQuadric(binId, q);
   }
@@ -825,9 +964,9 @@ void vtkQuadricClustering::AddVertex(
   {
     // Now add the vert to the geometry.
     // Get the vertex from the bin.
-    if (this->QuadricArray[binId].VertexId == -1)
+    if (bin.VertexId == -1)
     {
-      this->QuadricArray[binId].VertexId = this->NumberOfBinsUsed;
+      bin.VertexId = this->NumberOfBinsUsed;
       this->NumberOfBinsUsed++;
 
       if (this->CopyCellData && input)
@@ -842,7 +981,7 @@ void vtkQuadricClustering::AddVertex(
 //------------------------------------------------------------------------------
 void vtkQuadricClustering::AddQuadric(vtkIdType binId, double quadric[9])
 {
-  double* q = this->QuadricArray[binId].Quadric;
+  double* q = (*this->QuadricMap)[binId].Quadric;
 
   for (int i = 0; i < 9; i++)
   {
@@ -902,17 +1041,7 @@ void vtkQuadricClustering::EndAppend()
   }
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numBuckets;
-  bool abortExecute = false;
   vtkPoints* outputPoints;
-  double newPt[3];
-  numBuckets = this->NumberOfDivisions[0] * this->NumberOfDivisions[1] * this->NumberOfDivisions[2];
-  double step = (double)numBuckets / 10.0;
-  if (step < 1000.0)
-  {
-    step = 1000.0;
-  }
-  double cstep = 0;
 
   // Check for misuse of the Append methods.
   if (this->OutputTriangleArray == nullptr || this->OutputLines == nullptr)
@@ -928,25 +1057,41 @@ void vtkQuadricClustering::EndAppend()
     this->CellSet = nullptr;
   }
 
-  // Compute the representative points for each bin
-  outputPoints = vtkPoints::New();
-  for (vtkIdType i = 0; !abortExecute && i < numBuckets; i++)
+  // Compute the representative points for each visited bin with a vertex
+  std::vector<std::pair<vtkIdType, PointQuadric*>> bins;
+  bins.reserve(this->NumberOfBinsUsed);
+  for (auto& entry : *this->QuadricMap)
   {
-    if (cstep > step)
-    {
-      cstep = 0;
-      vtkDebugMacro(<< "Finding point in bin #" << i);
-      this->UpdateProgress(0.8 + 0.2 * i / numBuckets);
-      abortExecute = this->CheckAbort();
-    }
-    ++cstep;
-
-    if (this->QuadricArray[i].VertexId != -1)
+    if (entry.second.VertexId != -1)
     {
-      this->ComputeRepresentativePoint(this->QuadricArray[i].Quadric, i, newPt);
-      outputPoints->InsertPoint(this->QuadricArray[i].VertexId, newPt);
+      bins.emplace_back(entry.first, &entry.second);
     }
   }
+  outputPoints = vtkPoints::New();
+  outputPoints->SetNumberOfPoints(this->NumberOfBinsUsed);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(bins.size()),
+    [this, &bins, outputPoints](vtkIdType begin, vtkIdType end) {
+      double newPt[3];
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (i % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        this->ComputeRepresentativePoint(bins[i].second->Quadric, bins[i].first, newPt);
+        outputPoints->SetPoint(bins[i].second->VertexId, newPt);
+      }
+    });
+  this->UpdateProgress(1.0);
 
   // Set up the output data object.
   output->SetPoints(outputPoints);
@@ -972,9 +1117,9 @@ void vtkQuadricClustering::EndAppend()
   // (in case the user calls this method directly).
   output->DataHasBeenGenerated();
 
-  // Free the quadric array.
-  delete[] this->QuadricArray;
-  this->QuadricArray = nullptr;
+  // Free the quadric bins.
+  delete this->QuadricMap;
+  this->QuadricMap = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -1214,9 +1359,9 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData* input, vtkPolyData*
   vtkIdType outPtId;
   vtkPoints* inputPoints;
   vtkPoints* outputPoints;
-  vtkIdType numPoints, numBins;
+  vtkIdType numPoints;
   vtkIdType binId;
-  double *minError, e, pt[3];
+  double e, pt[3];
   double* q;
 
   inputPoints = input->GetPoints();
@@ -1244,13 +1389,8 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData* input, vtkPolyData*
   // Prepare to copy point data to output
   output->GetPointData()->CopyAllocate(input->GetPointData(), this->NumberOfBinsUsed);
 
-  // Allocate and initialize an array to hold errors for each bin.
-  numBins = this->NumberOfDivisions[0] * this->NumberOfDivisions[1] * this->NumberOfDivisions[2];
-  minError = new double[numBins];
-  for (vtkIdType i = 0; i < numBins; ++i)
-  {
-    minError[i] = VTK_DOUBLE_MAX;
-  }
+  // Allocate and initialize an array to hold errors for each output point.
+  std::vector<double> minError(this->NumberOfBinsUsed, VTK_DOUBLE_MAX);
 
   // Loop through the input points.
   numPoints = inputPoints->GetNumberOfPoints();
@@ -1258,7 +1398,8 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData* input, vtkPolyData*
   {
     inputPoints->GetPoint(i, pt);
     binId = this->HashPoint(pt);
-    outPtId = this->QuadricArray[binId].VertexId;
+    auto bin = this->QuadricMap->find(binId);
+    outPtId = bin != this->QuadricMap->end() ? bin->second.VertexId : -1;
     // Sanity check.
     if (outPtId == -1)
     {
@@ -1271,13 +1412,13 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData* input, vtkPolyData*
     // Compute the error for this point.  Note: the constant term is ignored.
     // It will be the same for every point in this bin, and it
     // is not stored in the quadric array anyway.
-    q = this->QuadricArray[binId].Quadric;
+    q = bin->second.Quadric;
     e = q[0] * pt[0] * pt[0] + 2.0 * q[1] * pt[0] * pt[1] + 2.0 * q[2] * pt[0] * pt[2] +
       2.0 * q[3] * pt[0] + q[4] * pt[1] * pt[1] + 2.0 * q[5] * pt[1] * pt[2] + 2.0 * q[6] * pt[1] +
       q[7] * pt[2] * pt[2] + 2.0 * q[8] * pt[2];
-    if (e < minError[binId])
+    if (e < minError[outPtId])
     {
-      minError[binId] = e;
+      minError[outPtId] = e;
       outputPoints->InsertPoint(outPtId, pt);
 
       // Since this is the same point as the input point, copy point data here too.
@@ -1300,10 +1441,8 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData* input, vtkPolyData*
 
   this->EndAppendVertexGeometry(input, output);
 
-  delete[] this->QuadricArray;
-  this->QuadricArray = nullptr;
-
-  delete[] minError;
+  delete this->QuadricMap;
+  this->QuadricMap = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -1337,11 +1476,12 @@ void vtkQuadricClustering::EndAppendVertexGeometry(vtkPolyData* input, vtkPolyDa
     {
       input->GetPoint(ptIds[j], pt);
       binId = this->HashPoint(pt);
-      outPtId = this->QuadricArray[binId].VertexId;
+      auto bin = this->QuadricMap->find(binId);
+      outPtId = bin != this->QuadricMap->end() ? bin->second.VertexId : -1;
       if (outPtId >= 0)
       {
         // Do not use this point.  Destroy information in Quadric array.
-        this->QuadricArray[binId].VertexId = -1;
+        bin->second.VertexId = -1;
         tmp[tmpIdx] = outPtId;
         ++tmpIdx;
       }
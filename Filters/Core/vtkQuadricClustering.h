@@ -47,6 +47,14 @@
  * manual control, it has the advantage that extremely large data can be
  * processed in pieces and appended to the filter piece-by-piece.
  *
+ * Only the bins visited by the input are stored, in a hash map, so that very
+ * fine divisions do not allocate memory for the whole grid of bins. The
+ * polygons of each piece are processed in parallel with vtkSMPTools: each
+ * thread accumulates quadrics in its own sparse set of bins, which are merged
+ * at the end. Output vertices and triangles are numbered as in a serial
+ * traversal of the polygons, so the output does not depend on the number of
+ * threads.
+ *
  * @warning
  * This filter can drastically affect topology, i.e., topology is not
  * preserved.
@@ -283,6 +291,14 @@ protected:
     vtkPolyData* input, vtkPolyData* output);
   ///@}
 
+  /**
+   * Add a triangle with the given output vertices to the output, unless its
+   * bins are not distinct or it is a duplicate. Cell data is copied from the
+   * input cell inCellId.
+   */
+  void InsertTriangle(const vtkIdType binIds[3], const vtkIdType triPtIds[3], vtkIdType inCellId,
+    vtkPolyData* input, vtkPolyData* output);
+
   ///@{
   /**
    * Add edges to the quadric array.  If geometry flag is on then
@@ -391,7 +407,9 @@ protected:
     double Quadric[9];
   };
 
-  PointQuadric* QuadricArray;
+  // PIMPLd stl map of the bins visited so far, indexed by bin id
+  class PointQuadricMap;
+  PointQuadricMap* QuadricMap;
   vtkIdType NumberOfBinsUsed;
 
   // Have to make these instance variables if we are going to allow
@@ -408,6 +426,8 @@ protected:
   int OutCellCount;
 
 private:
+  struct AddPolygonsFunctor;
+
   vtkQuadricClustering(const vtkQuadricClustering&) = delete;
   void operator=(const vtkQuadricClustering&) = delete;
 };
@@ -41,9 +41,53 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Temporaries of the cost computation of one thread, when collapsing edges
+// in batches.
+struct CostWorkspace
+{
+  std::vector<double> X;
+  std::vector<double> Quad;
+  std::vector<double> B;
+  std::vector<double> Data;
+  std::vector<double*> A;
+  std::vector<vtkIdType> Neighbors;
+  vtkSmartPointer<vtkIdList> CellIds;
+  vtkSmartPointer<vtkIdList> CellPointIds;
+
+  void Initialize(int quadSize, int size)
+  {
+    if (this->CellIds)
+    {
+      return;
+    }
+    this->X.resize(size);
+    this->Quad.resize(quadSize);
+    this->B.resize(size);
+    this->Data.resize(size * size);
+    this->A.resize(size);
+    for (int i = 0; i < size; i++)
+    {
+      this->A[i] = this->Data.data() + i * size;
+    }
+    this->CellIds = vtkSmartPointer<vtkIdList>::New();
+    this->CellPointIds = vtkSmartPointer<vtkIdList>::New();
+  }
+};
+}
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 //------------------------------------------------------------------------------
@@ -264,6 +308,12 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->Mesh->SetPoints(points);
   points->Delete();
   polys->DeepCopy(input->GetPolys());
+  if (this->BatchCollapse && !polys->IsStorageShareable())
+  {
+    // Batches are collapsed concurrently, which requires the cells to be
+    // accessed without copying their points.
+    polys->ConvertToDefaultStorage();
+  }
   this->Mesh->SetPolys(polys);
   polys->Delete();
   if (this->AttributeErrorMetric || this->MapPointData)
@@ -289,7 +339,8 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDebugMacro(<< "Computing Edges");
   this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
   this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
-  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+  // Batches find the edges of each point from the links instead
+  for (i = 0; !this->BatchCollapse && i < this->Mesh->GetNumberOfCells(); i++)
   {
     this->Mesh->GetCellPoints(i, npts, pts);
 
@@ -356,6 +407,12 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   // Okay collapse edges until desired reduction is reached
   this->ActualReduction = 0.0;
   this->NumberOfEdgeCollapses = 0;
+  if (this->BatchCollapse)
+  {
+    numDeletedTris = this->CollapseEdgeBatches(numTris);
+  }
+  // When collapsing batches, the queue is empty and the loop below is skipped
+  cost = 0.0;
   edgeId = this->EdgeCosts->Pop(0, cost);
 
   bool abort = false;
@@ -466,31 +523,81 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   vtkCellArray* polys;
   vtkIdType npts;
   const vtkIdType* pts = nullptr;
-  double point0[3], point1[3], point2[3];
-  double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
-  double data[16];
-  double *A[4], x[4];
-  int index[4];
-  A[0] = data;
-  A[1] = data + 4;
-  A[2] = data + 8;
-  A[3] = data + 12;
+  double n[3], d, triArea2;
+  const int quadSize = 11 + 4 * this->NumberOfComponents;
 
-  double regularizationVariance = 0.0;
-  if (this->Regularize)
+  // add the weighted QEM of a face to one of its points
+  auto addFaceQuadric = [this, quadSize](vtkIdType pointId, const double* faceQEM,
+                          const double normal[3], double offset, double area) {
+    for (int k = 0; k < quadSize; k++)
+    {
+      this->ErrorQuadrics[pointId].Quadric[k] += faceQEM[k] * area;
+    }
+
+    // Set volume constraint values g_vol and d_vol
+    if (this->VolumePreservation)
+    {
+      // Vector g_vol
+      for (int k = 0; k < 3; k++)
+      {
+        this->VolumeConstraints[pointId * 4 + k] +=
+          normal[k] * area * 2.0; // triangle normal with length triArea * 2
+      }
+      // Scalar d_vol
+      this->VolumeConstraints[pointId * 4 + 3] +=
+        -offset * area * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
+    }
+  };
+
+  if (this->BatchCollapse)
   {
-    regularizationVariance = std::pow(this->Regularization, 2);
+    // Gather the QEM of the faces using each point, so that each point is
+    // only written by one thread. Faces are evaluated once per point.
+    vtkSMPThreadLocal<std::vector<double>> localQEM;
+    vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> localCellPointIds;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<double>& faceQEM = localQEM.Local();
+      faceQEM.resize(quadSize);
+      vtkSmartPointer<vtkIdList>& cellPointIds = localCellPointIds.Local();
+      if (!cellPointIds)
+      {
+        cellPointIds = vtkSmartPointer<vtkIdList>::New();
+      }
+      double normal[3], offset, area;
+      for (vtkIdType pointId = begin; pointId < end; pointId++)
+      {
+        this->ErrorQuadrics[pointId].Quadric = new double[quadSize];
+        std::fill_n(this->ErrorQuadrics[pointId].Quadric, quadSize, 0.0);
+
+        vtkIdType ncells, *cells;
+        input->GetPointCells(pointId, ncells, cells);
+        for (vtkIdType k = 0; k < ncells; k++)
+        {
+          vtkIdType nfacePts;
+          const vtkIdType* facePts;
+          input->GetCellPoints(cells[k], nfacePts, facePts, cellPointIds);
+          area = this->ComputeTriangleQuadric(facePts, faceQEM.data(), normal, offset);
+          for (vtkIdType l = 0; l < nfacePts; l++)
+          {
+            if (facePts[l] == pointId)
+            {
+              addFaceQuadric(pointId, faceQEM.data(), normal, offset, area);
+            }
+          }
+        }
+      }
+    });
+    return;
   }
 
   // allocate local QEM sparse matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
+  QEM = new double[quadSize];
 
   // clear and allocate global QEM array
   for (ptId = 0; ptId < numPts; ptId++)
   {
-    this->ErrorQuadrics[ptId].Quadric = new double[11 + 4 * this->NumberOfComponents];
-    for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
+    this->ErrorQuadrics[ptId].Quadric = new double[quadSize];
+    for (i = 0; i < quadSize; i++)
     {
       this->ErrorQuadrics[ptId].Quadric[i] = 0.0;
     }
@@ -500,184 +607,194 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   // compute the QEM for each face
   for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
   {
-    input->GetPoint(pts[0], point0);
-    input->GetPoint(pts[1], point1);
-    input->GetPoint(pts[2], point2);
-    for (i = 0; i < 3; i++)
+    triArea2 = this->ComputeTriangleQuadric(pts, QEM, n, d);
+
+    // add the QEM to all points of the face
+    for (j = 0; j < 3; j++)
     {
-      tempP1[i] = point1[i] - point0[i];
-      tempP2[i] = point2[i] - point0[i];
+      addFaceQuadric(pts[j], QEM, n, d, triArea2);
     }
-    vtkMath::Cross(tempP1, tempP2, n);
-    triArea2 = vtkMath::Normalize(n);
-    // triArea2 = (triArea2 * triArea2 * 0.25);
-    triArea2 = triArea2 * 0.5;
-    // I am unsure whether this should be squared or not??
-    d = -vtkMath::Dot(n, point0);
-    // could possible add in angle weights??
-
-    // set the geometric part of the QEM
-    QEM[0] = n[0] * n[0];
-    QEM[1] = n[0] * n[1];
-    QEM[2] = n[0] * n[2];
-    QEM[3] = d * n[0];
+  } // for all triangles
 
-    QEM[4] = n[1] * n[1];
-    QEM[5] = n[1] * n[2];
-    QEM[6] = d * n[1];
+  delete[] QEM;
+}
 
-    QEM[7] = n[2] * n[2];
-    QEM[8] = d * n[2];
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeTriangleQuadric(
+  const vtkIdType* pts, double* QEM, double n[3], double& d)
+{
+  vtkPolyData* input = this->Mesh;
+  int i;
+  double point0[3], point1[3], point2[3];
+  double tempP1[3], tempP2[3], triArea2;
+  double data[16];
+  double *A[4], x[4];
+  int index[4];
+  A[0] = data;
+  A[1] = data + 4;
+  A[2] = data + 8;
+  A[3] = data + 12;
 
-    QEM[9] = d * d;
-    QEM[10] = 1;
+  double regularizationVariance = 0.0;
+  if (this->Regularize)
+  {
+    regularizationVariance = std::pow(this->Regularization, 2);
+  }
 
-    if (this->Regularize)
-    {
-      // Add in some regularizing identity \Sigma_n
-      QEM[0] += regularizationVariance;
-      QEM[4] += regularizationVariance;
-      QEM[7] += regularizationVariance;
+  input->GetPoint(pts[0], point0);
+  input->GetPoint(pts[1], point1);
+  input->GetPoint(pts[2], point2);
+  for (i = 0; i < 3; i++)
+  {
+    tempP1[i] = point1[i] - point0[i];
+    tempP2[i] = point2[i] - point0[i];
+  }
+  vtkMath::Cross(tempP1, tempP2, n);
+  triArea2 = vtkMath::Normalize(n);
+  // triArea2 = (triArea2 * triArea2 * 0.25);
+  triArea2 = triArea2 * 0.5;
+  // I am unsure whether this should be squared or not??
+  d = -vtkMath::Dot(n, point0);
+  // could possible add in angle weights??
+
+  // set the geometric part of the QEM
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+  QEM[10] = 1;
 
-      // -\Sigma_n . q
-      QEM[3] -= regularizationVariance * point0[0];
-      QEM[6] -= regularizationVariance * point0[1];
-      QEM[8] -= regularizationVariance * point0[2];
+  if (this->Regularize)
+  {
+    // Add in some regularizing identity \Sigma_n
+    QEM[0] += regularizationVariance;
+    QEM[4] += regularizationVariance;
+    QEM[7] += regularizationVariance;
+
+    // -\Sigma_n . q
+    QEM[3] -= regularizationVariance * point0[0];
+    QEM[6] -= regularizationVariance * point0[1];
+    QEM[8] -= regularizationVariance * point0[2];
+
+    // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
+    QEM[9] +=
+      regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
+  }
 
-      // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
-      QEM[9] +=
-        regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
+  if (this->AttributeErrorMetric)
+  {
+    for (i = 0; i < 3; i++)
+    {
+      A[0][i] = point0[i];
+      A[1][i] = point1[i];
+      A[2][i] = point2[i];
+      A[3][i] = n[i];
     }
+    A[0][3] = A[1][3] = A[2][3] = 1;
+    A[3][3] = 0;
 
-    if (this->AttributeErrorMetric)
+    // should handle poorly condition matrix better
+    if (vtkMath::LUFactorLinearSystem(A, index, 4))
     {
-      for (i = 0; i < 3; i++)
-      {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
-      }
-      A[0][3] = A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
-
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
+      for (i = 0; i < this->NumberOfComponents; i++)
       {
-        for (i = 0; i < this->NumberOfComponents; i++)
+        x[3] = 0;
+        if (i < this->AttributeComponents[0])
         {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-          {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
-              this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
-              this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
-              this->AttributeScale[0];
-          }
-          else if (i < this->AttributeComponents[1])
-          {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-          }
-          else if (i < this->AttributeComponents[2])
-          {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[0], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[1], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[2], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-          }
-          else if (i < this->AttributeComponents[3])
-          {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[0], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[1], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[2], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-          }
-          else if (i < this->AttributeComponents[4])
-          {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-          }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
+          x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
+            this->AttributeScale[0];
+          x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
+            this->AttributeScale[0];
+          x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
+            this->AttributeScale[0];
+        }
+        else if (i < this->AttributeComponents[1])
+        {
+          x[0] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[0], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+          x[1] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[1], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+          x[2] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[2], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+        }
+        else if (i < this->AttributeComponents[2])
+        {
+          x[0] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[0], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+          x[1] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[1], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+          x[2] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[2], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+        }
+        else if (i < this->AttributeComponents[3])
+        {
+          x[0] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[0], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+          x[1] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[1], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+          x[2] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[2], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+        }
+        else if (i < this->AttributeComponents[4])
+        {
+          x[0] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[0], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+          x[1] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[1], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+          x[2] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[2], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+        }
+        vtkMath::LUSolveLinearSystem(A, index, x, 4);
 
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[3] * x[0];
+        // add in the contribution of this element into the QEM
+        QEM[0] += x[0] * x[0];
+        QEM[1] += x[0] * x[1];
+        QEM[2] += x[0] * x[2];
+        QEM[3] += x[3] * x[0];
 
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[3] * x[1];
+        QEM[4] += x[1] * x[1];
+        QEM[5] += x[1] * x[2];
+        QEM[6] += x[3] * x[1];
 
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[3] * x[2];
+        QEM[7] += x[2] * x[2];
+        QEM[8] += x[3] * x[2];
 
-          QEM[9] += x[3] * x[3];
+        QEM[9] += x[3] * x[3];
 
-          QEM[11 + i * 4] = -x[0];
-          QEM[12 + i * 4] = -x[1];
-          QEM[13 + i * 4] = -x[2];
-          QEM[14 + i * 4] = -x[3];
-        }
-      }
-      else
-      {
-        vtkErrorMacro(<< "Unable to factor attribute matrix!");
+        QEM[11 + i * 4] = -x[0];
+        QEM[12 + i * 4] = -x[1];
+        QEM[13 + i * 4] = -x[2];
+        QEM[14 + i * 4] = -x[3];
       }
     }
-
-    // add the QEM to all points of the face
-    for (i = 0; i < 3; i++)
+    else
     {
-      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
-      {
-        this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
-      }
-
-      // Set volume constraint values g_vol and d_vol
-      if (this->VolumePreservation)
-      {
-        // Vector g_vol
-        for (j = 0; j < 3; j++)
-        {
-          this->VolumeConstraints[pts[i] * 4 + j] +=
-            n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
-        }
-        // Scalar d_vol
-        this->VolumeConstraints[pts[i] * 4 + 3] +=
-          -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
-      }
+      vtkErrorMacro(<< "Unable to factor attribute matrix!");
     }
-  } // for all triangles
+  }
 
-  delete[] QEM;
+  return triArea2;
 }
 
 void vtkQuadricDecimation::AddBoundaryConstraints()
@@ -695,14 +812,56 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   // allocate local QEM space matrix
   QEM = new double[11 + 4 * this->NumberOfComponents];
 
+  // When collapsing batches, look for the boundary edges in parallel first,
+  // one bit per edge of each cell.
+  std::vector<unsigned char> boundaryEdges;
+  if (this->BatchCollapse)
+  {
+    boundaryEdges.resize(input->GetNumberOfCells());
+    vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> localCellIds;
+    vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> localCellPointIds;
+    vtkSMPTools::For(0, input->GetNumberOfCells(), [&](vtkIdType begin, vtkIdType end) {
+      vtkSmartPointer<vtkIdList>& neighbors = localCellIds.Local();
+      vtkSmartPointer<vtkIdList>& cellPointIds = localCellPointIds.Local();
+      if (!neighbors)
+      {
+        neighbors = vtkSmartPointer<vtkIdList>::New();
+        cellPointIds = vtkSmartPointer<vtkIdList>::New();
+      }
+      vtkIdType ncellPts;
+      const vtkIdType* cellPts;
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        input->GetCellPoints(id, ncellPts, cellPts, cellPointIds);
+        for (int k = 0; k < 3; k++)
+        {
+          input->GetCellEdgeNeighbors(id, cellPts[k], cellPts[(k + 1) % 3], neighbors);
+          if (neighbors->GetNumberOfIds() == 0)
+          {
+            boundaryEdges[id] |= 1 << k;
+          }
+        }
+      }
+    });
+  }
+
   for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
   {
     input->GetCellPoints(cellId, npts, pts);
 
     for (i = 0; i < 3; i++)
     {
-      input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
-      if (cellIds->GetNumberOfIds() == 0)
+      bool boundary;
+      if (this->BatchCollapse)
+      {
+        boundary = (boundaryEdges[cellId] & (1 << i)) != 0;
+      }
+      else
+      {
+        input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
+        boundary = cellIds->GetNumberOfIds() == 0;
+      }
+      if (boundary)
       {
         // this is a boundary
         input->GetPoint(pts[(i + 2) % 3], t0);
@@ -932,10 +1091,17 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
+{
+  const vtkIdType pointIds[2] = { this->EndPoint1List->GetId(edgeId),
+    this->EndPoint2List->GetId(edgeId) };
+  return this->ComputeCost(pointIds, x, this->TempQuad);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(const vtkIdType pointIds[2], double* x, double* quad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
-  vtkIdType pointIds[2];
   double cost = 0.0;
   double* index;
   int i, j;
@@ -943,25 +1109,22 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
   double v[3], c, norm, normTemp, temp2[3];
   double pt1[3], pt2[3];
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
-
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -1013,7 +1176,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = quad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++) * newPoint[i] * newPoint[i];
@@ -1028,44 +1191,49 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
+{
+  const vtkIdType pointIds[2] = { this->EndPoint1List->GetId(edgeId),
+    this->EndPoint2List->GetId(edgeId) };
+  return this->ComputeCost2(pointIds, x, this->TempQuad, this->TempA, this->TempB);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(
+  const vtkIdType pointIds[2], double* x, double* quad, double** A, double* b)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
   // neither was multiplication and some other matrix and vector primitives
   static const double errorNumber = 1e-10;
-  vtkIdType pointIds[2];
   double cost = 0.0;
   int i, j;
   int solveOk;
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
-
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  // copy the temp quad into TempA
+  // copy the temp quad into A
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
-    this->TempB[i] = -this->TempQuad[11 + 4 * (i - 3) + 3];
+    A[0][i] = A[i][0] = quad[11 + 4 * (i - 3)];
+    A[1][i] = A[i][1] = quad[11 + 4 * (i - 3) + 1];
+    A[2][i] = A[i][2] = quad[11 + 4 * (i - 3) + 2];
+    b[i] = -quad[11 + 4 * (i - 3) + 3];
   }
 
   // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
@@ -1075,11 +1243,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1090,48 +1258,48 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        A[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
+    b[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
+    b[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = b[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
   solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+    A, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
+    A[0][i] = A[i][0] = quad[11 + 4 * (i - 3)];
+    A[1][i] = A[i][1] = quad[11 + 4 * (i - 3) + 1];
+    A[2][i] = A[i][2] = quad[11 + 4 * (i - 3) + 2];
   }
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
@@ -1140,11 +1308,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1155,16 +1323,16 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        A[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
@@ -1198,7 +1366,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j] * v[j];
+        temp2[i] += A[i][j] * v[j];
       }
     }
 
@@ -1216,13 +1384,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j] * pt1[j];
+          temp[i] += A[i][j] * pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = b[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1256,33 +1424,39 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i] * x[i] * x[i];
+    cost += A[i][i] * x[i] * x[i];
     for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
+      cost += 2.0 * A[i][j] * x[i] * x[j];
     }
   }
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -= 2.0 * this->TempB[i] * x[i];
+    cost -= 2.0 * b[i] * x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += quad[9];
 
   return cost;
 }
 
 int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
+{
+  return this->CollapseEdge(pt0Id, pt1Id, this->CollapseCellIds);
+}
+
+//------------------------------------------------------------------------------
+int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdList* cellIds)
 {
   int j, numDeleted = 0;
   vtkIdType i, cellId;
   vtkIdType npts;
   const vtkIdType* pts;
 
-  this->Mesh->GetPointCells(pt0Id, this->CollapseCellIds);
-  for (i = 0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt0Id, cellIds);
+  for (i = 0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     for (j = 0; j < 3; j++)
     {
@@ -1295,11 +1469,11 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
     }
   }
 
-  this->Mesh->GetPointCells(pt1Id, this->CollapseCellIds);
-  this->Mesh->ResizeCellList(pt0Id, this->CollapseCellIds->GetNumberOfIds());
-  for (i = 0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt1Id, cellIds);
+  this->Mesh->ResizeCellList(pt0Id, cellIds->GetNumberOfIds());
+  for (i = 0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     // making sure we don't already have the triangle we're about to
     // change this one to
@@ -1322,6 +1496,172 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
   return numDeleted;
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::CollapseEdgeBatches(vtkIdType numTris)
+{
+  vtkPolyData* mesh = this->Mesh;
+  const vtkIdType numPts = mesh->GetNumberOfPoints();
+  const int quadSize = 11 + 4 * this->NumberOfComponents;
+  const int size = 3 + this->NumberOfComponents + this->VolumePreservation;
+  const vtkIdType numTargetTris =
+    static_cast<vtkIdType>(std::ceil(this->TargetReduction * numTris));
+  vtkIdType numDeletedTris = 0;
+
+  // For each point, the cost of its cheapest collapse and the other end
+  // point of the edge, or -1.
+  std::vector<double> costs(numPts);
+  std::vector<vtkIdType> partners(numPts);
+  std::vector<vtkIdType> candidates;
+  std::vector<vtkIdType> batch;
+  std::vector<unsigned char> locked(numPts);
+  vtkSMPThreadLocal<CostWorkspace> workspaces;
+
+  auto computeCost = [this](const vtkIdType pointIds[2], CostWorkspace& workspace) -> double {
+    if (this->AttributeErrorMetric)
+    {
+      return this->ComputeCost2(pointIds, workspace.X.data(), workspace.Quad.data(),
+        workspace.A.data(), workspace.B.data());
+    }
+    return this->ComputeCost(pointIds, workspace.X.data(), workspace.Quad.data());
+  };
+
+  // Lock the points of the cells using either end point of an edge, unless
+  // one of them already is.
+  vtkIdList* cellPointIds = vtkIdList::New();
+  auto lockNeighborhood = [&](vtkIdType pt0Id, vtkIdType pt1Id) -> bool {
+    const vtkIdType endPtIds[2] = { pt0Id, pt1Id };
+    for (int pass = 0; pass < 2; pass++)
+    {
+      for (vtkIdType endPtId : endPtIds)
+      {
+        vtkIdType ncells, *cells;
+        mesh->GetPointCells(endPtId, ncells, cells);
+        for (vtkIdType i = 0; i < ncells; i++)
+        {
+          vtkIdType npts;
+          const vtkIdType* pts;
+          mesh->GetCellPoints(cells[i], npts, pts, cellPointIds);
+          for (vtkIdType j = 0; j < npts; j++)
+          {
+            if (pass == 0 && locked[pts[j]])
+            {
+              return false;
+            }
+            if (pass == 1)
+            {
+              locked[pts[j]] = 1;
+            }
+          }
+        }
+      }
+    }
+    return true;
+  };
+
+  bool abort = false;
+  while (!abort && numDeletedTris < numTargetTris)
+  {
+    // Each point proposes its cheapest collapse which does not flip a triangle
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      CostWorkspace& workspace = workspaces.Local();
+      workspace.Initialize(quadSize, size);
+      for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+        costs[ptId] = VTK_DOUBLE_MAX;
+        partners[ptId] = -1;
+        workspace.Neighbors.clear();
+        vtkIdType ncells, *cells;
+        mesh->GetPointCells(ptId, ncells, cells);
+        for (vtkIdType i = 0; i < ncells; i++)
+        {
+          vtkIdType npts;
+          const vtkIdType* pts;
+          mesh->GetCellPoints(cells[i], npts, pts, workspace.CellPointIds);
+          for (vtkIdType j = 0; j < npts; j++)
+          {
+            if (pts[j] == ptId ||
+              std::find(workspace.Neighbors.begin(), workspace.Neighbors.end(), pts[j]) !=
+                workspace.Neighbors.end())
+            {
+              continue;
+            }
+            workspace.Neighbors.push_back(pts[j]);
+            const vtkIdType pointIds[2] = { ptId, pts[j] };
+            const double cost = computeCost(pointIds, workspace);
+            if (cost < costs[ptId] && this->IsGoodPlacement(ptId, pts[j], workspace.X.data()))
+            {
+              costs[ptId] = cost;
+              partners[ptId] = pts[j];
+            }
+          }
+        }
+      }
+    });
+
+    candidates.clear();
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+      if (partners[ptId] >= 0)
+      {
+        candidates.push_back(ptId);
+      }
+    }
+    if (candidates.empty())
+    {
+      break;
+    }
+    vtkSMPTools::Sort(candidates.begin(), candidates.end(), [&costs](vtkIdType a, vtkIdType b) {
+      return costs[a] < costs[b] || (costs[a] == costs[b] && a < b);
+    });
+
+    // Pick, cheapest first, collapses whose neighborhoods do not overlap, so
+    // that they can be done concurrently. Only the cheapest half of the
+    // proposals is considered, so that, like with the priority queue, costly
+    // collapses wait for the cheap ones around them. An interior collapse
+    // deletes two triangles.
+    std::fill(locked.begin(), locked.end(), 0);
+    batch.clear();
+    const size_t maxBatchSize =
+      static_cast<size_t>(std::max<vtkIdType>((numTargetTris - numDeletedTris + 1) / 2, 1));
+    const size_t numConsidered = (candidates.size() + 1) / 2;
+    for (size_t i = 0; i < numConsidered && batch.size() < maxBatchSize; i++)
+    {
+      if (lockNeighborhood(candidates[i], partners[candidates[i]]))
+      {
+        batch.push_back(candidates[i]);
+      }
+    }
+
+    std::atomic<vtkIdType> numDeleted(0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(batch.size()), [&](vtkIdType begin, vtkIdType end) {
+      CostWorkspace& workspace = workspaces.Local();
+      workspace.Initialize(quadSize, size);
+      vtkIdType deleted = 0;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        vtkIdType endPtIds[2] = { batch[i], partners[batch[i]] };
+        computeCost(endPtIds, workspace);
+        this->SetPointAttributeArray(endPtIds, workspace.X.data());
+        this->AddQuadric(endPtIds[1], endPtIds[0]);
+        deleted += this->CollapseEdge(endPtIds[0], endPtIds[1], workspace.CellIds);
+      }
+      // memory_order_relaxed is safe here, since we're not using the atomics for synchronization.
+      numDeleted.fetch_add(deleted, std::memory_order_relaxed);
+    });
+
+    numDeletedTris += numDeleted.load();
+    this->NumberOfEdgeCollapses += static_cast<int>(batch.size());
+    this->ActualReduction = static_cast<double>(numDeletedTris) / numTris;
+    vtkDebugMacro(<< "Collapsed " << batch.size() << " edges out of " << candidates.size()
+                  << " candidates");
+    this->UpdateProgress(0.20 + 0.80 * this->ActualReduction / this->TargetReduction);
+    abort = this->CheckAbort();
+  }
+  cellPointIds->Delete();
+
+  return numDeletedTris;
+}
+
 // triangle t0, t1, t2 and point x
 // determines if t0 and x are on the same side of the plane defined by
 // t1 and t2, and parallel to the normal of the triangle
@@ -1548,5 +1888,6 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Batch Collapse: " << (this->BatchCollapse ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -36,6 +36,13 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * When BatchCollapse is on, the quadrics and the edge costs are computed in
+ * parallel and the edges are collapsed in rounds instead of one at a time
+ * from the priority queue: each round, every vertex proposes its cheapest
+ * collapse, and a set of the cheapest proposals whose neighborhoods do not
+ * overlap is collapsed concurrently with vtkSMPTools. The result is close to,
+ * but not the same as, the one of the serial algorithm.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -186,6 +193,19 @@ public:
   vtkGetMacro(TensorsWeight, double);
   ///@}
 
+  ///@{
+  /**
+   * Collapse independent sets of edges in parallel rounds rather than one
+   * edge at a time in order of cost (see the class description). This is
+   * much faster on multicore machines for large meshes, but the order of
+   * the collapses differs from the serial one, and so does the output.
+   * Off by default.
+   */
+  vtkSetMacro(BatchCollapse, bool);
+  vtkGetMacro(BatchCollapse, bool);
+  vtkBooleanMacro(BatchCollapse, bool);
+  ///@}
+
   ///@{
   /**
    * Get the actual reduction. This value is only valid after the
@@ -206,11 +226,30 @@ protected:
    */
   int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id);
 
+  /**
+   * Same as above, using the given list to hold the cells of the points so
+   * that independent edges can be collapsed concurrently.
+   */
+  int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdList* cellIds);
+
+  /**
+   * Collapse edges in rounds of independent edges until the desired
+   * reduction is reached, when BatchCollapse is on; return the number of
+   * triangles deleted.
+   */
+  vtkIdType CollapseEdgeBatches(vtkIdType numTris);
+
   /**
    * Compute quadric for all vertices
    */
   void InitializeQuadrics(vtkIdType numPts);
 
+  /**
+   * Compute the quadric of a triangle of the mesh, along with its unit normal
+   * and the offset of its plane, and return half its area.
+   */
+  double ComputeTriangleQuadric(const vtkIdType* pts, double* QEM, double n[3], double& d);
+
   /**
    * Free boundary edges are weighted
    */
@@ -236,6 +275,17 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double* x);
   ///@}
 
+  ///@{
+  /**
+   * Same as above for the edge between the two given points, using the given
+   * temporary buffers instead of TempQuad, TempA and TempB, so that costs can
+   * be computed concurrently.
+   */
+  double ComputeCost(const vtkIdType pointIds[2], double* x, double* quad);
+  double ComputeCost2(
+    const vtkIdType pointIds[2], double* x, double* quad, double** A, double* b);
+  ///@}
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -279,6 +329,7 @@ protected:
   vtkTypeBool VolumePreservation;
 
   bool MapPointData = false;
+  bool BatchCollapse = false;
 
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the packet traversal of vtkModifiedBSPTree and vtkOBBTree returns the same first
+// intersections as intersecting the segments one at a time.
+
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkOBBTree.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool TestLocator(vtkAbstractCellLocator* locator, vtkPoints* p1s, vtkPoints* p2s)
+{
+  const double tol = 1e-8;
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkPoints> x;
+  x->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> t;
+  locator->IntersectWithLines(p1s, p2s, tol, cellIds, x, t);
+  if (cellIds->GetNumberOfIds() != p1s->GetNumberOfPoints())
+  {
+    std::cerr << locator->GetClassName() << ": wrong number of results\n";
+    return false;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType numberOfHits = 0;
+  for (vtkIdType i = 0; i < p1s->GetNumberOfPoints(); ++i)
+  {
+    double p1[3], p2[3], lineT, lineX[3], pcoords[3];
+    int subId;
+    vtkIdType cellId = -1;
+    p1s->GetPoint(i, p1);
+    p2s->GetPoint(i, p2);
+    if (!locator->IntersectWithLine(p1, p2, tol, lineT, lineX, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (cellIds->GetId(i) != cellId)
+    {
+      std::cerr << locator->GetClassName() << ": segment " << i << " hits cell "
+                << cellIds->GetId(i) << " instead of " << cellId << "\n";
+      return false;
+    }
+    if (cellId < 0)
+    {
+      continue;
+    }
+    ++numberOfHits;
+    double batchedX[3];
+    x->GetPoint(i, batchedX);
+    if (std::abs(t->GetValue(i) - lineT) > 1e-12 ||
+      std::sqrt(vtkMath::Distance2BetweenPoints(batchedX, lineX)) > 1e-12)
+    {
+      std::cerr << locator->GetClassName() << ": wrong intersection for segment " << i << "\n";
+      return false;
+    }
+  }
+  // Every segment starting inside the sphere hits it.
+  if (numberOfHits < p1s->GetNumberOfPoints() / 2)
+  {
+    std::cerr << locator->GetClassName() << ": only " << numberOfHits << " hits\n";
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestBatchedRayIntersections(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(100);
+  sphere->SetRadius(1.0);
+  sphere->Update();
+
+  // Segments leaving the sphere from inside, and segments crossing the sphere from around it,
+  // the last ones being too few to fill a whole packet.
+  const vtkIdType numberOfLines = 20003;
+  vtkNew<vtkPoints> p1s;
+  vtkNew<vtkPoints> p2s;
+  p1s->SetDataTypeToDouble();
+  p2s->SetDataTypeToDouble();
+  p1s->SetNumberOfPoints(numberOfLines);
+  p2s->SetNumberOfPoints(numberOfLines);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> coordinate(-0.5, 0.5);
+  std::uniform_real_distribution<double> direction(-1.0, 1.0);
+  for (vtkIdType i = 0; i < numberOfLines; ++i)
+  {
+    double p1[3], p2[3], d[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      d[j] = direction(generator);
+    }
+    vtkMath::Normalize(d);
+    for (int j = 0; j < 3; ++j)
+    {
+      p1[j] = i % 2 ? coordinate(generator) : 4.0 * coordinate(generator);
+      p2[j] = i % 2 ? p1[j] + 3.0 * d[j] : -p1[j] + 0.5 * d[j];
+    }
+    p1s->SetPoint(i, p1);
+    p2s->SetPoint(i, p2);
+  }
+
+  bool success = true;
+  vtkNew<vtkModifiedBSPTree> bspTree;
+  bspTree->SetDataSet(sphere->GetOutput());
+  success = TestLocator(bspTree, p1s, p2s) && success;
+
+  vtkNew<vtkOBBTree> obbTree;
+  obbTree->SetDataSet(sphere->GetOutput());
+  success = TestLocator(obbTree, p1s, p2s) && success;
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
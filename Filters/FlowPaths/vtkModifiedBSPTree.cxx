@@ -6,14 +6,19 @@
 #include "vtkAppendPolyData.h"
 #include "vtkBox.h"
 #include "vtkCubeSource.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <array>
+#include <cfloat>
+#include <cmath>
 #include <stack>
 #include <vector>
 
@@ -750,6 +755,252 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
   return 0;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Number of segments traversing the tree together in IntersectWithLines.
+constexpr int RayPacketSize = 8;
+
+// A packet of segments, with the coordinates stored per axis so that the tests of all the
+// segments against a box are vectorized by the compiler.
+struct RayPacket
+{
+  int Size = 0;
+  vtkIdType LineIds[RayPacketSize];
+  double P1[RayPacketSize][3];
+  double P2[RayPacketSize][3];
+  double Direction[RayPacketSize][3];
+  double Origins[3][RayPacketSize];
+  double InverseDirections[3][RayPacketSize];
+  double TBest[RayPacketSize];
+
+  // Add the segment lineId to the packet.
+  void Add(vtkIdType lineId, const double p1[3], const double p2[3])
+  {
+    const int lane = this->Size++;
+    this->LineIds[lane] = lineId;
+    for (int i = 0; i < 3; ++i)
+    {
+      this->P1[lane][i] = p1[i];
+      this->P2[lane][i] = p2[i];
+      this->Direction[lane][i] = p2[i] - p1[i];
+      this->Origins[i][lane] = p1[i];
+      // Directions parallel to an axis get a huge finite inverse, so that the slab test below
+      // never multiplies zero by infinity.
+      this->InverseDirections[i][lane] = std::abs(this->Direction[lane][i]) > 1e-300
+        ? 1.0 / this->Direction[lane][i]
+        : VTK_DOUBLE_MAX;
+    }
+    this->TBest[lane] = VTK_DOUBLE_MAX;
+  }
+
+  // Complete a partial packet by repeating its first segment, so that all the lanes are valid.
+  void Pad()
+  {
+    for (int lane = this->Size; lane < RayPacketSize; ++lane)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Origins[i][lane] = this->Origins[i][0];
+        this->InverseDirections[i][lane] = this->InverseDirections[i][0];
+      }
+      this->TBest[lane] = VTK_DOUBLE_MAX;
+    }
+  }
+
+  // Return the mask of the segments of mask crossing the bounds enlarged by pad before the
+  // closest intersection found so far along them.
+  unsigned int IntersectBounds(const double bounds[6], double pad, unsigned int mask) const
+  {
+    double tNear[RayPacketSize], tFar[RayPacketSize];
+    for (int lane = 0; lane < RayPacketSize; ++lane)
+    {
+      tNear[lane] = 0.0;
+      tFar[lane] = std::min(1.0, this->TBest[lane]);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      const double low = bounds[2 * i] - pad;
+      const double high = bounds[2 * i + 1] + pad;
+      for (int lane = 0; lane < RayPacketSize; ++lane)
+      {
+        const double t0 = (low - this->Origins[i][lane]) * this->InverseDirections[i][lane];
+        const double t1 = (high - this->Origins[i][lane]) * this->InverseDirections[i][lane];
+        tNear[lane] = std::max(tNear[lane], std::min(t0, t1));
+        tFar[lane] = std::min(tFar[lane], std::max(t0, t1));
+      }
+    }
+    unsigned int hits = 0;
+    for (int lane = 0; lane < RayPacketSize; ++lane)
+    {
+      hits |= static_cast<unsigned int>(tNear[lane] <= tFar[lane]) << lane;
+    }
+    return hits & mask;
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+void vtkModifiedBSPTree::IntersectWithLines(
+  vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds, vtkPoints* x, vtkDoubleArray* t)
+{
+  if (!p1s || !p2s || !cellIds || !this->DataSet)
+  {
+    vtkErrorMacro(<< "IntersectWithLines needs segment end points, a cell id list and a data set");
+    return;
+  }
+  const vtkIdType numberOfLines = p1s->GetNumberOfPoints();
+  if (p2s->GetNumberOfPoints() != numberOfLines)
+  {
+    vtkErrorMacro(<< "The segments must have as many start points as end points");
+    return;
+  }
+  this->BuildLocator();
+
+  cellIds->SetNumberOfIds(numberOfLines);
+  if (x)
+  {
+    x->SetNumberOfPoints(numberOfLines);
+  }
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numberOfLines);
+  }
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* tPtr = t ? t->GetPointer(0) : nullptr;
+  if (this->mRoot == nullptr)
+  {
+    std::fill_n(cellIdsPtr, numberOfLines, -1);
+    return;
+  }
+
+  std::vector<vtkIdType> order;
+  this->ComputeQueryOrder(p1s, order);
+
+  // The boxes are enlarged enough to keep every cell accepted by vtkBox::IntersectBox, which pads
+  // flat cell bounds by the tolerance and accepts points within the tolerance of the bounds.
+  const double* rootBounds = this->mRoot->Bounds;
+  double diagonal2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double length = rootBounds[2 * i + 1] - rootBounds[2 * i];
+    diagonal2 += length * length;
+  }
+  const double pad = 2.0 * (tol <= 0 ? FLT_EPSILON : tol) + 1e-9 * std::sqrt(diagonal2);
+  const vtkIdType numberOfPackets = (numberOfLines + RayPacketSize - 1) / RayPacketSize;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  auto intersectPackets = [&](vtkIdType beginPacket, vtkIdType endPacket)
+  {
+    vtkGenericCell* cell = localCell.Local();
+    std::vector<std::pair<BSPNode*, unsigned int>> stack;
+    RayPacket packet;
+    double xBest[RayPacketSize][3];
+    vtkIdType cellIdBest[RayPacketSize];
+    double cellBounds[6], hitCellBoundsPosition[3], tHitCell, lineT, lineX[3], pcoords[3];
+    int subId;
+    for (vtkIdType packetId = beginPacket; packetId < endPacket; ++packetId)
+    {
+      packet.Size = 0;
+      const vtkIdType end = std::min((packetId + 1) * RayPacketSize, numberOfLines);
+      for (vtkIdType i = packetId * RayPacketSize; i < end; ++i)
+      {
+        double p1[3], p2[3];
+        p1s->GetPoint(order[i], p1);
+        p2s->GetPoint(order[i], p2);
+        packet.Add(order[i], p1, p2);
+        cellIdBest[packet.Size - 1] = -1;
+      }
+      packet.Pad();
+
+      // Depth first traversal of the tree, each node carrying the mask of the segments that
+      // may cross it.
+      stack.clear();
+      stack.emplace_back(this->mRoot.get(), (1u << packet.Size) - 1);
+      while (!stack.empty())
+      {
+        BSPNode* node = stack.back().first;
+        const unsigned int mask = packet.IntersectBounds(node->Bounds, pad, stack.back().second);
+        stack.pop_back();
+        if (!mask)
+        {
+          continue;
+        }
+        if (node->mChild[0])
+        {
+          // Visit the children from near to far along the first segment of the packet, the
+          // closest hits found first cull the farther nodes for the whole packet.
+          int lane = 0;
+          while (!(mask & (1u << lane)))
+          {
+            ++lane;
+          }
+          BSPNode *Near, *Mid, *Far;
+          double tDist;
+          node->Classify(packet.P1[lane], packet.Direction[lane], tDist, Near, Mid, Far);
+          stack.emplace_back(Far, mask);
+          if (Mid)
+          {
+            stack.emplace_back(Mid, mask);
+          }
+          stack.emplace_back(Near, mask);
+          continue;
+        }
+        for (int i = 0; i < node->num_cells; i++)
+        {
+          const vtkIdType cId = node->sorted_cell_lists[0][i];
+          double* cellBoundsPtr = cellBounds;
+          this->GetCellBounds(cId, cellBoundsPtr);
+          const unsigned int cellMask = packet.IntersectBounds(cellBoundsPtr, pad, mask);
+          bool cellLoaded = false;
+          for (int lane = 0; lane < packet.Size; ++lane)
+          {
+            if (!(cellMask & (1u << lane)) ||
+              !vtkBox::IntersectBox(cellBoundsPtr, packet.P1[lane], packet.Direction[lane],
+                hitCellBoundsPosition, tHitCell, tol))
+            {
+              continue;
+            }
+            if (!cellLoaded)
+            {
+              this->DataSet->GetCell(cId, cell);
+              cellLoaded = true;
+            }
+            if (cell->IntersectWithLine(
+                  packet.P1[lane], packet.P2[lane], tol, lineT, lineX, pcoords, subId) &&
+              lineT < packet.TBest[lane])
+            {
+              packet.TBest[lane] = lineT;
+              std::copy_n(lineX, 3, xBest[lane]);
+              cellIdBest[lane] = cId;
+            }
+          }
+        }
+      }
+
+      for (int lane = 0; lane < packet.Size; ++lane)
+      {
+        const vtkIdType lineId = packet.LineIds[lane];
+        cellIdsPtr[lineId] = cellIdBest[lane];
+        if (cellIdBest[lane] < 0)
+        {
+          continue;
+        }
+        if (x)
+        {
+          x->SetPoint(lineId, xBest[lane]);
+        }
+        if (tPtr)
+        {
+          tPtr[lineId] = packet.TBest[lane];
+        }
+      }
+    }
+  };
+  vtkSMPTools::For(0, numberOfPackets, intersectPackets);
+}
+
 //------------------------------------------------------------------------------
 struct IntersectionInfo
 {
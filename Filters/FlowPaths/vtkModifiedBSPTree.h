@@ -181,6 +181,19 @@ public:
   int IntersectWithLine(const double p1[3], const double p2[3], double tol, vtkPoints* points,
     vtkIdList* cellIds, vtkGenericCell* cell) override;
 
+  /**
+   * Batched version of IntersectWithLine, see vtkAbstractCellLocator.
+   *
+   * The segments are sorted along a space filling curve and traverse the tree in packets of 8
+   * neighboring segments: each node and each cell bounding box is tested against the whole
+   * packet at once with vectorized slab tests, the cells are fetched once per packet, and the
+   * closest hit found along each segment culls the farther boxes. The packets are processed in
+   * parallel with vtkSMPTools. The intersections match the ones of IntersectWithLine, except
+   * that any of the cells hit at exactly the same distance may be returned.
+   */
+  void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds,
+    vtkPoints* x = nullptr, vtkDoubleArray* t = nullptr) override;
+
   /**
    * Take the passed line segment and intersect it with the data set.
    * For each intersection with the bounds of a cell, the cellIds
@@ -16,6 +16,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLinearCellEvaluator.h"
 #include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -30,6 +31,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -584,35 +586,140 @@ struct PointGradientsWorker
   }
 };
 
+// Cells of an unstructured grid whose type is supported by
+// vtkLinearCellEvaluator are gathered by type, and their derivatives computed
+// a batch at a time. Other cells go through vtkCell::Derivatives().
+struct CellGradientsBatch
+{
+  static constexpr vtkIdType MaximumSize = 256;
+
+  vtkLinearCellEvaluator Evaluator;
+  std::vector<vtkIdType> CellIds;
+  std::vector<double> Values;
+};
+
+struct CellGradientsLocalData
+{
+  vtkSmartPointer<vtkGenericCell> Cell;
+  std::vector<double> Values;
+  std::vector<double> Gradient;
+  vtkSmartPointer<vtkIdList> PointIds;
+  CellGradientsBatch Batches[4];
+  std::vector<double> Centers;
+  std::vector<double> Derivatives;
+};
+
 template <typename TData>
 struct CellGradients : public GradientsBase<TData>
 {
   vtkDataSet* Input;
-  vtkSMPThreadLocal<vtkSmartPointer<vtkGenericCell>> Cell;
-  vtkSMPThreadLocal<std::vector<double>> Values;
-  vtkSMPThreadLocal<std::vector<double>> Gradient;
+  vtkUnstructuredGrid* Grid;
+  vtkSMPThreadLocal<CellGradientsLocalData> LocalData;
 
   CellGradients(vtkDataSet* input, TData* a, int numComp, TData* g, TData* v, TData* q, TData* d,
     vtkGradientFilter* filter)
     : GradientsBase<TData>(a, numComp, g, v, q, d, filter)
     , Input(input)
+    , Grid(vtkUnstructuredGrid::SafeDownCast(input))
   {
   }
 
   void Initialize()
   {
-    this->Cell.Local().TakeReference(vtkGenericCell::New());
-    this->Values.Local().resize(8);
-    this->Gradient.Local().resize(this->NumComp * 3);
+    auto& data = this->LocalData.Local();
+    data.Cell.TakeReference(vtkGenericCell::New());
+    data.Values.resize(8);
+    data.Gradient.resize(this->NumComp * 3);
+    data.PointIds = vtkSmartPointer<vtkIdList>::New();
+    const int types[4] = { VTK_TETRA, VTK_VOXEL, VTK_HEXAHEDRON, VTK_WEDGE };
+    for (int i = 0; i < 4; ++i)
+    {
+      data.Batches[i].Evaluator.SetCellType(types[i]);
+    }
+  }
+
+  static int GetBatchIndex(int cellType)
+  {
+    switch (cellType)
+    {
+      case VTK_TETRA:
+        return 0;
+      case VTK_VOXEL:
+        return 1;
+      case VTK_HEXAHEDRON:
+        return 2;
+      case VTK_WEDGE:
+        return 3;
+      default:
+        return -1;
+    }
+  }
+
+  void StoreGradient(vtkIdType cellId, double* cellGrad)
+  {
+    if (this->Gradients)
+    {
+      auto gradients = vtk::DataArrayTupleRange(this->Gradients);
+      auto g = gradients[cellId];
+      for (int i = 0; i < 3 * this->NumComp; i++)
+      {
+        g[i] = cellGrad[i];
+      }
+    }
+    if (this->Vorticity)
+    {
+      auto vorticity = vtk::DataArrayTupleRange(this->Vorticity);
+      ComputeVorticityFromGradient(cellGrad, vorticity[cellId]);
+    }
+    if (this->QCriterion)
+    {
+      auto qCriterion = vtk::DataArrayTupleRange(this->QCriterion);
+      ComputeQCriterionFromGradient(cellGrad, qCriterion[cellId]);
+    }
+    if (this->Divergence)
+    {
+      auto divergence = vtk::DataArrayTupleRange(this->Divergence);
+      ComputeDivergenceFromGradient(cellGrad, divergence[cellId]);
+    }
+  }
+
+  // Compute the gradients of the cells of a batch at their parametric center
+  void FlushBatch(CellGradientsLocalData& data, CellGradientsBatch& batch)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(batch.CellIds.size());
+    if (numCells == 0)
+    {
+      return;
+    }
+    double center[3];
+    batch.Evaluator.GetParametricCenter(center);
+    data.Centers.resize(3 * numCells);
+    for (vtkIdType i = 0; i < numCells; ++i)
+    {
+      std::copy(center, center + 3, &data.Centers[3 * i]);
+    }
+    const int size = 3 * this->NumComp;
+    data.Derivatives.resize(size * numCells);
+    batch.Evaluator.Derivatives(
+      numCells, data.Centers.data(), batch.Values.data(), this->NumComp, data.Derivatives.data());
+    for (vtkIdType i = 0; i < numCells; ++i)
+    {
+      this->StoreGradient(batch.CellIds[i], &data.Derivatives[size * i]);
+    }
+    batch.Evaluator.Reset();
+    batch.CellIds.clear();
+    batch.Values.clear();
   }
 
   void operator()(vtkIdType cellId, vtkIdType endCellId)
   {
-    auto& cell = this->Cell.Local();
-    auto& values = this->Values.Local();
-    auto& cellGrad = this->Gradient.Local();
+    auto& data = this->LocalData.Local();
+    auto& cell = data.Cell;
+    auto& values = data.Values;
+    auto& cellGrad = data.Gradient;
     const auto array = vtk::DataArrayTupleRange(this->Array);
     vtkDataSet* input = this->Input;
+    vtkUnstructuredGrid* grid = this->Grid;
     int subId = 0;
     double cellCenter[3], derivative[3];
     bool isFirst = vtkSMPTools::GetSingleThread();
@@ -627,6 +734,31 @@ struct CellGradients : public GradientsBase<TData>
       {
         break;
       }
+
+      const int batchIndex = grid ? GetBatchIndex(grid->GetCellType(cellId)) : -1;
+      if (batchIndex >= 0)
+      {
+        CellGradientsBatch& batch = data.Batches[batchIndex];
+        vtkIdType nPts;
+        const vtkIdType* pts;
+        grid->GetCellPoints(cellId, nPts, pts, data.PointIds);
+        batch.Evaluator.InsertNextCell(grid->GetPoints(), pts);
+        batch.CellIds.push_back(cellId);
+        for (vtkIdType i = 0; i < nPts; i++)
+        {
+          auto a = array[pts[i]];
+          for (int comp = 0; comp < this->NumComp; comp++)
+          {
+            batch.Values.push_back(a[comp]);
+          }
+        }
+        if (batch.Evaluator.GetNumberOfCells() == CellGradientsBatch::MaximumSize)
+        {
+          this->FlushBatch(data, batch);
+        }
+        continue;
+      }
+
       input->GetCell(cellId, cell);
       subId = cell->GetParametricCenter(cellCenter);
       vtkIdType nPts = cell->GetNumberOfPoints();
@@ -645,34 +777,14 @@ struct CellGradients : public GradientsBase<TData>
         cellGrad[comp * 3 + 1] = derivative[1];
         cellGrad[comp * 3 + 2] = derivative[2];
       }
-
-      if (this->Gradients)
-      {
-        auto gradients = vtk::DataArrayTupleRange(this->Gradients);
-        auto g = gradients[cellId];
-        for (int i = 0; i < 3 * this->NumComp; i++)
-        {
-          g[i] = cellGrad[i];
-        }
-      }
-      if (this->Vorticity)
-      {
-        auto vorticity = vtk::DataArrayTupleRange(this->Vorticity);
-        ComputeVorticityFromGradient(&cellGrad[0], vorticity[cellId]);
-      }
-      if (this->QCriterion)
-      {
-        auto qCriterion = vtk::DataArrayTupleRange(this->QCriterion);
-        ComputeQCriterionFromGradient(&cellGrad[0], qCriterion[cellId]);
-      }
-      if (this->Divergence)
-      {
-        auto divergence = vtk::DataArrayTupleRange(this->Divergence);
-        ComputeDivergenceFromGradient(&cellGrad[0], divergence[cellId]);
-      }
-
+      this->StoreGradient(cellId, &cellGrad[0]);
     } // for all cells
-  }   // operator()
+
+    for (CellGradientsBatch& batch : data.Batches)
+    {
+      this->FlushBatch(data, batch);
+    }
+  } // operator()
 
   void Reduce() {}
 };
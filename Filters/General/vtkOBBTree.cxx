@@ -3,16 +3,21 @@
 #include "vtkOBBTree.h"
 
 #include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkObjectFactory.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -980,6 +985,225 @@ int vtkOBBTree::IntersectWithLine(const double a0[3], const double a1[3], double
   return 0;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Number of segments traversing the tree together in IntersectWithLines.
+constexpr int OBBRayPacketSize = 8;
+
+// A packet of segments, with the coordinates of the end points also stored per axis so that the
+// tests of all the segments against a node are vectorized by the compiler.
+struct vtkOBBRayPacket
+{
+  int Size = 0;
+  vtkIdType LineIds[OBBRayPacketSize];
+  double P1[OBBRayPacketSize][3];
+  double P2[OBBRayPacketSize][3];
+  double Starts[3][OBBRayPacketSize];
+  double Ends[3][OBBRayPacketSize];
+  double TBest[OBBRayPacketSize];
+
+  void Add(vtkIdType lineId, const double p1[3], const double p2[3])
+  {
+    const int lane = this->Size++;
+    this->LineIds[lane] = lineId;
+    for (int i = 0; i < 3; ++i)
+    {
+      this->P1[lane][i] = this->Starts[i][lane] = p1[i];
+      this->P2[lane][i] = this->Ends[i][lane] = p2[i];
+    }
+    this->TBest[lane] = VTK_DOUBLE_MAX;
+  }
+
+  // Complete a partial packet by repeating its first segment, so that all the lanes are valid.
+  void Pad()
+  {
+    for (int lane = this->Size; lane < OBBRayPacketSize; ++lane)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Starts[i][lane] = this->Starts[i][0];
+        this->Ends[i][lane] = this->Ends[i][0];
+      }
+      this->TBest[lane] = VTK_DOUBLE_MAX;
+    }
+  }
+
+  // Return the mask of the segments of mask that overlap the node, as tested by
+  // vtkOBBTree::LineIntersectsNode, and that enter the node before the closest intersection found
+  // so far along them. The entry points are computed on the node enlarged by the tolerance of the
+  // cell intersections, so that no closer intersection is missed.
+  unsigned int IntersectNode(
+    const vtkOBBNode* node, double tolerance, double lineTolerance, unsigned int mask) const
+  {
+    bool overlaps[OBBRayPacketSize];
+    double tNear[OBBRayPacketSize];
+    for (int lane = 0; lane < OBBRayPacketSize; ++lane)
+    {
+      overlaps[lane] = true;
+      tNear[lane] = 0.0;
+    }
+    for (int ii = 0; ii < 3; ++ii)
+    {
+      const double* axis = node->Axes[ii];
+      const double rangeAmin = vtkMath::Dot(node->Corner, axis);
+      const double length2 = vtkMath::Dot(axis, axis);
+      const double rangeAmax = rangeAmin + length2;
+      const double eps = tolerance != 0 ? tolerance * sqrt(fabs(rangeAmax - rangeAmin)) : 0.0;
+      const double pad = eps + (lineTolerance + 1e-9 * sqrt(length2)) * sqrt(length2);
+      for (int lane = 0; lane < OBBRayPacketSize; ++lane)
+      {
+        const double dotB0 = this->Starts[0][lane] * axis[0] + this->Starts[1][lane] * axis[1] +
+          this->Starts[2][lane] * axis[2];
+        const double dotB1 = this->Ends[0][lane] * axis[0] + this->Ends[1][lane] * axis[1] +
+          this->Ends[2][lane] * axis[2];
+        const double rangeBmin = std::min(dotB0, dotB1);
+        const double rangeBmax = std::max(dotB0, dotB1);
+        overlaps[lane] = overlaps[lane] && !(rangeAmax + eps < rangeBmin) &&
+          !(rangeBmax + eps < rangeAmin);
+
+        const double slope = dotB1 - dotB0;
+        const double inverse = slope != 0.0 ? 1.0 / slope : 0.0;
+        const double t0 = (rangeAmin - pad - dotB0) * inverse;
+        const double t1 = (rangeAmax + pad - dotB0) * inverse;
+        tNear[lane] = std::max(tNear[lane], std::min(t0, t1));
+      }
+    }
+    unsigned int hits = 0;
+    for (int lane = 0; lane < OBBRayPacketSize; ++lane)
+    {
+      hits |= static_cast<unsigned int>(overlaps[lane] && tNear[lane] <= this->TBest[lane])
+        << lane;
+    }
+    return hits & mask;
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+void vtkOBBTree::IntersectWithLines(
+  vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds, vtkPoints* x, vtkDoubleArray* t)
+{
+  if (!p1s || !p2s || !cellIds || !this->DataSet)
+  {
+    vtkErrorMacro(<< "IntersectWithLines needs segment end points, a cell id list and a data set");
+    return;
+  }
+  const vtkIdType numberOfLines = p1s->GetNumberOfPoints();
+  if (p2s->GetNumberOfPoints() != numberOfLines)
+  {
+    vtkErrorMacro(<< "The segments must have as many start points as end points");
+    return;
+  }
+  this->BuildLocator();
+
+  cellIds->SetNumberOfIds(numberOfLines);
+  if (x)
+  {
+    x->SetNumberOfPoints(numberOfLines);
+  }
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numberOfLines);
+  }
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* tPtr = t ? t->GetPointer(0) : nullptr;
+  if (this->Tree == nullptr)
+  {
+    std::fill_n(cellIdsPtr, numberOfLines, -1);
+    return;
+  }
+
+  std::vector<vtkIdType> order;
+  this->ComputeQueryOrder(p1s, order);
+  const vtkIdType numberOfPackets = (numberOfLines + OBBRayPacketSize - 1) / OBBRayPacketSize;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  auto intersectPackets = [&](vtkIdType beginPacket, vtkIdType endPacket)
+  {
+    vtkGenericCell* cell = localCell.Local();
+    std::vector<std::pair<vtkOBBNode*, unsigned int>> OBBstack;
+    vtkOBBRayPacket packet;
+    double xBest[OBBRayPacketSize][3];
+    vtkIdType cellIdBest[OBBRayPacketSize];
+    double lineT, lineX[3], pcoords[3];
+    int subId;
+    for (vtkIdType packetId = beginPacket; packetId < endPacket; ++packetId)
+    {
+      packet.Size = 0;
+      const vtkIdType end = std::min((packetId + 1) * OBBRayPacketSize, numberOfLines);
+      for (vtkIdType i = packetId * OBBRayPacketSize; i < end; ++i)
+      {
+        double p1[3], p2[3];
+        p1s->GetPoint(order[i], p1);
+        p2s->GetPoint(order[i], p2);
+        packet.Add(order[i], p1, p2);
+        cellIdBest[packet.Size - 1] = -1;
+      }
+      packet.Pad();
+
+      // Same traversal as IntersectWithLine, each node carrying the mask of the segments that
+      // may intersect it.
+      OBBstack.clear();
+      OBBstack.emplace_back(this->Tree, (1u << packet.Size) - 1);
+      while (!OBBstack.empty())
+      {
+        vtkOBBNode* node = OBBstack.back().first;
+        const unsigned int mask =
+          packet.IntersectNode(node, this->Tolerance, tol, OBBstack.back().second);
+        OBBstack.pop_back();
+        if (!mask)
+        {
+          continue;
+        }
+        if (node->Kids != nullptr)
+        {
+          OBBstack.emplace_back(node->Kids[0], mask);
+          OBBstack.emplace_back(node->Kids[1], mask);
+          continue;
+        }
+        for (vtkIdType ii = 0; ii < node->Cells->GetNumberOfIds(); ii++)
+        {
+          const vtkIdType thisId = node->Cells->GetId(ii);
+          this->DataSet->GetCell(thisId, cell);
+          for (int lane = 0; lane < packet.Size; ++lane)
+          {
+            if ((mask & (1u << lane)) &&
+              cell->IntersectWithLine(
+                packet.P1[lane], packet.P2[lane], tol, lineT, lineX, pcoords, subId) &&
+              lineT < packet.TBest[lane])
+            {
+              packet.TBest[lane] = lineT;
+              std::copy_n(lineX, 3, xBest[lane]);
+              cellIdBest[lane] = thisId;
+            }
+          }
+        }
+      }
+
+      for (int lane = 0; lane < packet.Size; ++lane)
+      {
+        const vtkIdType lineId = packet.LineIds[lane];
+        cellIdsPtr[lineId] = cellIdBest[lane];
+        if (cellIdBest[lane] < 0)
+        {
+          continue;
+        }
+        if (x)
+        {
+          x->SetPoint(lineId, xBest[lane]);
+        }
+        if (tPtr)
+        {
+          tPtr[lineId] = packet.TBest[lane];
+        }
+      }
+    }
+  };
+  vtkSMPTools::For(0, numberOfPackets, intersectPackets);
+}
+
 //------------------------------------------------------------------------------
 void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int* maxCells)
 {
@@ -122,6 +122,17 @@ public:
   int IntersectWithLine(
     const double a0[3], const double a1[3], vtkPoints* points, vtkIdList* cellIds) override;
 
+  /**
+   * Batched version of the first intersection query, see vtkAbstractCellLocator.
+   * Neighboring segments are grouped in packets of 8 that walk down the tree together: a node is
+   * tested against all the segments of a packet in one vectorized loop, each leaf cell is
+   * fetched once per packet, and the nodes entered after the closest intersection already found
+   * along a segment are skipped for that segment. Packets are processed in parallel. The results
+   * are the ones returned by IntersectWithLine for each segment.
+   */
+  void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds,
+    vtkPoints* x = nullptr, vtkDoubleArray* t = nullptr) override;
+
   /**
    * Compute an OBB from the list of points given. Return the corner point
    * and the three axes defining the orientation of the OBB. Also return
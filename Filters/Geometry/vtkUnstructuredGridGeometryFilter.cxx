@@ -17,6 +17,7 @@
 #include "vtkGenericCell.h"
 #include "vtkHexagonalPrism.h"
 #include "vtkHexahedron.h"
+#include "vtkIdList.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,6 +27,7 @@
 #include "vtkLagrangeTetra.h"
 #include "vtkLagrangeTriangle.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPentagonalPrism.h"
 #include "vtkPointData.h"
@@ -875,6 +877,14 @@ int vtkUnstructuredGridGeometryFilter::RequestData(vtkInformation* vtkNotUsed(re
   vtkSmartPointer<vtkCellIterator> cellIter =
     vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
 
+  // Polyhedron faces are read directly from an unstructured grid instead of
+  // being copied for each cell by the cell iterator.
+  vtkUnstructuredGrid* inputGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkCellArray* inputFaces = inputGrid ? inputGrid->GetPolyhedronFaces() : nullptr;
+  vtkCellArray* inputFaceLocations = inputGrid ? inputGrid->GetPolyhedronFaceLocations() : nullptr;
+  vtkNew<vtkIdList> faceIds;
+  vtkNew<vtkIdList> facePointIds;
+
   // Output
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
@@ -1177,19 +1187,30 @@ int vtkUnstructuredGridGeometryFilter::RequestData(vtkInformation* vtkNotUsed(re
             break;
           case VTK_POLYHEDRON:
           {
-            vtkCellArray* faces = cellIter->GetCellFaces();
-            int nFaces = cellIter->GetNumberOfFaces();
-            vtkNew<vtkIdList> tmpIds;
-            for (int face = 0; face < nFaces; ++face)
+            vtkCellArray* faces;
+            vtkIdType nFaces;
+            const vtkIdType* cellFaceIds;
+            if (inputFaces && inputFaceLocations)
+            {
+              faces = inputFaces;
+              inputFaceLocations->GetCellAtId(cellId, nFaces, cellFaceIds, faceIds);
+            }
+            else
+            {
+              faces = cellIter->GetCellFaces();
+              nFaces = cellIter->GetNumberOfFaces();
+              cellFaceIds = nullptr;
+            }
+            for (vtkIdType face = 0; face < nFaces; ++face)
             {
               vtkIdType nFacePts;
               const vtkIdType* fptr;
-              faces->GetCellAtId(face, nFacePts, fptr, tmpIds);
+              faces->GetCellAtId(
+                cellFaceIds ? cellFaceIds[face] : face, nFacePts, fptr, facePointIds);
               int pt = static_cast<int>(nFacePts);
               int degrees[2]{ 0, 0 };
               this->HashTable->InsertFace(
                 cellId, VTK_POLYGON, pt, fptr, degrees, MatchBoundariesIgnoringCellOrder);
-              fptr += pt;
             }
             break;
           }
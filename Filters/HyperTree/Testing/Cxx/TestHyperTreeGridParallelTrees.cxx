@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the hypertree grid filters processing trees in parallel produce the same output,
+// in the same order, as when they run with the sequential SMP backend.
+
+#include "vtkAlgorithm.h"
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridCellCenters.h"
+#include "vtkHyperTreeGridContour.h"
+#include "vtkHyperTreeGridGeometry.h"
+#include "vtkHyperTreeGridThreshold.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRandomHyperTreeGridSource.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool CompareArrays(vtkDataArray* a1, vtkDataArray* a2, const std::string& name)
+{
+  if (!a1 || !a2)
+  {
+    if (a1 != a2)
+    {
+      std::cerr << name << ": missing array\n";
+      return false;
+    }
+    return true;
+  }
+  if (a1->GetNumberOfTuples() != a2->GetNumberOfTuples() ||
+    a1->GetNumberOfComponents() != a2->GetNumberOfComponents())
+  {
+    std::cerr << name << ": " << a1->GetNumberOfTuples() << " tuples instead of "
+              << a2->GetNumberOfTuples() << "\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a1->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a1->GetNumberOfComponents(); ++c)
+    {
+      if (a1->GetComponent(i, c) != a2->GetComponent(i, c))
+      {
+        std::cerr << name << ": values differ at tuple " << i << "\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareFields(vtkDataSetAttributes* fd1, vtkDataSetAttributes* fd2, const std::string& name)
+{
+  if (fd1->GetNumberOfArrays() != fd2->GetNumberOfArrays())
+  {
+    std::cerr << name << ": different number of arrays\n";
+    return false;
+  }
+  for (int i = 0; i < fd1->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = fd1->GetArray(i);
+    if (array &&
+      !CompareArrays(array, fd2->GetArray(array->GetName()), name + " " + array->GetName()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareCells(vtkCellArray* c1, vtkCellArray* c2, const std::string& name)
+{
+  return CompareArrays(c1->GetOffsetsArray(), c2->GetOffsetsArray(), name + " offsets") &&
+    CompareArrays(c1->GetConnectivityArray(), c2->GetConnectivityArray(), name + " connectivity");
+}
+
+//------------------------------------------------------------------------------
+bool CompareOutputs(vtkDataObject* do1, vtkDataObject* do2)
+{
+  vtkPolyData* pd1 = vtkPolyData::SafeDownCast(do1);
+  vtkPolyData* pd2 = vtkPolyData::SafeDownCast(do2);
+  if (pd1 && pd2)
+  {
+    return CompareArrays(pd1->GetPoints()->GetData(), pd2->GetPoints()->GetData(), "points") &&
+      CompareCells(pd1->GetVerts(), pd2->GetVerts(), "verts") &&
+      CompareCells(pd1->GetLines(), pd2->GetLines(), "lines") &&
+      CompareCells(pd1->GetPolys(), pd2->GetPolys(), "polys") &&
+      CompareFields(pd1->GetPointData(), pd2->GetPointData(), "point data") &&
+      CompareFields(pd1->GetCellData(), pd2->GetCellData(), "cell data");
+  }
+
+  vtkHyperTreeGrid* htg1 = vtkHyperTreeGrid::SafeDownCast(do1);
+  vtkHyperTreeGrid* htg2 = vtkHyperTreeGrid::SafeDownCast(do2);
+  if (htg1 && htg2)
+  {
+    if (htg1->GetNumberOfCells() != htg2->GetNumberOfCells())
+    {
+      std::cerr << "hypertree grid: " << htg1->GetNumberOfCells() << " cells instead of "
+                << htg2->GetNumberOfCells() << "\n";
+      return false;
+    }
+    return CompareArrays(htg1->GetMask(), htg2->GetMask(), "mask") &&
+      CompareFields(htg1->GetCellData(), htg2->GetCellData(), "cell data");
+  }
+
+  std::cerr << "Unexpected output types\n";
+  return false;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> RunFilter(vtkAlgorithm* filter, const char* backend)
+{
+  vtkSMPTools::SetBackend(backend);
+  vtkSMPTools::Initialize(4);
+  filter->Modified();
+  filter->Update();
+  vtkSmartPointer<vtkDataObject> output;
+  output.TakeReference(filter->GetOutputDataObject(0)->NewInstance());
+  output->DeepCopy(filter->GetOutputDataObject(0));
+  return output;
+}
+
+//------------------------------------------------------------------------------
+bool TestFilter(vtkAlgorithm* filter, const std::string& name)
+{
+  vtkSmartPointer<vtkDataObject> expected = RunFilter(filter, "Sequential");
+  vtkSmartPointer<vtkDataObject> output = RunFilter(filter, "STDThread");
+  if (!CompareOutputs(output, expected))
+  {
+    std::cerr << "Parallel output of " << name << " differs from the sequential one\n";
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestHyperTreeGridParallelTrees(int, char*[])
+{
+  if (!vtkSMPTools::SetBackend("STDThread"))
+  {
+    std::cout << "STDThread backend not available, nothing to compare\n";
+    return EXIT_SUCCESS;
+  }
+
+  bool success = true;
+  for (unsigned int dimension = 2; dimension <= 3; ++dimension)
+  {
+    vtkNew<vtkRandomHyperTreeGridSource> source;
+    source->SetDimensions(7, 6, dimension == 3 ? 5 : 1);
+    source->SetMaxDepth(dimension == 3 ? 4 : 6);
+    source->SetSeed(3);
+    source->SetSplitFraction(0.6);
+    source->SetMaskedFraction(0.1);
+    const std::string suffix = dimension == 3 ? " (3D)" : " (2D)";
+
+    vtkNew<vtkHyperTreeGridCellCenters> centers;
+    centers->SetInputConnection(source->GetOutputPort());
+    centers->SetVertexCells(true);
+    success &= TestFilter(centers, "vtkHyperTreeGridCellCenters" + suffix);
+
+    vtkNew<vtkHyperTreeGridGeometry> geometry;
+    geometry->SetInputConnection(source->GetOutputPort());
+    success &= TestFilter(geometry, "vtkHyperTreeGridGeometry" + suffix);
+
+    vtkNew<vtkHyperTreeGridContour> contour;
+    contour->SetInputConnection(source->GetOutputPort());
+    contour->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "Depth");
+    contour->SetValue(0, 1.5);
+    contour->SetValue(1, 2.5);
+    success &= TestFilter(contour, "vtkHyperTreeGridContour" + suffix);
+
+    vtkNew<vtkHyperTreeGridThreshold> threshold;
+    threshold->SetInputConnection(source->GetOutputPort());
+    threshold->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "Depth");
+    threshold->SetLowerThreshold(1);
+    threshold->SetUpperThreshold(3);
+    const int strategies[] = { vtkHyperTreeGridThreshold::MaskInput,
+      vtkHyperTreeGridThreshold::CopyStructureAndIndexArrays,
+      vtkHyperTreeGridThreshold::DeepThreshold };
+    for (int strategy : strategies)
+    {
+      threshold->SetMemoryStrategy(strategy);
+      success &=
+        TestFilter(threshold, "vtkHyperTreeGridThreshold " + std::to_string(strategy) + suffix);
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
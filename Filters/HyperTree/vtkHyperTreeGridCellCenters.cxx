@@ -8,14 +8,40 @@
 #include "vtkCellData.h"
 #include "vtkHyperTree.h"
 #include "vtkHyperTreeGrid.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
-#include "vtkHyperTreeGridNonOrientedGeometryCursor.h"
+#include "vtkHyperTreeGridSMPTools.h"
+#include "vtkHyperTreeLinearLayout.h"
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Number of leaves generating a cell center in a tree
+vtkIdType CountVisibleLeaves(vtkHyperTreeLinearLayout* layout)
+{
+  vtkIdType count = 0;
+  for (vtkIdType vertex = 0; vertex < layout->GetNumberOfVertices(); ++vertex)
+  {
+    if (layout->IsLeaf(vertex) && !layout->IsMasked(vertex))
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+}
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkHyperTreeGridCellCenters);
@@ -147,53 +173,74 @@ void vtkHyperTreeGridCellCenters::ProcessTrees()
   // Retrieve material mask
   this->InMask = this->Input->HasMask() ? this->Input->GetMask() : nullptr;
 
-  // Iterate over all hyper trees
-  vtkIdType index;
-  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-  this->Input->InitializeTreeIterator(it);
-  vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor;
-  while (it.GetNextTree(index))
-  {
-    if (this->CheckAbort())
+  // Trees are processed in parallel, in two passes: visible leaves are first
+  // counted in each tree, so that the centers of the leaves of each tree are
+  // then generated at the same output ids as with a serial traversal. Each
+  // tree is linearized once for both passes.
+  std::vector<vtkIdType> treeIndices;
+  vtkHyperTreeGridSMPTools::GetTreeIndices(this->Input, treeIndices);
+  const vtkIdType numberOfTrees = static_cast<vtkIdType>(treeIndices.size());
+  std::vector<vtkSmartPointer<vtkHyperTreeLinearLayout>> layouts(numberOfTrees);
+  std::vector<vtkIdType> offsets(numberOfTrees, 0);
+  vtkSMPTools::For(0, numberOfTrees,
+    [this, &treeIndices, &layouts, &offsets](vtkIdType begin, vtkIdType end)
     {
-      break;
-    }
-    // Initialize new geometric cursor at root of current tree
-    this->Input->InitializeNonOrientedGeometryCursor(cursor, index);
-    // Generate leaf cell centers recursively
-    this->RecursivelyProcessTree(cursor);
-  } // it
+      for (vtkIdType position = begin; position < end; ++position)
+      {
+        layouts[position] = vtkSmartPointer<vtkHyperTreeLinearLayout>::New();
+        layouts[position]->Initialize(this->Input, treeIndices[position]);
+        offsets[position] = ::CountVisibleLeaves(layouts[position]);
+      }
+    });
+  vtkIdType numberOfPoints = vtkHyperTreeGridSMPTools::ComputeOffsets(offsets);
+
+  this->Points->SetNumberOfPoints(numberOfPoints);
+  vtkNew<vtkIdList> cellIds;
+  cellIds->SetNumberOfIds(numberOfPoints);
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  vtkSMPTools::For(0, numberOfTrees,
+    [this, &layouts, &offsets, cellIdsPtr](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType position = begin; position < end; ++position)
+      {
+        if (vtkSMPTools::GetSingleThread())
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          return;
+        }
+        // Generate leaf cell centers, releasing the layout once done
+        this->ProcessTree(layouts[position], offsets[position], cellIdsPtr);
+        layouts[position] = nullptr;
+      }
+    });
+  if (this->GetAbortOutput())
+  {
+    // Skipped trees left part of the points and cell ids uninitialized
+    this->Points->Delete();
+    this->Points = nullptr;
+    return;
+  }
+
+  // Copy cell center data from leaf data
+  this->OutData->CopyData(this->InData, cellIds);
 
   // Set output geometry and topology if required
   this->Output->SetPoints(this->Points);
   if (this->VertexCells)
   {
-    vtkIdType np = this->Points->GetNumberOfPoints();
-    vtkCellArray* vertices = vtkCellArray::New();
-    vertices->AllocateEstimate(np, 1);
-    for (vtkIdType i = 0; i < np; ++i)
-    {
-      vertices->InsertNextCell(1, &i);
-    } // i
-    this->Output->SetVerts(vertices);
-    vertices->Delete();
-  } // this->VertexCells
-
-  if (this->VertexCells)
-  {
-    vtkIdType numPoints = this->Points->GetNumberOfPoints();
-    vtkNew<vtkIdTypeArray> iArray;
-    iArray->SetNumberOfComponents(1);
-    iArray->SetNumberOfTuples(numPoints * 2);
-    for (vtkIdType i = 0; i < numPoints; i++)
-    {
-      iArray->SetValue(2 * i, 1);
-      iArray->SetValue(2 * i + 1, i);
-    }
-
+    vtkNew<vtkIdTypeArray> offsetsArray;
+    offsetsArray->SetNumberOfValues(numberOfPoints + 1);
+    vtkIdType* offsetsPtr = offsetsArray->GetPointer(0);
+    std::iota(offsetsPtr, offsetsPtr + numberOfPoints + 1, vtkIdType(0));
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(numberOfPoints);
+    vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+    std::iota(connectivityPtr, connectivityPtr + numberOfPoints, vtkIdType(0));
     vtkNew<vtkCellArray> verts;
-    verts->AllocateEstimate(numPoints, 1);
-    verts->ImportLegacyFormat(iArray);
+    verts->SetData(offsetsArray, connectivity);
     this->Output->SetVerts(verts);
     this->Output->GetCellData()->ShallowCopy(this->OutData);
   }
@@ -204,46 +251,30 @@ void vtkHyperTreeGridCellCenters::ProcessTrees()
 }
 
 //------------------------------------------------------------------------------
-void vtkHyperTreeGridCellCenters::RecursivelyProcessTree(
-  vtkHyperTreeGridNonOrientedGeometryCursor* cursor)
+void vtkHyperTreeGridCellCenters::ProcessTree(
+  vtkHyperTreeLinearLayout* layout, vtkIdType outId, vtkIdType* cellIds)
 {
-  // Create cell center if cursor is at leaf
-  if (cursor->IsLeaf())
+  vtkHyperTreeLinearLayout::DepthFirstIterator it(layout);
+  for (it.Begin(); !it.IsAtEnd(); it.Next())
   {
-    // Cursor is at leaf, retrieve its global index
-    vtkIdType id = cursor->GetGlobalNodeIndex();
-
-    // If leaf is masked, skip it
-    if (this->InMask && this->InMask->GetValue(id))
+    // Create a cell center at each visible leaf
+    if (!it.IsLeaf() || it.IsMasked())
     {
-      return;
+      continue;
     }
 
     // Retrieve cell center coordinates
+    const double* origin = it.GetOrigin();
+    const double* size = it.GetSize();
     double pt[3];
-    cursor->GetPoint(pt);
-
-    // Insert next point
-    vtkIdType outId = this->Points->InsertNextPoint(pt);
+    for (int d = 0; d < 3; ++d)
+    {
+      pt[d] = origin[d] + 0.5 * size[d];
+    }
 
-    // Copy cell center data from leaf data, when needed
-    this->OutData->CopyData(this->InData, id, outId);
+    // Set next point, its data is copied from the leaf once all trees are processed
+    this->Points->SetPoint(outId, pt);
+    cellIds[outId++] = it.GetGlobalNodeIndex();
   }
-  else
-  {
-    // Cursor is not at leaf, recurse to all children
-    int numChildren = this->Input->GetNumberOfChildren();
-    for (int child = 0; child < numChildren; ++child)
-    {
-      if (this->CheckAbort())
-      {
-        break;
-      }
-      cursor->ToChild(child);
-      // Recurse
-      this->RecursivelyProcessTree(cursor);
-      cursor->ToParent();
-    } // child
-  }   // else
 }
 VTK_ABI_NAMESPACE_END
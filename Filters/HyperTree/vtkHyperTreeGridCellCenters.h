@@ -40,7 +40,7 @@ class vtkBitArray;
 class vtkDataSetAttributes;
 class vtkHyperTreeGrid;
 class vtkPolyData;
-class vtkHyperTreeGridNonOrientedGeometryCursor;
+class vtkHyperTreeLinearLayout;
 
 class VTKFILTERSHYPERTREE_EXPORT vtkHyperTreeGridCellCenters : public vtkCellCenters
 {
@@ -64,9 +64,11 @@ protected:
   virtual void ProcessTrees();
 
   /**
-   * Recursively descend into tree down to leaves
+   * Visit the leaves of a tree in depth first order. The centers of the
+   * visible leaves are stored from outId on, and their indices in cellIds at
+   * the same positions. Trees can be processed concurrently.
    */
-  void RecursivelyProcessTree(vtkHyperTreeGridNonOrientedGeometryCursor*);
+  void ProcessTree(vtkHyperTreeLinearLayout* layout, vtkIdType outId, vtkIdType* cellIds);
 
   vtkHyperTreeGrid* Input;
   vtkPolyData* Output;
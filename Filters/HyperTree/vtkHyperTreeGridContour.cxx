@@ -18,6 +18,7 @@
 #include "vtkHyperTreeGridNonOrientedCursor.h"
 #include "vtkHyperTreeGridNonOrientedGeometryCursor.h"
 #include "vtkHyperTreeGridNonOrientedMooreSuperCursor.h"
+#include "vtkHyperTreeGridSMPTools.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkIndexedArray.h"
@@ -32,12 +33,14 @@
 #include "vtkPolyData.h"
 #include "vtkPolyhedron.h"
 #include "vtkPolyhedronUtilities.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVoxel.h"
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 
@@ -314,6 +317,11 @@ struct vtkHyperTreeGridContour::vtkInternals
   vtkNew<vtkPolyhedron> Polyhedron;
   vtkNew<vtkGenericCell> Tetra;
   vtkNew<vtkDoubleArray> TetraScalars;
+
+  // Selection flags and signs of the cells, one byte per cell, set while
+  // trees are pre-processed in parallel then copied into the bit arrays
+  std::vector<unsigned char> SelectedCells;
+  std::vector<std::vector<unsigned char>> CellSigns;
 };
 
 //------------------------------------------------------------------------------
@@ -612,39 +620,55 @@ int vtkHyperTreeGridContour::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObject
   this->Helper = new vtkContourHelper(this->Locator, newVerts, newLines, newPolys, dualPointData,
     nullptr, output->GetPointData(), nullptr, estimatedSize, true);
 
-  // Create storage to keep track of selected cells
-  this->SelectedCells = vtkBitArray::New();
-  this->SelectedCells->SetNumberOfTuples(numCells);
+  // Create storage to keep track of selected cells and of signs
+  this->Internals->SelectedCells.assign(numCells, 0);
+  this->Internals->CellSigns.resize(numContours);
+  for (auto& cellSigns : this->Internals->CellSigns)
+  {
+    cellSigns.assign(numCells, 0);
+  }
 
-  // Initialize storage for signs and values
+  // First pass across tree roots to evince cells intersected by contours.
+  // Trees only write the flags of their own cells, so they are processed in parallel.
+  std::vector<vtkIdType> treeIndices;
+  vtkHyperTreeGridSMPTools::GetTreeIndices(input, treeIndices);
+  auto preProcessTree = [this, numContours](
+                          vtkIdType, vtkHyperTreeGridNonOrientedCursor* treeCursor) -> bool
+  {
+    if (vtkSMPTools::GetSingleThread())
+    {
+      this->CheckAbort();
+    }
+    if (this->GetAbortOutput())
+    {
+      return false;
+    }
+    // Pre-process tree recursively
+    std::vector<bool> signs(numContours, true);
+    this->RecursivelyPreProcessTree(treeCursor, signs);
+    return true;
+  };
+  vtkHyperTreeGridSMPTools::ForEachTree<vtkHyperTreeGridNonOrientedCursor>(
+    input, treeIndices, preProcessTree);
+
+  this->SelectedCells = vtkBitArray::New();
+  vtkHyperTreeGridSMPTools::CopyToBitArray(this->Internals->SelectedCells, this->SelectedCells);
   // NOLINTNEXTLINE(bugprone-sizeof-expression)
   this->CellSigns = (vtkBitArray**)malloc(numContours * sizeof(*this->CellSigns));
-  this->Signs.resize(numContours, true);
   for (int c = 0; c < numContours; ++c)
   {
     this->CellSigns[c] = vtkBitArray::New();
-    this->CellSigns[c]->SetNumberOfTuples(numCells);
+    vtkHyperTreeGridSMPTools::CopyToBitArray(this->Internals->CellSigns[c], this->CellSigns[c]);
   }
+  this->Internals->SelectedCells.clear();
+  this->Internals->SelectedCells.shrink_to_fit();
+  this->Internals->CellSigns.clear();
 
-  // First pass across tree roots to evince cells intersected by contours
+  // Second pass across tree roots: now compute isocontours recursively.
+  // Output points are merged across trees by the locator, this pass remains serial.
   vtkIdType index;
   vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
   input->InitializeTreeIterator(it);
-  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
-  while (it.GetNextTree(index))
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    // Initialize new grid cursor at root of current input tree
-    input->InitializeNonOrientedCursor(cursor, index);
-    // Pre-process tree recursively
-    this->RecursivelyPreProcessTree(cursor);
-  } // it
-
-  // Second pass across tree roots: now compute isocontours recursively
-  input->InitializeTreeIterator(it);
   vtkNew<vtkHyperTreeGridNonOrientedMooreSuperCursor> supercursor;
   while (it.GetNextTree(index))
   {
@@ -702,12 +726,13 @@ int vtkHyperTreeGridContour::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObject
 }
 
 //------------------------------------------------------------------------------
-bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrientedCursor* cursor)
+bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(
+  vtkHyperTreeGridNonOrientedCursor* cursor, std::vector<bool>& leafSigns)
 {
   // Retrieve global index of input cursor
   vtkIdType id = cursor->GetGlobalNodeIndex();
 
-  if (this->InGhostArray && this->InGhostArray->GetTuple1(id))
+  if (this->InGhostArray && this->InGhostArray->GetValue(id))
   {
     return false;
   }
@@ -723,17 +748,13 @@ bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrien
     int numChildren = cursor->GetNumberOfChildren();
     for (int child = 0; child < numChildren; ++child)
     {
-      if (this->CheckAbort())
-      {
-        break;
-      }
       // Create storage for signs relative to contour values
       std::vector<bool> signs(numContours);
 
       cursor->ToChild(child);
 
       // Recurse and keep track of whether this branch is selected
-      selected |= this->RecursivelyPreProcessTree(cursor);
+      selected |= this->RecursivelyPreProcessTree(cursor, leafSigns);
 
       // Check if branch not completely selected
       if (!selected)
@@ -748,12 +769,12 @@ bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrien
           if (!child)
           {
             // Initialize sign array with sign of first child
-            signs[c] = (this->CellSigns[c]->GetTuple1(childId) != 0.0);
+            signs[c] = (this->Internals->CellSigns[c][childId] != 0);
           } // if ( ! child )
           else
           {
             // For subsequent children compare their sign with stored value
-            if (signs[c] != (this->CellSigns[c]->GetTuple1(childId) != 0.0))
+            if (signs[c] != (this->Internals->CellSigns[c][childId] != 0))
             {
               // A change of sign occurred, therefore cell must selected
               selected = true;
@@ -765,27 +786,27 @@ bool vtkHyperTreeGridContour::RecursivelyPreProcessTree(vtkHyperTreeGridNonOrien
       cursor->ToParent();
     } // child
   }
-  else if (!this->InGhostArray || !this->InGhostArray->GetTuple1(id))
+  else if (!this->InGhostArray || !this->InGhostArray->GetValue(id))
   {
     // Cursor is at leaf, retrieve its active scalar value
-    double val = this->InScalars->GetTuple1(id);
+    double val = this->InScalars->GetComponent(id, 0);
 
     // Iterate over all contours
     double* values = this->ContourValues->GetValues();
     for (int c = 0; c < numContours; ++c)
     {
-      this->Signs[c] = val > values[c];
+      leafSigns[c] = val > values[c];
     }
   } // else
 
   // Update list of selected cells
-  this->SelectedCells->SetTuple1(id, selected);
+  this->Internals->SelectedCells[id] = selected ? 1 : 0;
 
   // Set signs for all contours
   for (int c = 0; c < numContours; ++c)
   {
     // Parent cell has that of one of its children
-    this->CellSigns[c]->SetTuple1(id, this->Signs[c]);
+    this->Internals->CellSigns[c][id] = leafSigns[c] ? 1 : 0;
   }
 
   // Return whether current node was fully selected
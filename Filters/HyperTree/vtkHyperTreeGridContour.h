@@ -135,9 +135,12 @@ protected:
   int ProcessTrees(vtkHyperTreeGrid*, vtkDataObject*) override;
 
   /**
-   * Recursively decide whether a cell is intersected by a contour
+   * Recursively decide whether a cell is intersected by a contour. leafSigns
+   * holds the signs, relative to each contour value, of the last leaf visited
+   * in the tree. Different trees can be pre-processed concurrently.
    */
-  bool RecursivelyPreProcessTree(vtkHyperTreeGridNonOrientedCursor*);
+  bool RecursivelyPreProcessTree(
+    vtkHyperTreeGridNonOrientedCursor*, std::vector<bool>& leafSigns);
 
   /**
    * Recursively descend into the tree down to the leaves to construct the contour (verts, lines,
@@ -179,11 +182,6 @@ protected:
   vtkIdList* Leaves;
   ///@}
 
-  /**
-   * Storage for signs relative to current contour value
-   */
-  std::vector<bool> Signs;
-
   /**
    * Keep track of current index in output polydata
    */
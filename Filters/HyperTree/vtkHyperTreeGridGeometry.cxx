@@ -1,23 +1,134 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkArrayDispatch.h"
+#include "vtkBitArray.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGeometry1DImpl.h"
 #include "vtkHyperTreeGridGeometry2DImpl.h"
 #include "vtkHyperTreeGridGeometry3DImpl.h"
 #include "vtkHyperTreeGridGeometryImpl.h"
+#include "vtkHyperTreeGridSMPTools.h"
 #include "vtkInformation.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Surface generated from a range of trees
+struct SurfacePiece
+{
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkCellArray> Cells;
+  vtkNew<vtkCellData> CellData;
+  std::unique_ptr<vtkHyperTreeGridGeometryImpl> Implementation;
+};
+
+//------------------------------------------------------------------------------
+// Copy the values of an array at the given tuple of another array of the same
+// value type, sized beforehand.
+struct CopyTuplesWorker
+{
+  template <typename OutArrayT, typename InArrayT>
+  void operator()(OutArrayT* outArray, InArrayT* inArray, vtkIdType dstTuple) const
+  {
+    const auto src = vtk::DataArrayValueRange(inArray);
+    auto dst = vtk::DataArrayValueRange(outArray, dstTuple * outArray->GetNumberOfComponents());
+    std::copy(src.cbegin(), src.cend(), dst.begin());
+  }
+};
+
+//------------------------------------------------------------------------------
+// Append the pieces, in order, into the output points, cells and cell data.
+void AppendPieces(std::vector<SurfacePiece>& pieces, vtkPoints* outPoints, vtkCellArray* outCells,
+  vtkDataSetAttributes* outData)
+{
+  const vtkIdType numberOfPieces = static_cast<vtkIdType>(pieces.size());
+  std::vector<vtkIdType> pointOffsets(numberOfPieces + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numberOfPieces + 1, 0);
+  std::vector<vtkIdType> connectivityOffsets(numberOfPieces + 1, 0);
+  for (vtkIdType i = 0; i < numberOfPieces; ++i)
+  {
+    pointOffsets[i + 1] = pointOffsets[i] + pieces[i].Points->GetNumberOfPoints();
+    cellOffsets[i + 1] = cellOffsets[i] + pieces[i].Cells->GetNumberOfCells();
+    connectivityOffsets[i + 1] =
+      connectivityOffsets[i] + pieces[i].Cells->GetNumberOfConnectivityIds();
+  }
+
+  // The cell arrays of the first piece, which all pieces share the layout of,
+  // are extended to hold the data of the other pieces. All arrays are sized
+  // here, so that the pieces are then copied concurrently into disjoint ranges
+  // of values. Bit and string arrays, whose values cannot be written
+  // independently, are appended serially.
+  outData->ShallowCopy(pieces[0].CellData);
+  const int numberOfArrays = outData->GetNumberOfArrays();
+  std::vector<int> concurrentArrays;
+  std::vector<int> serialArrays;
+  for (int a = 0; a < numberOfArrays; ++a)
+  {
+    vtkAbstractArray* array = outData->GetAbstractArray(a);
+    if (vtkDataArray::SafeDownCast(array) && !vtkBitArray::SafeDownCast(array))
+    {
+      array->SetNumberOfTuples(cellOffsets[numberOfPieces]);
+      concurrentArrays.push_back(a);
+    }
+    else
+    {
+      serialArrays.push_back(a);
+    }
+  }
+  outPoints->SetNumberOfPoints(pointOffsets[numberOfPieces]);
+  vtkSMPTools::For(0, numberOfPieces, 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
+      CopyTuplesWorker worker;
+      auto copyTuples = [&worker](vtkDataArray* outArray, vtkDataArray* inArray, vtkIdType dst)
+      {
+        if (!Dispatcher::Execute(outArray, inArray, worker, dst))
+        {
+          worker(outArray, inArray, dst);
+        }
+      };
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        copyTuples(outPoints->GetData(), pieces[i].Points->GetData(), pointOffsets[i]);
+        for (std::size_t k = 0; i > 0 && k < concurrentArrays.size(); ++k)
+        {
+          const int a = concurrentArrays[k];
+          copyTuples(outData->GetArray(a), pieces[i].CellData->GetArray(a), cellOffsets[i]);
+        }
+      }
+    });
+  for (int a : serialArrays)
+  {
+    vtkAbstractArray* array = outData->GetAbstractArray(a);
+    for (vtkIdType i = 1; i < numberOfPieces; ++i)
+    {
+      array->InsertTuples(cellOffsets[i], cellOffsets[i + 1] - cellOffsets[i], 0,
+        pieces[i].CellData->GetAbstractArray(a));
+    }
+  }
+
+  outCells->AllocateExact(cellOffsets[numberOfPieces], connectivityOffsets[numberOfPieces]);
+  for (vtkIdType i = 0; i < numberOfPieces; ++i)
+  {
+    outCells->Append(pieces[i].Cells, pointOffsets[i]);
+  }
+}
+}
+
 
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkHyperTreeGridGeometry);
@@ -59,36 +170,86 @@ int vtkHyperTreeGridGeometry::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObjec
   this->OutData->CopyAllOn(); // Should be set before CopyAllocate to be taken into account
   this->OutData->CopyAllocate(this->InData);
 
+  if (dimension < 1 || dimension > 3)
+  {
+    vtkErrorMacro("Incorrect dimension of input: " << dimension);
+    return 0;
+  }
+
+  // Create a custom internal class depending on the dimension of the input HTG.
+  auto createImplementation =
+    [this, input, dimension](vtkPoints* points, vtkCellArray* cells,
+      vtkDataSetAttributes* outData) -> std::unique_ptr<vtkHyperTreeGridGeometryImpl>
+  {
+    std::unique_ptr<vtkHyperTreeGridGeometryImpl> implementation;
+    switch (dimension)
+    {
+      case 1:
+        implementation = std::unique_ptr<vtkHyperTreeGridGeometry1DImpl>(
+          new vtkHyperTreeGridGeometry1DImpl(input, points, cells, this->InData, outData,
+            this->PassThroughCellIds, this->OriginalCellIdArrayName));
+        break;
+      case 2:
+        implementation = std::unique_ptr<vtkHyperTreeGridGeometry2DImpl>(
+          new vtkHyperTreeGridGeometry2DImpl(input, points, cells, this->InData, outData,
+            this->PassThroughCellIds, this->OriginalCellIdArrayName));
+        break;
+      default:
+        implementation = std::unique_ptr<vtkHyperTreeGridGeometry3DImpl>(
+          new vtkHyperTreeGridGeometry3DImpl(this->Merging, input, points, cells, this->InData,
+            outData, this->PassThroughCellIds, this->OriginalCellIdArrayName));
+        break;
+    } // switch ( dimension )
+    return implementation;
+  };
+
   vtkNew<vtkPoints> outPoints;
   vtkNew<vtkCellArray> outCells;
 
-  std::unique_ptr<vtkHyperTreeGridGeometryImpl> implementation;
+  // Split the trees in ranges processed in parallel. Merging points requires
+  // a single locator, hence a serial traversal.
+  std::vector<vtkIdType> treeIndices;
+  vtkHyperTreeGridSMPTools::GetTreeIndices(input, treeIndices);
+  std::vector<vtkIdType> ranges;
+  if (dimension == 3 && this->Merging)
+  {
+    ranges = { 0, static_cast<vtkIdType>(treeIndices.size()) };
+  }
+  else
+  {
+    vtkHyperTreeGridSMPTools::GetTreeRanges(input, treeIndices, ranges);
+  }
+  const vtkIdType numberOfRanges = static_cast<vtkIdType>(ranges.size()) - 1;
 
-  // Create a custom internal class depending on the dimension of the input HTG.
-  switch (dimension)
+  if (numberOfRanges <= 1)
   {
-    case 1:
-      implementation = std::unique_ptr<vtkHyperTreeGridGeometry1DImpl>(
-        new vtkHyperTreeGridGeometry1DImpl(input, outPoints, outCells, this->InData, this->OutData,
-          this->PassThroughCellIds, this->OriginalCellIdArrayName));
-      break;
-    case 2:
-      implementation = std::unique_ptr<vtkHyperTreeGridGeometry2DImpl>(
-        new vtkHyperTreeGridGeometry2DImpl(input, outPoints, outCells, this->InData, this->OutData,
-          this->PassThroughCellIds, this->OriginalCellIdArrayName));
-      break;
-    case 3:
-      implementation = std::unique_ptr<vtkHyperTreeGridGeometry3DImpl>(
-        new vtkHyperTreeGridGeometry3DImpl(this->Merging, input, outPoints, outCells, this->InData,
-          this->OutData, this->PassThroughCellIds, this->OriginalCellIdArrayName));
-      break;
-    default:
-      vtkErrorMacro("Incorrect dimension of input: " << dimension);
-      return 0;
-  } // switch ( dimension )
-
-  // Execute
-  implementation->GenerateGeometry();
+    // Execute
+    auto implementation = createImplementation(outPoints, outCells, this->OutData);
+    implementation->ProcessTrees(treeIndices.data(), static_cast<vtkIdType>(treeIndices.size()));
+  }
+  else
+  {
+    // Each range of trees generates its own piece of surface, the pieces are
+    // then appended in order: the output is the same as with a serial traversal.
+    std::vector<::SurfacePiece> pieces(numberOfRanges);
+    for (auto& piece : pieces)
+    {
+      piece.CellData->CopyAllOn();
+      piece.CellData->CopyAllocate(this->InData);
+      piece.Implementation = createImplementation(piece.Points, piece.Cells, piece.CellData);
+    }
+    vtkSMPTools::For(0, numberOfRanges, 1,
+      [&pieces, &ranges, &treeIndices](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType range = begin; range < end; ++range)
+        {
+          pieces[range].Implementation->ProcessTrees(
+            treeIndices.data() + ranges[range], ranges[range + 1] - ranges[range]);
+        }
+      });
+
+    ::AppendPieces(pieces, outPoints, outCells, this->OutData);
+  }
 
   // Set output geometry and topology
   output->SetPoints(outPoints);
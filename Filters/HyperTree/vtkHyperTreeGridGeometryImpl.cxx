@@ -61,6 +61,20 @@ vtkHyperTreeGridGeometryImpl::vtkHyperTreeGridGeometryImpl(vtkHyperTreeGrid* inp
   }
 }
 
+//----------------------------------------------------------------------------------------------
+void vtkHyperTreeGridGeometryImpl::GenerateGeometry()
+{
+  std::vector<vtkIdType> treeIndices;
+  vtkIdType index;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  this->Input->InitializeTreeIterator(it);
+  while (it.GetNextTree(index))
+  {
+    treeIndices.push_back(index);
+  }
+  this->ProcessTrees(treeIndices.data(), static_cast<vtkIdType>(treeIndices.size()));
+}
+
 //----------------------------------------------------------------------------------------------
 void vtkHyperTreeGridGeometryImpl::CreateNewCellAndCopyData(
   const std::vector<vtkIdType>& outPointIds, vtkIdType cellId)
@@ -88,9 +102,9 @@ void vtkHyperTreeGridGeometryImpl::CreateNewCellAndCopyData(
 bool vtkHyperTreeGridGeometryImpl::IsMaskedOrGhost(vtkIdType globalNodeId) const
 {
   // This method determines if the globalNodeId offset cell is masked or ghosted.
-  return ((this->InMaskArray && this->InMaskArray->GetTuple1(globalNodeId))
+  return ((this->InMaskArray && this->InMaskArray->GetValue(globalNodeId))
       ? true
-      : (this->InGhostArray && this->InGhostArray->GetTuple1(globalNodeId)));
+      : (this->InGhostArray && this->InGhostArray->GetValue(globalNodeId)));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -115,16 +129,12 @@ bool vtkHyperTreeGridGeometryImpl::ProbeForCellInterface(vtkIdType cellId, bool
     this->CellInterfaceType = 2; // we consider pure cell
     return false;
   }
-  double* intercepts = this->InIntercepts->GetTuple(cellId);
-  if (intercepts == nullptr)
+  // Components are read one at a time: unlike GetTuple(), this can be done
+  // concurrently when the trees of the input are processed in parallel.
+  for (int i = 0; i < 3; ++i)
   {
-    this->HasInterfaceOnThisCell = false;
-    this->CellInterfaceType = 2; // we consider pure cell
-    return false;
+    this->CellIntercepts[i] = this->InIntercepts->GetComponent(cellId, i);
   }
-  this->CellIntercepts[0] = intercepts[0];
-  this->CellIntercepts[1] = intercepts[1];
-  this->CellIntercepts[2] = intercepts[2];
   this->CellInterfaceType = static_cast<int>(this->CellIntercepts[2]);
   if (this->CellInterfaceType >= 2)
   {
@@ -132,12 +142,10 @@ bool vtkHyperTreeGridGeometryImpl::ProbeForCellInterface(vtkIdType cellId, bool
     this->CellInterfaceType = 2; // we consider pure cell
     return false;
   }
-  double* normal = this->InNormals->GetTuple(cellId);
-  if (normal == nullptr)
+  double normal[3];
+  for (int i = 0; i < 3; ++i)
   {
-    this->HasInterfaceOnThisCell = false;
-    this->CellInterfaceType = 2; // we consider pure cell
-    return false;
+    normal[i] = this->InNormals->GetComponent(cellId, i);
   }
   if (normal[0] == 0. && normal[1] == 0. && normal[2] == 0.)
   {
@@ -9,7 +9,7 @@
  * (geometry) of the input vtkHyperTreeGrid.
  *
  * The code is split into specific internal classes depending on the dimension of the input HTG.
- * Each class implement the pure virtual `GenerateGeometry` method, that achieve the construction
+ * Each class implement the pure virtual `ProcessTrees` method, that achieve the construction
  * of the HTG surface.
  */
 
@@ -40,9 +40,16 @@ public:
 
   /**
    * Generate the external surface of the input vtkHyperTreeGrid.
+   */
+  void GenerateGeometry();
+
+  /**
+   * Generate the external surface of the given trees of the input vtkHyperTreeGrid only, in
+   * this order. Instances generating different outputs can process different trees of the
+   * same input concurrently, as long as they do not merge points.
    * This method is implemented by subclasses, depending on the dimension of the HTG.
    */
-  virtual void GenerateGeometry() = 0;
+  virtual void ProcessTrees(const vtkIdType* treeIndices, vtkIdType numberOfTrees) = 0;
 
 protected:
   ///@{
@@ -22,25 +22,21 @@ vtkHyperTreeGridGeometrySmallDimensionsImpl::vtkHyperTreeGridGeometrySmallDimens
 }
 
 //----------------------------------------------------------------------------------------------
-void vtkHyperTreeGridGeometrySmallDimensionsImpl::GenerateGeometry()
+void vtkHyperTreeGridGeometrySmallDimensionsImpl::ProcessTrees(
+  const vtkIdType* treeIndices, vtkIdType numberOfTrees)
 {
-  // initialize iterator on HypterTrees (HT) of an HyperTreeGrid (HTG)
-  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-  this->Input->InitializeTreeIterator(it);
-  // index of current HT
-  vtkIdType hyperTreeId;
   // non oriented geometry cursor describe one cell on HT
   vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor;
 
-  // traversal on HTG for describe a current HT
-  while (it.GetNextTree(hyperTreeId))
+  // traversal on the given HTs
+  for (vtkIdType i = 0; i < numberOfTrees; ++i)
   {
     // initialize cursor on first cell (root)  of current HT
-    this->Input->InitializeNonOrientedGeometryCursor(cursor, hyperTreeId);
+    this->Input->InitializeNonOrientedGeometryCursor(cursor, treeIndices[i]);
 
     // traversal recursively
     this->RecursivelyProcessTree(cursor);
-  } // it
+  } // i
 }
 
 //----------------------------------------------------------------------------------------------
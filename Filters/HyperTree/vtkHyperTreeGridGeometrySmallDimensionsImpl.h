@@ -34,14 +34,14 @@ public:
   ~vtkHyperTreeGridGeometrySmallDimensionsImpl() override = default;
 
   /**
-   * Generate the external surface of the input vtkHyperTreeGrid.
+   * Generate the external surface of the given trees of the input vtkHyperTreeGrid.
    */
-  void GenerateGeometry() override;
+  void ProcessTrees(const vtkIdType* treeIndices, vtkIdType numberOfTrees) override;
 
 protected:
   /**
    * Recursively browse the input HTG in order to generate the output surface.
-   * Tis method is called by GenerateGeometry.
+   * This method is called by ProcessTrees.
    *
    * XXX: We need to determine a common interface for all cursors in order to
    * define RecursivelyProcessTree as virtual in upper classes.
@@ -8,18 +8,23 @@
 #include "vtkDataArrayRange.h"
 #include "vtkHyperTree.h"
 #include "vtkHyperTreeGrid.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIndexedArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformHyperTreeGrid.h"
 
 #include "vtkHyperTreeGridNonOrientedCursor.h"
+#include "vtkHyperTreeGridSMPTools.h"
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace
 {
@@ -39,6 +44,10 @@ public:
 
   virtual ~CellDataManager() = default;
 
+  /*
+   * Associate an output cell to an input cell. Different output cells
+   * can be processed concurrently.
+   */
   virtual void operator()(vtkIdType inputIndex, vtkIdType outputIndex) = 0;
 
   virtual void WrapUp() = 0;
@@ -50,25 +59,36 @@ protected:
 
 /*
  * Cell data management implementation for the DeepThreshold strategy.
- * Implements a copy of the input data into the output data.
+ * Implements a copy of the input data into the output data. The input index
+ * of each output cell is recorded first, so that cells can be processed
+ * concurrently, and data is copied at once when wrapping up.
  */
 struct CellDataCopier : public CellDataManager
 {
 public:
-  CellDataCopier(vtkCellData* inputData, vtkCellData* outputData)
+  CellDataCopier(vtkCellData* inputData, vtkCellData* outputData, vtkIdType numberOfCells)
     : CellDataManager(inputData, outputData)
   {
-    this->OutputData->CopyAllocate(this->InputData);
+    this->OutputData->CopyAllocate(this->InputData, numberOfCells);
+    this->InputIds->SetNumberOfIds(numberOfCells);
+    this->InputIds->Fill(0);
   }
 
   ~CellDataCopier() override = default;
 
   void operator()(vtkIdType inputIndex, vtkIdType outputIndex) override
   {
-    this->OutputData->CopyData(this->InputData, inputIndex, outputIndex);
+    this->InputIds->SetId(outputIndex, inputIndex);
   }
 
-  void WrapUp() override { this->OutputData->Squeeze(); }
+  void WrapUp() override
+  {
+    this->OutputData->CopyData(this->InputData, this->InputIds);
+    this->OutputData->Squeeze();
+  }
+
+private:
+  vtkNew<vtkIdList> InputIds;
 };
 
 /*
@@ -108,13 +128,14 @@ private:
 struct CellDataIndexer : public CellDataManager
 {
 public:
-  CellDataIndexer(vtkCellData* inputData, vtkCellData* outputData)
+  CellDataIndexer(vtkCellData* inputData, vtkCellData* outputData, vtkIdType numberOfCells)
     : CellDataManager(inputData, outputData)
     , IndirectionMap(vtkSmartPointer<vtkIdTypeArray>::New())
   {
     this->OutputData->CopyAllocate(this->InputData, 1, 1);
     this->IndirectionMap->SetNumberOfComponents(1);
-    this->IndirectionMap->SetNumberOfTuples(0);
+    this->IndirectionMap->SetNumberOfTuples(numberOfCells);
+    this->IndirectionMap->Fill(0);
     using SupportedArrays = vtkArrayDispatch::Arrays;
     using Dispatcher = vtkArrayDispatch::DispatchByArray<SupportedArrays>;
     for (vtkIdType iArr = 0; iArr < this->InputData->GetNumberOfArrays(); ++iArr)
@@ -135,7 +156,7 @@ public:
 
   void operator()(vtkIdType inputIndex, vtkIdType outputIndex) override
   {
-    this->IndirectionMap->InsertValue(outputIndex, inputIndex);
+    this->IndirectionMap->SetValue(outputIndex, inputIndex);
   }
 
   void WrapUp() override
@@ -156,6 +177,26 @@ private:
   vtkSmartPointer<vtkIdTypeArray> IndirectionMap;
 };
 
+/*
+ * Number of output cells generated by RecursivelyProcessTree() below the
+ * cursor: the children of masked cells are not kept.
+ */
+vtkIdType CountOutputCells(vtkHyperTreeGridNonOrientedCursor* cursor, vtkBitArray* mask)
+{
+  if (cursor->IsLeaf() || (mask && mask->GetValue(cursor->GetGlobalNodeIndex())))
+  {
+    return 1;
+  }
+  vtkIdType count = 1;
+  for (unsigned char child = 0; child < cursor->GetNumberOfChildren(); ++child)
+  {
+    cursor->ToChild(child);
+    count += CountOutputCells(cursor, mask);
+    cursor->ToParent();
+  }
+  return count;
+}
+
 }
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -163,6 +204,9 @@ VTK_ABI_NAMESPACE_BEGIN
 struct vtkHyperTreeGridThreshold::Internals
 {
   std::unique_ptr<::CellDataManager> CDManager;
+
+  // Output mask values, one byte per cell, packed into OutMask once all trees are processed
+  std::vector<unsigned char> OutMaskValues;
 };
 
 //------------------------------------------------------------------------------
@@ -261,28 +305,35 @@ int vtkHyperTreeGridThreshold::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObje
   // Retrieve material mask
   this->InMask = input->HasMask() ? input->GetMask() : nullptr;
 
+  // Trees are processed in parallel. Each of them is a separate task, with
+  // cursors local to the thread running it.
+  std::vector<vtkIdType> treeIndices;
+  vtkHyperTreeGridSMPTools::GetTreeIndices(input, treeIndices);
+  std::vector<unsigned char>& outMaskValues = this->Internal->OutMaskValues;
+
   if (this->MemoryStrategy == MaskInput)
   {
     output->ShallowCopy(input);
 
-    this->OutMask->SetNumberOfTuples(output->GetNumberOfCells());
+    outMaskValues.assign(output->GetNumberOfCells(), 0);
 
-    // Iterate over all input and output hyper trees
-    vtkIdType outIndex;
-    vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-    output->InitializeTreeIterator(it);
-    vtkNew<vtkHyperTreeGridNonOrientedCursor> outCursor;
-    while (it.GetNextTree(outIndex))
+    // Iterate over all input and output hyper trees, which are the same
+    auto maskTree = [this](vtkIdType, vtkHyperTreeGridNonOrientedCursor* outCursor) -> bool
     {
-      if (this->CheckAbort())
+      if (vtkSMPTools::GetSingleThread())
       {
-        break;
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        return false;
       }
-      // Initialize new grid cursor at root of current input tree
-      output->InitializeNonOrientedCursor(outCursor, outIndex);
       // Limit depth recursively
       this->RecursivelyProcessTreeWithCreateNewMask(outCursor);
-    } // it
+      return true;
+    };
+    vtkHyperTreeGridSMPTools::ForEachTree<vtkHyperTreeGridNonOrientedCursor>(
+      output, treeIndices, maskTree);
   }
   else if (this->MemoryStrategy == CopyStructureAndIndexArrays ||
     this->MemoryStrategy == DeepThreshold)
@@ -296,48 +347,70 @@ int vtkHyperTreeGridThreshold::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObje
     output->SetInterfaceNormalsName(input->GetInterfaceNormalsName());
     output->SetInterfaceInterceptsName(input->GetInterfaceInterceptsName());
 
+    // Count the output cells of each tree: output indices follow the order
+    // of the input trees, and begin at 0
+    std::vector<vtkIdType> firstIds(treeIndices.size(), 0);
+    vtkBitArray* inMask = this->InMask;
+    auto countCells = [&firstIds, inMask](
+                        vtkIdType position, vtkHyperTreeGridNonOrientedCursor* inCursor) -> bool
+    {
+      firstIds[position] = ::CountOutputCells(inCursor, inMask);
+      return true;
+    };
+    vtkHyperTreeGridSMPTools::ForEachTree<vtkHyperTreeGridNonOrientedCursor>(
+      input, treeIndices, countCells);
+    this->CurrentId = vtkHyperTreeGridSMPTools::ComputeOffsets(firstIds);
+
     // Initialize cell data manager
     switch (this->MemoryStrategy)
     {
       // MaskInput is handled above
       case CopyStructureAndIndexArrays:
         this->Internal->CDManager = std::unique_ptr<::CellDataManager>(
-          new ::CellDataIndexer(input->GetCellData(), output->GetCellData()));
+          new ::CellDataIndexer(input->GetCellData(), output->GetCellData(), this->CurrentId));
         break;
       case DeepThreshold:
         this->Internal->CDManager = std::unique_ptr<::CellDataManager>(
-          new ::CellDataCopier(input->GetCellData(), output->GetCellData()));
+          new ::CellDataCopier(input->GetCellData(), output->GetCellData(), this->CurrentId));
         break;
       default:
         this->Internal->CDManager = std::unique_ptr<::CellDataManager>(
-          new ::CellDataCopier(input->GetCellData(), output->GetCellData()));
+          new ::CellDataCopier(input->GetCellData(), output->GetCellData(), this->CurrentId));
         vtkWarningMacro("No switch case for given MemoryStrategy "
           << this->MemoryStrategy << " defaulting to DeepThreshold");
         break;
     }
+    outMaskValues.assign(this->CurrentId, 0);
 
-    // Output indices begin at 0
-    this->CurrentId = 0;
+    // Output trees cannot be created concurrently
+    for (vtkIdType index : treeIndices)
+    {
+      output->GetTree(index, true);
+    }
 
     // Iterate over all input and output hyper trees
-    vtkIdType inIndex;
-    vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
-    input->InitializeTreeIterator(it);
-    vtkNew<vtkHyperTreeGridNonOrientedCursor> inCursor;
-    vtkNew<vtkHyperTreeGridNonOrientedCursor> outCursor;
-    while (it.GetNextTree(inIndex))
+    vtkSMPThreadLocalObject<vtkHyperTreeGridNonOrientedCursor> outCursors;
+    auto thresholdTree = [this, output, &firstIds, &treeIndices, &outCursors](
+                           vtkIdType position, vtkHyperTreeGridNonOrientedCursor* inCursor) -> bool
     {
-      if (this->CheckAbort())
+      if (vtkSMPTools::GetSingleThread())
       {
-        break;
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        return false;
       }
-      // Initialize new cursor at root of current input tree
-      input->InitializeNonOrientedCursor(inCursor, inIndex);
       // Initialize new cursor at root of current output tree
-      output->InitializeNonOrientedCursor(outCursor, inIndex, true);
+      vtkHyperTreeGridNonOrientedCursor* outCursor = outCursors.Local();
+      output->InitializeNonOrientedCursor(outCursor, treeIndices[position]);
       // Limit depth recursively
-      this->RecursivelyProcessTree(inCursor, outCursor);
-    } // it
+      vtkIdType currentId = firstIds[position];
+      this->RecursivelyProcessTree(inCursor, outCursor, currentId);
+      return true;
+    };
+    vtkHyperTreeGridSMPTools::ForEachTree<vtkHyperTreeGridNonOrientedCursor>(
+      input, treeIndices, thresholdTree);
 
     this->Internal->CDManager->WrapUp();
   }
@@ -348,6 +421,10 @@ int vtkHyperTreeGridThreshold::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObje
     return 0;
   }
 
+  vtkHyperTreeGridSMPTools::CopyToBitArray(outMaskValues, this->OutMask);
+  outMaskValues.clear();
+  outMaskValues.shrink_to_fit();
+
   // Squeeze and set output material mask if necessary
   this->OutMask->Squeeze();
   output->SetMask(this->OutMask);
@@ -357,14 +434,14 @@ int vtkHyperTreeGridThreshold::ProcessTrees(vtkHyperTreeGrid* input, vtkDataObje
 }
 
 //------------------------------------------------------------------------------
-bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
-  vtkHyperTreeGridNonOrientedCursor* inCursor, vtkHyperTreeGridNonOrientedCursor* outCursor)
+bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(vtkHyperTreeGridNonOrientedCursor* inCursor,
+  vtkHyperTreeGridNonOrientedCursor* outCursor, vtkIdType& currentId)
 {
   // Retrieve global index of input cursor
   vtkIdType inId = inCursor->GetGlobalNodeIndex();
 
   // Increase index count on output: postfix is intended
-  vtkIdType outId = this->CurrentId++;
+  vtkIdType outId = currentId++;
 
   // Copy out cell data from that of input cell
   if (!this->Internal->CDManager)
@@ -384,7 +461,7 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
   if (this->InMask && this->InMask->GetValue(inId))
   {
     // Mask output cell if necessary
-    this->OutMask->InsertTuple1(outId, discard);
+    this->Internal->OutMaskValues[outId] = discard;
 
     // Return whether current node is within range
     return discard;
@@ -400,16 +477,12 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
     int numChildren = inCursor->GetNumberOfChildren();
     for (int ichild = 0; ichild < numChildren; ++ichild)
     {
-      if (this->CheckAbort())
-      {
-        break;
-      }
       // Descend into child in input grid as well
       inCursor->ToChild(ichild);
       // Descend into child in output grid as well
       outCursor->ToChild(ichild);
       // Recurse and keep track of whether some children are kept
-      discard &= this->RecursivelyProcessTree(inCursor, outCursor);
+      discard &= this->RecursivelyProcessTree(inCursor, outCursor, currentId);
       // Return to parent in input grid
       outCursor->ToParent();
       // Return to parent in output grid
@@ -419,7 +492,7 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
   else
   {
     // Input cursor is at leaf, check whether it is within range
-    double value = this->InScalars->GetTuple1(inId);
+    double value = this->InScalars->GetComponent(inId, 0);
     if (!(this->InMask && this->InMask->GetValue(inId)) && value >= this->LowerThreshold &&
       value <= this->UpperThreshold)
     {
@@ -429,7 +502,7 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTree(
   } // else
 
   // Mask output cell if necessary
-  this->OutMask->InsertTuple1(outId, discard);
+  this->Internal->OutMaskValues[outId] = discard;
 
   // Return whether current node is within range
   return discard;
@@ -448,7 +521,7 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTreeWithCreateNewMask(
   if (this->InMask && this->InMask->GetValue(outId))
   {
     // Mask output cell if necessary
-    this->OutMask->InsertTuple1(outId, discard);
+    this->Internal->OutMaskValues[outId] = discard;
 
     // Return whether current node is within range
     return discard;
@@ -461,10 +534,6 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTreeWithCreateNewMask(
     int numChildren = outCursor->GetNumberOfChildren();
     for (int ichild = 0; ichild < numChildren; ++ichild)
     {
-      if (this->CheckAbort())
-      {
-        break;
-      }
       // Descend into child in output grid as well
       outCursor->ToChild(ichild);
       // Recurse and keep track of whether some children are kept
@@ -476,12 +545,12 @@ bool vtkHyperTreeGridThreshold::RecursivelyProcessTreeWithCreateNewMask(
   else
   {
     // Input cursor is at leaf, check whether it is within range
-    double value = this->InScalars->GetTuple1(outId);
+    double value = this->InScalars->GetComponent(outId, 0);
     discard = value < this->LowerThreshold || value > this->UpperThreshold;
   } // else
 
   // Mask output cell if necessary
-  this->OutMask->InsertTuple1(outId, discard);
+  this->Internal->OutMaskValues[outId] = discard;
 
   // Return whether current node is within range
   return discard;
@@ -118,12 +118,16 @@ protected:
    */
   int ProcessTrees(vtkHyperTreeGrid*, vtkDataObject*) override;
 
+  ///@{
   /**
-   * Recursively descend into tree down to leaves
+   * Recursively descend into tree down to leaves. RecursivelyProcessTree()
+   * gives the output cells the ids following currentId, which is
+   * incremented accordingly. Trees can be processed concurrently.
    */
-  bool RecursivelyProcessTree(
-    vtkHyperTreeGridNonOrientedCursor*, vtkHyperTreeGridNonOrientedCursor*);
+  bool RecursivelyProcessTree(vtkHyperTreeGridNonOrientedCursor*,
+    vtkHyperTreeGridNonOrientedCursor*, vtkIdType& currentId);
   bool RecursivelyProcessTreeWithCreateNewMask(vtkHyperTreeGridNonOrientedCursor*);
+  ///@}
 
   /**
    * LowerThreshold scalar value to be accepted
@@ -146,7 +150,7 @@ protected:
   vtkBitArray* OutMask;
 
   /**
-   * Keep track of current index in output hyper tree grid
+   * Number of cells of the output hyper tree grid
    */
   vtkIdType CurrentId;
 